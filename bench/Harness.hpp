@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <systemc>
+#include <tlm>
+
+/*
+ * Harnesses for the microbenchmarks.
+ *
+ * SystemC modules can only be constructed during elaboration, and the kernel
+ * can not be restarted. All harnesses are therefore constructed up-front (see
+ * Bench::registerHarness), after which every benchmark runs inside a single
+ * SC_THREAD. Benchmarks may call wait() to advance simulation time.
+ */
+
+namespace Bench {
+
+/**
+ * @brief registerHarness queue a function constructing a harness during
+ * elaboration.
+ * @retval true, to allow registration in a static initializer.
+ */
+bool registerHarness(const std::function<void()> &construct);
+
+/**
+ * @brief elaborate construct all registered harnesses.
+ */
+void elaborate();
+
+/**
+ * @brief The Word class A word-sized transaction, reused across iterations so
+ * that only the transport itself is measured.
+ */
+class Word {
+ public:
+  Word() {
+    trans.set_data_ptr(m_data);
+    trans.set_data_length(TARGET_WORD_SIZE);
+    trans.set_streaming_width(TARGET_WORD_SIZE);
+  }
+
+  /**
+   * @brief at prepare the transaction for an access.
+   * @param cmd read or write
+   * @param addr target-relative address
+   */
+  tlm::tlm_generic_payload &at(const tlm::tlm_command cmd,
+                               const uint64_t addr) {
+    trans.set_command(cmd);
+    trans.set_address(addr);
+    trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+    delay = sc_core::SC_ZERO_TIME;
+    return trans;
+  }
+
+  tlm::tlm_generic_payload trans;
+  sc_core::sc_time delay{sc_core::SC_ZERO_TIME};
+
+ private:
+  unsigned char m_data[TARGET_WORD_SIZE]{0};
+};
+
+}  // namespace Bench
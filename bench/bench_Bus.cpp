@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <memory>
+#include <string>
+#include <systemc>
+#include <tlm>
+#include <vector>
+#include "bench/Harness.hpp"
+#include "libs/make_unique.hpp"
+#include "mcu/Bus.hpp"
+#include "mcu/ClockSourceChannel.hpp"
+#include "mcu/GenericMemory.hpp"
+#include "ps/PowerModelChannel.hpp"
+
+using namespace sc_core;
+
+/**
+ * @brief Bus with NTARGETS consecutive memory targets.
+ */
+SC_MODULE(BusHarness) {
+ public:
+  static const unsigned NTARGETS = 8;
+  static const unsigned TARGET_SIZE = 0x100;
+
+  sc_signal<bool> pwrOn{"pwrOn", true};
+  tlm_utils::simple_initiator_socket<BusHarness> iSocket{"iSocket"};
+  ClockSourceChannel clk{"clk"};  // Stopped, delays are not of interest
+  PowerModelChannel powerModelChannel{"powerModelChannel", "none",
+                                      SC_ZERO_TIME};
+  Bus bus{"bus"};
+  std::vector<std::unique_ptr<GenericMemory>> targets;
+
+  SC_CTOR(BusHarness) {
+    iSocket.bind(bus.tSocket);
+    for (unsigned i = 0; i < NTARGETS; ++i) {
+      targets.push_back(std::make_unique<GenericMemory>(
+          ("mem" + std::to_string(i)).c_str(), i * TARGET_SIZE,
+          (i + 1) * TARGET_SIZE - 1));
+      auto &t = *targets.back();
+      t.pwrOn.bind(pwrOn);
+      t.systemClk.bind(clk);
+      t.powerModelPort.bind(powerModelChannel);
+      bus.bindTarget(t);
+    }
+  }
+};
+
+static BusHarness *harness;
+static const bool registered =
+    Bench::registerHarness([] { harness = new BusHarness("bus"); });
+
+// Route a read to the target at port state.range(0). The routing table is
+// searched linearly, so the last port is the worst case.
+static void BM_BusRead(benchmark::State &state) {
+  const uint64_t addr = state.range(0) * BusHarness::TARGET_SIZE;
+  Bench::Word w;
+  for (auto _ : state) {
+    harness->iSocket->b_transport(w.at(tlm::TLM_READ_COMMAND, addr), w.delay);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BusRead)->Arg(0)->Arg(BusHarness::NTARGETS - 1);
+
+static void BM_BusWrite(benchmark::State &state) {
+  const uint64_t addr = state.range(0) * BusHarness::TARGET_SIZE;
+  Bench::Word w;
+  for (auto _ : state) {
+    harness->iSocket->b_transport(w.at(tlm::TLM_WRITE_COMMAND, addr), w.delay);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BusWrite)->Arg(0)->Arg(BusHarness::NTARGETS - 1);
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <string>
+#include <systemc>
+#include <tlm>
+#include "bench/Harness.hpp"
+#include "include/fused.h"
+#include "mcu/Cache.hpp"
+#include "mcu/ClockSourceChannel.hpp"
+#include "mcu/NonvolatileMemory.hpp"
+#include "ps/PowerModelChannel.hpp"
+#include "utilities/Config.hpp"
+
+using namespace sc_core;
+
+static const char *const POLICIES[] = {"LRU", "LFU", "RoundRobin",
+                                       "PseudoRandom"};
+static const unsigned NPOLICIES = sizeof(POLICIES) / sizeof(POLICIES[0]);
+
+// Geometry of Msp430TestBoard's cache
+static const unsigned LINE_WIDTH = 8;
+static const unsigned NLINES = 2;
+static const unsigned NSETS = 2;
+
+SC_MODULE(CacheHarness) {
+ public:
+  sc_signal<bool> pwrOn{"pwrOn", true};
+  sc_signal<unsigned> waitStates{"waitStates", 1};
+  tlm_utils::simple_initiator_socket<CacheHarness> iSocket{"iSocket"};
+  ClockSourceChannel clk{"clk"};  // Stopped, delays are not of interest
+  PowerModelChannel powerModelChannel{"powerModelChannel", "none",
+                                      SC_ZERO_TIME};
+
+  CacheHarness(sc_module_name nm, const std::string &policy)
+      : sc_module(nm),
+        cache(configure(std::string(nm) + ".cache", policy).c_str(),
+              NVRAM_START, NVRAM_START + NVRAM_SIZE - 1) {
+    iSocket.bind(cache.tSocket);
+    cache.iSocket.bind(nvm.tSocket);
+    cache.pwrOn.bind(pwrOn);
+    cache.systemClk.bind(clk);
+    cache.powerModelPort.bind(powerModelChannel);
+    nvm.pwrOn.bind(pwrOn);
+    nvm.systemClk.bind(clk);
+    nvm.waitStates.bind(waitStates);
+    nvm.powerModelPort.bind(powerModelChannel);
+  }
+
+  Cache cache;
+  NonvolatileMemory nvm{"nvm", NVRAM_START, NVRAM_START + NVRAM_SIZE - 1};
+
+ private:
+  /**
+   * @brief configure set the cache's config keys before it is constructed.
+   * @retval name of the cache
+   */
+  static std::string configure(const std::string &name,
+                               const std::string &policy) {
+    auto &config = Config::get();
+    config.set(name + ".CacheReplacementPolicy", policy);
+    config.set(name + ".CacheWritePolicy", "WriteAround");
+    config.set(name + ".CacheLineWidth", std::to_string(LINE_WIDTH));
+    config.set(name + ".CacheNLines", std::to_string(NLINES));
+    config.set(name + ".CacheNSets", std::to_string(NSETS));
+    return "cache";
+  }
+};
+
+static CacheHarness *harnesses[NPOLICIES];
+static const bool registered = Bench::registerHarness([] {
+  for (unsigned i = 0; i < NPOLICIES; ++i) {
+    harnesses[i] = new CacheHarness(
+        (std::string("cache") + POLICIES[i]).c_str(), POLICIES[i]);
+  }
+});
+
+// Reads cycling over [0, span) with a fixed stride
+static void readSweep(benchmark::State &state, const unsigned stride,
+                      const unsigned span) {
+  auto &harness = *harnesses[state.range(0)];
+  state.SetLabel(POLICIES[state.range(0)]);
+  Bench::Word w;
+  uint64_t addr = 0;
+  for (auto _ : state) {
+    harness.iSocket->b_transport(w.at(tlm::TLM_READ_COMMAND, addr), w.delay);
+    addr = (addr + stride) % span;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Working set of a single line, always hits after the first access
+static void BM_CacheReadHit(benchmark::State &state) {
+  readSweep(state, TARGET_WORD_SIZE, LINE_WIDTH);
+}
+BENCHMARK(BM_CacheReadHit)->DenseRange(0, NPOLICIES - 1);
+
+// One word per line over 4x the cache capacity, every access misses
+static void BM_CacheReadMiss(benchmark::State &state) {
+  readSweep(state, LINE_WIDTH, 4 * NSETS * NLINES * LINE_WIDTH);
+}
+BENCHMARK(BM_CacheReadMiss)->DenseRange(0, NPOLICIES - 1);
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <systemc>
+#include <tlm>
+#include "bench/Harness.hpp"
+#include "mcu/ClockSourceChannel.hpp"
+#include "mcu/GenericMemory.hpp"
+#include "mcu/NonvolatileMemory.hpp"
+#include "ps/PowerModelChannel.hpp"
+
+using namespace sc_core;
+
+SC_MODULE(MemoryHarness) {
+ public:
+  static const unsigned SIZE = 0x1000;
+
+  sc_signal<bool> pwrOn{"pwrOn", true};
+  sc_signal<unsigned> waitStates{"waitStates", 1};
+  tlm_utils::simple_initiator_socket<MemoryHarness> sramSocket{"sramSocket"};
+  tlm_utils::simple_initiator_socket<MemoryHarness> nvmSocket{"nvmSocket"};
+  ClockSourceChannel clk{"clk"};  // Stopped, delays are not of interest
+  PowerModelChannel powerModelChannel{"powerModelChannel", "none",
+                                      SC_ZERO_TIME};
+  GenericMemory sram{"sram", 0, SIZE - 1};
+  NonvolatileMemory nvm{"nvm", 0, SIZE - 1};
+
+  SC_CTOR(MemoryHarness) {
+    sramSocket.bind(sram.tSocket);
+    sram.pwrOn.bind(pwrOn);
+    sram.systemClk.bind(clk);
+    sram.powerModelPort.bind(powerModelChannel);
+    nvmSocket.bind(nvm.tSocket);
+    nvm.pwrOn.bind(pwrOn);
+    nvm.systemClk.bind(clk);
+    nvm.waitStates.bind(waitStates);
+    nvm.powerModelPort.bind(powerModelChannel);
+  }
+};
+
+static MemoryHarness *harness;
+static const bool registered =
+    Bench::registerHarness([] { harness = new MemoryHarness("memory"); });
+
+// Sweep word-aligned accesses over the whole memory
+template <typename Socket>
+static void sweep(benchmark::State &state, Socket &socket,
+                  const tlm::tlm_command cmd) {
+  Bench::Word w;
+  uint64_t addr = 0;
+  for (auto _ : state) {
+    socket->b_transport(w.at(cmd, addr), w.delay);
+    addr = (addr + TARGET_WORD_SIZE) % MemoryHarness::SIZE;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * TARGET_WORD_SIZE);
+}
+
+static void BM_GenericMemoryRead(benchmark::State &state) {
+  sweep(state, harness->sramSocket, tlm::TLM_READ_COMMAND);
+}
+BENCHMARK(BM_GenericMemoryRead);
+
+static void BM_GenericMemoryWrite(benchmark::State &state) {
+  sweep(state, harness->sramSocket, tlm::TLM_WRITE_COMMAND);
+}
+BENCHMARK(BM_GenericMemoryWrite);
+
+static void BM_NonvolatileMemoryRead(benchmark::State &state) {
+  sweep(state, harness->nvmSocket, tlm::TLM_READ_COMMAND);
+}
+BENCHMARK(BM_NonvolatileMemoryRead);
+
+static void BM_NonvolatileMemoryWrite(benchmark::State &state) {
+  sweep(state, harness->nvmSocket, tlm::TLM_WRITE_COMMAND);
+}
+BENCHMARK(BM_NonvolatileMemoryWrite);
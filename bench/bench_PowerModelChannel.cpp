@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <systemc>
+#include <vector>
+#include "bench/Harness.hpp"
+#include "libs/make_unique.hpp"
+#include "ps/ConstantCurrentState.hpp"
+#include "ps/ConstantEnergyEvent.hpp"
+#include "ps/PowerModelChannel.hpp"
+
+using namespace sc_core;
+
+// Roughly the number of events & modules registered by Msp430TestBoard
+static const unsigned NMODULES = 16;
+static const unsigned NEVENTS_PER_MODULE = 4;
+
+static PowerModelChannel *channel;
+static std::vector<int> events;
+static std::vector<int> onStates;
+
+static const bool registered = Bench::registerHarness([] {
+  channel = new PowerModelChannel("powerModelChannel", "none", SC_ZERO_TIME);
+  for (unsigned m = 0; m < NMODULES; ++m) {
+    const auto module = "module" + std::to_string(m);
+    for (unsigned e = 0; e < NEVENTS_PER_MODULE; ++e) {
+      events.push_back(channel->registerEvent(
+          module, std::make_unique<ConstantEnergyEvent>(
+                      "event" + std::to_string(e), 1.0e-12)));
+    }
+    channel->registerState(module,
+                           std::make_unique<ConstantCurrentState>("off", 0.0));
+    onStates.push_back(channel->registerState(
+        module, std::make_unique<ConstantCurrentState>("on", 1.0e-6)));
+  }
+});
+
+static void BM_PowerModelChannelReportEvent(benchmark::State &state) {
+  unsigned i = 0;
+  for (auto _ : state) {
+    channel->reportEvent(events[i++ % events.size()]);
+  }
+  channel->popDynamicEnergy();
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PowerModelChannelReportEvent);
+
+// One power-model timestep: some events reported, then popped by the bridge
+static void BM_PowerModelChannelPopDynamicEnergy(benchmark::State &state) {
+  for (auto _ : state) {
+    for (unsigned i = 0; i < events.size(); i += NEVENTS_PER_MODULE) {
+      channel->reportEvent(events[i]);
+    }
+    benchmark::DoNotOptimize(channel->popDynamicEnergy());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PowerModelChannelPopDynamicEnergy);
+
+static void BM_PowerModelChannelGetStaticCurrent(benchmark::State &state) {
+  for (const auto s : onStates) {
+    channel->reportState(s);
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(channel->getStaticCurrent());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PowerModelChannelGetStaticCurrent);
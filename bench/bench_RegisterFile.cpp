@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include "mcu/RegisterFile.hpp"
+
+// Register file of a typical peripheral
+static const unsigned NREGS = 16;
+
+static RegisterFile makeRegisterFile() {
+  RegisterFile regs;
+  for (unsigned i = 0; i < NREGS; ++i) {
+    regs.addRegister(i * TARGET_WORD_SIZE, 0);
+  }
+  return regs;
+}
+
+static void BM_RegisterFileRead(benchmark::State &state) {
+  auto regs = makeRegisterFile();
+  unsigned i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(regs.read((i++ % NREGS) * TARGET_WORD_SIZE));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RegisterFileRead);
+
+static void BM_RegisterFileWrite(benchmark::State &state) {
+  auto regs = makeRegisterFile();
+  unsigned i = 0;
+  for (auto _ : state) {
+    regs.write((i % NREGS) * TARGET_WORD_SIZE, i);
+    ++i;
+  }
+  benchmark::DoNotOptimize(regs.read(0));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RegisterFileWrite);
+
+static void BM_RegisterFileReadByte(benchmark::State &state) {
+  auto regs = makeRegisterFile();
+  unsigned i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(regs.readByte(i++ % (NREGS * TARGET_WORD_SIZE)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RegisterFileReadByte);
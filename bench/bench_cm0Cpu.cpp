@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <stdint.h>
+#include <systemc>
+#include <tlm>
+#include "bench/Harness.hpp"
+#include "include/fused.h"
+#include "mcu/Bus.hpp"
+#include "mcu/ClockSourceChannel.hpp"
+#include "mcu/GenericMemory.hpp"
+#include "mcu/cortex-m0/CortexM0Cpu.hpp"
+#include "ps/PowerModelChannel.hpp"
+#include "utilities/Utilities.hpp"
+
+using namespace sc_core;
+
+/*
+ * Representative instruction mix, loaded at ROM_START + 8:
+ *        movs r2, #0x20
+ *        lsls r2, r2, #24     ; r2 = RAM
+ *        movs r0, #0
+ * loop:  adds r0, r0, #1
+ *        str  r0, [r2, #0]
+ *        ldr  r1, [r2, #4]
+ *        lsls r3, r0, #2
+ *        eors r3, r1
+ *        ands r3, r0
+ *        subs r1, r3, r0
+ *        str  r1, [r2, #4]
+ *        cmp  r0, #255
+ *        bne  loop
+ *        push {r0, r1}
+ *        pop  {r0, r1}
+ *        movs r0, #0
+ *        b    loop
+ */
+static const uint16_t PROGRAM[] = {
+    0x2220, 0x0612, 0x2000, 0x1c40, 0x6010, 0x6851, 0x0083, 0x404b, 0x4003,
+    0x1a19, 0x6051, 0x28ff, 0xd1f5, 0xb403, 0xbc03, 0x2000, 0xe7f1};
+
+static const uint32_t RAM_START = 0x20000000;
+static const uint32_t MEM_SIZE = 0x10000;
+
+// Simulated cycles per benchmark iteration
+static const unsigned CYCLES = 1000;
+
+SC_MODULE(Cm0CpuHarness) {
+ public:
+  sc_signal<bool> pwrOn{"pwrOn", false};
+  sc_signal<bool> busStall{"busStall", false};
+  sc_signal<bool> sysTickIrq{"sysTickIrq", false};
+  sc_signal<int> nvicIrq{"nvicIrq", -1};
+  sc_signal<int> returningException{"returningException"};
+  sc_signal<int> activeException{"activeException"};
+  ClockSourceChannel clk{"clk", sc_time(125, SC_NS)};
+  PowerModelChannel powerModelChannel{"powerModelChannel", "none",
+                                      SC_ZERO_TIME};
+  Bus bus{"bus"};
+  GenericMemory rom{"rom", ROM_START, ROM_START + MEM_SIZE - 1};
+  GenericMemory ram{"ram", RAM_START, RAM_START + MEM_SIZE - 1};
+  CortexM0Cpu cpu{"cpu"};
+
+  SC_CTOR(Cm0CpuHarness) {
+    for (auto *m : {&rom, &ram}) {
+      m->pwrOn.bind(pwrOn);
+      m->systemClk.bind(clk);
+      m->powerModelPort.bind(powerModelChannel);
+      bus.bindTarget(*m);
+    }
+    cpu.iSocket.bind(bus.tSocket);
+    cpu.clk.bind(clk);
+    cpu.pwrOn.bind(pwrOn);
+    cpu.busStall.bind(busStall);
+    cpu.powerModelPort.bind(powerModelChannel);
+    cpu.sysTickIrq.bind(sysTickIrq);
+    cpu.nvicIrq.bind(nvicIrq);
+    cpu.returningException.bind(returningException);
+    cpu.activeException.bind(activeException);
+    cpu.unstall();  // Stalled CPUs block the kernel, waiting for gdb
+  }
+
+  /**
+   * @brief start load vector table & program, then power up the CPU.
+   */
+  void start() {
+    if (pwrOn.read()) {
+      return;  // Already running the program
+    }
+
+    write32(0, RAM_START + MEM_SIZE / 2);  // Initial stack pointer
+    write32(4, ROM_START + 8 + 1);         // Reset vector (thumb)
+    for (unsigned i = 0; i < sizeof(PROGRAM) / sizeof(PROGRAM[0]); ++i) {
+      uint8_t data[2];
+      Utility::unpackBytes(data, Utility::htots(PROGRAM[i]), 2);
+      write(8 + 2 * i, data, 2);
+    }
+
+    pwrOn.write(true);
+    wait(SC_ZERO_TIME);
+  }
+
+ private:
+  void write32(const uint32_t addr, const uint32_t val) {
+    uint8_t data[4];
+    Utility::unpackBytes(data, Utility::htotl(val), 4);
+    write(addr, data, 4);
+  }
+
+  void write(const uint32_t addr, uint8_t *const data, const unsigned len) {
+    tlm::tlm_generic_payload trans;
+    trans.set_data_ptr(data);
+    trans.set_data_length(len);
+    trans.set_command(tlm::TLM_WRITE_COMMAND);
+    trans.set_address(addr);
+    rom.transport_dbg(trans);  // Bypassing sockets
+  }
+};
+
+static Cm0CpuHarness *harness;
+static const bool registered =
+    Bench::registerHarness([] { harness = new Cm0CpuHarness("cm0"); });
+
+static void BM_Cm0CpuMix(benchmark::State &state) {
+  harness->start();
+  const auto period = harness->clk.getPeriod();
+  const auto start = harness->cpu.getInstructionCount();
+  for (auto _ : state) {
+    wait(CYCLES * period);
+  }
+  state.SetItemsProcessed(harness->cpu.getInstructionCount() - start);
+  state.counters["sim_cycles"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * CYCLES),
+      benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Cm0CpuMix);
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+#include <functional>
+#include <systemc>
+#include <vector>
+#include "bench/Harness.hpp"
+#include "utilities/Config.hpp"
+
+using namespace sc_core;
+
+namespace Bench {
+
+static std::vector<std::function<void()>> &harnesses() {
+  static std::vector<std::function<void()>> h;
+  return h;
+}
+
+bool registerHarness(const std::function<void()> &construct) {
+  harnesses().push_back(construct);
+  return true;
+}
+
+void elaborate() {
+  for (const auto &construct : harnesses()) {
+    construct();
+  }
+}
+
+}  // namespace Bench
+
+/**
+ * @brief Runs all benchmarks from within the simulation.
+ */
+SC_MODULE(BenchmarkRunner) {
+  SC_CTOR(BenchmarkRunner) {
+    SC_THREAD(run);
+    set_stack_size(16 * 1024 * 1024);  // Reporters are not written for 64 kB
+  }
+
+  void run() {
+    benchmark::RunSpecifiedBenchmarks();
+    sc_stop();
+  }
+};
+
+int sc_main(int argc, char *argv[]) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  // Self-contained, no config file required
+  auto &config = Config::get();
+  if (!config.contains("OutputDirectory")) {
+    config.set("OutputDirectory", "/tmp");
+  }
+  if (!config.contains("CortexM0Version")) {
+    config.set("CortexM0Version", "cm0+");
+  }
+  spdlog::set_level(spdlog::level::warn);
+
+  Bench::elaborate();
+  BenchmarkRunner runner("runner");
+  sc_start();
+  return 0;
+}
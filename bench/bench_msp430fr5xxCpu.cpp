@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <stdint.h>
+#include <systemc>
+#include <tlm>
+#include "bench/Harness.hpp"
+#include "mcu/ClockSourceChannel.hpp"
+#include "mcu/GenericMemory.hpp"
+#include "mcu/InterruptController.hpp"
+#include "mcu/msp430fr5xx/Msp430Cpu.hpp"
+#include "ps/PowerModelChannel.hpp"
+#include "utilities/Utilities.hpp"
+
+using namespace sc_core;
+
+/*
+ * Representative instruction mix, loaded at address 0:
+ *        mov   #0x3000, r1
+ *        mov   #0x2000, r4
+ *        clr   r5
+ * loop:  inc   r5
+ *        mov   r5, 0(r4)
+ *        mov   @r4, r6
+ *        add   r5, r6
+ *        xor   #0x5555, r6
+ *        and   r5, r6
+ *        rla   r6
+ *        mov.b r6, 2(r4)
+ *        cmp   #255, r5
+ *        jne   loop
+ *        push  r5
+ *        pop   r5
+ *        clr   r5
+ *        jmp   loop
+ */
+static const uint16_t PROGRAM[] = {
+    0x4031, 0x3000, 0x4034, 0x2000, 0x4305, 0x5315, 0x4584, 0x0000,
+    0x4426, 0x5506, 0xe036, 0x5555, 0xf506, 0x5606, 0x46c4, 0x0002,
+    0x9035, 0x00ff, 0x23f2, 0x1205, 0x4135, 0x4305, 0x3fee};
+
+// Simulated cycles per benchmark iteration
+static const unsigned CYCLES = 1000;
+
+SC_MODULE(Msp430CpuHarness) {
+ public:
+  sc_signal<bool> nReset{"nReset", false};
+  sc_signal<bool> busStall{"busStall", false};
+  InterruptController irqCtrl{"irqCtrl", 37};
+  GenericMemory mem{"mem", 0, 0xFFFF};
+  ClockSourceChannel mclk{"mclk", sc_time(125, SC_NS)};
+  PowerModelChannel powerModelChannel{"powerModelChannel", "none",
+                                      SC_ZERO_TIME};
+  Msp430Cpu cpu{"cpu"};
+
+  SC_CTOR(Msp430CpuHarness) {
+    mem.pwrOn.bind(nReset);
+    mem.tSocket.bind(cpu.iSocket);
+    mem.systemClk.bind(mclk);
+    mem.powerModelPort.bind(powerModelChannel);
+    cpu.mclk.bind(mclk);
+    cpu.pwrOn.bind(nReset);
+    cpu.irqCtrl.bind(irqCtrl);
+    cpu.busStall.bind(busStall);
+    cpu.powerModelPort.bind(powerModelChannel);
+    cpu.unstall();  // Stalled CPUs block the kernel, waiting for gdb
+  }
+
+  /**
+   * @brief start load the program and reset the CPU.
+   */
+  void start() {
+    if (nReset.read()) {
+      return;  // Already running the program
+    }
+
+    tlm::tlm_generic_payload trans;
+    uint8_t data[2];
+    trans.set_data_ptr(data);
+    trans.set_data_length(2);
+    trans.set_command(tlm::TLM_WRITE_COMMAND);
+    for (unsigned i = 0; i < sizeof(PROGRAM) / sizeof(PROGRAM[0]); ++i) {
+      Utility::unpackBytes(data, Utility::htots(PROGRAM[i]), 2);
+      trans.set_address(2 * i);
+      mem.transport_dbg(trans);
+    }
+
+    nReset.write(true);
+    wait(SC_ZERO_TIME);
+    cpu.dbg_writeReg(SR_REGNUM, 0x00);  // Clear CPUOFF flag
+  }
+
+  static const unsigned SR_REGNUM = 2;
+};
+
+static Msp430CpuHarness *harness;
+static const bool registered =
+    Bench::registerHarness([] { harness = new Msp430CpuHarness("msp430"); });
+
+static void BM_Msp430CpuMix(benchmark::State &state) {
+  harness->start();
+  const auto period = harness->mclk.getPeriod();
+  const auto start = harness->cpu.getInstructionCount();
+  for (auto _ : state) {
+    wait(CYCLES * period);
+  }
+  state.SetItemsProcessed(harness->cpu.getInstructionCount() - start);
+  state.counters["sim_cycles"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * CYCLES),
+      benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Msp430CpuMix);
@@ -7,8 +7,14 @@
 
 #pragma once
 
+#include <systemc-ams>
 #include <systemc>
+#include <vector>
 #include "mcu/Microcontroller.hpp"
+#include "ps/PowerModelChannel.hpp"
+#include "sd/Nrf24Radio.hpp"
+#include "utilities/Config.hpp"
+#include "utilities/TraceWindow.hpp"
 
 /**
  * @brief Board base class for PCB-level models in Fused.
@@ -18,4 +24,45 @@ SC_MODULE(Board) {
   SC_CTOR(Board) {}
 
   virtual Microcontroller& getMicrocontroller() = 0;
+
+  /**
+   * @brief getPowerModelChannel get a reference to the power model channel
+   */
+  virtual PowerModelChannel& getPowerModelChannel() = 0;
+
+  /**
+   * @brief getCapacitorVoltage get the voltage of the energy storage.
+   */
+  virtual double getCapacitorVoltage() const = 0;
+
+  /**
+   * @brief getRadio get the board's radio, for connecting it to an RfMedium.
+   * @retval nullptr if the board has no radio
+   */
+  virtual Nrf24Radio* getRadio() { return nullptr; }
+
+  /**
+   * @brief isBatchMode check whether to run headless, i.e. without waveform
+   * and csv traces ("BatchMode" config).
+   */
+  static bool isBatchMode() {
+    return Config::get().contains("BatchMode") &&
+           Config::get().getBool("BatchMode");
+  }
+
+  /**
+   * @brief gateTraces only record to trace files while the trace window is
+   * open, see utilities/TraceWindow.hpp.
+   */
+  static void gateTraces(const std::vector<sca_util::sca_trace_file*>& files) {
+    TraceWindow::onChange([files](bool open) {
+      for (auto* f : files) {
+        if (open) {
+          f->enable();
+        } else {
+          f->disable();
+        }
+      }
+    });
+  }
 };
@@ -23,7 +23,7 @@ Cm0SensorNode::Cm0SensorNode(const sc_module_name name)
     : Board(name),
       powerModelChannel(
           "powerModelChannel", /*logfile=*/
-          Config::get().getString("OutputDirectory"),
+          isBatchMode() ? "none" : Config::get().getString("OutputDirectory"),
           sc_time::from_seconds(Config::get().getDouble("LogTimestep"))) {
   /* ------ Bind ------ */
   // Reset
@@ -31,21 +31,28 @@ Cm0SensorNode::Cm0SensorNode(const sc_module_name name)
   resetCtrl.nReset.bind(nReset);
   mcu.nReset.bind(nReset);
 
-  // GPIO
-  for (unsigned i = 0; i < gpioPins.size(); i++) {
-    mcu.gpio->pins[i].bind(gpioPins[i]);
-  }
+  // Power cycle ledger
+  mcu.mon->setCapacitorVoltage([this] { return getCapacitorVoltage(); });
+
+  // GPIO, only pins connected to external circuitry
+  mcu.gpio->pins[GpioPinAssignment::KEEP_ALIVE].bind(keepAlivePin);
+  mcu.gpio->pins[GpioPinAssignment::V_WARN].bind(vWarnPin);
+  mcu.gpio->pins[GpioPinAssignment::BME280_CHIP_SELECT].bind(
+      bme280ChipSelectPin);
+  mcu.gpio->pins[GpioPinAssignment::ACCELEROMETER_CHIP_SELECT].bind(
+      accelerometerChipSelectPin);
+  mcu.gpio->pins[GpioPinAssignment::ACCELEROMETER_IRQ].bind(
+      accelerometerIrqPin);
 
   // off-chip serial devices
   bme280.nReset.bind(nReset);
-  bme280.chipSelect.bind(gpioPins[GpioPinAssignment::BME280_CHIP_SELECT]);
+  bme280.chipSelect.bind(bme280ChipSelectPin);
   bme280.powerModelPort.bind(powerModelChannel);
   mcu.spi->spiSocket.bind(bme280.tSocket);
 
   accelerometer.nReset.bind(nReset);
-  accelerometer.chipSelect.bind(
-      gpioPins[GpioPinAssignment::ACCELEROMETER_CHIP_SELECT]);
-  accelerometer.irq.bind(gpioPins[GpioPinAssignment::ACCELEROMETER_IRQ]);
+  accelerometer.chipSelect.bind(accelerometerChipSelectPin);
+  accelerometer.irq.bind(accelerometerIrqPin);
   accelerometer.powerModelPort.bind(powerModelChannel);
   mcu.spi->spiSocket.bind(accelerometer.tSocket);
 
@@ -59,10 +66,10 @@ Cm0SensorNode::Cm0SensorNode(const sc_module_name name)
   // External circuits (capacitor + supply voltage supervisor etc.)
   externalCircuitry.i_out.bind(icc);
   externalCircuitry.vcc.bind(vcc);
-  externalCircuitry.v_warn.bind(gpioPins[GpioPinAssignment::V_WARN]);
+  externalCircuitry.v_warn.bind(vWarnPin);
 
   // KeepAlive -- bind to IO via converter
-  keepAliveConverter.in.bind(gpioPins[GpioPinAssignment::KEEP_ALIVE]);
+  keepAliveConverter.in.bind(keepAlivePin);
   keepAliveConverter.out.bind(keepAliveBool);
   externalCircuitry.keepAlive.bind(keepAliveConverter.out);
 
@@ -70,21 +77,22 @@ Cm0SensorNode::Cm0SensorNode(const sc_module_name name)
   std::cout << "------ MCU construction complete ------\n" << mcu.bus;
 
   /* ------- Signal tracing ------ */
+  if (isBatchMode()) {
+    return;  // Headless, no traces
+  }
+
   // Creates a value-change dump
   vcdfile = sca_util::sca_create_vcd_trace_file(
       (Config::get().getString("OutputDirectory") + "/ext.vcd").c_str());
 
-  for (int i = 0; i < gpioPins.size(); ++i) {
-    sca_trace(vcdfile, gpioPins[i], fmt::format("GPIO[{:02d}]", i));
-  }
+  sca_trace(vcdfile, mcu.gpio->portState, "GPIO");
 
-  for (int i = 0; i < mcu.nvic->irq.size(); ++i) {
-    sca_trace(vcdfile, mcu.nvic->irq[i], fmt::format("NVIC.irqIn[{:02d}]", i));
-  }
   sca_trace(vcdfile, mcu.nvic_pending, "NVIC.pendingIrq");
   sca_trace(vcdfile, mcu.cpu_active_exception, "CPU.ActiveException");
   sca_trace(vcdfile, mcu.cpu_returning_exception, "CPU.ReturningException");
   sca_trace(vcdfile, mcu.spi->irq, "SPI.irq");
+  sca_trace(vcdfile, mcu.gpio->irq, "GPIO.irq");
+  sca_trace(vcdfile, mcu.dma->irq, "DMA.irq");
   sca_trace(vcdfile, mcu.systick_irq, "SysTick.irq");
   sca_trace(vcdfile, vcc, "vcc");
   sca_trace(vcdfile, icc, "icc");
@@ -102,11 +110,23 @@ Cm0SensorNode::Cm0SensorNode(const sc_module_name name)
   sca_trace(tabfile, externalCircuitry.keepAlive,
             "externalCircuitry.keepAlive");
   sca_trace(tabfile, externalCircuitry.i_supply, "externalCircuitry.i_supply");
+
+  gateTraces({vcdfile, tabfile});
 }
 
 Cm0SensorNode::~Cm0SensorNode() {
-  sca_util::sca_close_vcd_trace_file(vcdfile);
-  sca_util::sca_close_tabular_trace_file(tabfile);
+  if (vcdfile != nullptr) {
+    sca_util::sca_close_vcd_trace_file(vcdfile);
+    sca_util::sca_close_tabular_trace_file(tabfile);
+  }
 }
 
 Microcontroller &Cm0SensorNode::getMicrocontroller() { return mcu; }
+
+PowerModelChannel &Cm0SensorNode::getPowerModelChannel() {
+  return powerModelChannel;
+}
+
+double Cm0SensorNode::getCapacitorVoltage() const {
+  return externalCircuitry.getCapacitorVoltage();
+}
@@ -57,6 +57,16 @@ class Cm0SensorNode : public Board {
    */
   virtual Microcontroller &getMicrocontroller() override;
 
+  /**
+   * @brief getPowerModelChannel get a reference to the power model channel
+   */
+  virtual PowerModelChannel &getPowerModelChannel() override;
+
+  /**
+   * @brief getCapacitorVoltage get the voltage of the energy storage
+   */
+  virtual double getCapacitorVoltage() const override;
+
   /* ------ GPIO pin numbers ------ */
   struct GpioPinAssignment {
     static const int KEEP_ALIVE = 5;
@@ -72,7 +82,12 @@ class Cm0SensorNode : public Board {
   sc_core::sc_signal<double> icc{"icc", 0.0};
   sc_core::sc_signal<bool> nReset{"nReset"};
   sc_core::sc_signal<bool> keepAliveBool{"keepAliveBool"};
-  std::array<sc_core::sc_signal_resolved, 32> gpioPins;
+  sc_core::sc_signal_resolved keepAlivePin{"keepAlivePin"};
+  sc_core::sc_signal_resolved vWarnPin{"vWarnPin"};
+  sc_core::sc_signal_resolved bme280ChipSelectPin{"bme280ChipSelectPin"};
+  sc_core::sc_signal_resolved accelerometerChipSelectPin{
+      "accelerometerChipSelectPin"};
+  sc_core::sc_signal_resolved accelerometerIrqPin{"accelerometerIrqPin"};
 
   /* ------ Submodules ------ */
   ResetCtrl resetCtrl{"resetCtrl"};
@@ -86,6 +101,6 @@ class Cm0SensorNode : public Board {
   Bme280 bme280{"bme280"};
 
   /* ------ Tracing ------ */
-  sca_util::sca_trace_file *vcdfile;
-  sca_util::sca_trace_file *tabfile;
+  sca_util::sca_trace_file *vcdfile{nullptr};
+  sca_util::sca_trace_file *tabfile{nullptr};
 };
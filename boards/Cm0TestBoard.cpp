@@ -23,7 +23,7 @@ Cm0TestBoard::Cm0TestBoard(const sc_module_name name)
     : Board(name),
       powerModelChannel(
           "powerModelChannel", /*logfile=*/
-          Config::get().getString("OutputDirectory"),
+          isBatchMode() ? "none" : Config::get().getString("OutputDirectory"),
           sc_time::from_seconds(Config::get().getDouble("LogTimestep"))) {
   /* ------ Bind ------ */
   // Reset
@@ -31,10 +31,12 @@ Cm0TestBoard::Cm0TestBoard(const sc_module_name name)
   resetCtrl.nReset.bind(nReset);
   mcu.nReset.bind(nReset);
 
+  // Power cycle ledger
+  mcu.mon->setCapacitorVoltage([this] { return getCapacitorVoltage(); });
+
   // GPIO
-  for (unsigned i = 0; i < gpioPins.size(); i++) {
-    mcu.gpio->pins[i].bind(gpioPins[i]);
-  }
+  mcu.gpio->pins[31].bind(vWarnPin);
+  mcu.gpio->pins[5].bind(keepAlivePin);
 
   // off-chip serial devices
   spiLoopBack.nReset.bind(nReset);
@@ -52,10 +54,10 @@ Cm0TestBoard::Cm0TestBoard(const sc_module_name name)
   // External circuits (capacitor + supply voltage supervisor etc.)
   externalCircuitry.i_out.bind(icc);
   externalCircuitry.vcc.bind(vcc);
-  externalCircuitry.v_warn.bind(gpioPins[31]);
+  externalCircuitry.v_warn.bind(vWarnPin);
 
   // KeepAlive -- bind to IO via converter
-  keepAliveConverter.in.bind(gpioPins[5]);
+  keepAliveConverter.in.bind(keepAlivePin);
   keepAliveConverter.out.bind(keepAliveBool);
   externalCircuitry.keepAlive.bind(keepAliveConverter.out);
 
@@ -63,21 +65,22 @@ Cm0TestBoard::Cm0TestBoard(const sc_module_name name)
   std::cout << "------ MCU construction complete ------\n" << mcu.bus;
 
   /* ------- Signal tracing ------ */
+  if (isBatchMode()) {
+    return;  // Headless, no traces
+  }
+
   // Creates a value-change dump
   vcdfile = sca_util::sca_create_vcd_trace_file(
       (Config::get().getString("OutputDirectory") + "/ext.vcd").c_str());
 
-  for (int i = 0; i < gpioPins.size(); ++i) {
-    sca_trace(vcdfile, gpioPins[i], fmt::format("GPIO[{:02d}]", i));
-  }
+  sca_trace(vcdfile, mcu.gpio->portState, "GPIO");
 
-  for (int i = 0; i < mcu.nvic->irq.size(); ++i) {
-    sca_trace(vcdfile, mcu.nvic->irq[i], fmt::format("NVIC.irqIn[{:02d}]", i));
-  }
   sca_trace(vcdfile, mcu.nvic_pending, "NVIC.pendingIrq");
   sca_trace(vcdfile, mcu.cpu_active_exception, "CPU.ActiveException");
   sca_trace(vcdfile, mcu.cpu_returning_exception, "CPU.ReturningException");
   sca_trace(vcdfile, mcu.spi->irq, "SPI.irq");
+  sca_trace(vcdfile, mcu.gpio->irq, "GPIO.irq");
+  sca_trace(vcdfile, mcu.dma->irq, "DMA.irq");
   sca_trace(vcdfile, mcu.systick_irq, "SysTick.irq");
 
   // Creates a csv-like file
@@ -91,11 +94,23 @@ Cm0TestBoard::Cm0TestBoard(const sc_module_name name)
   sca_trace(tabfile, externalCircuitry.keepAlive,
             "externalCircuitry.keepAlive");
   sca_trace(tabfile, externalCircuitry.i_supply, "externalCircuitry.i_supply");
+
+  gateTraces({vcdfile, tabfile});
 }
 
 Cm0TestBoard::~Cm0TestBoard() {
-  sca_util::sca_close_vcd_trace_file(vcdfile);
-  sca_util::sca_close_tabular_trace_file(tabfile);
+  if (vcdfile != nullptr) {
+    sca_util::sca_close_vcd_trace_file(vcdfile);
+    sca_util::sca_close_tabular_trace_file(tabfile);
+  }
 }
 
 Microcontroller &Cm0TestBoard::getMicrocontroller() { return mcu; }
+
+PowerModelChannel &Cm0TestBoard::getPowerModelChannel() {
+  return powerModelChannel;
+}
+
+double Cm0TestBoard::getCapacitorVoltage() const {
+  return externalCircuitry.getCapacitorVoltage();
+}
@@ -56,6 +56,16 @@ class Cm0TestBoard : public Board {
    */
   virtual Microcontroller &getMicrocontroller() override;
 
+  /**
+   * @brief getPowerModelChannel get a reference to the power model channel
+   */
+  virtual PowerModelChannel &getPowerModelChannel() override;
+
+  /**
+   * @brief getCapacitorVoltage get the voltage of the energy storage
+   */
+  virtual double getCapacitorVoltage() const override;
+
   /* ------ Channels & signals ------ */
   PowerModelChannel powerModelChannel;
   sc_core::sc_signal<double> vcc{"vcc", 0.0};
@@ -64,7 +74,8 @@ class Cm0TestBoard : public Board {
   sc_core::sc_signal_resolved chipSelectDummySpi{"chipSelectDummySpi",
                                                  sc_dt::SC_LOGIC_0};
   sc_core::sc_signal<bool> keepAliveBool{"keepAliveBool"};
-  std::array<sc_core::sc_signal_resolved, 32> gpioPins;
+  sc_core::sc_signal_resolved vWarnPin{"vWarnPin"};          // GPIO31
+  sc_core::sc_signal_resolved keepAlivePin{"keepAlivePin"};  // GPIO5
 
   /* ------ Submodules ------ */
   ResetCtrl resetCtrl{"resetCtrl"};
@@ -75,6 +86,6 @@ class Cm0TestBoard : public Board {
   PowerModelBridge powerModelBridge{"powerModelBridge"};
 
   /* ------ Tracing ------ */
-  sca_util::sca_trace_file *vcdfile;
-  sca_util::sca_trace_file *tabfile;
+  sca_util::sca_trace_file *vcdfile{nullptr};
+  sca_util::sca_trace_file *tabfile{nullptr};
 };
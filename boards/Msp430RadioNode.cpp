@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/spdlog.h>
+#include <stdlib.h>
+#include <string>
+#include <systemc-ams>
+#include <systemc>
+#include "boards/Msp430RadioNode.hpp"
+#include "utilities/BoolLogicConverter.hpp"
+#include "utilities/Config.hpp"
+
+using namespace sc_core;
+
+Msp430RadioNode::Msp430RadioNode(const sc_module_name name)
+    : Board(name),
+      outputDirectory(Config::get().getString("OutputDirectory") + "/" +
+                      std::string(name)),
+      powerModelChannel(
+          "powerModelChannel", /*logfile=*/
+          isBatchMode() ? "none" : outputDirectory,
+          sc_time::from_seconds(Config::get().getDouble("LogTimestep"))) {
+  if (!isBatchMode() &&
+      system(std::string("mkdir -p " + outputDirectory).c_str())) {
+    SC_REPORT_FATAL(this->name(), ("Failed to create output directory " +
+                                   outputDirectory)
+                                      .c_str());
+  }
+
+  /* ------ Bind ------ */
+  // Reset
+  mcu.pmm->pwrGood.bind(nReset);
+  mcu.nReset.bind(nReset);
+
+  // Power cycle ledger
+  mcu.mon->setCapacitorVoltage([this] { return getCapacitorVoltage(); });
+
+  // IO ports
+  mcu.portA->pins[2].bind(stopperPin);
+  mcu.portA->pins[3].bind(radioIrqPin);
+  mcu.portA->pins[4].bind(radioCsPin);
+  mcu.portA->pins[5].bind(radioCePin);
+  mcu.portB->pins[0].bind(vWarnPin);
+  mcu.portC->pins[8 + 0].bind(keepAlivePin);
+
+  // Radio, powered from the same supply as the MCU
+  radio.nReset.bind(nReset);
+  radio.chipSelect.bind(radioCsPin);
+  radio.chipEnable.bind(radioCePin);
+  radio.interruptRequest.bind(radioIrqPin);
+  radio.tSocket.bind(mcu.euscib->iEusciSocket);
+  radio.powerModelPort.bind(powerModelChannel);
+
+  // Power circuitry
+  mcu.powerModelPort.bind(powerModelChannel);
+  powerModelBridge.powerModelPort.bind(powerModelChannel);
+  powerModelBridge.i_out.bind(icc);
+  powerModelBridge.v_in.bind(vcc);
+  mcu.vcc.bind(vcc);
+
+  // External circuits (capacitor + supply voltage supervisor etc.)
+  externalCircuitry.i_out.bind(icc);
+  externalCircuitry.vcc.bind(vcc);
+  externalCircuitry.v_warn.bind(vWarnPin);
+
+  // KeepAlive -- bind to IO via converter
+  keepAliveConverter.in.bind(keepAlivePin);  // P6.0 as keepAlive
+  keepAliveConverter.out.bind(keepAliveBool);
+  externalCircuitry.keepAlive.bind(keepAliveConverter.out);
+
+  // Stop simulation after <configurable> io toggles
+  simStopper.in(stopperPin);
+
+  /* ------- Signal tracing ------ */
+  if (isBatchMode()) {
+    return;  // Headless, no traces
+  }
+
+  // Creates a value-change dump
+  vcdfile = sca_util::sca_create_vcd_trace_file(
+      (outputDirectory + "/ext.vcd").c_str());
+
+  sca_trace(vcdfile, mcu.portA->portState, "PA");
+  sca_trace(vcdfile, mcu.portB->portState, "PB");
+  sca_trace(vcdfile, mcu.portC->portState, "PC");
+  sca_trace(vcdfile, mcu.portD->portState, "PD");
+  sca_trace(vcdfile, radioIrqPin, "radioIrq");
+  sca_trace(vcdfile, radioCsPin, "radioCs");
+  sca_trace(vcdfile, radioCePin, "radioCe");
+
+  // Creates a csv-like file
+  tabfile = sca_util::sca_create_tabular_trace_file(
+      (outputDirectory + "/ext.tab").c_str());
+
+  sca_trace(tabfile, vcc, "vcc");
+  sca_trace(tabfile, icc, "icc");
+  sca_trace(tabfile, nReset, "nReset");
+  sca_trace(tabfile, externalCircuitry.v_cap, "externalCircuitry.v_cap");
+
+  gateTraces({vcdfile, tabfile});
+}
+
+Msp430RadioNode::~Msp430RadioNode() {
+  if (vcdfile != nullptr) {
+    sca_util::sca_close_vcd_trace_file(vcdfile);
+    sca_util::sca_close_tabular_trace_file(tabfile);
+  }
+}
+
+Microcontroller &Msp430RadioNode::getMicrocontroller() { return mcu; }
+
+PowerModelChannel &Msp430RadioNode::getPowerModelChannel() {
+  return powerModelChannel;
+}
+
+double Msp430RadioNode::getCapacitorVoltage() const {
+  return externalCircuitry.getCapacitorVoltage();
+}
+
+Nrf24Radio *Msp430RadioNode::getRadio() { return &radio; }
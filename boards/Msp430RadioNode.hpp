@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <string>
+#include <systemc-ams>
+#include <systemc>
+#include "boards/Board.hpp"
+#include "mcu/Microcontroller.hpp"
+#include "mcu/Msp430Microcontroller.hpp"
+#include "ps/ExternalCircuitry.hpp"
+#include "ps/PowerModelBridge.hpp"
+#include "ps/PowerModelChannel.hpp"
+#include "sd/Nrf24Radio.hpp"
+#include "utilities/BoolLogicConverter.hpp"
+#include "utilities/Config.hpp"
+#include "utilities/IoSimulationStopper.hpp"
+
+/**
+ * @brief Msp430RadioNode MSP430 sensor node with an nRF24L01+ radio on the
+ * eUSCI_B SPI. Several nodes can share an RfMedium (see NetworkNodes).
+ *
+ * Traces are written to <OutputDirectory>/<board name>/, so that nodes don't
+ * overwrite each other's.
+ */
+class Msp430RadioNode : public Board {
+ public:
+  /* ------ Public methods ------ */
+  /**
+   * @brief constructor
+   */
+  Msp430RadioNode(const sc_core::sc_module_name name);
+
+  /**
+   * @brief destructor closes vcd files
+   */
+  ~Msp430RadioNode();
+
+  /**
+   * @brief getMicrocontroller get a reference to the microcontroller
+   */
+  virtual Microcontroller &getMicrocontroller() override;
+
+  /**
+   * @brief getPowerModelChannel get a reference to the power model channel
+   */
+  virtual PowerModelChannel &getPowerModelChannel() override;
+
+  /**
+   * @brief getCapacitorVoltage get the voltage of the energy storage
+   */
+  virtual double getCapacitorVoltage() const override;
+
+  /**
+   * @brief getRadio get a pointer to the radio
+   */
+  virtual Nrf24Radio *getRadio() override;
+
+  /* ------ Channels & signals ------ */
+  const std::string outputDirectory;
+  PowerModelChannel powerModelChannel;
+  sc_core::sc_signal<double> vcc{"vcc", 0.0};
+  sc_core::sc_signal<double> icc{"icc", 0.0};
+  sc_core::sc_signal<bool> nReset{"nReset"};
+  sc_core::sc_signal<bool> keepAliveBool{"keepAliveBool"};
+
+  // IO pins -- only pins connected to external devices are bound, the full
+  // ports are available as mcu.portX->portState
+  sc_core::sc_signal_resolved vWarnPin{"vWarnPin"};          // PB0 (P3.0)
+  sc_core::sc_signal_resolved keepAlivePin{"keepAlivePin"};  // PC8 (P6.0)
+  sc_core::sc_signal_resolved stopperPin{"stopperPin"};      // PA2 (P1.2)
+  sc_core::sc_signal_resolved radioIrqPin{"radioIrqPin"};    // PA3 (P1.3)
+  sc_core::sc_signal_resolved radioCsPin{"radioCsPin"};      // PA4 (P1.4)
+  sc_core::sc_signal_resolved radioCePin{"radioCePin"};      // PA5 (P1.5)
+
+  /* ------ Submodules ------ */
+  Msp430Microcontroller mcu{"mcu"};
+  ExternalCircuitry externalCircuitry{"externalCircuitry"};
+  Utility::ResolvedInBoolOut keepAliveConverter{"keepAliveConverter"};
+  IoSimulationStopper simStopper{"PA2Stopper"};
+  PowerModelBridge powerModelBridge{"powerModelBridge"};
+
+  /* ------ External chips ------ */
+  Nrf24Radio radio{"radio"};
+
+  /* ------ Tracing ------ */
+  sca_util::sca_trace_file *vcdfile{nullptr};
+  sca_util::sca_trace_file *tabfile{nullptr};
+};
@@ -18,20 +18,20 @@ Msp430TestBoard::Msp430TestBoard(const sc_module_name name)
     : Board(name),
       powerModelChannel(
           "powerModelChannel", /*logfile=*/
-          Config::get().getString("OutputDirectory"),
+          isBatchMode() ? "none" : Config::get().getString("OutputDirectory"),
           sc_time::from_seconds(Config::get().getDouble("LogTimestep"))) {
   /* ------ Bind ------ */
   // Reset
   mcu.pmm->pwrGood.bind(nReset);
   mcu.nReset.bind(nReset);
 
+  // Power cycle ledger
+  mcu.mon->setCapacitorVoltage([this] { return getCapacitorVoltage(); });
+
   // IO ports
-  for (unsigned i = 0; i < DIOAPins.size(); i++) {
-    mcu.portA->pins[i].bind(DIOAPins[i]);
-    mcu.portB->pins[i].bind(DIOBPins[i]);
-    mcu.portC->pins[i].bind(DIOCPins[i]);
-    mcu.portD->pins[i].bind(DIODPins[i]);
-  }
+  mcu.portA->pins[2].bind(stopperPin);
+  mcu.portB->pins[0].bind(vWarnPin);
+  mcu.portC->pins[8 + 0].bind(keepAlivePin);
 
   // off-chip serial devices
   spiLoopBack.nReset.bind(nReset);
@@ -49,30 +49,32 @@ Msp430TestBoard::Msp430TestBoard(const sc_module_name name)
   // External circuits (capacitor + supply voltage supervisor etc.)
   externalCircuitry.i_out.bind(icc);
   externalCircuitry.vcc.bind(vcc);
-  externalCircuitry.v_warn.bind(DIOBPins[0]);
+  externalCircuitry.v_warn.bind(vWarnPin);
 
   // KeepAlive -- bind to IO via converter
-  keepAliveConverter.in.bind(DIOCPins[8 + 0]);  // P6.0 as keepAlive
+  keepAliveConverter.in.bind(keepAlivePin);  // P6.0 as keepAlive
   keepAliveConverter.out.bind(keepAliveBool);
   externalCircuitry.keepAlive.bind(keepAliveConverter.out);
 
   // Stop simulation after <configurable> io toggles
-  simStopper.in(DIOAPins[2]);
+  simStopper.in(stopperPin);
 
   // Print memory map
   std::cout << "------ MCU construction complete ------\n" << mcu.bus;
 
   /* ------- Signal tracing ------ */
+  if (isBatchMode()) {
+    return;  // Headless, no traces
+  }
+
   // Creates a value-change dump
   vcdfile = sca_util::sca_create_vcd_trace_file(
       (Config::get().getString("OutputDirectory") + "/ext.vcd").c_str());
 
-  for (int i = 0; i < DIOAPins.size(); ++i) {
-    sca_trace(vcdfile, DIOAPins[i], fmt::format("PA{:02d}", i));
-    sca_trace(vcdfile, DIOBPins[i], fmt::format("PB{:02d}", i));
-    sca_trace(vcdfile, DIOCPins[i], fmt::format("PC{:02d}", i));
-    sca_trace(vcdfile, DIODPins[i], fmt::format("PD{:02d}", i));
-  }
+  sca_trace(vcdfile, mcu.portA->portState, "PA");
+  sca_trace(vcdfile, mcu.portB->portState, "PB");
+  sca_trace(vcdfile, mcu.portC->portState, "PC");
+  sca_trace(vcdfile, mcu.portD->portState, "PD");
   for (size_t i = 0; i < mcu.dmaTrigger.size(); ++i) {
     sca_trace(vcdfile, mcu.dmaTrigger[i], fmt::format("dmatrigger{:02d}", i));
   }
@@ -93,11 +95,23 @@ Msp430TestBoard::Msp430TestBoard(const sc_module_name name)
   sca_trace(tabfile, externalCircuitry.keepAlive,
             "externalCircuitry.keepAlive");
   sca_trace(tabfile, externalCircuitry.i_supply, "externalCircuitry.i_supply");
+
+  gateTraces({vcdfile, tabfile});
 }
 
 Msp430TestBoard::~Msp430TestBoard() {
-  sca_util::sca_close_vcd_trace_file(vcdfile);
-  sca_util::sca_close_tabular_trace_file(tabfile);
+  if (vcdfile != nullptr) {
+    sca_util::sca_close_vcd_trace_file(vcdfile);
+    sca_util::sca_close_tabular_trace_file(tabfile);
+  }
 }
 
 Microcontroller &Msp430TestBoard::getMicrocontroller() { return mcu; }
+
+PowerModelChannel &Msp430TestBoard::getPowerModelChannel() {
+  return powerModelChannel;
+}
+
+double Msp430TestBoard::getCapacitorVoltage() const {
+  return externalCircuitry.getCapacitorVoltage();
+}
@@ -38,6 +38,16 @@ class Msp430TestBoard : public Board {
    */
   virtual Microcontroller &getMicrocontroller() override;
 
+  /**
+   * @brief getPowerModelChannel get a reference to the power model channel
+   */
+  virtual PowerModelChannel &getPowerModelChannel() override;
+
+  /**
+   * @brief getCapacitorVoltage get the voltage of the energy storage
+   */
+  virtual double getCapacitorVoltage() const override;
+
   /* ------ Channels & signals ------ */
   PowerModelChannel powerModelChannel;
   sc_core::sc_signal<double> vcc{"vcc", 0.0};
@@ -47,11 +57,11 @@ class Msp430TestBoard : public Board {
                                                 sc_dt::SC_LOGIC_0};
   sc_core::sc_signal<bool> keepAliveBool{"keepAliveBool"};
 
-  // IO pins
-  std::array<sc_signal_resolved, 16> DIOAPins;
-  std::array<sc_signal_resolved, 16> DIOBPins;
-  std::array<sc_signal_resolved, 16> DIOCPins;
-  std::array<sc_signal_resolved, 16> DIODPins;
+  // IO pins -- only pins connected to external devices are bound, the full
+  // ports are available as mcu.portX->portState
+  sc_core::sc_signal_resolved vWarnPin{"vWarnPin"};          // PB0 (P3.0)
+  sc_core::sc_signal_resolved keepAlivePin{"keepAlivePin"};  // PC8 (P6.0)
+  sc_core::sc_signal_resolved stopperPin{"stopperPin"};      // PA2 (P1.2)
 
   /* ------ Submodules ------ */
   Msp430Microcontroller mcu{"mcu"};
@@ -62,6 +72,6 @@ class Msp430TestBoard : public Board {
   PowerModelBridge powerModelBridge{"powerModelBridge"};
 
   /* ------ Tracing ------ */
-  sca_util::sca_trace_file *vcdfile;
-  sca_util::sca_trace_file *tabfile;
+  sca_util::sca_trace_file *vcdfile{nullptr};
+  sca_util::sca_trace_file *tabfile{nullptr};
 };
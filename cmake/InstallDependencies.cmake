@@ -66,7 +66,7 @@ ExternalProject_Add (ep_ihex_parser
   CMAKE_ARGS -DCMAKE_INSTALL_PREFIX=${EP_INSTALL_DIR}
   )
 
-# GDB Server
+# GDB Server. Watchpoint packets don't reach it, see utilities/RspProxy.hpp
 ExternalProject_Add (ep_gdb_server
   GIT_REPOSITORY https://github.com/UoS-EEC/gdb-server.git
   GIT_SHALLOW ON
@@ -75,6 +75,18 @@ ExternalProject_Add (ep_gdb_server
   DEPENDS ep_spdlog
   )
 
+# google-benchmark (microbenchmarks only)
+ExternalProject_Add (ep_benchmark
+  GIT_REPOSITORY https://github.com/google/benchmark.git
+  GIT_TAG v1.5.2
+  GIT_SHALLOW ON
+  GIT_PROGRESS ON
+  CMAKE_ARGS -DCMAKE_INSTALL_PREFIX=${EP_INSTALL_DIR}
+             -DCMAKE_BUILD_TYPE=Release
+             -DBENCHMARK_ENABLE_TESTING=OFF
+             -DBENCHMARK_ENABLE_GTEST_TESTS=OFF
+  )
+
 # ------ Target compilers ------
 IF (INSTALL_TARGET_TOOLCHAINS)
 
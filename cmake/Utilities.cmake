@@ -4,6 +4,26 @@ function(add_sw_tests BOARDNAME)
   message("Adding software tests for ${BOARDNAME}")
   set(SWTEST_BUILD_DIR ${PROJECT_SOURCE_DIR}/sw/build/validation)
   file(GLOB_RECURSE TARGET_BINS "${SWTEST_BUILD_DIR}/${BOARDNAME}/*.hex")
+  if(SW_TEST_SUITE)
+    # Single test: elaborate the board once, then fork each program from it
+    list(LENGTH TARGET_BINS NBINS)
+    if(NBINS EQUAL 0)
+      return()
+    endif()
+    set(LISTFILE ${CMAKE_BINARY_DIR}/${BOARDNAME}-programs.txt)
+    string(REPLACE ";" "\n" PROGRAMS "${TARGET_BINS}")
+    file(WRITE ${LISTFILE} "${PROGRAMS}\n")
+    set(TESTNAME "${BOARDNAME}-suite")
+    add_test(
+      NAME ${TESTNAME}
+      COMMAND fused --board ${BOARDNAME} -L ${LISTFILE}
+        -O ${CMAKE_BINARY_DIR}/${TESTNAME}
+    )
+    math(EXPR SUITE_TIMEOUT "10 * ${NBINS}")
+    set_tests_properties(${TESTNAME} PROPERTIES TIMEOUT ${SUITE_TIMEOUT})
+    message("Added test ${TESTNAME} (${NBINS} programs)")
+    return()
+  endif()
   foreach(HEXFILE ${TARGET_BINS})
     get_filename_component(PROGNAME ${HEXFILE} NAME)
     set(TESTNAME "${BOARDNAME}-${PROGNAME}")
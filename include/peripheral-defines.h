@@ -27,9 +27,20 @@ extern "C" {
 #define SIMPLE_MONITOR_KILL_SIM 0x0D1E  //! Kill simulation (success)
 #define SIMPLE_MONITOR_SW_ERROR 0x5D1E  //! Indicate SW error (kills simulation)
 #define SIMPLE_MONITOR_TEST_FAIL 0xFA11  //! Indicate test fail (kills sim)
+//! Open/close the trace window, if TraceWindowFirmware is set (see
+//! utilities/TraceWindow.hpp)
 #define SIMPLE_MONITOR_START_EVENT_LOG 0x000E  //! Start logging events
+#define SIMPLE_MONITOR_STOP_EVENT_LOG 0x000F   //! Stop logging events
 #define SIMPLE_MONITOR_INDICATE_BEGIN 0x0001   //! Indicate start of workload
 #define SIMPLE_MONITOR_INDICATE_END 0x0002     //! Indicate end of workload
+//! Mark the end of boot & of state restoration in the current power cycle, see
+//! mcu/PowerCycleLedger.hpp
+#define SIMPLE_MONITOR_BOOT_DONE 0x0003
+#define SIMPLE_MONITOR_RESTORE_DONE 0x0004
+//! Open/close region of interest id (0-255), see mcu/RegionProfiler.hpp.
+//! INDICATE_BEGIN/END are equivalent to region 0.
+#define SIMPLE_MONITOR_ROI_BEGIN(id) (0x1000u | ((id)&0xffu))
+#define SIMPLE_MONITOR_ROI_END(id) (0x2000u | ((id)&0xffu))
 
 /* ------ SPI ------ */
 #define OFS_SPI_CR1 0x00
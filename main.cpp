@@ -17,19 +17,38 @@
 
 #include <spdlog/spdlog.h>
 #include <stdlib.h>
+#include <sys/resource.h>
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
+#include <fstream>
 #include <ihex-parser/IntelHexFile.hpp>
+#include <sstream>
 #include <string>
 #include <systemc-ams>
 #include <systemc>
 #include <thread>
+#include <vector>
 #include "boards/Board.hpp"
 #include "boards/Cm0SensorNode.hpp"
 #include "boards/Cm0TestBoard.hpp"
+#include "boards/Msp430RadioNode.hpp"
 #include "boards/Msp430TestBoard.hpp"
+#include "mcu/MemoryProfiler.hpp"
+#include "mcu/PowerCycleLedger.hpp"
+#include "mcu/RegionProfiler.hpp"
+#include "sd/RfMedium.hpp"
+#include "utilities/Checkpoint.hpp"
 #include "utilities/Config.hpp"
+#include "utilities/Ensemble.hpp"
+#include "utilities/Logging.hpp"
+#include "utilities/Profiler.hpp"
+#include "utilities/ProgramSuite.hpp"
+#include "utilities/RspProxy.hpp"
 #include "utilities/SimulationController.hpp"
+#include "utilities/Sweep.hpp"
+#include "utilities/Telemetry.hpp"
+#include "utilities/TraceWindow.hpp"
 
 #ifdef GDB_SERVER
 #include <gdb-server/GdbServer.hpp>
@@ -39,6 +58,29 @@ using namespace sc_core;
 
 Board *board;
 
+// Network simulation: all boards, and the medium connecting their radios
+std::vector<Board *> nodes;
+RfMedium *rfMedium{nullptr};
+
+/**
+ * @brief makeBoard instantiate a board by type name.
+ */
+Board *makeBoard(const std::string &type, const std::string &name) {
+  // if (type == "Cm0TestBoard") {
+  //   return new Cm0TestBoard(name.c_str());
+  // } else if (type == "Cm0SensorNode") {
+  //   return new Cm0SensorNode(name.c_str());
+  if (type == "Msp430TestBoard") {
+    return new Msp430TestBoard(name.c_str());
+  } else if (type == "Msp430RadioNode") {
+    return new Msp430RadioNode(name.c_str());
+  }
+  SC_REPORT_FATAL(
+      "sc_main",
+      fmt::format("invalid setting for Board \"{:s}\"", type).c_str());
+  exit(1);  // supress "board may be uninitialized" warning
+}
+
 // clang-format off
 // A dummy module to implement the end_of_simulation callback.
 SC_MODULE(DummyModule){
@@ -63,6 +105,21 @@ SC_MODULE(DummyModule){
     file << num_power_cycles << std::endl;
     file.close();
 
+    if (Board::isBatchMode()) {
+      writeSummary(Config::get().getString("OutputDirectory") +
+                   "/summary.json");
+    }
+
+    if (rfMedium != nullptr) {
+      writeNetworkSummary(Config::get().getString("OutputDirectory") +
+                          "/network.json");
+    }
+
+    if (Logging::g_sink == Logging::Sink::RingBuffer) {
+      Logging::dumpRingBuffer(Config::get().getString("OutputDirectory") +
+                              "/log.bin");
+    }
+
     if (Config::get().getBool("GdbServer")) {
       m_simCtrl->stopServer();
       std::this_thread::sleep_for(std::chrono::milliseconds(10));
@@ -74,6 +131,79 @@ SC_MODULE(DummyModule){
   }
   private:
   SimulationController *m_simCtrl;
+
+  //! Wall-clock time at the end of elaboration
+  const std::chrono::steady_clock::time_point m_wallStart{
+      std::chrono::steady_clock::now()};
+
+  /**
+   * @brief writeSummary write a machine-readable summary of the run, for batch
+   * mode.
+   */
+  void writeSummary(const std::string &path) {
+    const double wallTime = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - m_wallStart).count();
+    const auto &mcu = board->getMicrocontroller();
+    const auto &pmc = board->getPowerModelChannel();
+    const auto cpu = mcu.getCpuName();
+    const auto instructions = mcu.getInstructionCount();
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    std::ofstream os(path);
+    os << "{\n";
+    os << fmt::format("  \"sim_time_s\": {:g},\n", sc_time_stamp().to_seconds());
+    os << fmt::format("  \"wall_time_s\": {:g},\n", wallTime);
+    os << fmt::format("  \"instructions\": {:d},\n", instructions);
+    os << fmt::format("  \"mips\": {:g},\n", instructions / wallTime / 1e6);
+    os << fmt::format("  \"delta_cycles\": {:d},\n", sc_delta_count());
+    os << fmt::format("  \"power_cycles\": {:d},\n",
+                      mcu.getPowerOnResetCount());
+    os << fmt::format(
+        "  \"cpu_time_s\": {{\"on\": {:g}, \"off\": {:g}, \"lpm\": {:g}}},\n",
+        pmc.getStateTime(cpu, "on"), pmc.getStateTime(cpu, "off"),
+        pmc.getStateTime(cpu, "sleep"));
+    os << fmt::format("  \"peak_rss_kb\": {:d},\n", usage.ru_maxrss);
+    os << "  \"energy\": ";
+    pmc.writeSummary(os, "    ");
+    os << "\n}\n";
+    spdlog::info("Run summary written to {:s}", path);
+  }
+
+  /**
+   * @brief writeNetworkSummary write energy & activity of every node, and the
+   * RF medium's packet statistics, for network simulations.
+   */
+  void writeNetworkSummary(const std::string &path) {
+    const double wallTime = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - m_wallStart).count();
+    double totalEnergy = 0.0;
+
+    std::ofstream os(path);
+    os << "{\n";
+    os << fmt::format("  \"sim_time_s\": {:g},\n", sc_time_stamp().to_seconds());
+    os << fmt::format("  \"wall_time_s\": {:g},\n", wallTime);
+    os << "  \"nodes\": {";
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      const auto &mcu = nodes[i]->getMicrocontroller();
+      const auto &pmc = nodes[i]->getPowerModelChannel();
+      totalEnergy += pmc.getTotalEnergy();
+      os << (i == 0 ? "\n" : ",\n") << "    \"" << nodes[i]->name() << "\": {\n";
+      os << fmt::format("      \"instructions\": {:d},\n",
+                        mcu.getInstructionCount());
+      os << fmt::format("      \"power_cycles\": {:d},\n",
+                        mcu.getPowerOnResetCount());
+      os << "      \"energy\": ";
+      pmc.writeSummary(os, "        ");
+      os << "\n    }";
+    }
+    os << "\n  },\n";
+    os << fmt::format("  \"total_energy\": {:g},\n", totalEnergy);
+    os << "  \"rf\": ";
+    rfMedium->writeSummary(os, "    ");
+    os << "\n}\n";
+    spdlog::info("Network summary written to {:s}", path);
+  }
 };
 // clang-format on
 
@@ -85,22 +215,70 @@ int sc_main(int argc, char *argv[]) {
   auto &config = Config::get();
   config.parseCli(argc, argv);
   config.parseFile();
+  Logging::configure();
+
+  // Parameter sweep: workers are forked after elaboration if possible (see
+  // Sweep::forkElaborated), otherwise here. Both continue below.
+  if (config.contains("SweepFile")) {
+    const bool restore = config.contains("CheckpointRestoreFile") &&
+                         config.getString("CheckpointRestoreFile") != "none";
+    const bool network =
+        config.contains("NetworkNodes") && config.getUint("NetworkNodes") > 0;
+    if (!Sweep::forkWorkers(config.getString("SweepFile"),
+                            !config.getBool("GdbServer") && !restore &&
+                                !network)) {
+      return 0;
+    }
+  }
+
+  if (config.contains("ProgramList") &&
+      (config.getBool("GdbServer") ||
+       (config.contains("CheckpointRestoreFile") &&
+        config.getString("CheckpointRestoreFile") != "none"))) {
+    SC_REPORT_FATAL("sc_main",
+                    "ProgramList doesn't support GdbServer or checkpoint "
+                    "restore");
+  }
 
   // Instantiate board
   const auto &bstring = Config::get().getString("Board");
-  // if (bstring == "Cm0TestBoard") {
-  //   board = new Cm0TestBoard("Cm0TestBoard");
-  // } else if (bstring == "Msp430TestBoard") {
-  //   board = new Msp430TestBoard("Msp430TestBoard");
-  // } else if (bstring == "Cm0SensorNode") {
-  //   board = new Cm0SensorNode("Cm0SensorNode");
-  if (bstring == "Msp430TestBoard") {
-    board = new Msp430TestBoard("Msp430TestBoard");
+  const unsigned nNodes =
+      config.contains("NetworkNodes") ? config.getUint("NetworkNodes") : 0;
+  if (nNodes > 0) {
+    // Network: nodes "node0", "node1", ... share the board's config keys and
+    // an RF medium. Their outputs go to <OutputDirectory>/nodeN (see
+    // Utility::outputDirectory).
+    if (config.getBool("GdbServer") || config.contains("EnsembleFile") ||
+        config.contains("ProgramList") ||
+        (config.contains("CheckpointRestoreFile") &&
+         config.getString("CheckpointRestoreFile") != "none")) {
+      SC_REPORT_FATAL("sc_main",
+                      "NetworkNodes doesn't support GdbServer, ensembles, "
+                      "program lists or checkpoint restore");
+    }
+    rfMedium = new RfMedium("rfMedium");
+    for (unsigned i = 0; i < nNodes; ++i) {
+      const auto name = fmt::format("node{:d}", i);
+      config.addAlias(name, bstring);
+      const auto nodeDir = config.getString("OutputDirectory") + "/" + name;
+      config.set(name + ".OutputDirectory", nodeDir);
+      if (system(std::string("mkdir -p " + nodeDir).c_str())) {
+        spdlog::error("Failed to create output directory at {} ... exiting",
+                      nodeDir);
+        exit(1);
+      }
+      nodes.push_back(makeBoard(bstring, name));
+      if (nodes.back()->getRadio() == nullptr) {
+        SC_REPORT_FATAL(
+            "sc_main",
+            fmt::format("Board \"{:s}\" has no radio", bstring).c_str());
+      }
+      nodes.back()->getRadio()->rfMedium.bind(*rfMedium);
+    }
+    board = nodes.front();
   } else {
-    SC_REPORT_FATAL(
-        "sc_main",
-        fmt::format("invalid setting for Board \"{:s}\"", bstring).c_str());
-    exit(1);  // supress "board may be uninitialized" warning
+    board = makeBoard(bstring, bstring);
+    nodes.push_back(board);
   }
 
   // Set up output folder
@@ -118,38 +296,99 @@ int sc_main(int argc, char *argv[]) {
   SimulationController simCtrl(&board->getMicrocontroller());
   [[maybe_unused]] DummyModule d(
       "dummy", &simCtrl);  // Used to access end_of_simulation callback
+  Profiler::Reporter profiler("profiler");  // Idle unless ProfilerPeriod set
+  TraceWindow::Controller traceWindow("traceWindow");
+  Telemetry::Publisher telemetry(  // Idle unless TelemetryPeriod set
+      "telemetry", board->getMicrocontroller(), board->getPowerModelChannel(),
+      [] { return board->getCapacitorVoltage(); });
 
 #ifdef GDB_SERVER
   GdbServer *gdbServer;
   std::thread *dbgThread;
+  RspProxy *rspProxy;
+  std::thread *rspProxyThread;
 #endif
 
   if (Config::get().getBool("GdbServer")) {
 #ifdef GDB_SERVER
+    // gdb connects to the proxy, which handles watchpoints and relays
+    // everything else to the server on the next port
     spdlog::info("Starting gdb server");
-    gdbServer = new GdbServer(&simCtrl, rspPort);
+    gdbServer = new GdbServer(&simCtrl, rspPort + 1);
     dbgThread = new std::thread(&GdbServer::serverThread, gdbServer);
+    rspProxy = new RspProxy(&simCtrl, rspPort, rspPort + 1);
+    rspProxyThread = new std::thread(&RspProxy::run, rspProxy);
 #else
     spdlog::error("'GdbServer' true in config, but GDB_SERVER is undefined.");
     exit(1);
 #endif
+  } else if (config.contains("CheckpointRestoreFile") &&
+             config.getString("CheckpointRestoreFile") != "none") {
+    // Resume from checkpoint. sc_time_stamp() restarts at zero, time-indexed
+    // inputs continue from the checkpoint time (Checkpoint::now()).
+    sc_start(SC_ZERO_TIME);  // Finish elaboration before restoring
+    simCtrl.unstall();
+    Checkpoint::restore(config.getString("CheckpointRestoreFile"));
   } else {
-    // Load binary to mcu
-    auto fn = Config::get().getString("ProgramHexFile");
-    if (fn.find(".hex") == std::string::npos &&
-        fn.find(".ihex") == std::string::npos) {
-      spdlog::error(
-          "-x: Invalid file format for input file {:s}, must be '.hex' or "
-          "'.ihex'",
-          fn);
-      return 1;
-    }
-    IntelHexFile programFile(fn);
     sc_start(SC_ZERO_TIME);  // Finish elaboration before programming
-    for (const auto &s : programFile.getProgramData()) {
-      simCtrl.writeMem(&s.second[0], s.first, s.second.size());
+
+    // Sweep: elaborated once, one worker per point continues below
+    if (!Sweep::forkElaborated()) {
+      return 0;
     }
-    simCtrl.unstall();
+
+    // Program list: elaborated once, one child per program continues below
+    if (config.contains("ProgramList")) {
+      unsigned failed;
+      if (!ProgramSuite::run(config.getString("ProgramList"), failed)) {
+        return failed > 0 ? 1 : 0;
+      }
+    }
+
+    // Load binary to mcu. Network nodes run NetworkProgramHexFiles (comma-
+    // separated, the last one is repeated for remaining nodes) if set.
+    std::vector<std::string> programs;
+    if (config.contains("NetworkProgramHexFiles") &&
+        config.getString("NetworkProgramHexFiles") != "none") {
+      std::stringstream ss(config.getString("NetworkProgramHexFiles"));
+      std::string item;
+      while (std::getline(ss, item, ',')) {
+        item.erase(0, item.find_first_not_of(' '));
+        item.erase(item.find_last_not_of(' ') + 1);
+        programs.push_back(item);
+      }
+    } else {
+      programs.push_back(Config::get().getString("ProgramHexFile"));
+    }
+    for (const auto &fn : programs) {
+      if (fn.find(".hex") == std::string::npos &&
+          fn.find(".ihex") == std::string::npos) {
+        spdlog::error(
+            "-x: Invalid file format for input file {:s}, must be '.hex' or "
+            "'.ihex'",
+            fn);
+        return 1;
+      }
+    }
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      const auto &program = programs[std::min(i, programs.size() - 1)];
+      if (nNodes > 0) {
+        // For debug info, see Utility::elfPath
+        config.set(std::string(nodes[i]->name()) + ".ProgramHexFile", program);
+      }
+      IntelHexFile programFile(program);
+      SimulationController nodeCtrl(&nodes[i]->getMicrocontroller());
+      for (const auto &s : programFile.getProgramData()) {
+        nodeCtrl.writeMem(&s.second[0], s.first, s.second.size());
+      }
+      nodeCtrl.unstall();
+    }
+  }
+
+  // Ensemble: simulate the shared prefix once, members continue below
+  if (config.contains("EnsembleFile") &&
+      !Ensemble::run(config.getString("EnsembleFile"))) {
+    return 0;
   }
 
   auto timeLimit =
@@ -157,7 +396,25 @@ int sc_main(int argc, char *argv[]) {
 
   spdlog::info("Starting simulation with time limit {:s}.",
                timeLimit.to_string());
-  sc_start(timeLimit);
+  const auto checkpointPeriod =
+      config.contains("CheckpointPeriod")
+          ? sc_time::from_seconds(config.getDouble("CheckpointPeriod"))
+          : SC_ZERO_TIME;
+  // sc_start takes a duration. Simulation may already have run (ensemble
+  // prefix), or ended if an ensemble's fork point was never reached.
+  const auto running = [timeLimit]() {
+    return sc_time_stamp() < timeLimit && !sc_end_of_simulation_invoked() &&
+           sc_get_status() != SC_STOPPED;
+  };
+  if (checkpointPeriod > SC_ZERO_TIME) {
+    // Run in slices, requesting a checkpoint at the end of each
+    while (running()) {
+      sc_start(std::min(checkpointPeriod, timeLimit - sc_time_stamp()));
+      Checkpoint::request(config.getString("CheckpointFile"));
+    }
+  } else if (running()) {
+    sc_start(timeLimit - sc_time_stamp());
+  }
 
   if (sc_time_stamp() >= timeLimit) {
     spdlog::warn("Simulation stopped at SimTimeLimit {:s}",
@@ -169,11 +426,17 @@ int sc_main(int argc, char *argv[]) {
     sc_stop();
   }
 
+  // Once for all monitors, grouped by their nodes' output directories
+  RegionProfiler::writeReports("regions.json");
+  PowerCycleLedger::writeReports("power_cycles.json");
+  MemoryProfiler::writeReports("memory_profile.json");
+
 #ifdef GDB_SERVER
   if (Config::get().getBool("GdbServer")) {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
     dbgThread->join();
+    rspProxyThread->join();
 #pragma GCC diagnostic pop
   }
 #endif
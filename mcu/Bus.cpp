@@ -17,7 +17,10 @@
 #include <utility>
 #include <vector>
 #include "mcu/Bus.hpp"
+#include "libs/make_unique.hpp"
 #include "mcu/BusTarget.hpp"
+#include "mcu/BusTracer.hpp"
+#include "mcu/InstructionFetchExtension.hpp"
 #include "utilities/Config.hpp"
 
 Bus::Bus(const sc_core::sc_module_name name)
@@ -28,6 +31,7 @@ Bus::Bus(const sc_core::sc_module_name name)
 
 void Bus::bindTarget(BusTarget &t) {
   m_routingTable.emplace_back(std::make_pair(t.startAddress(), t.endAddress()));
+  m_targetNames.emplace_back(t.name());
   iSocket.bind(t.tSocket);
   sc_assert(m_routingTable.size() == iSocket.size());
 }
@@ -62,8 +66,17 @@ void Bus::b_transport([[maybe_unused]] const int id,
             .c_str());
   }
   checkTransaction(trans, port);
-  iSocket[port]->b_transport(trans, delay);
-  updateTrace(trans, addr);
+  if (m_tracer) {
+    const auto start = sc_core::sc_time_stamp() + delay;
+    iSocket[port]->b_transport(trans, delay);
+    m_tracer->record(id, port, addr, trans, start,
+                     sc_core::sc_time_stamp() + delay - start);
+  } else {
+    iSocket[port]->b_transport(trans, delay);
+  }
+  if (isWatched(addr)) {
+    checkWatchpoints(trans, addr);
+  }
 }
 
 unsigned int Bus::transport_dbg([[maybe_unused]] const int id,
@@ -90,6 +103,71 @@ unsigned int Bus::transport_dbg([[maybe_unused]] const int id,
   }
 }
 
+void Bus::insertWatchpoint(const unsigned addr, const unsigned len,
+                           const WatchType type) {
+  m_watchpoints.push_back(Watchpoint{addr, std::max(len, 1u), type});
+  updateWatchedPages();
+}
+
+bool Bus::removeWatchpoint(const unsigned addr, const unsigned len,
+                           const WatchType type) {
+  const auto it = std::find_if(
+      m_watchpoints.begin(), m_watchpoints.end(),
+      [addr, len, type](const Watchpoint &w) {
+        return w.addr == addr && w.len == std::max(len, 1u) && w.type == type;
+      });
+  if (it == m_watchpoints.end()) {
+    return false;
+  }
+  m_watchpoints.erase(it);
+  updateWatchedPages();
+  return true;
+}
+
+void Bus::updateWatchedPages() {
+  m_watchedPages.clear();
+  for (const auto &w : m_watchpoints) {
+    const unsigned last = (w.addr + w.len - 1) >> WATCH_PAGE_BITS;
+    if (last >= m_watchedPages.size()) {
+      m_watchedPages.resize(last + 1, false);
+    }
+    for (unsigned p = w.addr >> WATCH_PAGE_BITS; p <= last; ++p) {
+      m_watchedPages[p] = true;
+    }
+  }
+}
+
+void Bus::checkWatchpoints(const tlm::tlm_generic_payload &trans,
+                           const unsigned addr) {
+  if (InstructionFetchExtension::isFetch(trans)) {
+    return;  // Data watchpoints only, as gdb's rwatch/awatch
+  }
+  const bool isWrite = trans.get_command() == tlm::TLM_WRITE_COMMAND;
+  const unsigned len = trans.get_data_length();
+  for (const auto &w : m_watchpoints) {
+    if (addr + len <= w.addr || addr >= w.addr + w.len ||
+        (w.type == WatchType::Write && !isWrite) ||
+        (w.type == WatchType::Read && isWrite)) {
+      continue;
+    }
+    spdlog::info("@{:10s}: Watchpoint hit ({:s} 0x{:08x})",
+                 sc_core::sc_time_stamp().to_string(),
+                 isWrite ? "write" : "read", addr);
+    if (m_watchpointHandler) {
+      m_watchpointHandler(addr, w.type);
+    }
+    return;
+  }
+}
+
+void Bus::start_of_simulation() {
+  if (BusTracer::isEnabled()) {
+    m_tracer = std::make_unique<BusTracer>(this->name(), m_targetNames);
+  }
+}
+
+void Bus::end_of_simulation() { m_tracer.reset(); }
+
 bool Bus::overlapsExistingTarget(const int startAddress,
                                  const int endAddress) const {
   const auto hit = std::find_if(
@@ -124,16 +202,3 @@ std::ostream &operator<<(std::ostream &os, Bus &rhs) {
   }
   return os;
 }
-
-void Bus::updateTrace(const tlm::tlm_generic_payload &trans,
-                      const unsigned originalAddress) {
-  dataTrace = 0;
-  for (int i = 0; i < sizeof(dataTrace); ++i) {
-    dataTrace <<= 8;
-    if (i < trans.get_data_length()) {
-      dataTrace |= trans.get_data_ptr()[i];
-    }
-  }
-  addressTrace = originalAddress;
-  sizeTrace = trans.get_data_length();
-}
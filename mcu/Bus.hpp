@@ -12,7 +12,9 @@
 #include <tlm_utils/multi_passthrough_target_socket.h>
 #include <algorithm>
 #include <array>
+#include <functional>
 #include <iomanip>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <systemc>
@@ -20,10 +22,18 @@
 #include <utility>
 #include <vector>
 #include "mcu/BusTarget.hpp"
+#include "mcu/BusTracer.hpp"
 #include "utilities/Config.hpp"
 
 class Bus : sc_core::sc_module {
  public:
+  /* ------ Types ------ */
+  //! Watchpoint kinds, numbered as the type of gdb's Z2/Z3/Z4 packets
+  enum class WatchType : int { Write = 2, Read = 3, Access = 4 };
+
+  //! Called after an access hits a watchpoint, with the accessed address
+  typedef std::function<void(unsigned, WatchType)> WatchpointHandler;
+
   /* ------ Ports ------ */
   tlm_utils::multi_passthrough_initiator_socket<Bus> iSocket;
   tlm_utils::multi_passthrough_target_socket<Bus> tSocket;
@@ -59,18 +69,89 @@ class Bus : sc_core::sc_module {
   unsigned int transport_dbg([[maybe_unused]] const int id,
                              tlm::tlm_generic_payload &trans);
 
-  /* ------ Trace variables ------ */
- public:
-  unsigned addressTrace{0xffffffff};
-  unsigned sizeTrace{0};
-  unsigned dataTrace{0};
+  /**
+   * @brief insertWatchpoint watch accesses to an address range.
+   * @param addr start address
+   * @param len length of the range in bytes
+   * @param type kind of accesses to watch
+   */
+  void insertWatchpoint(const unsigned addr, const unsigned len,
+                        const WatchType type);
+
+  /**
+   * @brief removeWatchpoint remove a watchpoint inserted with the same
+   * arguments.
+   * @retval false if there was no such watchpoint.
+   */
+  bool removeWatchpoint(const unsigned addr, const unsigned len,
+                        const WatchType type);
+
+  /**
+   * @brief setWatchpointHandler set the function called on watchpoint hits.
+   */
+  void setWatchpointHandler(WatchpointHandler handler) {
+    m_watchpointHandler = handler;
+  }
+
+  /**
+   * @brief SystemC callback, used here to start the transaction tracer.
+   */
+  virtual void start_of_simulation() override;
+
+  /**
+   * @brief SystemC callback, used here to flush the transaction tracer.
+   */
+  virtual void end_of_simulation() override;
 
  private:
   /* ------ Private variables ------ */
   /* Routing table, index is port number, holds <startAddress, endAddress> */
   std::vector<std::pair<const unsigned, const unsigned>> m_routingTable{};
 
+  //! Target names, index is port number
+  std::vector<std::string> m_targetNames{};
+
+  //! Transaction tracer, only set if BusTrace is enabled
+  std::unique_ptr<BusTracer> m_tracer;
+
+  //! Watched address range
+  struct Watchpoint {
+    unsigned addr;
+    unsigned len;
+    WatchType type;
+  };
+
+  //! log2 of the granularity of the watched page filter, in bytes
+  static const unsigned WATCH_PAGE_BITS = 8;
+
+  std::vector<Watchpoint> m_watchpoints{};
+  std::vector<bool> m_watchedPages{};  //! Empty while there are no watchpoints
+  WatchpointHandler m_watchpointHandler{};
+
   /* ------ Private methods ------ */
+  /**
+   * @brief isWatched Filter for the watchpoint slow path: check if an address
+   * is in a page with a watchpoint.
+   */
+  bool isWatched(const unsigned addr) const {
+    return (addr >> WATCH_PAGE_BITS) < m_watchedPages.size() &&
+           m_watchedPages[addr >> WATCH_PAGE_BITS];
+  }
+
+  /**
+   * @brief checkWatchpoints Check a completed transaction against all
+   * watchpoints, and call the handler on a hit. Instruction fetches are
+   * ignored.
+   * @param addr bus address of the transaction
+   */
+  void checkWatchpoints(const tlm::tlm_generic_payload &trans,
+                        const unsigned addr);
+
+  /**
+   * @brief updateWatchedPages Rebuild the page filter from m_watchpoints.
+   */
+  void updateWatchedPages();
+
   /**
    * @brief Check if a is within the bounds specified by min and max
    * @param a address to check
@@ -113,14 +194,6 @@ class Bus : sc_core::sc_module {
   void checkTransaction(const tlm::tlm_generic_payload &trans,
                         const int targetPort) const;
 
-  /**
-   * @brief updateTrace update trace variables according to current transaction.
-   * @param trans transaction after completion (i.e. with loaded data)
-   * @param originalAddress Transaction address before decoding
-   */
-  void updateTrace(const tlm::tlm_generic_payload &trans,
-                   const unsigned originalAddress);
-
   /**
    * @brief << debug printout.
    * @note the rhs reference should be const, but SystemC prevents this because
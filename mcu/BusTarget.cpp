@@ -23,6 +23,15 @@ BusTarget::BusTarget(const sc_module_name name, const unsigned startAddress,
       m_endAddress(endAddress) {
   sc_assert(startAddress <= endAddress);
   tSocket.bind(*this);
+  registerCheckpointable(this->name());
+}
+
+void BusTarget::saveState(CheckpointWriter &writer) const {
+  m_regs.saveState(writer);
+}
+
+void BusTarget::restoreState(CheckpointReader &reader) {
+  m_regs.restoreState(reader);
 }
 
 void BusTarget::end_of_elaboration() {
@@ -13,8 +13,11 @@
 #include "mcu/ClockSourceIf.hpp"
 #include "mcu/RegisterFile.hpp"
 #include "ps/PowerModelChannelIf.hpp"
+#include "utilities/Checkpoint.hpp"
 
-class BusTarget : public sc_core::sc_module, public tlm::tlm_fw_transport_if<> {
+class BusTarget : public sc_core::sc_module,
+                  public tlm::tlm_fw_transport_if<>,
+                  public Checkpointable {
  public:
   /* ------ Ports ------ */
   //! Bus clock
@@ -60,6 +63,17 @@ class BusTarget : public sc_core::sc_module, public tlm::tlm_fw_transport_if<> {
    */
   virtual void reset(void) = 0;
 
+  /**
+   * @brief saveState Checkpoint the register file. Peripherals with internal
+   * state beyond their registers extend this.
+   */
+  virtual void saveState(CheckpointWriter &writer) const override;
+
+  /**
+   * @brief restoreState Restore the register file from a checkpoint.
+   */
+  virtual void restoreState(CheckpointReader &reader) override;
+
   /**
    * @brief inRange Check whether an address is in range for this target.
    *        The bus is assumed to decrement the address before sending the
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <pthread.h>
+#include <spdlog/spdlog.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <systemc>
+#include <thread>
+#include <tlm>
+#include <vector>
+#include "mcu/BusTracer.hpp"
+#include "utilities/Config.hpp"
+#include "utilities/Utilities.hpp"
+
+using namespace sc_core;
+
+namespace {
+
+//! Open tracers, for draining the writer threads before a fork
+std::vector<BusTracer *> g_tracers;
+
+unsigned getAddress(const std::string &key, const unsigned defaultValue) {
+  const auto &config = Config::get();
+  return config.contains(key)
+             ? static_cast<unsigned>(std::stoul(config.getString(key), 0, 0))
+             : defaultValue;
+}
+
+uint64_t toPs(const sc_time &t) {
+  return static_cast<uint64_t>(std::llround(t.to_seconds() * 1e12));
+}
+
+void writeU32(FILE *f, const uint32_t val) {
+  const uint8_t b[4] = {static_cast<uint8_t>(val),
+                        static_cast<uint8_t>(val >> 8),
+                        static_cast<uint8_t>(val >> 16),
+                        static_cast<uint8_t>(val >> 24)};
+  fwrite(b, 1, sizeof(b), f);
+}
+
+}  // namespace
+
+BusTracer::BusTracer(const std::string &name,
+                     const std::vector<std::string> &targetNames)
+    : m_targets(targetNames.size(), true), m_ring(new Record[RING_SIZE]) {
+  const auto &config = Config::get();
+  m_startAddress = getAddress("BusTraceStartAddress", 0);
+  m_endAddress = getAddress("BusTraceEndAddress", 0xffffffff);
+
+  if (config.contains("BusTraceTargets") &&
+      config.getString("BusTraceTargets") != "all") {
+    std::fill(m_targets.begin(), m_targets.end(), false);
+    std::stringstream ss(config.getString("BusTraceTargets"));
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+      item.erase(0, item.find_first_not_of(' '));
+      item.erase(item.find_last_not_of(' ') + 1);
+      const auto it =
+          std::find_if(targetNames.begin(), targetNames.end(),
+                       [&item](const std::string &name) {
+                         return name == item ||
+                                name.substr(name.rfind('.') + 1) == item;
+                       });
+      if (it == targetNames.end()) {
+        SC_REPORT_FATAL("BusTracer",
+                        fmt::format("Unknown bus target \"{:s}\" in "
+                                    "BusTraceTargets",
+                                    item)
+                            .c_str());
+      }
+      m_targets[it - targetNames.begin()] = true;
+    }
+  }
+
+  const auto path = Utility::outputDirectory(name) + "/bus_trace.bin";
+  m_file = fopen(path.c_str(), "wb");
+  if (m_file == nullptr) {
+    SC_REPORT_FATAL("BusTracer",
+                    ("Can't open " + path + " for writing").c_str());
+  }
+  fwrite("FUSEDBUS", 1, 8, m_file);
+  writeU32(m_file, VERSION);
+  writeU32(m_file, sizeof(Record));
+  writeU32(m_file, targetNames.size());
+  for (const auto &name : targetNames) {
+    fwrite(name.c_str(), 1, name.size() + 1, m_file);
+  }
+
+  static std::once_flag registered;
+  std::call_once(registered, [] {
+    pthread_atfork(&BusTracer::prepareFork, nullptr,
+                   &BusTracer::afterForkChild);
+  });
+  g_tracers.push_back(this);
+  m_writer.reset(new std::thread(&BusTracer::writerLoop, this));
+}
+
+BusTracer::~BusTracer() {
+  m_stop = true;
+  if (m_writer) {
+    m_writer->join();
+  } else {
+    drain();  // Forked, and nothing recorded since
+  }
+  fclose(m_file);
+  g_tracers.erase(std::remove(g_tracers.begin(), g_tracers.end(), this),
+                  g_tracers.end());
+}
+
+bool BusTracer::isEnabled() {
+  return Config::get().contains("BusTrace") &&
+         Config::get().getBool("BusTrace");
+}
+
+void BusTracer::push(const int initiator, const int target,
+                     const unsigned address,
+                     const tlm::tlm_generic_payload &trans,
+                     const sc_time &start, const sc_time &latency) {
+  if (!m_writer) {
+    // The parent's writer thread doesn't exist in a forked child
+    m_writer.reset(new std::thread(&BusTracer::writerLoop, this));
+  }
+
+  const auto head = m_head.load(std::memory_order_relaxed);
+  while (head - m_tail.load(std::memory_order_acquire) >= RING_SIZE) {
+    std::this_thread::yield();  // Full, wait for the writer
+  }
+
+  auto &r = m_ring[head & (RING_SIZE - 1)];
+  r.time = toPs(start);
+  r.latency = toPs(latency);
+  r.address = address;
+  r.data = 0;
+  const auto len = std::min<unsigned>(trans.get_data_length(), sizeof(r.data));
+  memcpy(&r.data, trans.get_data_ptr(), len);
+  r.initiator = static_cast<uint8_t>(initiator);
+  r.target = static_cast<uint8_t>(target);
+  r.size = static_cast<uint8_t>(trans.get_data_length());
+  r.command = static_cast<uint8_t>(trans.get_command());
+  r.reserved = 0;
+  m_head.store(head + 1, std::memory_order_release);
+}
+
+size_t BusTracer::drain() {
+  const auto head = m_head.load(std::memory_order_acquire);
+  auto tail = m_tail.load(std::memory_order_relaxed);
+  const size_t n = head - tail;
+  while (tail != head) {
+    // Write contiguous chunks up to the end of the ring
+    const auto idx = tail & (RING_SIZE - 1);
+    const auto chunk = std::min<uint64_t>(head - tail, RING_SIZE - idx);
+    fwrite(&m_ring[idx], sizeof(Record), chunk, m_file);
+    tail += chunk;
+    m_tail.store(tail, std::memory_order_release);
+  }
+  return n;
+}
+
+void BusTracer::writerLoop() {
+  while (true) {
+    const bool stop = m_stop.load(std::memory_order_acquire);
+    if (drain() == 0) {
+      if (stop) {
+        return;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+}
+
+/* ------ Fork handling ------ */
+
+void BusTracer::prepareFork() {
+  // Forking happens on the simulation thread, nothing is pushed meanwhile
+  for (auto *t : g_tracers) {
+    while (t->m_tail.load(std::memory_order_acquire) !=
+           t->m_head.load(std::memory_order_relaxed)) {
+      std::this_thread::yield();
+    }
+    fflush(t->m_file);
+  }
+}
+
+void BusTracer::afterForkChild() {
+  for (auto *t : g_tracers) {
+    t->m_writer.release();  // Not joinable from the child
+  }
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <systemc>
+#include <thread>
+#include <tlm>
+#include <vector>
+#include "utilities/TraceWindow.hpp"
+
+/*
+ * Bus transaction tracer.
+ *
+ * Transactions are captured as fixed-size records into a single-producer,
+ * single-consumer lock-free ring buffer, which a background thread drains to
+ * <OutputDirectory>/bus_trace.bin. The producer only blocks if the writer
+ * falls a full ring behind.
+ *
+ * File layout: an 8-byte magic "FUSEDBUS", u32 version, u32 record size, u32
+ * number of targets, the NUL-terminated target names (indexed by the record's
+ * target field), then records until the end of the file. All little-endian.
+ * Decode with tools/decode_bus_trace.py.
+ *
+ * Enabled with BusTrace: True, filtered by BusTraceStartAddress,
+ * BusTraceEndAddress (inclusive, bus addresses) and BusTraceTargets (comma-
+ * separated target names, or all). Only records while the trace window is
+ * open, see utilities/TraceWindow.hpp.
+ */
+class BusTracer {
+ public:
+  //! Trace record, as written to file
+  struct Record {
+    uint64_t time;     //! Start of the transaction, including delay (ps)
+    uint64_t latency;  //! Delay added by the target (ps)
+    uint32_t address;  //! Bus address
+    uint32_t data;     //! Data, little-endian, after completion
+    uint8_t initiator;  //! Bus target socket index of the initiator
+    uint8_t target;     //! Bus initiator socket index of the target
+    uint8_t size;       //! Bytes
+    uint8_t command;    //! tlm::tlm_command
+    uint32_t reserved;
+  };
+  static_assert(sizeof(Record) == 32, "Unexpected BusTracer::Record padding");
+
+  /**
+   * @brief BusTracer open the trace file and start the writer thread.
+   * @param name name of the bus
+   * @param targetNames names of the bus targets, by port
+   */
+  BusTracer(const std::string &name,
+            const std::vector<std::string> &targetNames);
+
+  //! Drain the ring buffer & stop the writer thread
+  ~BusTracer();
+
+  /**
+   * @brief isEnabled check if bus tracing is enabled in the config.
+   */
+  static bool isEnabled();
+
+  /**
+   * @brief record trace a completed transaction, if it passes the filters.
+   * @param initiator index of the initiator
+   * @param target port number of the target
+   * @param address bus address (before decoding)
+   * @param trans transaction after completion
+   * @param start start time of the transaction
+   * @param latency delay added by the target
+   */
+  void record(const int initiator, const int target, const unsigned address,
+              const tlm::tlm_generic_payload &trans,
+              const sc_core::sc_time &start, const sc_core::sc_time &latency) {
+    if (!TraceWindow::isOpen() || address < m_startAddress ||
+        address > m_endAddress || !m_targets[target]) {
+      return;
+    }
+    push(initiator, target, address, trans, start, latency);
+  }
+
+ private:
+  static const unsigned VERSION = 1;
+  static const size_t RING_SIZE = 1 << 16;  // Records, power of 2
+
+  FILE *m_file{nullptr};
+  unsigned m_startAddress{0};
+  unsigned m_endAddress{0xffffffff};
+  std::vector<bool> m_targets;  //! Traced targets, by port
+
+  // ------ Ring buffer ------
+  std::unique_ptr<Record[]> m_ring;
+  std::atomic<uint64_t> m_head{0};  //! Next record to write, producer only
+  std::atomic<uint64_t> m_tail{0};  //! Next record to drain, writer only
+  std::atomic<bool> m_stop{false};
+
+  //! Writer thread, null in a forked child (see Ensemble) until restarted
+  std::unique_ptr<std::thread> m_writer;
+
+  void push(const int initiator, const int target, const unsigned address,
+            const tlm::tlm_generic_payload &trans,
+            const sc_core::sc_time &start, const sc_core::sc_time &latency);
+
+  void writerLoop();
+
+  /**
+   * @brief drain write all records in the ring buffer to file.
+   * @retval number of records written
+   */
+  size_t drain();
+
+  static void prepareFork();
+  static void afterForkChild();
+};
@@ -39,6 +39,27 @@ void CacheSet::reset() {
   replacementPolicy->reset();
 }
 
+void CacheSet::saveState(CheckpointWriter &writer) const {
+  for (const auto &l : lines) {
+    writer.write(l.valid);
+    writer.write(l.dirty);
+    writer.write(l.tag);
+    writer.writeVector(l.data);
+  }
+  replacementPolicy->saveState(writer);
+}
+
+void CacheSet::restoreState(CheckpointReader &reader) {
+  for (auto &l : lines) {
+    reader.read(l.valid);
+    reader.read(l.dirty);
+    reader.read(l.tag);
+    reader.expect(l.data.size(), "cache line width");
+    reader.readBlock(l.data.data(), l.data.size());
+  }
+  replacementPolicy->restoreState(reader);
+}
+
 Cache::Cache(const sc_module_name name, const unsigned startAddress,
              const unsigned endAddress)
     : BusTarget(name, startAddress, endAddress) {
@@ -49,6 +70,9 @@ Cache::Cache(const sc_module_name name, const unsigned startAddress,
   auto cfg = m_lineWidth = Config::get().getUint(strname + ".CacheLineWidth");
   m_nSets = Config::get().getUint(strname + ".CacheNSets");
   m_nLines = Config::get().getUint(strname + ".CacheNLines");
+  if (Config::get().contains(strname + ".CacheEnabled")) {
+    m_enabled = Config::get().getBool(strname + ".CacheEnabled");
+  }
   m_nOffsetBits = static_cast<int>(log2(m_lineWidth));
   m_offsetMask = m_lineWidth - 1;
   m_nIdBits = static_cast<int>(log2(m_nSets));
@@ -86,6 +110,12 @@ Cache::Cache(const sc_module_name name, const unsigned startAddress,
       SC_REPORT_ERROR("FRAM Cache set", "Invalid replacement policy.");
     }
   }
+
+  if (MemoryProfiler::isEnabled()) {
+    m_profiler = std::make_unique<MemoryProfiler>(
+        this->name(), startAddress, endAddress - startAddress + 1,
+        /*nonvolatile=*/false);
+  }
 };
 
 void Cache::end_of_elaboration() {
@@ -117,10 +147,23 @@ void Cache::end_of_elaboration() {
 }
 
 void Cache::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay) {
+  if (!m_enabled) {
+    iSocket->b_transport(trans, delay);  // Uncached
+    return;
+  }
+
   auto addr = trans.get_address();
   uint8_t *dataPtr = trans.get_data_ptr();
   auto len = trans.get_data_length();
 
+  if (m_profiler) {
+    if (trans.get_command() == tlm::TLM_WRITE_COMMAND) {
+      m_profiler->write(addr, len);
+    } else {
+      m_profiler->read(addr, len);
+    }
+  }
+
   // Check alignment to cache line
   if (offset(addr) > offset(addr + len - 1)) {
     spdlog::error(
@@ -241,6 +284,24 @@ void Cache::reset() {
   }
 }
 
+void Cache::saveState(CheckpointWriter &writer) const {
+  BusTarget::saveState(writer);
+  writer.write(static_cast<uint64_t>(m_sets.size()));
+  writer.write(static_cast<uint64_t>(m_nLines));
+  for (const auto &s : m_sets) {
+    s.saveState(writer);
+  }
+}
+
+void Cache::restoreState(CheckpointReader &reader) {
+  BusTarget::restoreState(reader);
+  reader.expect(m_sets.size(), "number of cache sets");
+  reader.expect(m_nLines, "number of cache lines");
+  for (auto &s : m_sets) {
+    s.restoreState(reader);
+  }
+}
+
 void Cache::writeLine(CacheLine &line, const uint32_t addr, sc_time &delay) {
   sc_assert(line.dirty);  // Don't write back clean lines
   sc_assert(line.valid);  // Don't write back valid lines
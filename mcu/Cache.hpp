@@ -10,12 +10,14 @@
 #include <stdint.h>
 #include <iostream>
 #include <list>
+#include <memory>
 #include <string>
 #include <systemc>
 #include <tlm>
 #include <vector>
 #include "mcu/BusTarget.hpp"
 #include "mcu/CacheReplacementPolicies.hpp"
+#include "mcu/MemoryProfiler.hpp"
 #include "utilities/Config.hpp"
 
 /* Cache line */
@@ -45,6 +47,8 @@ class CacheSet {
   unsigned miss(const unsigned tag);
   void hit(const unsigned tag);
   void reset();
+  void saveState(CheckpointWriter &writer) const;
+  void restoreState(CheckpointReader &reader);
 
   /* ------ Public variables ------ */
   CacheReplacementIf *replacementPolicy;
@@ -86,6 +90,16 @@ class Cache : public BusTarget, public tlm::tlm_bw_transport_if<> {
    */
   unsigned int transport_dbg(tlm::tlm_generic_payload &trans) override;
 
+  /**
+   * @brief saveState checkpoint the content and replacement state of all sets
+   */
+  virtual void saveState(CheckpointWriter &writer) const override;
+
+  /**
+   * @brief restoreState restore all sets from a checkpoint
+   */
+  virtual void restoreState(CheckpointReader &reader) override;
+
   /**
    * @brief << operator debug printout
    */
@@ -99,6 +113,7 @@ class Cache : public BusTarget, public tlm::tlm_bw_transport_if<> {
   int m_lineWidth;
   int m_nSets;
   int m_nLines;
+  bool m_enabled{true};  //! Forward all accesses to memory when false
   int m_nOffsetBits;
   int m_nIdBits;
   unsigned m_offsetMask;
@@ -118,6 +133,9 @@ class Cache : public BusTarget, public tlm::tlm_bw_transport_if<> {
   int m_nBytesReadEventId{-1};
   int m_nBytesWrittenEventId{-1};
 
+  //! CPU-side access counts, only constructed if enabled
+  std::unique_ptr<MemoryProfiler> m_profiler;
+
   /* ------- Private methods ------ */
 
   /**
@@ -11,6 +11,7 @@
 #include <array>
 #include <list>
 #include <queue>
+#include "utilities/Checkpoint.hpp"
 
 /**
  * Collection of cache replacement policies
@@ -38,6 +39,16 @@ class CacheReplacementIf {
    * @brief reset reset to power-on defaults.
    */
   virtual void reset() = 0;
+
+  /**
+   * @brief saveState write replacement state to a checkpoint.
+   */
+  virtual void saveState(CheckpointWriter &writer) const = 0;
+
+  /**
+   * @brief restoreState read replacement state from a checkpoint.
+   */
+  virtual void restoreState(CheckpointReader &reader) = 0;
 };
 
 /**
@@ -70,6 +81,14 @@ class CacheReplacementLru : public CacheReplacementIf {
     }
   }
 
+  virtual void saveState(CheckpointWriter &writer) const override {
+    writer.writeContainer(m_lru);
+  }
+
+  virtual void restoreState(CheckpointReader &reader) override {
+    reader.readContainer(m_lru);
+  }
+
  private:
   /* ------ Private variables ------ */
   std::list<unsigned int> m_lru{};
@@ -91,6 +110,14 @@ class CacheReplacementRoundRobin : public CacheReplacementIf {
 
   virtual void reset() override { m_cnt = 0; }
 
+  virtual void saveState(CheckpointWriter &writer) const override {
+    writer.write(m_cnt);
+  }
+
+  virtual void restoreState(CheckpointReader &reader) override {
+    reader.read(m_cnt);
+  }
+
  private:
   unsigned m_cnt{0};
   const unsigned m_nLines;
@@ -141,6 +168,16 @@ class CacheReplacementLfu : public CacheReplacementIf {
     }
   }
 
+  virtual void saveState(CheckpointWriter &writer) const override {
+    writer.writeVector(m_counters);
+    writer.write(m_tieBreaker);
+  }
+
+  virtual void restoreState(CheckpointReader &reader) override {
+    reader.readVector(m_counters);
+    reader.read(m_tieBreaker);
+  }
+
  private:
   /* ------ Private variables ------ */
   std::vector<int> m_counters;
@@ -163,7 +200,7 @@ class CacheReplacementPseudoRandom : public CacheReplacementIf {
   virtual int miss([[maybe_unused]] bool isWrite) override {
     /* taps: 16 14 13 11; feedback polynomial: x^16 + x^14 + x^13 + x^11 + 1
      */
-    static uint16_t lfsr = 0xBEEF;  //! Only need one lfsr for the whole cache
+    uint16_t &lfsr = sharedLfsr();
     uint16_t bit = ((lfsr >> 0) ^ (lfsr >> 2) ^ (lfsr >> 3) ^ (lfsr >> 5));
     lfsr = (lfsr >> 1) | (bit << 15);
     return lfsr & m_outputMask;
@@ -173,7 +210,21 @@ class CacheReplacementPseudoRandom : public CacheReplacementIf {
     // Do nothing
   }
 
+  virtual void saveState(CheckpointWriter &writer) const override {
+    writer.write(sharedLfsr());
+  }
+
+  virtual void restoreState(CheckpointReader &reader) override {
+    reader.read(sharedLfsr());
+  }
+
  private:
+  //! Only need one lfsr for the whole cache
+  static uint16_t &sharedLfsr() {
+    static uint16_t lfsr = 0xBEEF;
+    return lfsr;
+  }
+
   /* ------ Private variables ------ */
   const unsigned m_outputMask;
 };
@@ -9,6 +9,7 @@
 
 #include <systemc>
 #include "mcu/ClockSourceIf.hpp"
+#include "utilities/Profiler.hpp"
 
 class ClockSourceChannel : public ClockSourceDriverIf,
                            public sc_core::sc_module {
@@ -72,6 +73,7 @@ class ClockSourceChannel : public ClockSourceDriverIf,
    * @note Clock starts after period has been set.
    */
   void process() {
+    FUSED_PROFILE("ClockSourceChannel::process");
     if (m_period > sc_core::SC_ZERO_TIME) {
       m_nextEdgeEvent.notify(m_period);
     }
@@ -45,7 +45,7 @@ Cm0Microcontroller::Cm0Microcontroller(sc_module_name nm)
   scb = new DummyPeripheral("scb", 0xe000ed00, 0xe000ed8f);
   sysTick = new SysTick("sysTick");
   nvic = new Nvic("nvic");
-  mon = new SimpleMonitor("mon", SIMPLE_MONITOR_BASE);
+  mon = new SimpleMonitor("mon", SIMPLE_MONITOR_BASE, this);
   gpio = new Gpio("gpio");
   spi = new Spi("spi", SPI1_BASE, SPI1_BASE + 0x10);
   dma = new Dma("dma", DMA_BASE);
@@ -92,24 +92,19 @@ Cm0Microcontroller::Cm0Microcontroller(sc_module_name nm)
   sysTick->irq.bind(systick_irq);
   sysTick->returning_exception.bind(cpu_returning_exception);
 
-  spi->irq.bind(nvic_irq[SPI1_EXCEPT_ID]);
+  spi->irq.bind(nvic->irqLine(SPI1_EXCEPT_ID));
   spi->active_exception.bind(cpu_active_exception);
 
-  gpio->irq.bind(nvic_irq[GPIO_EXCEPT_ID]);
+  gpio->irq.bind(nvic->irqLine(GPIO_EXCEPT_ID));
   gpio->active_exception.bind(cpu_active_exception);
 
-  dma->irq.bind(nvic_irq[DMA_EXCEPT_ID]);
+  dma->irq.bind(nvic->irqLine(DMA_EXCEPT_ID));
   dma->active_exception.bind(cpu_active_exception);
 
   nvic->pending.bind(nvic_pending);
   nvic->returning.bind(cpu_returning_exception);
   nvic->active.bind(cpu_active_exception);
 
-  // Bind internal interrupt signals
-  for (unsigned i = 0; i < nvic_irq.size(); i++) {
-    nvic->irq[i].bind(nvic_irq[i]);
-  }
-
   // Reset
   m_cpu.pwrOn.bind(nReset);
   for (const auto &s : slaves) {
@@ -135,6 +130,12 @@ Cm0Microcontroller::Cm0Microcontroller(sc_module_name nm)
 
   // Bus
   m_cpu.iSocket.bind(bus.tSocket);
+  bus.setWatchpointHandler([this](unsigned addr, Bus::WatchType type) {
+    m_watchpointHit = true;
+    m_watchpointAddr = addr;
+    m_watchpointType = static_cast<int>(type);
+    m_cpu.stall();
+  });
   dma->iSocket.bind(bus.tSocket);
   for (const auto &s : slaves) {
     bus.bindTarget(*s);
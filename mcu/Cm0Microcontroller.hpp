@@ -38,7 +38,6 @@ public:
   sc_core::sc_signal<int> cpu_active_exception{"cpu_active_exception"};
   sc_core::sc_signal<int> cpu_returning_exception{"cpu_returning_exception"};
 
-  std::array<sc_core::sc_signal<bool>, 32> nvic_irq;
   sc_core::sc_signal<int> nvic_pending{"nvic_pending"};
   sc_core::sc_signal<bool> systick_irq{"systick_irq"};
 
@@ -80,7 +79,10 @@ public:
   /**
    * @brief Unstall CPU execution
    */
-  virtual void unstall(void) override { m_cpu.unstall(); }
+  virtual void unstall(void) override {
+    m_watchpointHit = false;
+    m_cpu.unstall();
+  }
 
   /**
    * @brief Check if CPU is stalled
@@ -92,7 +94,10 @@ public:
   /**
    * @brief Execute a single instrucion, then stall
    */
-  virtual void step(void) override { m_cpu.step(); }
+  virtual void step(void) override {
+    m_watchpointHit = false;
+    m_cpu.step();
+  }
 
   /* ------ Interrogation functions ------ */
 
@@ -164,11 +169,56 @@ public:
     m_cpu.removeBreakpoint(addr);
   }
 
+  /**
+   * @brief insertWatchpoint watch accesses to an address range.
+   * Execution will halt after a matching access.
+   * @param type 2 (write), 3 (read) or 4 (access), as in gdb's Z2/Z3/Z4
+   */
+  virtual bool insertWatchpoint(int type, unsigned addr,
+                                unsigned len) override {
+    if (type < 2 || type > 4) {
+      return false;
+    }
+    bus.insertWatchpoint(addr, len, static_cast<Bus::WatchType>(type));
+    return true;
+  }
+
+  /**
+   * @brief removeWatchpoint remove a watchpoint inserted with the same
+   * arguments.
+   */
+  virtual bool removeWatchpoint(int type, unsigned addr,
+                                unsigned len) override {
+    return type >= 2 && type <= 4 &&
+           bus.removeWatchpoint(addr, len, static_cast<Bus::WatchType>(type));
+  }
+
+  /**
+   * @brief stoppedByWatchpoint check if execution was halted by a watchpoint
+   * since it was last resumed.
+   */
+  virtual bool stoppedByWatchpoint(unsigned &addr,
+                                   int &type) const override {
+    addr = m_watchpointAddr;
+    type = m_watchpointType;
+    return m_watchpointHit;
+  }
+
   // number of power cycles (power-on resets)
   unsigned getPowerOnResetCount() const {
     return 1;
   }
 
+  virtual uint64_t getInstructionCount() const override {
+    return m_cpu.getInstructionCount();
+  }
+
+  virtual uint64_t getCycleCount() const override {
+    return m_cpu.getCycleCount();
+  }
+
+  virtual std::string getCpuName() const override { return m_cpu.name(); }
+
 private:
   /**
    * @brief process Monitors output from PMM and resets processor during
@@ -194,6 +244,9 @@ public:
   CortexM0Cpu m_cpu;
   Bus bus;
   std::vector<BusTarget *> slaves;
+  bool m_watchpointHit{false};   //! Stalled by a watchpoint
+  unsigned m_watchpointAddr{0};  //! Address of the last watchpoint hit
+  int m_watchpointType{0};       //! Type (2, 3 or 4) of the last watchpoint hit
 
   /* ------ Simulation utilities */
   SimpleMonitor *mon;
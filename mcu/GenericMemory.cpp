@@ -18,10 +18,20 @@
 using namespace sc_core;
 
 GenericMemory::GenericMemory(sc_module_name name, unsigned startAddress,
-                             unsigned endAddress)
+                             unsigned endAddress, const bool isVolatile)
     : BusTarget(name, startAddress, endAddress),
       mem(std::make_unique<uint8_t[]>(endAddress - startAddress + 1)),
-      m_capacity(endAddress - startAddress + 1) {}
+      m_capacity(endAddress - startAddress + 1) {
+  if (MemoryProfiler::isEnabled()) {
+    m_profiler = std::make_unique<MemoryProfiler>(this->name(), startAddress,
+                                                  m_capacity, !isVolatile);
+    if (!isVolatile) {
+      SC_METHOD(powerOff);
+      sensitive << pwrOn;
+      dont_initialize();
+    }
+  }
+}
 
 void GenericMemory::end_of_elaboration() {
   BusTarget::end_of_elaboration();
@@ -35,6 +45,18 @@ void GenericMemory::end_of_elaboration() {
       std::make_unique<ConstantEnergyEvent>(this->name(), "bytes read"));
 }
 
+void GenericMemory::saveState(CheckpointWriter &writer) const {
+  BusTarget::saveState(writer);
+  writer.write(static_cast<uint64_t>(m_capacity));
+  writer.writeBlock(mem.get(), m_capacity);
+}
+
+void GenericMemory::restoreState(CheckpointReader &reader) {
+  BusTarget::restoreState(reader);
+  reader.expect(m_capacity, "memory size");
+  reader.readBlock(mem.get(), m_capacity);
+}
+
 void GenericMemory::b_transport(tlm::tlm_generic_payload &trans,
                                 sc_time &delay) {
   auto addr = trans.get_address();
@@ -43,11 +65,17 @@ void GenericMemory::b_transport(tlm::tlm_generic_payload &trans,
 
   if (trans.get_command() == tlm::TLM_WRITE_COMMAND) {
     std::memcpy(&mem[addr], data, len);
+    if (m_profiler) {
+      m_profiler->write(addr, len);
+    }
     m_writeEvent.notify(delay + systemClk->getPeriod());
     powerModelPort->reportEvent(m_writeEventId);
     powerModelPort->reportEvent(m_nBytesWrittenEventId, len);
   } else if (trans.get_command() == tlm::TLM_READ_COMMAND) {
     std::memcpy(data, &mem[addr], len);
+    if (m_profiler) {
+      m_profiler->read(addr, len);
+    }
     m_readEvent.notify(delay + systemClk->getPeriod());
     powerModelPort->reportEvent(m_readEventId);
     powerModelPort->reportEvent(m_nBytesReadEventId, len);
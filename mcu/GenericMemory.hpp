@@ -11,6 +11,7 @@
 #include <systemc>
 #include <tlm>
 #include "mcu/BusTarget.hpp"
+#include "mcu/MemoryProfiler.hpp"
 
 class GenericMemory : public BusTarget {
   SC_HAS_PROCESS(GenericMemory);
@@ -19,8 +20,12 @@ class GenericMemory : public BusTarget {
   /* ------ Types ------ */
 
   /* ------ Public methods ------ */
+  /**
+   * @brief GenericMemory constructor
+   * @param isVolatile only affects profiling, see MemoryProfiler.hpp
+   */
   GenericMemory(sc_core::sc_module_name name, unsigned startAddress,
-                unsigned endAddress);
+                unsigned endAddress, const bool isVolatile = false);
 
   /**
    * @brief reset Do nothing, i.e. models nonvolatile memory by default.
@@ -54,10 +59,33 @@ class GenericMemory : public BusTarget {
    */
   virtual void end_of_elaboration() override;
 
+  /**
+   * @brief saveState Checkpoint the memory image.
+   */
+  virtual void saveState(CheckpointWriter &writer) const override;
+
+  /**
+   * @brief restoreState Restore the memory image from a checkpoint.
+   */
+  virtual void restoreState(CheckpointReader &reader) override;
+
  protected:
   std::unique_ptr<uint8_t[]> mem;  // Pointer to emulated memory
   const size_t m_capacity;         // Memory capacity (bytes)
 
   int m_nBytesWrittenEventId{-1};
   int m_nBytesReadEventId{-1};
+
+  //! Access counts, only constructed if enabled
+  std::unique_ptr<MemoryProfiler> m_profiler;
+
+ private:
+  /**
+   * @brief powerOff SystemC method, closes the profiler's power cycle.
+   */
+  void powerOff() {
+    if (!pwrOn.read()) {
+      m_profiler->powerOff();
+    }
+  }
 };
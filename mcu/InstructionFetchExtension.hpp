@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <tlm>
+
+/**
+ * @brief The InstructionFetchExtension class Marks a read as an instruction
+ * fetch, e.g. so that data watchpoints ignore it. CPUs set their own instance
+ * for the duration of the transport call, and clear it before the payload goes
+ * out of scope.
+ */
+struct InstructionFetchExtension
+    : public tlm::tlm_extension<InstructionFetchExtension> {
+  virtual tlm::tlm_extension_base *clone() const override {
+    return new InstructionFetchExtension();
+  }
+
+  virtual void copy_from(const tlm::tlm_extension_base &) override {}
+
+  /**
+   * @brief isFetch check if a transaction is an instruction fetch.
+   */
+  static bool isFetch(const tlm::tlm_generic_payload &trans) {
+    return trans.get_extension<InstructionFetchExtension>() != nullptr;
+  }
+};
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <systemc>
+#include <vector>
+#include "mcu/InterruptControllerIf.hpp"
+#include "utilities/Checkpoint.hpp"
+
+/**
+ * @brief The InterruptLine class Single-bit channel connecting a peripheral's
+ * irq or ira port to an InterruptController. Unlike sc_signal<bool>, a write
+ * takes effect immediately, i.e. raising or clearing a request is a direct
+ * update of the controller's pending mask without an update phase. Events are
+ * still notified (one delta later) for processes that are sensitive to the
+ * line.
+ */
+class InterruptLine : public sc_core::sc_signal_inout_if<bool> {
+ public:
+  /**
+   * @brief InterruptLine constructor
+   * @param ctrl controller to forward writes to, or nullptr for ira lines
+   * @param idx source index
+   */
+  InterruptLine(InterruptControllerIf *ctrl, const unsigned idx)
+      : m_ctrl(ctrl), m_idx(idx) {}
+
+  virtual void write(const bool &val) override {
+    if (val == m_value) {
+      return;
+    }
+    m_value = val;
+    m_changeStamp = sc_core::sc_delta_count() + 1;
+    m_valueChangedEvent.notify(sc_core::SC_ZERO_TIME);
+    if (val) {
+      m_posedgeEvent.notify(sc_core::SC_ZERO_TIME);
+    } else {
+      m_negedgeEvent.notify(sc_core::SC_ZERO_TIME);
+    }
+    if (m_ctrl != nullptr) {
+      m_ctrl->setPending(m_idx, val);
+    }
+  }
+
+  virtual const bool &read() const override { return m_value; }
+  virtual const bool &get_data_ref() const override { return m_value; }
+
+  virtual bool event() const override {
+    return m_changeStamp == sc_core::sc_delta_count();
+  }
+  virtual bool posedge() const override { return event() && m_value; }
+  virtual bool negedge() const override { return event() && !m_value; }
+
+  virtual const sc_core::sc_event &value_changed_event() const override {
+    return m_valueChangedEvent;
+  }
+  virtual const sc_core::sc_event &posedge_event() const override {
+    return m_posedgeEvent;
+  }
+  virtual const sc_core::sc_event &negedge_event() const override {
+    return m_negedgeEvent;
+  }
+  virtual const sc_core::sc_event &default_event() const override {
+    return m_valueChangedEvent;
+  }
+
+ private:
+  InterruptControllerIf *const m_ctrl;
+  const unsigned m_idx;
+  bool m_value{false};
+  sc_dt::uint64 m_changeStamp{~sc_dt::uint64(0)};
+  sc_core::sc_event m_valueChangedEvent;
+  sc_core::sc_event m_posedgeEvent;
+  sc_core::sc_event m_negedgeEvent;
+};
+
+/**
+ * @brief The InterruptController class Interrupt fabric based on bitmasks.
+ * Each source owns one bit of a pending mask. Sources are grouped into
+ * priority levels (level 0 being the highest), and within a level the lowest
+ * source index has the highest priority, so the winning source is found with
+ * a single count-trailing-zeros of (pending & enabled & level).
+ */
+class InterruptController : public InterruptControllerIf,
+                            public sc_core::sc_module,
+                            public Checkpointable {
+ public:
+  static const unsigned MAX_SOURCES = 64;
+
+  /**
+   * @brief InterruptController constructor
+   * @param nm
+   * @param nSources number of interrupt sources (max. MAX_SOURCES)
+   * @param nPriorities number of priority levels. All sources start at level
+   * 0 and enabled.
+   */
+  InterruptController(sc_core::sc_module_name nm, const unsigned nSources,
+                      const unsigned nPriorities = 1)
+      : sc_core::sc_module(nm),
+        m_nSources(nSources),
+        m_sourceMask((nSources >= MAX_SOURCES) ? ~uint64_t(0)
+                                                : (uint64_t(1) << nSources) -
+                                                      1),
+        m_enableMask(m_sourceMask),
+        m_priorityMasks(nPriorities, 0) {
+    if ((nSources == 0) || (nSources > MAX_SOURCES) || (nPriorities == 0)) {
+      SC_REPORT_FATAL(this->name(), "Invalid number of sources/priorities");
+    }
+    m_priorityMasks[0] = m_sourceMask;
+    for (unsigned i = 0; i < m_nSources; ++i) {
+      m_irqLines.emplace_back(new InterruptLine(this, i));
+      m_iraLines.emplace_back(new InterruptLine(nullptr, i));
+    }
+    registerCheckpointable(this->name());
+  }
+
+  /**
+   * @brief irqLine get the request line of a source, to be bound to the
+   * source's irq port.
+   */
+  sc_core::sc_signal_inout_if<bool> &irqLine(const unsigned idx) {
+    sc_assert(idx < m_nSources);
+    return *m_irqLines[idx];
+  }
+
+  /**
+   * @brief iraLine get the interrupt-accepted line of a source, to be bound
+   * to the source's ira port.
+   */
+  sc_core::sc_signal_inout_if<bool> &iraLine(const unsigned idx) {
+    sc_assert(idx < m_nSources);
+    return *m_iraLines[idx];
+  }
+
+  virtual void setPending(const unsigned idx, const bool pending) override {
+    const uint64_t bit = uint64_t(1) << idx;
+    setPendingMask(pending ? (m_pendingMask | bit) : (m_pendingMask & ~bit));
+  }
+
+  virtual bool isPending(const unsigned idx) const override {
+    return m_pendingMask & (uint64_t(1) << idx);
+  }
+
+  virtual int highestPending() const override {
+    const uint64_t requests = m_pendingMask & m_enableMask;
+    if (requests) {
+      for (const auto &levelMask : m_priorityMasks) {
+        const uint64_t p = requests & levelMask;
+        if (p) {
+          return __builtin_ctzll(p);
+        }
+      }
+    }
+    return -1;
+  }
+
+  virtual void acknowledge(const unsigned idx, const bool ack) override {
+    m_iraLines[idx]->write(ack);
+  }
+
+  virtual const sc_core::sc_event &default_event() const override {
+    return m_pendingChangedEvent;
+  }
+
+  /* ------ Mask-level access, bit n corresponds to source n ------ */
+
+  uint64_t pendingMask() const { return m_pendingMask; }
+
+  void setPendingMask(const uint64_t mask) {
+    if ((mask & m_sourceMask) != m_pendingMask) {
+      m_pendingMask = mask & m_sourceMask;
+      m_pendingChangedEvent.notify(sc_core::SC_ZERO_TIME);
+    }
+  }
+
+  uint64_t enableMask() const { return m_enableMask; }
+
+  void setEnableMask(const uint64_t mask) { m_enableMask = mask & m_sourceMask; }
+
+  /**
+   * @brief setPriority move a source to a priority level
+   * @param idx source index
+   * @param level priority level, 0 being the highest
+   */
+  void setPriority(const unsigned idx, const unsigned level) {
+    sc_assert(level < m_priorityMasks.size());
+    const uint64_t bit = uint64_t(1) << idx;
+    for (auto &levelMask : m_priorityMasks) {
+      levelMask &= ~bit;
+    }
+    m_priorityMasks[level] |= bit;
+  }
+
+  /* ------ Checkpointing ------ */
+
+  virtual void saveState(CheckpointWriter &writer) const override {
+    writer.write(m_enableMask);
+    writer.writeVector(m_priorityMasks);
+    uint64_t acceptMask = 0;
+    for (unsigned i = 0; i < m_nSources; ++i) {
+      acceptMask |= uint64_t(m_iraLines[i]->read()) << i;
+    }
+    writer.write(m_pendingMask);
+    writer.write(acceptMask);
+  }
+
+  /**
+   * @brief restoreState restore masks and drive the irq/ira lines to their
+   * checkpointed values, so processes sensitive to them see the change.
+   */
+  virtual void restoreState(CheckpointReader &reader) override {
+    reader.read(m_enableMask);
+    reader.expect(m_priorityMasks.size(), "number of priority levels");
+    reader.readBlock(m_priorityMasks.data(),
+                     m_priorityMasks.size() * sizeof(uint64_t));
+    const auto pendingMask = reader.read<uint64_t>();
+    const auto acceptMask = reader.read<uint64_t>();
+    for (unsigned i = 0; i < m_nSources; ++i) {
+      m_irqLines[i]->write(pendingMask & (uint64_t(1) << i));
+      m_iraLines[i]->write(acceptMask & (uint64_t(1) << i));
+    }
+  }
+
+ private:
+  const unsigned m_nSources;
+  const uint64_t m_sourceMask;  //! One bit per source
+  uint64_t m_pendingMask{0};
+  uint64_t m_enableMask;
+  std::vector<uint64_t> m_priorityMasks;  //! Sources per priority level
+  std::vector<std::unique_ptr<InterruptLine>> m_irqLines;
+  std::vector<std::unique_ptr<InterruptLine>> m_iraLines;
+  sc_core::sc_event m_pendingChangedEvent{"m_pendingChangedEvent"};
+};
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <systemc>
+
+class InterruptControllerIf : public virtual sc_core::sc_interface {
+ public:
+  /**
+   * @brief setPending set or clear the pending bit of an interrupt source.
+   * @param idx source index
+   * @param pending new pending status
+   */
+  virtual void setPending(const unsigned idx, const bool pending) = 0;
+
+  /**
+   * @brief isPending
+   * @param idx source index
+   * @retval true if the source is requesting an interrupt
+   */
+  virtual bool isPending(const unsigned idx) const = 0;
+
+  /**
+   * @brief highestPending find the highest-priority pending (and enabled)
+   * interrupt source.
+   * @retval source index, or -1 if no interrupt is pending.
+   */
+  virtual int highestPending() const = 0;
+
+  /**
+   * @brief acknowledge assert or deassert the interrupt-accepted line of a
+   * source.
+   * @param idx source index
+   * @param ack new value of the interrupt-accepted line
+   */
+  virtual void acknowledge(const unsigned idx, const bool ack) = 0;
+
+  /**
+   * @brief default_event returns an event that triggers when the pending
+   * status of any source changes. Used when building the sensitivity list
+   * (i.e. "sensitive << channel")
+   * @retval default event
+   */
+  virtual const sc_core::sc_event &default_event() const = 0;
+};
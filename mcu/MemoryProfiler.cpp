@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "mcu/MemoryProfiler.hpp"
+#include "utilities/Config.hpp"
+#include "utilities/ElfSymbols.hpp"
+#include "utilities/Utilities.hpp"
+
+namespace {
+
+//! Live profilers, see writeReports
+std::vector<MemoryProfiler *> g_profilers;
+
+//! Look up the first of several alternative symbol names
+bool findSymbol(const ElfSymbols &symbols,
+                const std::vector<std::string> &names, uint32_t &value) {
+  for (const auto &n : names) {
+    if (symbols.value(n, value)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+//! Variable containing an address, as symbol+offset
+std::string resolve(const ElfSymbols &symbols, const uint32_t addr) {
+  const int i = symbols.find(addr);
+  if (i < 0) {
+    return "";
+  }
+  const auto &s = symbols.symbols()[i];
+  return addr == s.addr ? s.name
+                        : fmt::format("{:s}+0x{:x}", s.name, addr - s.addr);
+}
+
+}  // namespace
+
+MemoryProfiler::MemoryProfiler(const std::string &name,
+                               const uint32_t startAddress,
+                               const size_t capacity, const bool nonvolatile)
+    : m_name(name),
+      m_startAddress(startAddress),
+      m_nonvolatile(nonvolatile),
+      m_reads((capacity + 1) / 2, 0),
+      m_writes((capacity + 1) / 2, 0) {
+  g_profilers.push_back(this);
+}
+
+MemoryProfiler::~MemoryProfiler() {
+  g_profilers.erase(std::find(g_profilers.begin(), g_profilers.end(), this));
+}
+
+bool MemoryProfiler::isEnabled() {
+  return Config::get().contains("MemoryProfile") &&
+         Config::get().getBool("MemoryProfile");
+}
+
+void MemoryProfiler::powerOff() {
+  if (m_nonvolatile) {
+    m_cycleWrites.push_back(m_bytesWritten - m_cycleStart);
+    m_cycleStart = m_bytesWritten;
+  }
+}
+
+void MemoryProfiler::report(std::ostream &os, const std::string &dir,
+                            const ElfSymbols &symbols) const {
+  const std::string indent = "    ";
+  const auto nWords = m_writes.size();
+
+  // Per-word map & footprint
+  std::ofstream map(dir + "/" + m_name + "_memory_map.csv");
+  map << "address,reads,writes\n";
+  uint64_t wordsRead = 0, wordsWritten = 0;
+  for (size_t w = 0; w < nWords; ++w) {
+    wordsRead += m_reads[w] > 0;
+    wordsWritten += m_writes[w] > 0;
+    if (m_reads[w] || m_writes[w]) {
+      map << fmt::format("0x{:04x},{:d},{:d}\n", m_startAddress + 2 * w,
+                         m_reads[w], m_writes[w]);
+    }
+  }
+
+  os << "{\n";
+  os << indent
+     << fmt::format("\"start\": \"0x{:04x}\", \"size\": {:d}, "
+                    "\"nonvolatile\": {:s},\n",
+                    m_startAddress, 2 * nWords,
+                    m_nonvolatile ? "true" : "false");
+  os << indent
+     << fmt::format("\"bytes_read\": {:d}, \"bytes_written\": {:d},\n",
+                    m_bytesRead, m_bytesWritten);
+  os << indent
+     << fmt::format("\"footprint\": {{\"bytes_read\": {:d}, "
+                    "\"bytes_written\": {:d}}},\n",
+                    2 * wordsRead, 2 * wordsWritten);
+
+  // Most written words
+  std::vector<size_t> order;
+  for (size_t w = 0; w < nWords; ++w) {
+    if (m_writes[w] > 0) {
+      order.push_back(w);
+    }
+  }
+  const auto nTop = std::min<size_t>(N_TOP, order.size());
+  std::partial_sort(order.begin(), order.begin() + nTop, order.end(),
+                    [this](const size_t a, const size_t b) {
+                      return m_writes[a] != m_writes[b]
+                                 ? m_writes[a] > m_writes[b]
+                                 : a < b;
+                    });
+  os << indent << "\"top_written\": [";
+  for (size_t i = 0; i < nTop; ++i) {
+    const uint32_t addr = m_startAddress + 2 * order[i];
+    os << (i == 0 ? "\n" : ",\n") << indent << "  "
+       << fmt::format("{{\"address\": \"0x{:04x}\", \"symbol\": \"{:s}\", "
+                      "\"writes\": {:d}}}",
+                      addr, resolve(symbols, addr), m_writes[order[i]]);
+  }
+  os << (nTop ? "\n" + indent : "") << "]";
+
+  // Bytes written per power cycle, including the one cut short by the end of
+  // simulation
+  if (m_nonvolatile) {
+    auto cycles = m_cycleWrites;
+    if (m_bytesWritten > m_cycleStart) {
+      cycles.push_back(m_bytesWritten - m_cycleStart);
+    }
+    std::ofstream f(dir + "/" + m_name + "_nvm_writes.csv");
+    f << "cycle,bytes_written\n";
+    for (size_t i = 0; i < cycles.size(); ++i) {
+      f << i << ',' << cycles[i] << '\n';
+    }
+    const auto minmax = std::minmax_element(cycles.begin(), cycles.end());
+    os << ",\n"
+       << indent
+       << fmt::format(
+              "\"power_cycle_writes\": {{\"cycles\": {:d}, \"mean\": {:g}, "
+              "\"min\": {:d}, \"max\": {:d}}}",
+              cycles.size(),
+              cycles.empty() ? 0.0
+                             : std::accumulate(cycles.begin(), cycles.end(),
+                                               0.0) /
+                                   cycles.size(),
+              cycles.empty() ? 0 : *minmax.first,
+              cycles.empty() ? 0 : *minmax.second);
+  }
+
+  // Stack & heap high-water marks, if the stack is in this memory
+  uint32_t stackTop = 0, heapStart = 0;
+  const uint32_t end = m_startAddress + 2 * nWords;
+  if (findSymbol(symbols, {"__stack", "_estack", "__StackTop"}, stackTop) &&
+      stackTop - 1 - m_startAddress < 2 * nWords) {
+    const bool hasHeap =
+        findSymbol(symbols, {"__heap_start__", "end", "_end", "__end__"},
+                   heapStart) &&
+        heapStart - m_startAddress < stackTop - m_startAddress;
+    const uint32_t base = hasHeap ? heapStart : m_startAddress;
+    const size_t lo = (base - m_startAddress + 1) / 2;
+    const size_t hi = (std::min(stackTop, end) - m_startAddress) / 2;
+
+    // Longest run of never-written words separates heap & stack
+    size_t gapBegin = lo, gapEnd = lo, run = lo;
+    for (size_t w = lo; w <= hi; ++w) {
+      if (w == hi || m_writes[w] > 0) {
+        if (w - run > gapEnd - gapBegin) {
+          gapBegin = run;
+          gapEnd = w;
+        }
+        run = w + 1;
+      }
+    }
+    os << ",\n"
+       << indent << fmt::format("\"stack_bytes\": {:d}", 2 * (hi - gapEnd));
+    if (hasHeap) {
+      os << fmt::format(", \"heap_bytes\": {:d}", 2 * (gapBegin - lo));
+    }
+  }
+  os << "\n  }";
+}
+
+void MemoryProfiler::writeReports(const std::string &fileName) {
+  std::map<std::string, std::vector<const MemoryProfiler *>> byDirectory;
+  for (const auto *p : g_profilers) {
+    if (p->m_bytesRead > 0 || p->m_bytesWritten > 0) {
+      byDirectory[Utility::outputDirectory(p->m_name)].push_back(p);
+    }
+  }
+
+  // Memories of different network nodes may hold different programs
+  std::map<std::string, ElfSymbols> symbols;
+  for (const auto &kv : byDirectory) {
+    const auto &dir = kv.first;
+    const auto path = dir + "/" + fileName;
+    const auto &profilers = kv.second;
+    std::ofstream os(path);
+    os << "{";
+    for (size_t i = 0; i < profilers.size(); ++i) {
+      const auto elf =
+          Utility::elfPath("MemoryProfileElf", profilers[i]->m_name);
+      auto it = symbols.find(elf);
+      if (it == symbols.end()) {
+        it = symbols.emplace(elf, ElfSymbols(elf, /*objects=*/true)).first;
+      }
+      os << (i == 0 ? "\n" : ",\n") << "  \"" << profilers[i]->m_name
+         << "\": ";
+      profilers[i]->report(os, dir, it->second);
+    }
+    os << "\n}\n";
+    spdlog::info("Memory profile written to {:s}", path);
+  }
+}
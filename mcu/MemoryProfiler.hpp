@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class ElfSymbols;
+
+/*
+ * Memory access profiler, for sizing checkpoints and tuning data placement
+ * without instrumenting the firmware.
+ *
+ * Each memory (GenericMemory and derived, Cache) counts the reads & writes of
+ * every 16-bit word in flat arrays, updated inline on its access path. A cache
+ * counts the accesses of the CPU, the memory behind it the line fills &
+ * write-backs, i.e. the actual wear. Nonvolatile memories also record the
+ * number of bytes written in each power cycle.
+ *
+ * At the end of simulation, sc_main writes for all memories, to the output
+ * directory of their node (see Utility::outputDirectory):
+ *  - <OutputDirectory>/memory_profile.json: bytes read & written, footprint
+ *    (words ever read or written), the most written addresses resolved to
+ *    variables, bytes written to NVM per power cycle, and the stack & heap
+ *    high-water marks;
+ *  - <OutputDirectory>/<name>_memory_map.csv: the counts of each accessed word;
+ *  - <OutputDirectory>/<name>_nvm_writes.csv: bytes written per power cycle.
+ *
+ * Symbols are read from MemoryProfileElf (or ProgramHexFile with .elf
+ * extension). The stack grows down from __stack (_estack, __StackTop), the
+ * heap up from __heap_start__ (end, _end, __end__). As neither is bounded, the
+ * longest run of never-written words in between separates them.
+ *
+ * Enabled with MemoryProfile: True.
+ */
+class MemoryProfiler {
+ public:
+  /**
+   * @brief MemoryProfiler constructor. Profilers are registered for
+   * writeReports() for their lifetime.
+   * @param name name of the memory
+   * @param startAddress bus address of the first byte
+   * @param capacity size in bytes
+   * @param nonvolatile record the bytes written per power cycle
+   */
+  MemoryProfiler(const std::string &name, const uint32_t startAddress,
+                 const size_t capacity, const bool nonvolatile);
+
+  ~MemoryProfiler();
+
+  MemoryProfiler(const MemoryProfiler &) = delete;
+  MemoryProfiler &operator=(const MemoryProfiler &) = delete;
+
+  /**
+   * @brief isEnabled check if the profiler is enabled in the config.
+   */
+  static bool isEnabled();
+
+  /**
+   * @brief read count a read.
+   * @param offset offset of the first byte from the start of the memory
+   * @param len number of bytes
+   */
+  void read(const uint32_t offset, const unsigned len) {
+    count(m_reads, offset, len);
+    m_bytesRead += len;
+  }
+
+  /**
+   * @brief write count a write.
+   * @param offset offset of the first byte from the start of the memory
+   * @param len number of bytes
+   */
+  void write(const uint32_t offset, const unsigned len) {
+    count(m_writes, offset, len);
+    m_bytesWritten += len;
+  }
+
+  /**
+   * @brief powerOff close a power cycle.
+   */
+  void powerOff();
+
+  /**
+   * @brief writeReports write the reports of all memories that were
+   * accessed. Memories are grouped by output directory (see
+   * Utility::outputDirectory), with one JSON report per directory, next to
+   * the csv files of its memories. Call once, at the end of simulation.
+   * @param fileName name of the JSON report in each output directory
+   */
+  static void writeReports(const std::string &fileName);
+
+ private:
+  //! Number of most written addresses in the report
+  static const unsigned N_TOP = 20;
+
+  const std::string m_name;
+  const uint32_t m_startAddress;
+  const bool m_nonvolatile;
+  std::vector<uint64_t> m_reads;   //! Per word
+  std::vector<uint64_t> m_writes;  //! Per word
+  uint64_t m_bytesRead{0};
+  uint64_t m_bytesWritten{0};
+  uint64_t m_cycleStart{0};             //! m_bytesWritten at power-on
+  std::vector<uint64_t> m_cycleWrites;  //! Bytes written per power cycle
+
+  static void count(std::vector<uint64_t> &counts, const uint32_t offset,
+                    const unsigned len) {
+    for (uint32_t w = offset >> 1; w <= (offset + len - 1) >> 1; ++w) {
+      ++counts[w];
+    }
+  }
+
+  /**
+   * @brief report write the report of this memory as a JSON object, and its
+   * csv files.
+   * @param dir directory of the csv files
+   * @param symbols object symbols of the firmware
+   */
+  void report(std::ostream &os, const std::string &dir,
+              const ElfSymbols &symbols) const;
+};
@@ -7,6 +7,7 @@
 
 #pragma once
 #include <stdint.h>
+#include <string>
 #include <systemc>
 #include "ps/PowerModelChannelIf.hpp"
 
@@ -110,12 +111,55 @@ class Microcontroller : public sc_core::sc_module {
    */
   virtual void removeBreakpoint(unsigned addr) = 0;
 
+  /**
+   * @brief insertWatchpoint watch accesses to an address range.
+   * Execution will halt after a matching access.
+   * @param type 2 (write), 3 (read) or 4 (access), as in gdb's Z2/Z3/Z4
+   * @param addr start address
+   * @param len length in bytes
+   * @retval false if the type is not supported
+   */
+  virtual bool insertWatchpoint(int type, unsigned addr, unsigned len) = 0;
+
+  /**
+   * @brief removeWatchpoint remove a watchpoint inserted with the same
+   * arguments.
+   * @retval false if there was no such watchpoint
+   */
+  virtual bool removeWatchpoint(int type, unsigned addr, unsigned len) = 0;
+
+  /**
+   * @brief stoppedByWatchpoint check if execution was halted by a watchpoint
+   * since it was last resumed.
+   * @param addr set to the accessed address
+   * @param type set to the type of the watchpoint hit, as in insertWatchpoint
+   */
+  virtual bool stoppedByWatchpoint(unsigned &addr, int &type) const = 0;
+
   /**
    * @brief Get the number of power cycles (power-on resets)
    * 
    */
   virtual unsigned getPowerOnResetCount() const = 0;
 
+  /**
+   * @brief getInstructionCount get the number of instructions executed by the
+   * CPU since the start of simulation.
+   */
+  virtual uint64_t getInstructionCount() const = 0;
+
+  /**
+   * @brief getCycleCount get the number of clock cycles the CPU spent
+   * executing instructions (i.e. not sleeping) since the start of simulation.
+   */
+  virtual uint64_t getCycleCount() const = 0;
+
+  /**
+   * @brief getCpuName get the hierarchical name of the CPU, under which it
+   * reports its power model states ("on", "off" & "sleep").
+   */
+  virtual std::string getCpuName() const = 0;
+
   /**
    * @brief pc_regnum get the PC register number
    */
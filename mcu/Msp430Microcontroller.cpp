@@ -16,6 +16,7 @@
 #include "mcu/Microcontroller.hpp"
 #include "mcu/Msp430Microcontroller.hpp"
 #include "mcu/msp430fr5xx/Msp430Cpu.hpp"
+#include "utilities/Config.hpp"
 
 extern "C" {
 #include "mcu/msp430fr5xx/device_includes/msp430fr5994.h"
@@ -24,7 +25,10 @@ extern "C" {
 using namespace sc_core;
 
 Msp430Microcontroller::Msp430Microcontroller(sc_module_name nm)
-    : Microcontroller(nm), m_cpu("CPU", false, false), bus("bus") {
+    : Microcontroller(nm),
+      m_cpu("CPU", /*trace=*/Config::get().contains("CpuTrace") &&
+                       Config::get().getBool("CpuTrace")),
+      bus("bus") {
   /* ------ Memories ------ */
   cache = new Cache("cache", FRAM_START, 0xff7f);
   fram = new NonvolatileMemory("fram", FRAM_START, 0xff7f);
@@ -44,7 +48,7 @@ Msp430Microcontroller::Msp430Microcontroller(sc_module_name nm)
   fram_ctl = new Frctl_a("FRAM_CTL_A");
   watchdog =
       new DummyPeripheral("watchdog", zeroRetval, WDT_A_BASE, WDT_A_BASE + 1);
-  mon = new SimpleMonitor("mon", SIMPLE_MONITOR_BASE);
+  mon = new SimpleMonitor("mon", SIMPLE_MONITOR_BASE, this);
   portJ = new DummyPeripheral("portJ", zeroRetval, PJ_BASE, PJ_BASE + 0x16);
   portA = new DigitalIo("portA", PA_BASE, PA_BASE + 0x1f);
   portB = new DigitalIo("portB", PB_BASE, PB_BASE + 0x1f);
@@ -52,7 +56,7 @@ Msp430Microcontroller::Msp430Microcontroller(sc_module_name nm)
   portD = new DigitalIo("portD", PD_BASE, PD_BASE + 0x1f);
   cs = new ClockSystem("cs", CS_BASE);
   tima = new TimerA("tima", TA0_BASE);
-  interruptArbiter = new InterruptArbiter<37>("interruptArbiter", false);
+  interruptController = new InterruptController("interruptController", 37);
   mpy32 = new Mpy32("mpy32", MPY32_BASE, MPY32_BASE + 0x2f);
   euscib = new eUSCI_B("eUSCI_B", EUSCI_B0_BASE, EUSCI_B0_BASE + 0x2f);
   dma = new Dma("Dma");
@@ -109,55 +113,31 @@ Msp430Microcontroller::Msp430Microcontroller(sc_module_name nm)
   euscib->smclk.bind(smclk);
 
   // Interrupts
-  m_cpu.ira.bind(cpu_ira);
-  m_cpu.irq.bind(cpu_irq);
-  m_cpu.irqIdx.bind(cpu_irqIdx);
-  m_cpu.iraConnected.bind(m_iraConnected);
-  interruptArbiter->iraConnected.bind(m_iraConnected);
-  interruptArbiter->irqOut.bind(cpu_irq);
-  interruptArbiter->iraIn.bind(cpu_ira);
-  interruptArbiter->idxOut.bind(cpu_irqIdx);
-
-  tima->ira.bind(tima_ira);
-  tima->irq.bind(tima_irq);
-  interruptArbiter->irqIn[10].bind(tima_irq);
-  interruptArbiter->iraOut[10].bind(tima_ira);
-
-  pmm->ira.bind(pmm_ira);
-  pmm->irq.bind(pmm_irq);
-  interruptArbiter->irqIn[0].bind(pmm_irq);
-  interruptArbiter->iraOut[0].bind(pmm_ira);
-
-  euscib->irq.bind(euscib_irq);
-  euscib->ira.bind(euscib_ira);
-  interruptArbiter->irqIn[8].bind(euscib_irq);
-  interruptArbiter->iraOut[8].bind(euscib_ira);
+  m_cpu.irqCtrl.bind(*interruptController);
+
+  tima->irq.bind(interruptController->irqLine(10));
+  tima->ira.bind(interruptController->iraLine(10));
+
+  pmm->irq.bind(interruptController->irqLine(0));
+  pmm->ira.bind(interruptController->iraLine(0));
+
+  euscib->irq.bind(interruptController->irqLine(8));
+  euscib->ira.bind(interruptController->iraLine(8));
   euscib->dmaTrigger.bind(dma_dummy);
 
-  dma->irq.bind(dma_irq);
-  dma->ira.bind(dma_ira);
-  interruptArbiter->irqIn[13].bind(dma_irq);
-  interruptArbiter->iraOut[13].bind(dma_ira);
-
-  adc->irq.bind(adc_irq);
-  interruptArbiter->irqIn[9].bind(adc_irq);
-
-  portA->irq[0].bind(port1_irq);
-  portA->irq[1].bind(port2_irq);
-  portB->irq[0].bind(port3_irq);
-  portB->irq[1].bind(port4_irq);
-  portC->irq[0].bind(port5_irq);
-  portC->irq[1].bind(port6_irq);
-  portD->irq[0].bind(port7_irq);
-  portD->irq[1].bind(port8_irq);
-  interruptArbiter->irqIn[16].bind(port1_irq);
-  interruptArbiter->irqIn[19].bind(port2_irq);
-  interruptArbiter->irqIn[22].bind(port3_irq);
-  interruptArbiter->irqIn[23].bind(port4_irq);
-  interruptArbiter->irqIn[28].bind(port5_irq);
-  interruptArbiter->irqIn[29].bind(port6_irq);
-  interruptArbiter->irqIn[35].bind(port7_irq);
-  interruptArbiter->irqIn[36].bind(port8_irq);
+  dma->irq.bind(interruptController->irqLine(13));
+  dma->ira.bind(interruptController->iraLine(13));
+
+  adc->irq.bind(interruptController->irqLine(9));
+
+  portA->irq[0].bind(interruptController->irqLine(16));
+  portA->irq[1].bind(interruptController->irqLine(19));
+  portB->irq[0].bind(interruptController->irqLine(22));
+  portB->irq[1].bind(interruptController->irqLine(23));
+  portC->irq[0].bind(interruptController->irqLine(28));
+  portC->irq[1].bind(interruptController->irqLine(29));
+  portD->irq[0].bind(interruptController->irqLine(35));
+  portD->irq[1].bind(interruptController->irqLine(36));
 
   // Reset
   m_cpu.pwrOn.bind(nReset);
@@ -195,6 +175,12 @@ Msp430Microcontroller::Msp430Microcontroller(sc_module_name nm)
 
   // Bus
   m_cpu.iSocket.bind(bus.tSocket);
+  bus.setWatchpointHandler([this](unsigned addr, Bus::WatchType type) {
+    m_watchpointHit = true;
+    m_watchpointAddr = addr;
+    m_watchpointType = static_cast<int>(type);
+    m_cpu.stall();
+  });
   dma->iSocket.bind(bus.tSocket);
   for (const auto &s : slaves) {
     bus.bindTarget(*s);
@@ -19,6 +19,7 @@
 #include "mcu/ClockSourceIf.hpp"
 #include "mcu/DummyPeripheral.hpp"
 #include "mcu/GenericMemory.hpp"
+#include "mcu/InterruptController.hpp"
 #include "mcu/Microcontroller.hpp"
 #include "mcu/NonvolatileMemory.hpp"
 #include "mcu/VolatileMemory.hpp"
@@ -27,7 +28,6 @@
 #include "mcu/msp430fr5xx/DigitalIo.hpp"
 #include "mcu/msp430fr5xx/Dma.hpp"
 #include "mcu/msp430fr5xx/Frctl_a.hpp"
-#include "mcu/msp430fr5xx/InterruptArbiter.hpp"
 #include "mcu/msp430fr5xx/Mpy32.hpp"
 #include "mcu/msp430fr5xx/Msp430Cpu.hpp"
 #include "mcu/msp430fr5xx/PowerManagementModule.hpp"
@@ -42,35 +42,6 @@ class Msp430Microcontroller : public Microcontroller {
   /* ------ Signals ------ */
   sc_core::sc_signal<bool> dma_dummy{"dma_dummy"};
 
-  /*------ Interrupt lines ------*/
-  sc_core::sc_signal<bool> cpu_irq{"cpu_irq"};
-  sc_core::sc_signal<bool> cpu_ira{"cpu_ira"};
-  sc_core::sc_signal<unsigned> cpu_irqIdx{"cpu_irqIdx"};
-
-  sc_core::sc_signal<bool> dma_irq{"dma_irq"};
-  sc_core::sc_signal<bool> dma_ira{"dma_ira"};
-
-  sc_core::sc_signal<bool> tima_irq{"tima_irq"};
-  sc_core::sc_signal<bool> tima_ira{"tima_ira"};
-
-  sc_core::sc_signal<bool> pmm_irq{"pmm_irq"};
-  sc_core::sc_signal<bool> pmm_ira{"pmm_ira"};
-
-  sc_core::sc_signal<bool> adc_irq{"adc_irq"};
-  sc_core::sc_signal<bool> m_iraConnected{"m_iraConnected"};
-
-  sc_core::sc_signal<bool> port1_irq{"port1_irq"};
-  sc_core::sc_signal<bool> port2_irq{"port2_irq"};
-  sc_core::sc_signal<bool> port3_irq{"port3_irq"};
-  sc_core::sc_signal<bool> port4_irq{"port4_irq"};
-  sc_core::sc_signal<bool> port5_irq{"port5_irq"};
-  sc_core::sc_signal<bool> port6_irq{"port6_irq"};
-  sc_core::sc_signal<bool> port7_irq{"port7_irq"};
-  sc_core::sc_signal<bool> port8_irq{"port8_irq"};
-
-  sc_core::sc_signal<bool> euscib_irq{"euscib_irq"};
-  sc_core::sc_signal<bool> euscib_ira{"euscib_ira"};
-
   /* ------ Clocks ------ */
   ClockSourceChannel mclk{"mclk"};
   ClockSourceChannel smclk{"smclk"};
@@ -112,7 +83,10 @@ class Msp430Microcontroller : public Microcontroller {
   /**
    * @brief Unstall CPU execution
    */
-  virtual void unstall(void) override { m_cpu.unstall(); }
+  virtual void unstall(void) override {
+    m_watchpointHit = false;
+    m_cpu.unstall();
+  }
 
   /**
    * @brief Check if CPU is stalled
@@ -123,7 +97,10 @@ class Msp430Microcontroller : public Microcontroller {
   /**
    * @brief Execute a single instrucion, then stall
    */
-  virtual void step(void) override { m_cpu.step(); }
+  virtual void step(void) override {
+    m_watchpointHit = false;
+    m_cpu.step();
+  }
 
   /* ------ Interrogation functions ------ */
 
@@ -195,6 +172,41 @@ class Msp430Microcontroller : public Microcontroller {
     m_cpu.removeBreakpoint(addr);
   }
 
+  /**
+   * @brief insertWatchpoint watch accesses to an address range.
+   * Execution will halt after a matching access.
+   * @param type 2 (write), 3 (read) or 4 (access), as in gdb's Z2/Z3/Z4
+   */
+  virtual bool insertWatchpoint(int type, unsigned addr,
+                                unsigned len) override {
+    if (type < 2 || type > 4) {
+      return false;
+    }
+    bus.insertWatchpoint(addr, len, static_cast<Bus::WatchType>(type));
+    return true;
+  }
+
+  /**
+   * @brief removeWatchpoint remove a watchpoint inserted with the same
+   * arguments.
+   */
+  virtual bool removeWatchpoint(int type, unsigned addr,
+                                unsigned len) override {
+    return type >= 2 && type <= 4 &&
+           bus.removeWatchpoint(addr, len, static_cast<Bus::WatchType>(type));
+  }
+
+  /**
+   * @brief stoppedByWatchpoint check if execution was halted by a watchpoint
+   * since it was last resumed.
+   */
+  virtual bool stoppedByWatchpoint(unsigned &addr,
+                                   int &type) const override {
+    addr = m_watchpointAddr;
+    type = m_watchpointType;
+    return m_watchpointHit;
+  }
+
   /**
    * @brief process Monitors output from PMM and resets processor during
    * power outages
@@ -209,6 +221,16 @@ class Msp430Microcontroller : public Microcontroller {
     return pmm->getPowerOnResetCount();
   }
 
+  virtual uint64_t getInstructionCount() const override {
+    return m_cpu.getInstructionCount();
+  }
+
+  virtual uint64_t getCycleCount() const override {
+    return m_cpu.getCycleCount();
+  }
+
+  virtual std::string getCpuName() const override { return m_cpu.name(); }
+
   /* ------ Constants ------ */
 
   /* ------ Private variables ------ */
@@ -228,7 +250,7 @@ class Msp430Microcontroller : public Microcontroller {
   eUSCI_B *euscib;
   Frctl_a *fram_ctl;
   GenericMemory *vectors;
-  InterruptArbiter<37> *interruptArbiter;
+  InterruptController *interruptController;
   Mpy32 *mpy32;
   PowerManagementModule *pmm;
   TimerA *tima;
@@ -240,4 +262,7 @@ class Msp430Microcontroller : public Microcontroller {
   Msp430Cpu m_cpu;
   Bus bus;
   std::vector<BusTarget *> slaves;
+  bool m_watchpointHit{false};   //! Stalled by a watchpoint
+  unsigned m_watchpointAddr{0};  //! Address of the last watchpoint hit
+  int m_watchpointType{0};       //! Type (2, 3 or 4) of the last watchpoint hit
 };
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "mcu/PowerCycleLedger.hpp"
+#include "utilities/Config.hpp"
+#include "utilities/Utilities.hpp"
+
+namespace {
+
+//! Live ledgers, see writeReports
+std::vector<PowerCycleLedger *> g_ledgers;
+
+//! Empty csv field for unmarked cycle counts
+std::string optional(const int64_t v) {
+  return v < 0 ? std::string() : std::to_string(v);
+}
+
+}  // namespace
+
+void PowerCycleLedger::Stat::add(const double v, const bool first) {
+  min = first ? v : std::min(min, v);
+  max = first ? v : std::max(max, v);
+  sum += v;
+}
+
+PowerCycleLedger::PowerCycleLedger(const std::string &name) : m_name(name) {
+  g_ledgers.push_back(this);
+}
+
+PowerCycleLedger::~PowerCycleLedger() {
+  g_ledgers.erase(std::find(g_ledgers.begin(), g_ledgers.end(), this));
+}
+
+bool PowerCycleLedger::isEnabled() {
+  return Config::get().contains("PowerCycleLedger") &&
+         Config::get().getBool("PowerCycleLedger");
+}
+
+void PowerCycleLedger::powerOn(const Snapshot &snapshot) {
+  m_on = true;
+  m_begin = snapshot;
+  m_bootDone = m_restoreDone = -1;
+}
+
+void PowerCycleLedger::bootDone(const uint64_t cycles) {
+  m_markersSeen = true;
+  if (m_on && m_bootDone < 0) {
+    m_bootDone = cycles;
+  }
+}
+
+void PowerCycleLedger::restoreDone(const uint64_t cycles) {
+  m_markersSeen = true;
+  if (m_on && m_restoreDone < 0) {
+    m_restoreDone = cycles;
+  }
+}
+
+void PowerCycleLedger::powerOff(const Snapshot &snapshot, const uint32_t pc,
+                                const bool terminated) {
+  const auto &b = m_begin;
+  Cycle c;
+  c.on = b.time.to_seconds();
+  c.off = snapshot.time.to_seconds();
+  c.vcapOn = b.vcap;
+  c.vcapOff = snapshot.vcap;
+  c.terminated = terminated;
+  c.instructions = snapshot.instructions - b.instructions;
+  c.cycles = snapshot.cycles - b.cycles;
+  c.lpmTime = snapshot.lpmTime - b.lpmTime;
+  c.bootCycles = m_bootDone < 0 ? -1 : m_bootDone - int64_t(b.cycles);
+  c.restoreCycles =
+      m_restoreDone < 0
+          ? -1
+          : m_restoreDone - (m_bootDone < 0 ? int64_t(b.cycles) : m_bootDone);
+  c.pc = pc;
+  c.moduleEnergy.resize(snapshot.moduleEnergy.size());
+  for (size_t i = 0; i < c.moduleEnergy.size(); ++i) {
+    c.moduleEnergy[i] = snapshot.moduleEnergy[i] -
+                        (i < b.moduleEnergy.size() ? b.moduleEnergy[i] : 0.0);
+  }
+  const double energy =
+      std::accumulate(c.moduleEnergy.begin(), c.moduleEnergy.end(), 0.0);
+
+  // Summary
+  const bool first = m_count == 0;
+  ++m_count;
+  if (!terminated) {
+    ++m_unterminated;
+  }
+  m_onTime.add(c.off - c.on, first);
+  m_energy.add(energy, first);
+  m_instructions.add(c.instructions, first);
+  m_cycles += c.cycles;
+  m_lpmTime += c.lpmTime;
+  if (c.bootCycles >= 0) {
+    ++m_bootMarked;
+    m_bootCycles += c.bootCycles;
+  }
+  if (c.restoreCycles >= 0) {
+    ++m_restoreMarked;
+    m_restoreCycles += c.restoreCycles;
+  }
+  // Cycles without markers make no progress, unless the firmware doesn't use
+  // markers at all
+  const int64_t lastMarker = std::max(m_bootDone, m_restoreDone);
+  if (lastMarker >= 0) {
+    m_usefulCycles += snapshot.cycles - lastMarker;
+  } else if (!m_markersSeen) {
+    m_usefulCycles += c.cycles;
+  }
+  m_moduleEnergy.resize(std::max(m_moduleEnergy.size(), c.moduleEnergy.size()),
+                        0.0);
+  for (size_t i = 0; i < c.moduleEnergy.size(); ++i) {
+    m_moduleEnergy[i] += c.moduleEnergy[i];
+  }
+
+  m_rows.push_back(std::move(c));
+  m_on = false;
+  if (m_rows.size() >= FLUSH_THRESHOLD) {
+    flush();
+  }
+}
+
+void PowerCycleLedger::flush() {
+  if (m_rows.empty()) {
+    return;
+  }
+  const auto path =
+      Utility::outputDirectory(m_name) + "/" + m_name + "_power_cycles.csv";
+  // Overwrite files from previous runs, append to our own
+  std::ofstream f(path, std::ios::out | (path == m_path ? std::ios::app
+                                                         : std::ios::trunc));
+  m_path = path;
+  if (f.tellp() == 0) {
+    // Header
+    f << "on(s),off(s),vcap_on(V),vcap_off(V),terminated,instructions,"
+         "cpu_cycles,lpm_time(s),boot_cycles,restore_cycles,pc_off,"
+         "energy(J)";
+    for (const auto &m : m_moduleNames) {
+      f << ',' << m << " energy(J)";
+    }
+    f << '\n';
+  }
+
+  for (const auto &c : m_rows) {
+    f << fmt::format("{:.9g},{:.9g},{:g},{:g},{:d},{:d},{:d},{:.9g},{:s},{:s},"
+                     "0x{:04x},{:g}",
+                     c.on, c.off, c.vcapOn, c.vcapOff, c.terminated ? 1 : 0,
+                     c.instructions, c.cycles, c.lpmTime,
+                     optional(c.bootCycles), optional(c.restoreCycles), c.pc,
+                     std::accumulate(c.moduleEnergy.begin(),
+                                     c.moduleEnergy.end(), 0.0));
+    for (const auto e : c.moduleEnergy) {
+      f << fmt::format(",{:g}", e);
+    }
+    f << '\n';
+  }
+  m_rows.clear();
+}
+
+void PowerCycleLedger::write(std::ostream &os,
+                             const std::string &indent) const {
+  const auto n = static_cast<double>(std::max<uint64_t>(m_count, 1));
+  const auto stat = [n](const Stat &s) {
+    return fmt::format("{{\"mean\": {:g}, \"min\": {:g}, \"max\": {:g}}}",
+                       s.sum / n, s.min, s.max);
+  };
+  std::vector<std::string> modules;
+  for (size_t i = 0; i < m_moduleEnergy.size(); ++i) {
+    modules.push_back(fmt::format(
+        "\"{:s}\": {:g}",
+        i < m_moduleNames.size() ? m_moduleNames[i] : std::to_string(i),
+        m_moduleEnergy[i]));
+  }
+
+  os << "{\n";
+  os << indent
+     << fmt::format("\"power_cycles\": {:d}, \"unterminated\": {:d},\n",
+                    m_count, m_unterminated);
+  os << indent << "\"on_time_s\": " << stat(m_onTime) << ",\n";
+  os << indent << "\"energy\": " << stat(m_energy) << ",\n";
+  os << indent << "\"instructions\": " << stat(m_instructions) << ",\n";
+  os << indent
+     << fmt::format("\"cpu_cycles\": {:g}, \"lpm_time_s\": {:g},\n", m_cycles,
+                    m_lpmTime);
+  os << indent
+     << fmt::format(
+            "\"boot\": {{\"marked\": {:d}, \"cycles\": {:g}, \"mean\": {:g}}},\n",
+            m_bootMarked, m_bootCycles,
+            m_bootMarked ? m_bootCycles / m_bootMarked : 0.0);
+  os << indent
+     << fmt::format("\"restore\": {{\"marked\": {:d}, \"cycles\": {:g}, "
+                    "\"mean\": {:g}}},\n",
+                    m_restoreMarked, m_restoreCycles,
+                    m_restoreMarked ? m_restoreCycles / m_restoreMarked : 0.0);
+  os << indent
+     << fmt::format("\"useful_cycles\": {:g}, \"progress\": {:g},\n",
+                    m_usefulCycles,
+                    m_cycles > 0.0 ? m_usefulCycles / m_cycles : 0.0);
+  os << indent << "\"module_energy\": {"
+     << fmt::format("{}", fmt::join(modules, ", ")) << "}\n";
+  os << indent.substr(0, indent.size() >= 2 ? indent.size() - 2 : 0) << "}";
+}
+
+void PowerCycleLedger::writeReports(const std::string &fileName) {
+  std::map<std::string, std::vector<const PowerCycleLedger *>> byDirectory;
+  for (const auto *l : g_ledgers) {
+    if (l->m_count > 0) {
+      byDirectory[Utility::outputDirectory(l->m_name)].push_back(l);
+    }
+  }
+
+  for (const auto &kv : byDirectory) {
+    const auto path = kv.first + "/" + fileName;
+    const auto &ledgers = kv.second;
+    std::ofstream os(path);
+    os << "{";
+    for (size_t i = 0; i < ledgers.size(); ++i) {
+      os << (i == 0 ? "\n" : ",\n") << "  \"" << ledgers[i]->m_name
+         << "\": ";
+      ledgers[i]->write(os, "    ");
+    }
+    os << "\n}\n";
+    spdlog::info("Power cycle ledger summary written to {:s}", path);
+  }
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <iostream>
+#include <string>
+#include <systemc>
+#include <vector>
+
+/*
+ * Power-cycle ledger, one row per power-on to power-off interval of a
+ * microcontroller, recorded by its SimpleMonitor at the nReset edges:
+ *  - on & off times, and the voltage of the energy storage capacitor at
+ *    both edges;
+ *  - instructions, CPU cycles and time in low-power mode;
+ *  - boot cycles, from power-on to SIMPLE_MONITOR_BOOT_DONE, and restore
+ *    cycles, from there (or power-on) to SIMPLE_MONITOR_RESTORE_DONE, as
+ *    marked by the firmware (see include/peripheral-defines.h);
+ *  - the PC at power loss;
+ *  - the energy of each power model module.
+ *
+ * Each edge costs one snapshot of cumulative counters, independent of the
+ * number of events in between. Rows are buffered and appended to
+ * <OutputDirectory>/<name>_power_cycles.csv. There is one row per power cycle,
+ * rather than per event, so plain csv stays small and loads directly into
+ * pandas & spreadsheets. Summary statistics are kept
+ * incrementally, and written by sc_main for all ledgers to
+ * <OutputDirectory>/power_cycles.json at the end of simulation.
+ *
+ * Enabled with PowerCycleLedger: True.
+ */
+class PowerCycleLedger {
+ public:
+  //! Cumulative counters at a power edge
+  struct Snapshot {
+    sc_core::sc_time time{sc_core::SC_ZERO_TIME};
+    double vcap{0.0};  //! Capacitor voltage [V]
+    uint64_t instructions{0};
+    uint64_t cycles{0};
+    double lpmTime{0.0};              //! [s]
+    std::vector<double> moduleEnergy;  //! [J]
+  };
+
+  /**
+   * @brief PowerCycleLedger constructor. Ledgers are registered for
+   * writeReports() for their lifetime.
+   * @param name name of the ledger, prefix of its csv file
+   */
+  explicit PowerCycleLedger(const std::string &name);
+
+  ~PowerCycleLedger();
+
+  PowerCycleLedger(const PowerCycleLedger &) = delete;
+  PowerCycleLedger &operator=(const PowerCycleLedger &) = delete;
+
+  /**
+   * @brief isEnabled check if the ledger is enabled in the config.
+   */
+  static bool isEnabled();
+
+  /**
+   * @brief setModuleNames set the power model module names, i.e. the energy
+   * columns. Call before the first powerOn().
+   */
+  void setModuleNames(const std::vector<std::string> &names) {
+    m_moduleNames = names;
+  }
+
+  //! Whether a power cycle is open
+  bool isOn() const { return m_on; }
+
+  /**
+   * @brief powerOn open a power cycle.
+   */
+  void powerOn(const Snapshot &snapshot);
+
+  /**
+   * @brief powerOff close the open power cycle.
+   * @param pc program counter at power loss
+   * @param terminated false if the cycle is cut short by the end of simulation
+   */
+  void powerOff(const Snapshot &snapshot, const uint32_t pc,
+                const bool terminated = true);
+
+  /**
+   * @brief bootDone firmware marker, only the first one per cycle counts.
+   * @param cycles cumulative CPU cycles
+   */
+  void bootDone(const uint64_t cycles);
+
+  /**
+   * @brief restoreDone firmware marker, only the first one per cycle counts.
+   * @param cycles cumulative CPU cycles
+   */
+  void restoreDone(const uint64_t cycles);
+
+  /**
+   * @brief flush append buffered rows to the csv file.
+   */
+  void flush();
+
+  /**
+   * @brief write write the summary statistics as a JSON object.
+   * @param os output stream
+   * @param indent indentation of the object's members
+   */
+  void write(std::ostream &os, const std::string &indent = "  ") const;
+
+  /**
+   * @brief writeReports write the summaries of all ledgers that recorded any
+   * cycles to a JSON file, keyed by ledger name. Ledgers are grouped by
+   * output directory (see Utility::outputDirectory), with one file per
+   * directory. Call once, at the end of simulation, after flush().
+   * @param fileName name of the file in each output directory
+   */
+  static void writeReports(const std::string &fileName);
+
+ private:
+  //! A row of the ledger
+  struct Cycle {
+    double on;
+    double off;
+    double vcapOn;
+    double vcapOff;
+    bool terminated;
+    uint64_t instructions;
+    uint64_t cycles;
+    double lpmTime;
+    int64_t bootCycles;     //! -1 if not marked
+    int64_t restoreCycles;  //! -1 if not marked
+    uint32_t pc;
+    std::vector<double> moduleEnergy;
+  };
+
+  //! Running min, max & sum
+  struct Stat {
+    double min{0.0};
+    double max{0.0};
+    double sum{0.0};
+    void add(const double v, const bool first);
+  };
+
+  //! How many rows to buffer before appending them to file
+  static const size_t FLUSH_THRESHOLD = 4096;
+
+  const std::string m_name;
+  std::vector<std::string> m_moduleNames;
+  std::vector<Cycle> m_rows;  //! Not yet flushed
+  std::string m_path;         //! File flushed to so far
+
+  // ------ Open cycle ------
+  bool m_on{false};
+  Snapshot m_begin;
+  int64_t m_bootDone{-1};     //! Cumulative cycles at the marker
+  int64_t m_restoreDone{-1};  //! Cumulative cycles at the marker
+
+  // ------ Summary ------
+  uint64_t m_count{0};
+  uint64_t m_unterminated{0};
+  uint64_t m_bootMarked{0};
+  uint64_t m_restoreMarked{0};
+  bool m_markersSeen{false};
+  Stat m_onTime;
+  Stat m_energy;
+  Stat m_instructions;
+  double m_cycles{0.0};
+  double m_bootCycles{0.0};
+  double m_restoreCycles{0.0};
+  double m_usefulCycles{0.0};  //! After the last marker reached in each cycle
+  double m_lpmTime{0.0};
+  std::vector<double> m_moduleEnergy;
+};
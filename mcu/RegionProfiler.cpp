@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "mcu/RegionProfiler.hpp"
+#include "utilities/Utilities.hpp"
+
+namespace {
+
+//! Live profilers, see writeReports
+std::vector<RegionProfiler *> g_profilers;
+
+//! Element-wise a += b - c, growing a as needed
+template <typename T>
+void accumulateDelta(std::vector<T> &a, const std::vector<T> &b,
+                     const std::vector<T> &c) {
+  a.resize(std::max(a.size(), b.size()), T(0));
+  for (size_t i = 0; i < b.size(); ++i) {
+    a[i] += b[i] - (i < c.size() ? c[i] : T(0));
+  }
+}
+
+template <typename T>
+T sumDelta(const std::vector<T> &b, const std::vector<T> &c) {
+  return std::accumulate(b.begin(), b.end(), T(0)) -
+         std::accumulate(c.begin(), c.end(), T(0));
+}
+
+}  // namespace
+
+RegionProfiler::RegionProfiler(const std::string &name) : m_name(name) {
+  g_profilers.push_back(this);
+}
+
+RegionProfiler::~RegionProfiler() {
+  g_profilers.erase(std::find(g_profilers.begin(), g_profilers.end(), this));
+}
+
+void RegionProfiler::begin(const unsigned id, const Snapshot &snapshot) {
+  m_open.push_back(OpenRegion{id, snapshot});
+}
+
+bool RegionProfiler::end(const unsigned id, const Snapshot &snapshot) {
+  for (auto it = m_open.end(); it != m_open.begin();) {
+    --it;
+    if (it->id == id) {
+      close(it, snapshot, /*terminated=*/true);
+      return true;
+    }
+  }
+  return false;
+}
+
+void RegionProfiler::closeAll(const Snapshot &snapshot) {
+  while (!m_open.empty()) {
+    close(m_open.end() - 1, snapshot, /*terminated=*/false);
+  }
+}
+
+void RegionProfiler::close(const std::vector<OpenRegion>::iterator it,
+                           const Snapshot &snapshot, const bool terminated) {
+  const auto &b = it->begin;
+  auto &r = m_regions[it->id];
+  const uint64_t cycles = snapshot.cycles - b.cycles;
+  const double energy = sumDelta(snapshot.eventEnergy, b.eventEnergy) +
+                        sumDelta(snapshot.stateEnergy, b.stateEnergy);
+
+  r.cyclesMin = std::min(r.cyclesMin, cycles);
+  r.cyclesMax = std::max(r.cyclesMax, cycles);
+  r.energyMin = r.instances == 0 ? energy : std::min(r.energyMin, energy);
+  r.energyMax = r.instances == 0 ? energy : std::max(r.energyMax, energy);
+  ++r.instances;
+  if (!terminated) {
+    ++r.unterminated;
+  }
+  r.time += (snapshot.time - b.time).to_seconds();
+  r.cycles += cycles;
+  r.instructions += snapshot.instructions - b.instructions;
+  r.wallTime += snapshot.wallTime - b.wallTime;
+  r.energy += energy;
+  accumulateDelta(r.eventCounts, snapshot.eventCounts, b.eventCounts);
+  accumulateDelta(r.eventEnergy, snapshot.eventEnergy, b.eventEnergy);
+  accumulateDelta(r.stateEnergy, snapshot.stateEnergy, b.stateEnergy);
+
+  spdlog::info("{:s}: region {:d} {:s}: {:d} cycles, {:d} instructions, {:g} J",
+               m_name, it->id, terminated ? "end" : "unterminated", cycles,
+               snapshot.instructions - b.instructions, energy);
+  m_open.erase(it);
+}
+
+void RegionProfiler::write(std::ostream &os, const std::string &indent) const {
+  const auto in2 = indent + "  ";
+  const auto name = [](const NameFn &fn, const int i) {
+    return fn ? fn(i) : std::to_string(i);
+  };
+
+  os << "{";
+  for (auto it = m_regions.begin(); it != m_regions.end(); ++it) {
+    const auto &r = it->second;
+
+    // Cache hits & misses, from the cache's power model events
+    uint64_t hits = 0, misses = 0;
+    std::vector<std::string> events;
+    for (int i = 0; i < r.eventCounts.size(); ++i) {
+      if (r.eventCounts[i] == 0) {
+        continue;
+      }
+      const auto n = name(m_eventName, i);
+      if (n.find("cache") != std::string::npos) {
+        if (n.find(" hit") != std::string::npos) {
+          hits += r.eventCounts[i];
+        } else if (n.find(" miss") != std::string::npos) {
+          misses += r.eventCounts[i];
+        }
+      }
+      events.push_back(
+          fmt::format("\"{:s}\": {{\"count\": {:d}, \"energy\": {:g}}}", n,
+                      r.eventCounts[i], r.eventEnergy[i]));
+    }
+    std::vector<std::string> states;
+    for (int i = 0; i < r.stateEnergy.size(); ++i) {
+      if (r.stateEnergy[i] != 0.0) {
+        states.push_back(fmt::format("\"{:s}\": {:g}", name(m_stateName, i),
+                                     r.stateEnergy[i]));
+      }
+    }
+
+    os << (it == m_regions.begin() ? "\n" : ",\n") << indent << "\""
+       << it->first << "\": {\n";
+    os << in2
+       << fmt::format(
+              "\"instances\": {:d}, \"unterminated\": {:d}, \"time_s\": {:g}, "
+              "\"wall_time_s\": {:g},\n",
+              r.instances, r.unterminated, r.time, r.wallTime);
+    os << in2
+       << fmt::format(
+              "\"cycles\": {:d}, \"cycles_min\": {:d}, \"cycles_max\": {:d}, "
+              "\"instructions\": {:d},\n",
+              r.cycles, r.cyclesMin, r.cyclesMax, r.instructions);
+    os << in2
+       << fmt::format(
+              "\"energy\": {:g}, \"energy_min\": {:g}, \"energy_max\": {:g}, "
+              "\"cache_hits\": {:d}, \"cache_misses\": {:d},\n",
+              r.energy, r.energyMin, r.energyMax, hits, misses);
+    os << in2 << "\"events\": {" << fmt::format("{}", fmt::join(events, ", "))
+       << "},\n";
+    os << in2 << "\"states\": {" << fmt::format("{}", fmt::join(states, ", "))
+       << "}\n";
+    os << indent << "}";
+  }
+  os << "\n" << indent.substr(0, indent.size() >= 2 ? indent.size() - 2 : 0)
+     << "}";
+}
+
+void RegionProfiler::writeReports(const std::string &fileName) {
+  std::map<std::string, std::vector<const RegionProfiler *>> byDirectory;
+  for (const auto *p : g_profilers) {
+    if (!p->m_regions.empty()) {
+      byDirectory[Utility::outputDirectory(p->m_name)].push_back(p);
+    }
+  }
+
+  for (const auto &kv : byDirectory) {
+    const auto path = kv.first + "/" + fileName;
+    const auto &profilers = kv.second;
+    std::ofstream os(path);
+    os << "{";
+    for (size_t i = 0; i < profilers.size(); ++i) {
+      os << (i == 0 ? "\n" : ",\n") << "  \"" << profilers[i]->m_name
+         << "\": ";
+      profilers[i]->write(os, "    ");
+    }
+    os << "\n}\n";
+    spdlog::info("Regions of interest written to {:s}", path);
+  }
+}
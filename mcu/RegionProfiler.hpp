@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <string>
+#include <systemc>
+#include <vector>
+
+/*
+ * Regions of interest (ROI), opened and closed by the firmware through the
+ * SimpleMonitor: SIMPLE_MONITOR_INDICATE_BEGIN/END for region 0, and
+ * SIMPLE_MONITOR_ROI_BEGIN(id)/END(id) for regions 0-255 (see
+ * include/peripheral-defines.h).
+ *
+ * Each boundary takes a snapshot of cumulative counters (simulated time, CPU
+ * cycles & instructions, count & energy of each power model event, energy of
+ * each power model state, host wall time). A region's cost is the difference
+ * between the snapshots at its end and its beginning, so nested regions are
+ * included in their enclosing regions. An END closes the innermost open
+ * instance of that region id, so regions may also overlap and recurse.
+ * Regions stay open across power failures.
+ *
+ * Costs are accumulated per region id over all instances. At the end of
+ * simulation, sc_main writes the regions of all microcontrollers to
+ * <OutputDirectory>/regions.json.
+ */
+class RegionProfiler {
+ public:
+  //! Cumulative counters at a region boundary
+  struct Snapshot {
+    sc_core::sc_time time{sc_core::SC_ZERO_TIME};
+    uint64_t cycles{0};
+    uint64_t instructions{0};
+    double wallTime{0.0};  //! Host time [s]
+    std::vector<uint64_t> eventCounts;
+    std::vector<double> eventEnergy;  //! [J]
+    std::vector<double> stateEnergy;  //! [J]
+  };
+
+  typedef std::function<std::string(int)> NameFn;
+
+  /**
+   * @brief RegionProfiler constructor. Profilers are registered for
+   * writeReports() for their lifetime.
+   * @param name name of the profiler in the report
+   */
+  explicit RegionProfiler(const std::string &name);
+
+  ~RegionProfiler();
+
+  RegionProfiler(const RegionProfiler &) = delete;
+  RegionProfiler &operator=(const RegionProfiler &) = delete;
+
+  /**
+   * @brief begin open an instance of a region.
+   */
+  void begin(const unsigned id, const Snapshot &snapshot);
+
+  /**
+   * @brief end close the innermost open instance of a region.
+   * @retval false if no instance of the region is open
+   */
+  bool end(const unsigned id, const Snapshot &snapshot);
+
+  /**
+   * @brief closeAll close all open regions, e.g. at the end of simulation.
+   * They are counted as unterminated in the report.
+   */
+  void closeAll(const Snapshot &snapshot);
+
+  //! Number of open region instances
+  size_t depth() const { return m_open.size(); }
+
+  /**
+   * @brief setNames set the functions naming events and states in the report
+   * (see PowerModelChannelOutIf::getEventName).
+   */
+  void setNames(NameFn eventName, NameFn stateName) {
+    m_eventName = eventName;
+    m_stateName = stateName;
+  }
+
+  /**
+   * @brief write write the costs per region as a JSON object.
+   * @param os output stream
+   * @param indent indentation of the object's members
+   */
+  void write(std::ostream &os, const std::string &indent = "  ") const;
+
+  /**
+   * @brief writeReports write the regions of all profilers that recorded any
+   * to a JSON file, keyed by profiler name. Profilers are grouped by output
+   * directory (see Utility::outputDirectory), with one file per directory.
+   * Nothing is written for directories without regions. Call once, at the end
+   * of simulation.
+   * @param fileName name of the file in each output directory
+   */
+  static void writeReports(const std::string &fileName);
+
+ private:
+  //! Costs of a region, summed over its instances
+  struct Region {
+    uint64_t instances{0};
+    uint64_t unterminated{0};
+    double time{0.0};
+    uint64_t cycles{0};
+    uint64_t instructions{0};
+    double wallTime{0.0};
+    double energy{0.0};
+    uint64_t cyclesMin{UINT64_MAX};
+    uint64_t cyclesMax{0};
+    double energyMin{0.0};
+    double energyMax{0.0};
+    std::vector<uint64_t> eventCounts;
+    std::vector<double> eventEnergy;
+    std::vector<double> stateEnergy;
+  };
+
+  struct OpenRegion {
+    unsigned id;
+    Snapshot begin;
+  };
+
+  const std::string m_name;
+  std::vector<OpenRegion> m_open;  //! Innermost last
+  std::map<unsigned, Region> m_regions;
+  NameFn m_eventName;
+  NameFn m_stateName;
+
+  void close(const std::vector<OpenRegion>::iterator it,
+             const Snapshot &snapshot, const bool terminated);
+};
@@ -178,6 +178,20 @@ bool RegisterFile::contains(unsigned address) const {
   return (rit != m_regs.end());
 }
 
+void RegisterFile::saveState(CheckpointWriter &writer) const {
+  writer.write(static_cast<uint64_t>(m_regs.size()));
+  for (const auto &r : m_regs) {
+    writer.write(r.val);
+  }
+}
+
+void RegisterFile::restoreState(CheckpointReader &reader) {
+  reader.expect(m_regs.size(), "number of registers");
+  for (auto &r : m_regs) {
+    reader.read(r.val);
+  }
+}
+
 std::ostream &operator<<(std::ostream &os, const RegisterFile &rhs) {
   for (const auto &r : rhs.m_regs) {
     os << "@0x" << std::hex << r.addr << ": 0x" << std::hex << r.val << "\n";
@@ -10,6 +10,7 @@
 #include <stdint.h>
 #include <iostream>
 #include <vector>
+#include "utilities/Checkpoint.hpp"
 
 /**
  * @brief The RegisterFile class Convenience class to implement register files
@@ -195,6 +196,17 @@ class RegisterFile {
    */
   bool contains(unsigned address) const;
 
+  /**
+   * @brief saveState write register values to a checkpoint.
+   */
+  void saveState(CheckpointWriter &writer) const;
+
+  /**
+   * @brief restoreState read register values from a checkpoint. The register
+   * layout must match the one the checkpoint was taken with.
+   */
+  void restoreState(CheckpointReader &reader);
+
   /**
    * @brief << debug printout.
    */
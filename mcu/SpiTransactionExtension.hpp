@@ -34,7 +34,7 @@ struct SpiTransactionExtension
   SpiPolarity polarity{SpiPolarity::LOW};
   SpiPhase phase{SpiPhase::CAPTURE_FIRST_EDGE};
   SpiBitOrder bitOrder{SpiBitOrder::LSB_FIRST};
-  int response{0};  //! Response message
+  int response{0};  //! Response message (last word of a burst)
 
  public:
   /* ------ Public methods ------ */
@@ -63,10 +63,30 @@ struct SpiTransactionExtension
   }
 
   /**
-   * @brief transferTime return the transfer time of this transaction.
+   * @brief transferTime return the transfer time of a single data word.
    */
   const sc_core::sc_time transferTime() const { return nDataBits * clkPeriod; }
 
+  /**
+   * @brief transferTime return the transfer time of a burst of nWords words.
+   */
+  const sc_core::sc_time transferTime(const unsigned nWords) const {
+    return nWords * transferTime();
+  }
+
+  /**
+   * @brief bytesPerWord number of payload bytes holding one data word.
+   */
+  unsigned bytesPerWord() const {
+    return (nDataBits > 8) ? (nDataBits + 7) / 8 : 1;
+  }
+
+  /**
+   * @brief nWords number of data words held by a payload of len bytes.
+   * Payloads holding more than one word are burst transactions.
+   */
+  unsigned nWords(const unsigned len) const { return len / bytesPerWord(); }
+
   /**
    * Mandatory function for tlm payload extensions
    */
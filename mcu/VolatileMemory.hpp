@@ -22,7 +22,7 @@ class VolatileMemory : public GenericMemory {
   /* ------ Public methods ------ */
   VolatileMemory(sc_core::sc_module_name name, unsigned startAddress,
                  unsigned endAddress)
-      : GenericMemory(name, startAddress, endAddress) {
+      : GenericMemory(name, startAddress, endAddress, /*isVolatile=*/true) {
     // Call reset method on poweron
     SC_METHOD(reset);
     sensitive << pwrOn;
@@ -11,6 +11,8 @@
 #include "mcu/cortex-m0/CortexM0Cpu.hpp"
 #include "ps/ConstantCurrentState.hpp"
 #include "ps/ConstantEnergyEvent.hpp"
+#include "utilities/Logging.hpp"
+#include "utilities/TraceWindow.hpp"
 #include "utilities/Utilities.hpp"
 #include <chrono>
 #include <spdlog/spdlog.h>
@@ -50,6 +52,17 @@ CortexM0Cpu::CortexM0Cpu(const sc_module_name nm) : sc_module(nm) {
 
   // Construct & init cpu
   memset(&cpu, 0, sizeof(struct CPU));
+
+  if (EnergyProfiler::isEnabled()) {
+    m_energyProfiler =
+        std::make_unique<EnergyProfiler>(this->name(), ROM_START,
+                                         ROM_START + ROM_SIZE);
+  }
+
+  if (Coverage::isEnabled()) {
+    m_coverage = std::make_unique<Coverage>(this->name(), ROM_START,
+                                            ROM_START + ROM_SIZE);
+  }
 }
 
 void CortexM0Cpu::end_of_elaboration() {
@@ -78,8 +91,20 @@ void CortexM0Cpu::end_of_elaboration() {
   dont_initialize();
 }
 
+void CortexM0Cpu::end_of_simulation() {
+  if (m_energyProfiler) {
+    m_energyProfiler->write();
+  }
+  if (m_coverage) {
+    m_coverage->write();
+  }
+}
+
 void CortexM0Cpu::process() {
   wait(SC_ZERO_TIME); // Wait for start of simulation
+  if (m_energyProfiler) {
+    powerModelPort->attributeEvents();
+  }
 
   // Initialize CPU state
   cpu.debug = 1;
@@ -88,12 +113,17 @@ void CortexM0Cpu::process() {
   while (true) {
     if (pwrOn.read() && m_run) {
       uint16_t insn;
+      const auto begin = sc_time_stamp();
 
       if ((cpu_get_pc() & 0x1) == 0) {
         spdlog::error("PC moved out of thumb mode: 0x{:08x}", cpu_get_pc());
         SC_REPORT_FATAL(this->name(), "PC moved out of thumb mode");
       }
 
+      if (m_energyProfiler) {
+        m_energyProfiler->begin(powerModelPort->getAttributedEnergy());
+      }
+
       // Check for exceptions
       exceptionCheck();
       returningException.write(0);
@@ -103,7 +133,7 @@ void CortexM0Cpu::process() {
              pwrOn.default_event());
       } else {
         // Handle breakpoints
-        if (m_bubbles == 0 && m_breakpoints.count(getNextExecutionPc())) {
+        if (m_bubbles == 0 && m_breakpoints.contains(getNextExecutionPc())) {
           // Hit breakpoint
           spdlog::info("@{:10s}: Breakpoint hit (0x{:08x})",
                        sc_core::sc_time_stamp().to_string(),
@@ -112,6 +142,13 @@ void CortexM0Cpu::process() {
           continue;
         }
 
+        const uint32_t pc = getNextExecutionPc();
+        const uint32_t sp = cpu_get_sp();
+        TraceWindow::pc(pc);
+        if (m_coverage) {
+          m_coverage->mark(pc);
+        }
+
         // Fetch next instruction
         m_instructionQueue.push_back(fetch(cpu_get_pc()));
 
@@ -155,6 +192,13 @@ void CortexM0Cpu::process() {
         }
 
         powerModelPort->reportEvent(m_nInstructionsEventId);
+        ++m_instructionCount;
+        m_cycleCount += static_cast<uint64_t>(
+            (sc_time_stamp() - begin) / clk->getPeriod() + 0.5);
+        if (m_energyProfiler) {
+          m_energyProfiler->retire(pc, sp, clk->getPeriod(),
+                                   powerModelPort->getAttributedEnergy());
+        }
 
         if (m_doStep && (m_bubbles == 0)) {
           m_run = false;
@@ -192,6 +236,12 @@ void CortexM0Cpu::reset() {
   m_instructionBuffer.valid = 0;
   m_instructionBuffer.address = 0;
   m_instructionBuffer.data = 0;
+  if (m_energyProfiler) {
+    m_energyProfiler->reset();
+  }
+  if (m_coverage) {
+    m_coverage->reset();
+  }
 
   // Initialize the special-purpose registers
   cpu.apsr = 0;       // No flags set
@@ -242,8 +292,8 @@ void CortexM0Cpu::exceptionCheck() {
     exceptionId = nvicIrq.read();
   }
   if (exceptionId != 0) {
-    spdlog::info("{}: @{:s} handling exception with ID {}", this->name(),
-                 sc_time_stamp().to_string(), exceptionId);
+    FUSED_LOG(CortexM0Cpu, INFO, "{}: @{:s} handling exception with ID {}",
+              this->name(), sc_time_stamp().to_string(), exceptionId);
     m_sleeping = false;
     exceptionEnter(exceptionId);
   }
@@ -397,7 +447,9 @@ unsigned CortexM0Cpu::fetch(const unsigned address) {
   if (!m_instructionBuffer.valid ||
       (addressWordAligned != m_instructionBuffer.address)) {
     // Read from memory
-    m_instructionBuffer.data = read32(addressWordAligned);
+    uint8_t tmp[4];
+    readMem(addressWordAligned, tmp, 4, /*fetch=*/true);
+    m_instructionBuffer.data = Utility::ttohl(Utility::packBytes(tmp, 4));
     m_instructionBuffer.address = addressWordAligned;
     m_instructionBuffer.valid = true;
   } else {
@@ -455,7 +507,7 @@ uint32_t CortexM0Cpu::read32(const uint32_t addr) {
 }
 
 void CortexM0Cpu::readMem(const uint32_t addr, uint8_t *const data,
-                          const size_t bytelen) {
+                          const size_t bytelen, const bool fetch) {
   sc_time delay;
   tlm::tlm_generic_payload trans;
 
@@ -469,7 +521,13 @@ void CortexM0Cpu::readMem(const uint32_t addr, uint8_t *const data,
   trans.set_data_length(bytelen);
   trans.set_data_ptr(data);
   trans.set_command(tlm::TLM_READ_COMMAND);
+  if (fetch) {
+    trans.set_extension(&m_fetchExtension);
+  }
   iSocket->b_transport(trans, delay);
+  if (fetch) {
+    trans.clear_extension(&m_fetchExtension);  // Not owned by trans
+  }
   if (trans.get_response_status() != tlm::TLM_OK_RESPONSE) {
     spdlog::error("{} Failed read from address 0x{:08x}.", this->name(), addr);
     sc_stop();
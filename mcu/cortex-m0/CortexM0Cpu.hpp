@@ -7,9 +7,15 @@
 
 #pragma once
 
+#include "include/cm0-fused.h"
 #include "mcu/ClockSourceIf.hpp"
+#include "mcu/InstructionFetchExtension.hpp"
 #include "ps/PowerModelChannelIf.hpp"
+#include "utilities/BreakpointMap.hpp"
+#include "utilities/Coverage.hpp"
+#include "utilities/EnergyProfiler.hpp"
 #include <deque>
+#include <memory>
 #include <systemc>
 #include <tlm>
 #include <unordered_set>
@@ -59,6 +65,12 @@ public:
    */
   virtual void end_of_elaboration() override;
 
+  /**
+   * @brief end_of_simulation SystemC callback. Used here for writing the
+   * energy profile.
+   */
+  virtual void end_of_simulation() override;
+
   /**
    * @brief exceptionCheck Check for pending exceptions, and handle them.
    */
@@ -149,8 +161,10 @@ public:
    * @param addr read address (MCU memory space)
    * @param data buffer for return value
    * @param bytelen number of bytes to be read
+   * @param fetch tag the read as an instruction fetch
    */
-  void readMem(const uint32_t addr, uint8_t *const data, const size_t bytelen);
+  void readMem(const uint32_t addr, uint8_t *const data, const size_t bytelen,
+               const bool fetch = false);
 
   /* ------ Controls for GDB server ------ */
 
@@ -215,6 +229,17 @@ public:
    */
   uint32_t n_regs() const { return N_GPR; }
 
+  /**
+   * @brief Get number of instructions executed since the start of simulation
+   */
+  uint64_t getInstructionCount() const { return m_instructionCount; }
+
+  /**
+   * @brief Get number of clock cycles spent executing instructions (including
+   * exception entry, excluding sleep) since the start of simulation
+   */
+  uint64_t getCycleCount() const { return m_cycleCount; }
+
   /**
    * @brief operator<< debug printout
    */
@@ -266,11 +291,20 @@ private:
   bool m_sleeping{false};
   bool m_run{false};
   bool m_doStep{false};
+  uint64_t m_instructionCount{0};  //! Instructions executed (for logging)
+  uint64_t m_cycleCount{0};        //! Active cycles (for logging)
   InstructionBuffer m_instructionBuffer;
-  std::unordered_set<unsigned> m_breakpoints; // Set of breakpoint addresses
-  std::unordered_set<unsigned> m_watchpoints; // Set of watchpoint addresses
+  InstructionFetchExtension m_fetchExtension; //! Tags instruction fetches
+  BreakpointMap m_breakpoints{ROM_START,
+                              ROM_START + ROM_SIZE}; //! Breakpoint addresses
   std::array<unsigned, 17> m_regsAtExceptEnter{{0}}; //! Used for checking
 
+  //! Per-PC energy profiler, only constructed if enabled
+  std::unique_ptr<EnergyProfiler> m_energyProfiler;
+
+  //! Executed instruction bitmap, only constructed if enabled
+  std::unique_ptr<Coverage> m_coverage;
+
   /* Power model event & state ids */
   int m_idleCyclesEventId{-1};    //! Event used to track idle cycles
   int m_nInstructionsEventId{-1}; //! Event used to track number of
@@ -12,6 +12,7 @@
 #include "libs/make_unique.hpp"
 #include "mcu/cortex-m0/Gpio.hpp"
 #include "ps/ConstantEnergyEvent.hpp"
+#include "utilities/Logging.hpp"
 
 using namespace sc_core;
 
@@ -34,12 +35,26 @@ void Gpio::end_of_elaboration() {
   m_pinNegEdgeId = powerModelPort->registerEvent(
       this->name(),
       std::make_unique<ConstantEnergyEvent>(this->name(), "posedge"));
+  // Only bound pins are sampled & driven
+  m_boundPins.clear();
+  m_boundMask = 0;
+  for (unsigned i = 0; i < pins.size(); i++) {
+    if (pins[i].size() > 0) {
+      m_boundPins.push_back(i);
+      m_boundMask |= (1u << i);
+    }
+  }
+
   // Set up methods
   SC_METHOD(reset);
   sensitive << pwrOn;
 
+  // Event-driven: register writes, power and bound pins, not every clock
   SC_METHOD(process);
-  sensitive << clk << pwrOn.pos();
+  sensitive << m_writeEvent << pwrOn;
+  for (const auto i : m_boundPins) {
+    sensitive << pins[i]->value_changed_event();
+  }
 
   SC_METHOD(irqControl);
   sensitive << active_exception << m_updateIrqEvent;
@@ -55,75 +70,63 @@ void Gpio::reset(void) {
 }
 
 void Gpio::process(void) {
-  unsigned dir = m_regs.read(OFS_GPIO_DIR);    // Pin direction (in=0/out=1)
-  unsigned data = m_regs.read(OFS_GPIO_DATA);  // Pin states
-  unsigned ie = m_regs.read(OFS_GPIO_IE);      // Interrupt enable
-
-  if (pwrOn.read()) {
-    for (int i = 0; i < pins.size(); i++) {
-      unsigned mask = (1u << i);  // Pin mask
-
-      // Read pin as boolean
-      bool current;
-      if (pins[i].read().is_01()) {
-        current = pins[i].read().to_bool();
-      } else {  // Read 'Z' and 'X' as 0
-        current = false;
-        /*
-        SC_REPORT_WARNING(
-            this->name(),
-            fmt::format(
-                "pin {:d} reads non-binary value {:}, interpreting as 0.", i,
-                pins[i].read().to_char())
-                .c_str());
-                */
-      }
-
-      if (dir & mask) {  // If output mode
-        // Count edges
-        if (!current && (data & mask)) {  // Posedge
-          powerModelPort->reportEvent(m_pinPosEdgeId);
-          spdlog::info("{:s}: @{:s} posedge on pin {:d}", this->name(),
-                       sc_time_stamp().to_string(), i);
-        } else if (current && !(data & mask)) {  // Negedge
-          powerModelPort->reportEvent(m_pinNegEdgeId);
-          spdlog::info("{:s}: @{:s} negedge on pin {:d}", this->name(),
-                       sc_time_stamp().to_string(), i);
-        }
-
-        // Write to outputs
-        pins[i].write(sc_dt::sc_logic((data & mask) != 0));
-      } else {  // Input mode
-        // Read from inputs
-        if (current && !(m_lastState & mask)) {  // Posedge
-          spdlog::info("{:s}: @{:s} posedge on pin {:d}", this->name(),
-                       sc_time_stamp().to_string(), i);
-          m_regs.setBit(OFS_GPIO_DATA, i, true);
-          m_lastState |= mask;
-          if (ie & mask) {
-            m_regs.setBit(OFS_GPIO_IFG, i, true);
-            m_setIrq = true;
-            m_updateIrqEvent.notify(SC_ZERO_TIME);
-          }
-        } else if (!current && (m_lastState & mask)) {  // Negedge
-          spdlog::info("{:s}: @{:s} negedge on pin {:d}", this->name(),
-                       sc_time_stamp().to_string(), i);
-          m_regs.clearBit(OFS_GPIO_DATA, i, true);
-          m_lastState &= ~mask;
-          /* // Irq only on posedge for now
-          if (irqEn & irqEdge & mask) {
-            m_regs.setBit(OFS_PAIFG, i, true);
-          }
-          */
-        }
-      }
+  if (!pwrOn.read()) {
+    for (const auto i : m_boundPins) {
+      pins[i]->write(sc_dt::SC_LOGIC_Z);
     }
-  } else {
-    for (int i = 0; i < pins.size(); i++) {
-      pins[i].write(sc_dt::SC_LOGIC_Z);
+    return;
+  }
+
+  const unsigned dir = m_regs.read(OFS_GPIO_DIR);    // in=0/out=1
+  const unsigned data = m_regs.read(OFS_GPIO_DATA);  // Pin states
+  const unsigned ie = m_regs.read(OFS_GPIO_IE);      // Interrupt enable
+
+  // Sample external pins, reading 'Z' and 'X' as 0
+  unsigned sampled = 0;
+  for (const auto i : m_boundPins) {
+    const auto v = pins[i]->read();
+    sampled |= (v.is_01() && v.to_bool()) ? (1u << i) : 0u;
+  }
+
+  // Outputs are driven by DATA, inputs are sampled
+  const unsigned state = (data & dir) | (sampled & ~dir & m_boundMask);
+  const unsigned changed = m_lastState ^ state;
+
+  // Count output edges
+  const unsigned outEdges = changed & dir;
+  if (outEdges) {
+    const unsigned nPos = __builtin_popcount(outEdges & state);
+    const unsigned nNeg = __builtin_popcount(outEdges & ~state);
+    if (nPos) {
+      powerModelPort->reportEvent(m_pinPosEdgeId, nPos);
+    }
+    if (nNeg) {
+      powerModelPort->reportEvent(m_pinNegEdgeId, nNeg);
+    }
+  }
+
+  // Update inputs & set interrupt flags (irq only on posedge for now)
+  const unsigned inEdges = changed & ~dir;
+  if (inEdges) {
+    m_regs.write(OFS_GPIO_DATA, (data & ~inEdges) | (state & inEdges),
+                 /*force=*/true);
+    const unsigned newFlags = inEdges & state & ie;
+    if (newFlags) {
+      m_regs.write(OFS_GPIO_IFG, m_regs.read(OFS_GPIO_IFG) | newFlags,
+                   /*force=*/true);
+      m_setIrq = true;
+      m_updateIrqEvent.notify(SC_ZERO_TIME);
     }
   }
-  return;
+  m_lastState = state;
+  portState.write(state);
+
+  // Drive external pins: outputs, release inputs
+  for (const auto i : m_boundPins) {
+    const unsigned mask = (1u << i);
+    pins[i]->write((dir & mask) ? sc_dt::sc_logic((data & mask) != 0)
+                                : sc_dt::SC_LOGIC_Z);
+  }
 }
 
 void Gpio::irqControl() {
@@ -133,12 +136,12 @@ void Gpio::irqControl() {
     return;
   }
   if (m_setIrq && (!irq.read())) {
-    spdlog::info("{:s}: @{:s} interrupt request", this->name(),
-                 sc_time_stamp().to_string());
+    FUSED_LOG(Gpio, INFO, "{:s}: @{:s} interrupt request", this->name(),
+              sc_time_stamp().to_string());
     irq.write(true);
   } else if ((active_exception.read() - 16) == GPIO_EXCEPT_ID) {
-    spdlog::info("{:s}: @{:s} interrupt request cleared.", this->name(),
-                 sc_time_stamp().to_string());
+    FUSED_LOG(Gpio, INFO, "{:s}: @{:s} interrupt request cleared.",
+              this->name(), sc_time_stamp().to_string());
     irq.write(false);
   }
   m_setIrq = false;
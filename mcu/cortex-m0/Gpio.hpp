@@ -11,23 +11,34 @@
 #include <ostream>
 #include <systemc>
 #include <tlm>
+#include <vector>
 #include "mcu/BusTarget.hpp"
 #include "mcu/RegisterFile.hpp"
 
 /**
  * @brief The Gpio class : simple unidirectional output-only "IO" port.
+ * The port is processed as a whole word, bit n corresponding to pin n. Pins
+ * only need to be bound if they are connected to an external device. The port
+ * is processed on register writes, power changes and bound pin changes.
  */
 class Gpio : public BusTarget {
   SC_HAS_PROCESS(Gpio);
 
  public:
-  /* ------ Ports ------ */
   /* ------ Ports ------ */
   sc_core::sc_port<ClockSourceConsumerIf> clk{"clk"};
   sc_core::sc_out<bool> irq{"irq"};  //! Interrupt request output
   sc_core::sc_in<int> active_exception{
       "active_exception"};  //! Signals exception taken by cpu
-  std::array<sc_core::sc_inout_resolved, 32> pins;
+  std::array<sc_core::sc_port<sc_core::sc_signal_inout_if<sc_dt::sc_logic>, 1,
+                              sc_core::SC_ZERO_OR_MORE_BOUND>,
+             32>
+      pins;
+
+  /* ------ Signals ------ */
+  //! Word-wide port state: level driven on (outputs) or read from (inputs)
+  //! each pin
+  sc_core::sc_signal<unsigned> portState{"portState"};
 
   /*------ Methods ------*/
   /**
@@ -56,6 +67,8 @@ class Gpio : public BusTarget {
   /* ------ Private variables ------ */
   bool m_setIrq{false};     //! 1 if irq should be set
   unsigned m_lastState{0};  //! Last pin state, used to check for edges
+  unsigned m_boundMask{0};  //! Pins bound to external devices
+  std::vector<unsigned> m_boundPins;  //! Indices of bound pins
   sc_core::sc_event m_updateIrqEvent{"updateIrqEvent"};
   int m_pinPosEdgeId{-1};
   int m_pinNegEdgeId{-1};
@@ -43,10 +43,8 @@ void Nvic::end_of_elaboration() {
   BusTarget::end_of_elaboration();
   SC_METHOD(process);
   sensitive << m_writeEvent << active.value_changed_event()
-            << returning.value_changed_event() << m_resetEvent;
-  for (unsigned i = 0; i < irq.size(); i++) {
-    sensitive << irq[i].value_changed_event();
-  }
+            << returning.value_changed_event() << m_resetEvent
+            << m_irqIn.default_event();
 
   SC_METHOD(reset);
   sensitive << pwrOn;
@@ -54,17 +52,23 @@ void Nvic::end_of_elaboration() {
 }
 
 void Nvic::reset() {
-  for (unsigned i = 0; i < m_prevIrq.size(); ++i) {
-    m_prevIrq[i] = false;
-  }
+  m_prevIrq = 0;
   m_prevActive = -1;
   m_swClearPending = 0;
   m_swSetPending = 0;
 
   m_regs.reset();
+  m_irqCtrl.setPendingMask(0);
+  updatePriorities();
   m_resetEvent.notify(SC_ZERO_TIME);
 }
 
+void Nvic::updatePriorities() {
+  for (unsigned i = 0; i < 32; i++) {
+    m_irqCtrl.setPriority(i, m_regs.readByte(OFS_NVIC_IPR0 + i) >> 6);
+  }
+}
+
 uint32_t Nvic::writeOneToClear(uint32_t clearbits, uint32_t oldval) {
   return oldval & (~clearbits);
 }
@@ -108,20 +112,16 @@ void Nvic::b_transport(tlm::tlm_generic_payload& trans, sc_time& delay) {
       }
       break;
     case OFS_NVIC_IPR0:
-      break;
     case OFS_NVIC_IPR1:
-      break;
     case OFS_NVIC_IPR2:
-      break;
     case OFS_NVIC_IPR3:
-      break;
     case OFS_NVIC_IPR4:
-      break;
     case OFS_NVIC_IPR5:
-      break;
     case OFS_NVIC_IPR6:
-      break;
     case OFS_NVIC_IPR7:
+      if (cmd == tlm::TLM_WRITE_COMMAND) {
+        updatePriorities();
+      }
       break;
     default:
       spdlog::error("SysTick: Invalid address  0x{:08x} accessed.", addr);
@@ -132,67 +132,48 @@ void Nvic::b_transport(tlm::tlm_generic_payload& trans, sc_time& delay) {
 
 void Nvic::process() {
   // Update pending status for all interrupts & find irq with highest priority
-  // (low number => high priority)
+  // (low number => high priority). All irqs are resolved at once as bitmasks,
+  // bit n corresponding to irq n.
   if (pwrOn.read()) {
-    auto m_pending = m_regs.read(OFS_NVIC_ISPR);
-
-    int highestPri = 4;
-    int highestPriIrq = -1;
-    for (int i = 0; i < irq.size(); i++) {
-      uint32_t mask = (1u << i);
-
-      // -- Set pending
-      // Posedge on irq
-      bool edge = irq[i].read() && (!m_prevIrq[i]);
-
-      // irq still requesting when returning from handler
-      bool stillRequesting =
-          irq[i].read() && (returning.read() == i + NVIC_EXCEPT_ID_BASE);
-
-      // Software set pending
-      bool swSet = (m_swSetPending & mask) != 0;
-
-      bool setPend = edge || stillRequesting || swSet;
-
-      // -- Clear pending
-      // Software clear: irq level is low && posedge on ICPR
-      bool swClear = (irq[i].read() == false) && (m_swClearPending & mask);
-
-      // CPU has started executing the handler
-      bool irqActive = (active.read() == i + NVIC_EXCEPT_ID_BASE) &&
-                       (active.read() != m_prevActive);
-
-      bool clearPend = swClear || irqActive;
-
-      // -- Resolve pending status
-      if (setPend && clearPend) {
-        spdlog::warn(
-            "{}: irq[{}] has both setPend and clearPend set, this will result "
-            "in "
-            "IMPLEMENTATION DEFINED behaviour. Will set pending status and "
-            "ignore clearPend.",
-            this->name());
-        clearPend = false;
-      }
-
-      if (setPend) {
-        m_pending |= mask;
-      } else if (clearPend) {
-        m_pending &= ~mask;
-      }
-
-      // -- Check priority
-      uint8_t prio = m_regs.readByte(OFS_NVIC_IPR0 + i) >> 6;
-      if ((m_pending & mask) && (prio < highestPri) &&
-          (m_regs.read(OFS_NVIC_ISER) & mask)) {
-        highestPri = prio;
-        highestPriIrq = i;
-      }
+    // Map an exception number to its irq bit (0 if not an external irq)
+    const auto exceptionMask = [](const int exceptionId) -> uint32_t {
+      const int i = exceptionId - NVIC_EXCEPT_ID_BASE;
+      return ((i >= 0) && (i < 32)) ? (1u << i) : 0u;
+    };
+
+    const uint32_t level = static_cast<uint32_t>(m_irqIn.pendingMask());
+
+    // -- Set pending
+    // Posedge on irq, irq still requesting when returning from handler, or
+    // software set pending
+    const uint32_t setPend = (level & ~m_prevIrq) |
+                             (level & exceptionMask(returning.read())) |
+                             m_swSetPending;
+
+    // -- Clear pending
+    // Software clear (irq level is low && posedge on ICPR), or CPU has started
+    // executing the handler
+    uint32_t clearPend = (~level & m_swClearPending);
+    if (active.read() != m_prevActive) {
+      clearPend |= exceptionMask(active.read());
+    }
 
-      m_prevIrq[i] = irq[i].read();
+    // -- Resolve pending status
+    if (setPend & clearPend) {
+      spdlog::warn(
+          "{}: irq mask 0x{:08x} has both setPend and clearPend set, this will "
+          "result in IMPLEMENTATION DEFINED behaviour. Will set pending status "
+          "and ignore clearPend.",
+          this->name(), setPend & clearPend);
+      clearPend &= ~setPend;
     }
+    const uint32_t pendingMask =
+        (m_regs.read(OFS_NVIC_ISPR) | setPend) & ~clearPend;
 
     // -- Set highest-priority pending interrupt
+    m_irqCtrl.setPendingMask(pendingMask);
+    m_irqCtrl.setEnableMask(m_regs.read(OFS_NVIC_ISER));
+    const int highestPriIrq = m_irqCtrl.highestPending();
     if (highestPriIrq >= 0) {
       pending.write(NVIC_EXCEPT_ID_BASE + highestPriIrq);
     } else {
@@ -200,8 +181,9 @@ void Nvic::process() {
     }
 
     // Update state
-    m_regs.write(OFS_NVIC_ISPR, m_pending, true);
-    m_regs.write(OFS_NVIC_ICPR, m_pending, true);
+    m_regs.write(OFS_NVIC_ISPR, pendingMask, true);
+    m_regs.write(OFS_NVIC_ICPR, pendingMask, true);
+    m_prevIrq = level;
     m_prevActive = active.read();
     m_swClearPending = 0;
     m_swSetPending = 0;
@@ -216,8 +198,8 @@ std::ostream& operator<<(std::ostream& os, const Nvic& rhs) {
     << "\nclock period " << rhs.systemClk->getPeriod()
     << "\nirq: 0b";
 
-  for (int i = rhs.irq.size() - 1; i > 0; --i) {
-    os << (rhs.irq[i].read() ? "1" : "0");
+  for (int i = 31; i >= 0; --i) {
+    os << (rhs.m_irqIn.isPending(i) ? "1" : "0");
   }
 
   os << "\nreturning: 0x" << std::hex << rhs.returning.read()
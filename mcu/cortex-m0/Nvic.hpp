@@ -9,12 +9,12 @@
 
 #include <spdlog/spdlog.h>
 #include <stdint.h>
-#include <array>
 #include <iostream>
 #include <systemc>
 #include <tlm>
 #include "mcu/BusTarget.hpp"
 #include "mcu/ClockSourceIf.hpp"
+#include "mcu/InterruptController.hpp"
 #include "utilities/Utilities.hpp"
 
 #define NVIC_BASE 0xE000E100
@@ -46,7 +46,6 @@ class Nvic : public BusTarget {
 
  public:
   /*------ Ports ------*/
-  std::array<sc_core::sc_in<bool>, 32> irq;
   sc_core::sc_out<int> pending{"pending"};
   sc_core::sc_in<int> returning{"returning"};
   sc_core::sc_in<int> active{"active"};
@@ -58,6 +57,14 @@ class Nvic : public BusTarget {
    */
   Nvic(const sc_core::sc_module_name name);
 
+  /**
+   * @brief irqLine get the request line of irq n, to be bound to the irq port
+   * of the peripheral that raises it.
+   */
+  sc_core::sc_signal_inout_if<bool> &irqLine(const unsigned idx) {
+    return m_irqIn.irqLine(idx);
+  }
+
   /**
    * @brief reset Reset registers and member values to their power-on values,
    * and cancel pending expire events.
@@ -81,8 +88,14 @@ class Nvic : public BusTarget {
   /* ------ SC events ------ */
   sc_core::sc_event m_resetEvent{"resetEvent"};
 
+  /*------ Submodules ------*/
+  //! irq request levels as a mask, bit n corresponding to irq n
+  InterruptController m_irqIn{"irqIn", 32};
+  //! Pending/enable/priority resolution, 4 priority levels (IPRn[7:6])
+  InterruptController m_irqCtrl{"irqCtrl", 32, 4};
+
   /*------ Private variables ------*/
-  std::array<bool, 32> m_prevIrq{{false}};
+  uint32_t m_prevIrq{0};  //! irq levels in the prev. activation, one bit/irq
   int m_prevActive{-1};  //! active interrupt in the prev. clk cycle
   unsigned m_swClearPending{0};
   unsigned m_swSetPending{0};
@@ -104,6 +117,12 @@ class Nvic : public BusTarget {
    */
   uint32_t writeOneToSet(uint32_t clearReg, uint32_t oldval);
 
+  /**
+   * @brief updatePriorities copy the priority levels from the IPRn registers
+   * to the interrupt controller.
+   */
+  void updatePriorities();
+
   /**
    * @brief process Nvic operation
    */
@@ -6,6 +6,7 @@
  */
 
 #include <spdlog/fmt/fmt.h>
+#include <algorithm>
 #include <iostream>
 #include <systemc>
 #include "include/cm0-fused.h"
@@ -30,6 +31,9 @@ Spi::Spi(sc_module_name name, const unsigned startAddress,
   m_regs.addRegister(OFS_SPI_RXCRCR, 0);
   m_regs.addRegister(OFS_SPI_TXCRCR, 0);
 
+  m_burstTransfers = Config::get().contains("SpiBurstTransfers") &&
+                     Config::get().getBool("SpiBurstTransfers");
+
   SC_METHOD(reset);
   sensitive << pwrOn;
 
@@ -114,7 +118,7 @@ void Spi::process(void) {
   // Prepare payload object
   tlm::tlm_generic_payload trans;
   trans.set_command(tlm::TLM_WRITE_COMMAND);
-  std::array<uint8_t, 2> dataOut;
+  std::array<uint8_t, 4> dataOut;
   trans.set_data_ptr(&dataOut[0]);
   auto* spiExtension = new SpiTransactionExtension();
   trans.set_extension(spiExtension);
@@ -173,10 +177,22 @@ void Spi::process(void) {
     int nbytes = (nbits + 7) / 8;
     spiExtension->nDataBits = nbits;
 
-    trans.set_data_length(nbytes);
-    Utility::unpackBytes(&dataOut[0], m_txFifo.get(nbits), nbytes);
+    // Number of words to ship, limited by the space left in the RX FIFO
+    int nWords = 1;
+    if (m_burstTransfers) {
+      nWords = std::min(m_txFifo.nValidBytes,
+                        static_cast<int>(dataOut.size()) -
+                            m_rxFifo.nValidBytes) /
+               nbytes;
+      nWords = std::max(nWords, 1);
+    }
+
+    trans.set_data_length(nWords * nbytes);
+    for (int i = 0; i < nWords; ++i) {
+      Utility::unpackBytes(&dataOut[i * nbytes], m_txFifo.get(nbits), nbytes);
+    }
     trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
-    sc_time delay = spiExtension->transferTime();
+    sc_time delay = spiExtension->transferTime(nWords);
 
     // Blocking transport call to all targets
     // Only one target should respond with OK, otherwise there's contention
@@ -205,7 +221,13 @@ void Spi::process(void) {
     wait(delay);
 
     // Receive response
-    m_rxFifo.put(nbits, spiExtension->response);
+    if (nWords > 1) {  // Burst response is in the data buffer
+      for (int i = 0; i < nWords; ++i) {
+        m_rxFifo.put(nbits, Utility::packBytes(&dataOut[i * nbytes], nbytes));
+      }
+    } else {
+      m_rxFifo.put(nbits, spiExtension->response);
+    }
 
     // Update status register and interrupt request
     updateStatusRegister(/*isBusy=*/false);
@@ -20,6 +20,9 @@
  * @brief The Spi class Modelling operation of Spi module, based on the one
  * included on the STM32F0 series of microcontrollers.
  *
+ * When the "SpiBurstTransfers" config option is set, all complete words in the
+ * TX FIFO (as far as the RX FIFO can take their responses) are shipped as a
+ * single burst transaction.
  */
 class Spi : public BusTarget {
   SC_HAS_PROCESS(Spi);
@@ -219,6 +222,7 @@ class Spi : public BusTarget {
   sc_core::sc_event m_updateIrqEvent{"updateIrqEvent"};
   bool m_enable{false};
   bool m_setIrq{false};  // Used to asynch control irq flag
+  bool m_burstTransfers{false};
 
   Fifo m_txFifo{"txFifo"};
   Fifo m_rxFifo{"rxFifo"};
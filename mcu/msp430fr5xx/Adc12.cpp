@@ -99,6 +99,18 @@ void Adc12::reset(void) {
   }
 }
 
+void Adc12::saveState(CheckpointWriter &writer) const {
+  BusTarget::saveState(writer);
+  writer.write(m_active);
+}
+
+void Adc12::restoreState(CheckpointReader &reader) {
+  BusTarget::restoreState(reader);
+  reader.read(m_active);
+  samplingClockUpdateEvent.notify(SC_ZERO_TIME);
+  modeEvent.notify(SC_ZERO_TIME);
+}
+
 void Adc12::process() {
   if (pwrOn.read()) {
     // Default trigger
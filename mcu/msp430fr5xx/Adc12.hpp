@@ -79,6 +79,16 @@ class Adc12 : public BusTarget {
    */
   virtual void reset(void) override;
 
+  /**
+   * @brief saveState checkpoint registers and activity state
+   */
+  virtual void saveState(CheckpointWriter &writer) const override;
+
+  /**
+   * @brief restoreState restore registers and re-select the sampling clock
+   */
+  virtual void restoreState(CheckpointReader &reader) override;
+
   /**
    * @brief end_of_elaboration used to register SC_METHODs and build sensitivity
    * list.
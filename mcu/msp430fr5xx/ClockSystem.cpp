@@ -79,6 +79,11 @@ void ClockSystem::reset(void) {
   }
 }
 
+void ClockSystem::restoreState(CheckpointReader &reader) {
+  BusTarget::restoreState(reader);
+  m_writeEvent.notify(SC_ZERO_TIME);  // Triggers updateClocks
+}
+
 void ClockSystem::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay) {
   // Write to register file first
   BusTarget::b_transport(trans, delay);
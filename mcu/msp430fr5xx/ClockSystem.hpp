@@ -48,6 +48,11 @@ class ClockSystem : public BusTarget {
   virtual void b_transport(tlm::tlm_generic_payload &trans,
                            sc_core::sc_time &delay) override;
 
+  /**
+   * @brief restoreState restore registers and update clocks accordingly
+   */
+  virtual void restoreState(CheckpointReader &reader) override;
+
   /*------ Static constants ------*/
  private:
   // Base clocks
@@ -35,6 +35,17 @@ void DigitalIo::reset(void) {
   m_lastState = 0;
 }
 
+void DigitalIo::saveState(CheckpointWriter &writer) const {
+  BusTarget::saveState(writer);
+  writer.write(m_lastState);
+}
+
+void DigitalIo::restoreState(CheckpointReader &reader) {
+  BusTarget::restoreState(reader);
+  reader.read(m_lastState);
+  m_writeEvent.notify(SC_ZERO_TIME);  // Triggers process
+}
+
 void DigitalIo::end_of_elaboration() {
   BusTarget::end_of_elaboration();
 
@@ -46,6 +57,16 @@ void DigitalIo::end_of_elaboration() {
       this->name(),
       std::make_unique<ConstantEnergyEvent>(this->name(), "io_pin_neg"));
 
+  // Only bound pins are sampled & driven
+  m_boundPins.clear();
+  m_boundMask = 0;
+  for (unsigned i = 0; i < pins.size(); i++) {
+    if (pins[i].size() > 0) {
+      m_boundPins.push_back(i);
+      m_boundMask |= (1u << i);
+    }
+  }
+
   // Register SC_METHODs
   SC_METHOD(reset);
   sensitive << pwrOn;
@@ -53,83 +74,88 @@ void DigitalIo::end_of_elaboration() {
 
   SC_METHOD(process);
   sensitive << m_writeEvent << pwrOn;
-  for (int i = 0; i < 16; i++) {
-    sensitive << pins[i];
+  for (const auto i : m_boundPins) {
+    sensitive << pins[i]->value_changed_event();
   }
 }
 
 void DigitalIo::process(void) {
-  uint16_t dir = m_regs.read(OFS_PADIR);  //  Note: offset is same for all
-  uint16_t out = m_regs.read(OFS_PAOUT);  //  ports
-  uint16_t ren = m_regs.read(OFS_PAREN);  // Pull-up resistor mode
-  uint16_t irqEn = ~m_regs.read(OFS_PASEL0) & ~m_regs.readByte(OFS_PASEL1) &
-                   m_regs.read(OFS_PAIE);
-  uint16_t irqEdge = m_regs.read(OFS_PAIES);
-
-  // std::cerr << "DigitalIo processing...\n";
-  // std::cerr << "DIR: 0x" << std::hex << dir << "\n";
-  // std::cerr << "OUT: 0x" << std::hex << out << "\n";
-  // std::cerr << "REN: 0x" << std::hex << ren << "\n";
-  // std::cerr << "IRQEN: 0x" << std::hex << irqEn << "\n";
-
-  if (pwrOn.read()) {
-    for (int i = 0; i < 16; i++) {
-      unsigned mask = (1u << i);
-
-      // Read pin as boolean
-      bool current;
-      if (pins[i].read().is_01()) {
-        current = pins[i].read().to_bool();
-      } else {  // Read 'Z' and 'X' as 0
-        current = false;
-        SC_REPORT_WARNING(
-            this->name(),
-            fmt::format(
-                "pin {:d} reads non-binary value {:s}, interpreting as 0.", i,
-                pins[i].read().to_char())
-                .c_str());
-      }
-
-      if ((ren | dir) & mask) {  // If output or Pull-up mode
-        // Count edges
-        if (!current && (out & mask)) {
-          powerModelPort->reportEvent(m_pinPosEdgeId);
-          // std::cerr << "Posedge on pin " << i << '\n';;
-        } else if (current && !(out & mask)) {
-          powerModelPort->reportEvent(m_pinNegEdgeId);
-          // std::cerr << "Negedge on pin " << i << '\n';;
-        }
-
-        // Write to outputs
-        pins[i].write(sc_dt::sc_logic((out & mask) != 0));
-      }
-
-      if ((~dir) & mask) {  // Input mode
-        // Read from inputs
-        if (current && !(m_lastState & mask)) {  // High
-          m_regs.setBit(OFS_PAIN, i, true);
-          m_lastState |= mask;
-          if (irqEn & (~irqEdge) & mask) {
-            m_regs.setBit(OFS_PAIFG, i, true);
-          }
-        } else if (!current && (m_lastState & mask)) {  // Low
-          m_regs.clearBit(OFS_PAIN, i, true);
-          m_lastState &= ~mask;
-          if (irqEn & irqEdge & mask) {
-            m_regs.setBit(OFS_PAIFG, i, true);
-          }
-        }
-      }
-
-      // Interrupts
-      uint16_t irqFlags = m_regs.read(OFS_PAIFG);
-      irq[0].write(irqFlags & 0x00ff);
-      irq[1].write(irqFlags & 0xff00);
+  if (!pwrOn.read()) {
+    for (const auto i : m_boundPins) {
+      pins[i]->write(sc_dt::SC_LOGIC_0);
+    }
+    m_lastState = 0;
+    portState.write(0);
+    return;
+  }
+
+  const unsigned dir = m_regs.read(OFS_PADIR);  //  Note: offset is same for
+  const unsigned out = m_regs.read(OFS_PAOUT);  //  all ports
+  const unsigned ren = m_regs.read(OFS_PAREN);  // Pull-up resistor mode
+  const unsigned irqEn = ~m_regs.read(OFS_PASEL0) & ~m_regs.read(OFS_PASEL1) &
+                         m_regs.read(OFS_PAIE);
+  const unsigned irqEdge = m_regs.read(OFS_PAIES);  // 0: rising, 1: falling
+
+  // Sample external pins, reading 'Z' and 'X' as 0
+  unsigned sampled = 0;
+  for (const auto i : m_boundPins) {
+    const auto v = pins[i]->read();
+    if (v.is_01()) {
+      sampled |= v.to_bool() ? (1u << i) : 0u;
+    } else if (v == sc_dt::SC_LOGIC_X) {
+      SC_REPORT_WARNING(
+          this->name(),
+          fmt::format("pin {:d} reads non-binary value {:s}, interpreting as 0.",
+                      i, v.to_char())
+              .c_str());
     }
-  } else {
-    for (int i = 0; i < 16; i++) {
-      pins[i].write(sc_dt::sc_logic(false));
+  }
+
+  // Resolve pin levels: outputs are driven by PAOUT, inputs are sampled, and
+  // unbound inputs with a pull-up/down resistor read PAOUT.
+  const unsigned state = ((out & dir) | (sampled & ~dir & m_boundMask) |
+                          (out & ren & ~dir & ~m_boundMask)) &
+                         0xffff;
+  const unsigned changed = m_lastState ^ state;
+
+  // Count output edges
+  const unsigned outEdges = changed & dir;
+  if (outEdges) {
+    const unsigned nPos = __builtin_popcount(outEdges & state);
+    const unsigned nNeg = __builtin_popcount(outEdges & ~state);
+    if (nPos) {
+      powerModelPort->reportEvent(m_pinPosEdgeId, nPos);
+    }
+    if (nNeg) {
+      powerModelPort->reportEvent(m_pinNegEdgeId, nNeg);
     }
   }
-  return;
+
+  // Update inputs & set interrupt flags on the selected edges
+  const unsigned inEdges = changed & ~dir;
+  if (inEdges) {
+    m_regs.write(OFS_PAIN,
+                 (m_regs.read(OFS_PAIN) & ~inEdges) | (state & inEdges),
+                 /*force=*/true);
+    const unsigned newFlags = inEdges & irqEn & (state ^ irqEdge);
+    if (newFlags) {
+      m_regs.write(OFS_PAIFG, m_regs.read(OFS_PAIFG) | newFlags,
+                   /*force=*/true);
+    }
+  }
+  m_lastState = state;
+  portState.write(state);
+
+  // Drive external pins: outputs & pull-up/down, release others
+  const unsigned driven = dir | ren;
+  for (const auto i : m_boundPins) {
+    const unsigned mask = (1u << i);
+    pins[i]->write((driven & mask) ? sc_dt::sc_logic((out & mask) != 0)
+                                   : sc_dt::SC_LOGIC_Z);
+  }
+
+  // Interrupts
+  const unsigned irqFlags = m_regs.read(OFS_PAIFG);
+  irq[0].write(irqFlags & 0x00ff);
+  irq[1].write(irqFlags & 0xff00);
 }
@@ -10,12 +10,15 @@
 #include <array>
 #include <systemc>
 #include <tlm>
+#include <vector>
 #include "mcu/BusTarget.hpp"
 #include "mcu/RegisterFile.hpp"
 
 /**
  * @brief The DigitalIo class : model one IO port. For now only used to trace
- * IO outputs
+ * IO outputs. The port is processed as a whole word, bit n corresponding to
+ * pin n. Pins only need to be bound if they are connected to an external
+ * device; unbound pins are not sampled or driven.
  */
 class DigitalIo : public BusTarget {
   SC_HAS_PROCESS(DigitalIo);
@@ -23,7 +26,15 @@ class DigitalIo : public BusTarget {
  public:
   /* ------ Ports ------ */
   sc_core::sc_out<bool> irq[2];
-  std::array<sc_core::sc_inout_resolved, 16> pins;
+  std::array<sc_core::sc_port<sc_core::sc_signal_inout_if<sc_dt::sc_logic>, 1,
+                              sc_core::SC_ZERO_OR_MORE_BOUND>,
+             16>
+      pins;
+
+  /* ------ Signals ------ */
+  //! Word-wide port state: level driven on (outputs) or read from (inputs)
+  //! each pin
+  sc_core::sc_signal<unsigned> portState{"portState"};
 
   /*------ Methods ------*/
   /**
@@ -45,12 +56,24 @@ class DigitalIo : public BusTarget {
    */
   virtual void end_of_elaboration() override;
 
+  /**
+   * @brief saveState checkpoint registers and pin state
+   */
+  virtual void saveState(CheckpointWriter &writer) const override;
+
+  /**
+   * @brief restoreState restore registers and drive pins accordingly
+   */
+  virtual void restoreState(CheckpointReader &reader) override;
+
  private:
   /* ------ Private variables ------ */
   int m_pinPosEdgeId{-1};
   int m_pinNegEdgeId{-1};
 
-  unsigned int m_lastState{0};  // Used to detect input edges
+  unsigned int m_lastState{0};      // Used to detect edges
+  unsigned int m_boundMask{0};      // Pins bound to external devices
+  std::vector<unsigned> m_boundPins;  // Indices of bound pins
 
   /* ------ Private methods ------ */
   /**
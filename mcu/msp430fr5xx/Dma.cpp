@@ -94,12 +94,37 @@ Dma::Dma(const sc_module_name name)
 void Dma::reset() {
   // reset register values to defaults, or 0xAAAA if undefined
   m_regs.reset();
+  m_roundRobin = false;
+  m_lastChannel = NCHANNELS - 1;
   // Reset channels
   for (size_t i = 0; i < NCHANNELS; ++i) {
     m_channels[i]->reset();
   }
 }
 
+void Dma::saveState(CheckpointWriter &writer) const {
+  BusTarget::saveState(writer);
+  writer.write(m_clearIfg);
+  writer.write(m_roundRobin);
+  writer.write(m_lastChannel);
+  for (size_t i = 0; i < NCHANNELS; ++i) {
+    writer.write(m_channelTriggerSelect[i].read());
+    m_channels[i]->saveState(writer);
+  }
+}
+
+void Dma::restoreState(CheckpointReader &reader) {
+  BusTarget::restoreState(reader);
+  reader.read(m_clearIfg);
+  reader.read(m_roundRobin);
+  reader.read(m_lastChannel);
+  for (size_t i = 0; i < NCHANNELS; ++i) {
+    m_channelTriggerSelect[i].write(reader.read<int>());
+    m_channels[i]->restoreState(reader);
+  }
+  m_updateIrqEvent.notify(SC_ZERO_TIME);
+}
+
 void Dma::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay) {
   BusTarget::b_transport(trans, delay);
   auto addr = trans.get_address();
@@ -135,7 +160,12 @@ void Dma::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay) {
       setTrigger(5, (val & (0x1f << 8)) >> 8);
       break;
     case OFS_DMACTL4:
-      spdlog::warn("{}: DMACTL4 functionality is not implemented");
+      m_roundRobin = val & ROUNDROBIN;
+      if (val & (ENNMI | DMARMWDIS)) {
+        spdlog::warn("{}: DMACTL4.ENNMI and DMACTL4.DMARMWDIS are not "
+                     "implemented",
+                     this->name());
+      }
       break;
     case OFS_DMA0CTL:
       m_channels[0]->updateConfig(val);
@@ -170,10 +200,6 @@ void Dma::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay) {
 }
 
 void Dma::process() {
-  uint8_t data[2];
-  sc_time delay = SC_ZERO_TIME;
-  tlm_generic_payload trans; //! Outgoing transaction
-  trans.set_data_ptr(data);
   wait(SC_ZERO_TIME); // Wait for simulation start
 
   // Sensitivity list
@@ -183,14 +209,7 @@ void Dma::process() {
   }
 
   while (true) {
-    int channelIdx = -1;
-    // Find highest-priority (lowest channel number) triggered channel
-    for (auto i = 0; i < m_channelPending.size(); i++) {
-      if (m_channelPending[i].read()) {
-        channelIdx = i;
-        break;
-      }
-    }
+    const int channelIdx = nextPendingChannel();
 
     if (channelIdx >= 0) {
       // DMA spends "1 or 2 clock cycles to synchronize to mclk"
@@ -200,27 +219,16 @@ void Dma::process() {
       // Accept, perform transfer, update state & registers
       const auto &ch = *m_channels[channelIdx];
       const auto offset = channelIdx * (OFS_DMA1CTL - OFS_DMA0CTL);
-      trans.set_data_length((ch.sourceBytes == DmaChannel::Bytes::Byte) ? 1
-                                                                        : 2);
       m_regs.clearBitMask(OFS_DMA0CTL + offset, DMAREQ);
-      while (ch.pending.read()) {
-        // Read
-        trans.set_command(TLM_READ_COMMAND);
-        trans.set_address(ch.m_tSourceAddress);
-        delay = SC_ZERO_TIME;
-        iSocket->b_transport(trans, delay);
-        wait(delay);
-
-        // Write
-        trans.set_address(ch.m_tDestinationAddress);
-        trans.set_command(TLM_WRITE_COMMAND);
-        m_channelAccept[channelIdx].write(true);
-        delay = SC_ZERO_TIME;
-        iSocket->b_transport(trans, delay);
-        wait(delay);
-        m_channelAccept[channelIdx].write(false);
-        m_regs.write(OFS_DMA0SZ + offset, ch.size);
+      if (ch.isBlockTransfer()) {
+        if (!blockTransfer(channelIdx)) {
+          // Preempted, keep the CPU stalled and service the other channel
+          continue;
+        }
+      } else {
+        singleTransfer(channelIdx);
       }
+      m_lastChannel = channelIdx;
 
       if (!ch.enable) {
         m_regs.clearBitMask(OFS_DMA0CTL + offset, DMAEN);
@@ -235,6 +243,110 @@ void Dma::process() {
   }
 }
 
+void Dma::singleTransfer(const int channelIdx) {
+  uint8_t data[2];
+  sc_time delay = SC_ZERO_TIME;
+  tlm_generic_payload trans; //! Outgoing transaction
+  const auto &ch = *m_channels[channelIdx];
+  const auto offset = channelIdx * (OFS_DMA1CTL - OFS_DMA0CTL);
+
+  trans.set_data_ptr(data);
+  trans.set_data_length((ch.sourceBytes == DmaChannel::Bytes::Byte) ? 1 : 2);
+  while (ch.pending.read()) {
+    // Read
+    trans.set_command(TLM_READ_COMMAND);
+    trans.set_address(ch.m_tSourceAddress);
+    delay = SC_ZERO_TIME;
+    iSocket->b_transport(trans, delay);
+    wait(delay);
+
+    // Write
+    trans.set_address(ch.m_tDestinationAddress);
+    trans.set_command(TLM_WRITE_COMMAND);
+    m_channelAccept[channelIdx].write(true);
+    delay = SC_ZERO_TIME;
+    iSocket->b_transport(trans, delay);
+    wait(delay);
+    m_channelAccept[channelIdx].write(false);
+    m_regs.write(OFS_DMA0SZ + offset, ch.size);
+  }
+}
+
+bool Dma::blockTransfer(const int channelIdx) {
+  uint8_t data[2];
+  sc_time delay = SC_ZERO_TIME;
+  tlm_generic_payload trans; //! Outgoing transaction
+  auto &ch = *m_channels[channelIdx];
+  const auto offset = channelIdx * (OFS_DMA1CTL - OFS_DMA0CTL);
+  const int quantum = ch.isBurst() ? BURST_LENGTH : BLOCK_QUANTUM;
+
+  trans.set_data_ptr(data);
+  trans.set_data_length((ch.sourceBytes == DmaChannel::Bytes::Byte) ? 1 : 2);
+  while ((ch.size > 0) && ch.enable) {
+    // Issue a quantum of beats back-to-back, accumulating the delay. Targets
+    // still see (and report energy for) every beat.
+    delay = SC_ZERO_TIME;
+    for (int i = 0; (i < quantum) && (ch.size > 0); ++i) {
+      trans.set_command(TLM_READ_COMMAND);
+      trans.set_address(ch.m_tSourceAddress);
+      iSocket->b_transport(trans, delay);
+
+      trans.set_command(TLM_WRITE_COMMAND);
+      trans.set_address(ch.m_tDestinationAddress);
+      iSocket->b_transport(trans, delay);
+
+      ch.updateAddresses();
+      ch.size--;
+    }
+    m_regs.write(OFS_DMA0SZ + offset, ch.size);
+    wait(delay);
+
+    if (ch.size == 0) {
+      break;
+    }
+
+    if (ch.isBurst()) {
+      // CPU activity interleaved with transfer: 2 cycles every 4 beats
+      stallCpu.write(false);
+      wait(2 * systemClk->getPeriod());
+      stallCpu.write(true);
+    }
+
+    // Allow higher-priority channels to preempt between quanta
+    const int next = nextPendingChannel();
+    if ((next >= 0) && (priority(next) < priority(channelIdx))) {
+      spdlog::info("{:s}: Channel {:d} preempted by channel {:d}", this->name(),
+                   channelIdx, next);
+      return false;
+    }
+  }
+
+  // Hand back to channel, and let it reload its internal registers
+  ch.m_blockDone.notify();
+  wait(SC_ZERO_TIME);
+  m_regs.write(OFS_DMA0SZ + offset, ch.size);
+  return true;
+}
+
+int Dma::priority(const int channelIdx) const {
+  if (m_roundRobin) {
+    // Last serviced channel gets the lowest priority
+    return (channelIdx - m_lastChannel - 1 + NCHANNELS) % NCHANNELS;
+  }
+  return channelIdx; // Lowest channel number has highest priority
+}
+
+int Dma::nextPendingChannel() const {
+  int channelIdx = -1;
+  for (auto i = 0; i < NCHANNELS; i++) {
+    if (m_channelPending[i].read() &&
+        ((channelIdx == -1) || (priority(i) < priority(channelIdx)))) {
+      channelIdx = i;
+    }
+  }
+  return channelIdx;
+}
+
 void Dma::interruptUpdate() {
   int highestPrioChannel = -1;
   for (auto i = 0; i < m_channels.size(); i++) {
@@ -392,50 +504,20 @@ void DmaChannel::process() {
       pending.write(false);
       break;
     case DmaChannel::TransferMode::Block:
-      // Transfer whole block after first trigger
-      size = m_tSize;
-      m_tSourceAddress = sourceAddress;
-      m_tDestinationAddress = destinationAddress;
-      spdlog::info("{}: Block transfer {:d} beats 0x{:08x}->0x{:08x}",
-                   this->name(), size, sourceAddress, destinationAddress);
-      pending.write(true);
-      while (size) {
-        std::cout << "Block-transfer: remaining " << size << std::endl;
-        wait(accept.posedge_event());
-        updateAddresses();
-        if (!enable) {
-          break;
-        }
-        size--;
-      }
-      size = m_tSize;
-      enable = false;
-      interruptFlag = true;
-      pending.write(false);
-      break;
     case DmaChannel::TransferMode::BurstBlock:
-      //  CPU activity interleaved with transfer
-      //  Delay for 2 cycles every 4 transfers
+      // Transfer whole block after first trigger. The beats are performed by
+      // Dma::blockTransfer, which notifies m_blockDone when finished.
       size = m_tSize;
       m_tSourceAddress = sourceAddress;
       m_tDestinationAddress = destinationAddress;
-      spdlog::info("{}: Block-burst transfer {:d} beats 0x{:08x}->0x{:08x}",
-                   this->name(), size, sourceAddress, destinationAddress);
+      spdlog::info("{}: {:s} transfer {:d} beats 0x{:08x}->0x{:08x}",
+                   this->name(), isBurst() ? "Block-burst" : "Block", size,
+                   sourceAddress, destinationAddress);
       pending.write(true);
-      while (size) {
-        wait(accept.posedge_event());
-        updateAddresses();
-        if ((size > 0) && (size < m_tSize) && (size % 4 == 0)) {
-          wait(2 * systemClk->getPeriod());
-        }
-        if (!enable) {
-          break;
-        }
-        size--;
-      }
+      wait(m_blockDone);
       size = m_tSize;
-      interruptFlag = true;
       enable = false;
+      interruptFlag = true;
       pending.write(false);
       break;
     case TransferMode::RepeatedSingle:
@@ -466,13 +548,7 @@ void DmaChannel::process() {
       spdlog::info("{}: Repeated block transfer {:d} beats 0x{:08x}->0x{:08x}",
                    this->name(), size, sourceAddress, destinationAddress);
       pending.write(true);
-      while (size) {
-        wait(accept.posedge_event());
-        updateAddresses();
-        if (!enable) {
-          break;
-        }
-      }
+      wait(m_blockDone);
       size = m_tSize;
       interruptFlag = true;
       pending.write(false);
@@ -481,24 +557,14 @@ void DmaChannel::process() {
       // Continue burst-transfer indefinitely after first trigger, until
       // breakout condition
       pending.write(true);
-      while (1) {
+      while (enable) {
         size = m_tSize;
         m_tSourceAddress = sourceAddress;
         m_tDestinationAddress = destinationAddress;
         spdlog::info(
             "{}: Repeated block-burst transfer {:d} beats 0x{:08x}->0x{:08x}",
             this->name(), size, sourceAddress, destinationAddress);
-        while (size) {
-          wait(accept.posedge_event());
-          updateAddresses();
-          if ((size > 0) && (size < m_tSize) && (size % 4 == 0)) {
-            wait(2 * systemClk->getPeriod());
-          }
-          if (!enable) {
-            break;
-          }
-          size--;
-        }
+        wait(m_blockDone);
         size = m_tSize;
         interruptFlag = true;
       }
@@ -508,6 +574,16 @@ void DmaChannel::process() {
   }
 }
 
+bool DmaChannel::isBlockTransfer() const {
+  return (transferMode != TransferMode::Single) &&
+         (transferMode != TransferMode::RepeatedSingle);
+}
+
+bool DmaChannel::isBurst() const {
+  return (transferMode == TransferMode::BurstBlock) ||
+         (transferMode == TransferMode::RepeatedBurstBlock);
+}
+
 void Dma::updateChannelAddresses() {
   for (auto i = 0; i < m_channels.size(); i++) {
     const auto offset = i * (OFS_DMA1CTL - OFS_DMA0CTL);
@@ -535,6 +611,44 @@ void DmaChannel::reset() {
   interruptFlag = false;
 }
 
+void DmaChannel::saveState(CheckpointWriter &writer) const {
+  writer.write(interruptFlag);
+  writer.write(size);
+  writer.write(destinationAddress);
+  writer.write(sourceAddress);
+  writer.write(destinationAutoIncrement);
+  writer.write(sourceAutoIncrement);
+  writer.write(destinationBytes);
+  writer.write(sourceBytes);
+  writer.write(enable);
+  writer.write(levelSensitive);
+  writer.write(interruptEnable);
+  writer.write(abort);
+  writer.write(transferMode);
+  writer.write(m_tSize);
+  writer.write(m_tSourceAddress);
+  writer.write(m_tDestinationAddress);
+}
+
+void DmaChannel::restoreState(CheckpointReader &reader) {
+  reader.read(interruptFlag);
+  reader.read(size);
+  reader.read(destinationAddress);
+  reader.read(sourceAddress);
+  reader.read(destinationAutoIncrement);
+  reader.read(sourceAutoIncrement);
+  reader.read(destinationBytes);
+  reader.read(sourceBytes);
+  reader.read(enable);
+  reader.read(levelSensitive);
+  reader.read(interruptEnable);
+  reader.read(abort);
+  reader.read(transferMode);
+  reader.read(m_tSize);
+  reader.read(m_tSourceAddress);
+  reader.read(m_tDestinationAddress);
+}
+
 std::ostream &operator<<(std::ostream &os, const DmaChannel &rhs) {
   os << "<DmaChannel> " << rhs.name() << "\n";
   os << "Signals:\n";
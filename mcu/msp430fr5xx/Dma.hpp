@@ -105,6 +105,28 @@ SC_MODULE(DmaChannel) {
    */
   void reset();
 
+  /**
+   * @brief saveState write configuration & flags to a checkpoint
+   */
+  void saveState(CheckpointWriter &writer) const;
+
+  /**
+   * @brief restoreState read configuration & flags from a checkpoint
+   */
+  void restoreState(CheckpointReader &reader);
+
+  /**
+   * @brief isBlockTransfer check if the channel is configured for one of the
+   * block modes, i.e. a whole block is moved per trigger.
+   */
+  bool isBlockTransfer() const;
+
+  /**
+   * @brief isBurst check if the channel is configured for a burst-block mode,
+   * i.e. CPU activity is interleaved with the transfer.
+   */
+  bool isBurst() const;
+
   /**
    * @brief << debug printout.
    */
@@ -112,6 +134,7 @@ SC_MODULE(DmaChannel) {
 
   /*------ Private variables ------*/
   sc_core::sc_event m_softwareTrigger{"m_softwareTrigger"};
+  sc_core::sc_event m_blockDone{"m_blockDone"};  //! Notified by Dma
 
   int m_tSize{0};                //! Local copy
   int m_tSourceAddress{0};       //! Local copy
@@ -140,6 +163,13 @@ class Dma : public BusTarget {
 
   /*------ Submodules ------*/
   static const int NCHANNELS = 6;
+
+  //! Max. number of beats of a block transfer between kernel synchronisations
+  static const int BLOCK_QUANTUM = 16;
+
+  //! Number of beats between CPU cycles in burst-block modes
+  static const int BURST_LENGTH = 4;
+
   std::array<DmaChannel *, NCHANNELS> m_channels;
   std::array<TriggerMux *, NCHANNELS> m_triggerMuxes;
 
@@ -164,11 +194,23 @@ class Dma : public BusTarget {
   virtual void b_transport(tlm::tlm_generic_payload &trans,
                            sc_core::sc_time &delay) override;
 
+  /**
+   * @brief saveState checkpoint registers, arbitration and channel state
+   */
+  virtual void saveState(CheckpointWriter &writer) const override;
+
+  /**
+   * @brief restoreState restore registers, arbitration and channel state
+   */
+  virtual void restoreState(CheckpointReader &reader) override;
+
   /*------ Private types ------*/
 
  private:
   /*------ Private variables ------*/
   bool m_clearIfg;
+  bool m_roundRobin{false};  //! DMACTL4.ROUNDROBIN
+  int m_lastChannel{NCHANNELS - 1};  //! Last serviced channel (round-robin)
   std::array<sc_core::sc_signal<bool>, NCHANNELS> m_channelPending;
   std::array<sc_core::sc_signal<bool>, NCHANNELS> m_channelAccept;
   std::array<sc_core::sc_signal<bool>, NCHANNELS> m_channelTrigger;
@@ -182,6 +224,34 @@ class Dma : public BusTarget {
    */
   void process();
 
+  /**
+   * @brief priority get the priority rank of a channel, 0 being the highest.
+   * Depends on DMACTL4.ROUNDROBIN and the last serviced channel.
+   */
+  int priority(const int channelIdx) const;
+
+  /**
+   * @brief nextPendingChannel find highest-priority pending channel.
+   * @retval channel index, or -1 if no channel is pending.
+   */
+  int nextPendingChannel() const;
+
+  /**
+   * @brief singleTransfer perform the transfers of a single or repeated-single
+   * channel, one beat per accept-handshake.
+   */
+  void singleTransfer(const int channelIdx);
+
+  /**
+   * @brief blockTransfer perform a (burst-)block transfer. Beats are issued
+   * back-to-back with an annotated delay, and the thread only synchronises
+   * with the kernel every BLOCK_QUANTUM beats (BURST_LENGTH in burst modes).
+   * Energy is still reported per beat by the targets.
+   * @retval true if the block completed, false if the transfer was preempted
+   * by a higher-priority channel.
+   */
+  bool blockTransfer(const int channelIdx);
+
   /**
    * @brief updateChannelAddresses update addresses & size from register
    * values for all channels.
@@ -49,6 +49,11 @@ void Frctl_a::reset() {
   }
 }
 
+void Frctl_a::restoreState(CheckpointReader &reader) {
+  BusTarget::restoreState(reader);
+  m_writeEvent.notify(SC_ZERO_TIME);  // Triggers process
+}
+
 void Frctl_a::process() {
   // Update waitstate
   waitStates.write((m_regs.read(OFS_FRCTL0) >> 4) & 0x000f);
@@ -35,6 +35,11 @@ class Frctl_a : public BusTarget {
 
   virtual void reset() override;
 
+  /**
+   * @brief restoreState restore registers and update wait states accordingly
+   */
+  virtual void restoreState(CheckpointReader &reader) override;
+
  private:
   /* ------ Private variables ------ */
 
@@ -21,6 +21,8 @@
 #include "ps/ConstantCurrentState.hpp"
 #include "ps/ConstantEnergyEvent.hpp"
 #include "utilities/Config.hpp"
+#include "utilities/Ensemble.hpp"
+#include "utilities/TraceWindow.hpp"
 #include "utilities/Utilities.hpp"
 
 extern "C" {
@@ -29,22 +31,26 @@ extern "C" {
 
 using namespace sc_core;
 
-Msp430Cpu::Msp430Cpu(const sc_module_name name, const bool logOperation,
-                     const bool logInstructions)
-    : sc_module(name),
-      m_doLogOperation(logOperation),
-      m_doLogInstructions(logInstructions) {
+Msp430Cpu::Msp430Cpu(const sc_module_name name, const bool trace)
+    : sc_module(name) {
   iSocket.bind(*this);
+  registerCheckpointable(this->name());
 
   SC_THREAD(process);
 
-  std::string odir = Config::get().getString("OutputDirectory");
-  if (logOperation) {
-    m_opsLogFile.open(odir + "/cpu_op.log");
+  if (trace) {
+    m_trace = std::make_unique<InstructionTrace>(
+        Utility::outputDirectory(this->name()) + "/cpu_trace.bin", N_GPR,
+        PC_REGNUM);
   }
 
-  if (logInstructions) {
-    m_instrLogFile.open(odir + "/cpu_instructions.log");
+  if (EnergyProfiler::isEnabled()) {
+    m_energyProfiler =
+        std::make_unique<EnergyProfiler>(this->name(), 0, 0x100000);
+  }
+
+  if (Coverage::isEnabled()) {
+    m_coverage = std::make_unique<Coverage>(this->name(), 0, 0x100000);
   }
 }
 
@@ -88,27 +94,71 @@ void Msp430Cpu::end_of_elaboration() {
       std::make_unique<ConstantCurrentState>(this->name(), "sleep"));
 }
 
+void Msp430Cpu::end_of_simulation() {
+  if (m_energyProfiler) {
+    m_energyProfiler->write();
+  }
+  if (m_coverage) {
+    m_coverage->write();
+  }
+  if (m_trace) {
+    m_trace->flush();
+  }
+}
+
+void Msp430Cpu::saveState(CheckpointWriter &writer) const {
+  writer.write(m_cpuRegs);
+  writer.write(m_sleeping);
+  writer.write(m_idleCycles);
+}
+
+void Msp430Cpu::restoreState(CheckpointReader &reader) {
+  reader.read(m_cpuRegs);
+  reader.read(m_sleeping);
+  reader.read(m_idleCycles);
+}
+
 void Msp430Cpu::reset(void) {
   for (auto &r : m_cpuRegs) {
     r = 0;
   }
   setSr(CPUOFF);  // Don't execute anything until we get the power-up NMI
+  if (m_energyProfiler) {
+    m_energyProfiler->reset();
+  }
+  if (m_coverage) {
+    m_coverage->reset();
+  }
 }
 
 void Msp430Cpu::process() {
   wait(SC_ZERO_TIME);  // Wait for start of simulation
+  FUSED_PROFILE("Msp430Cpu::process");
+  if (m_energyProfiler) {
+    powerModelPort->attributeEvents();
+  }
 
   while (true) {  // Run emulator
+    Checkpoint::serviceRequest();  // Between instructions
 
     if (pwrOn.read() && m_run) {
+      const auto begin = sc_time_stamp();
+      updateTracing();
+      if (m_energyProfiler) {
+        m_energyProfiler->begin(powerModelPort->getAttributedEnergy());
+      }
+
       // Handle interrupts
-      if (irq.read()) {
+      const int irqIdx = irqCtrl->highestPending();
+      if (irqIdx >= 0) {
         powerModelPort->reportEvent(m_irqEventId);
-        processInterrupt();
+        processInterrupt(irqIdx);
       }
 
+      Ensemble::check(Ensemble::Trigger::Pc, getPc());
+
       // Handle breakpoints
-      if (m_breakpoints.count(getPc()) > 0) {  // Hit breakpoint
+      if (m_breakpoints.contains(getPc())) {  // Hit breakpoint
         std::cout << "@" << std::setw(10) << sc_core::sc_time_stamp()
                   << ": Breakpoint hit (0x" << std::hex << getPc() << ")!\n";
         m_run = false;
@@ -128,11 +178,15 @@ void Msp430Cpu::process() {
           powerModelPort->reportState(m_onStateId);
           m_sleeping = false;
         }
-        uint16_t opcode = fetch();
-        static const uint16_t INST_RETI = 0x1300;
-        if (m_doLogOperation && opcode == INST_RETI) {
-          m_opsLogFile << "@" << sc_time_stamp() << ": RETI\n";
+        const uint32_t pc = getPc();
+        const uint32_t sp = getSp();
+        TraceWindow::pc(pc);
+        updateTracing();  // PC-triggered windows open here
+        if (m_coverage) {
+          m_coverage->mark(pc);
         }
+        uint16_t opcode = fetch();
+        ++m_instructionCount;
 
         uint8_t instructionFmt = (opcode & 0xe000) >> 13;
         if (instructionFmt == 0) {
@@ -145,6 +199,16 @@ void Msp430Cpu::process() {
           executeDoubleOpInstruction(opcode);
           powerModelPort->reportEvent(m_formatIEventId);
         }
+        m_cycleCount += static_cast<uint64_t>(
+            (sc_time_stamp() - begin) / mclk->getPeriod() + 0.5);
+        if (m_energyProfiler) {
+          m_energyProfiler->retire(pc, sp, mclk->getPeriod(),
+                                   powerModelPort->getAttributedEnergy());
+        }
+        if (m_tracing) {
+          m_trace->instruction(pc, opcode, m_cpuRegs.data(),
+                               mclk->getPeriod());
+        }
         if (m_doStep) {  // end single step
           m_run = false;
           m_doStep = false;
@@ -158,23 +222,40 @@ void Msp430Cpu::process() {
 
     if (m_run && (!pwrOn.read())) {
       powerModelPort->reportState(m_offStateId);
-      wait(pwrOn.posedge_event());  // Wait for power
+      Ensemble::check(Ensemble::Trigger::PowerOff);
+      Checkpoint::serviceRequest();  // CPU is reset at power-up anyway
+      Checkpoint::setIdle(true);     // Requests while off are written at once
+      wait(pwrOn.posedge_event());   // Wait for power
+      Checkpoint::setIdle(false);
       m_sleeping = false;
       reset();  // Reset
     }
   }
 }
 
-void Msp430Cpu::processInterrupt() {
+void Msp430Cpu::updateTracing() {
+  if (!m_trace) {
+    return;
+  }
+  const bool open = TraceWindow::isOpen();
+  if (open && !m_tracing) {
+    // Records were skipped while the window was closed, don't count the gap
+    // as cycles of the next instruction
+    m_trace->resume(m_cpuRegs.data(), mclk->getPeriod());
+  }
+  m_tracing = open;
+}
+
+void Msp430Cpu::processInterrupt(const unsigned irqIdx) {
   uint16_t addr;
 
-  if (irqIdx.read() == 0) {  // Reset vector (BOR/PUC)
+  if (irqIdx == 0) {  // Reset vector (BOR/PUC)
     addr = 0xfffe;
 
     // Acknowledge interrupt source
-    ira.write(true);
+    irqCtrl->acknowledge(irqIdx, true);
     waitCycles(2);
-    ira.write(false);
+    irqCtrl->acknowledge(irqIdx, false);
 
     // Clear all bits of SR except SCG0
     setSr(getSr() & (1u << 6));
@@ -182,14 +263,12 @@ void Msp430Cpu::processInterrupt() {
     // Load reset vector
     setPc(read16(addr));
 
-    if (m_doLogOperation) {
-      using namespace std;
-      m_opsLogFile << "@" << setw(10) << sc_time_stamp() << ": IRQHANDLER 0x"
-                   << hex << setw(4) << addr << "\n";
+    if (m_tracing) {
+      m_trace->irq(addr);
     }
     powerModelPort->reportState(m_onStateId);
     m_sleeping = false;
-  } else if ((getSr() & GIE) || irqIdx.read() < 3) {  // GIE or NMI
+  } else if ((getSr() & GIE) || irqIdx < 3) {  // GIE or NMI
     // Push pc to stack
     setSp(getSp() - 2);
     write16(getSp(), getPc());
@@ -199,13 +278,13 @@ void Msp430Cpu::processInterrupt() {
     write16(getSp(), getSr());
 
     // Capture interrupt vector address
-    addr = 0xfffe - (2 * irqIdx.read());
+    addr = 0xfffe - (2 * irqIdx);
 
     // IRQ flag (source) resets if the selected peripheral's IRA is
     // connected
-    ira.write(true);
+    irqCtrl->acknowledge(irqIdx, true);
     wait(2 * mclk->getPeriod());
-    ira.write(false);
+    irqCtrl->acknowledge(irqIdx, false);
 
     // Clear all bits of SR except SCG0
     setSr(getSr() & (1u << 6));
@@ -213,10 +292,8 @@ void Msp430Cpu::processInterrupt() {
     // Load content of interrupt vector to PC
     setPc(read16(addr));
 
-    if (m_doLogOperation) {
-      using namespace std;
-      m_opsLogFile << "@" << setw(10) << sc_time_stamp() << ": IRQHANDLER 0x"
-                   << hex << setw(4) << addr << "\n";
+    if (m_tracing) {
+      m_trace->irq(addr);
     }
   } else {
     // Do nothing -- interrupts are disabled, and this was not an NMI
@@ -248,7 +325,7 @@ void Msp430Cpu::writeMem(const uint32_t addr, uint8_t *const data,
 }
 
 void Msp430Cpu::readMem(const uint32_t addr, uint8_t *const data,
-                        const size_t bytelen) {
+                        const size_t bytelen, const bool fetch) {
   sc_time delay;
   tlm::tlm_generic_payload trans;
 
@@ -261,7 +338,13 @@ void Msp430Cpu::readMem(const uint32_t addr, uint8_t *const data,
   trans.set_data_length(bytelen);
   trans.set_data_ptr(data);
   trans.set_command(tlm::TLM_READ_COMMAND);
+  if (fetch) {
+    trans.set_extension(&m_fetchExtension);
+  }
   iSocket->b_transport(trans, delay);
+  if (fetch) {
+    trans.clear_extension(&m_fetchExtension);  // Not owned by trans
+  }
 
   if (trans.get_response_status() != tlm::TLM_OK_RESPONSE) {
     spdlog::error("{} Failed read from address 0x{:08x}.", this->name(), addr);
@@ -334,30 +417,45 @@ bool Msp430Cpu::isStalled(void) { return !m_run; }
 
 uint16_t Msp430Cpu::fetch() {
   assert(getPc() % 2 == 0);
-  uint16_t retval = read16(getPc());
+  uint8_t tmp[2];
+  readMem(getPc(), tmp, 2, /*fetch=*/true);  // Fetches aren't traced
   setPc(getPc() + 2);
-  return retval;
+  return Utility::ttohs(Utility::packBytes(tmp, 2));
 }
 
 uint16_t Msp430Cpu::read16(size_t addr) {
   uint8_t tmp[2];
+  if (m_tracing) {
+    m_trace->access(addr, /*write=*/false, /*byte=*/false);
+  }
   readMem(addr, tmp, 2);
   return Utility::ttohs(Utility::packBytes(tmp, 2));
 }
 
 uint8_t Msp430Cpu::read8(size_t addr) {
   uint8_t tmp;
+  if (m_tracing) {
+    m_trace->access(addr, /*write=*/false, /*byte=*/true);
+  }
   readMem(addr, &tmp, 1);
   return tmp;
 }
 
 void Msp430Cpu::write16(size_t addr, uint16_t val) {
   uint8_t tmp[2];
+  if (m_tracing) {
+    m_trace->access(addr, /*write=*/true, /*byte=*/false);
+  }
   Utility::unpackBytes(tmp, Utility::htots(val), 2);
   writeMem(addr, tmp, 2);
 }
 
-void Msp430Cpu::write8(size_t addr, uint8_t val) { writeMem(addr, &val, 1); }
+void Msp430Cpu::write8(size_t addr, uint8_t val) {
+  if (m_tracing) {
+    m_trace->access(addr, /*write=*/true, /*byte=*/true);
+  }
+  writeMem(addr, &val, 1);
+}
 
 void Msp430Cpu::writeback(operand_t operand) {
   writeback(operand.addr, operand.val, operand.inMem, operand.byteNotWord);
@@ -857,9 +955,7 @@ std::ostream &operator<<(std::ostream &os, const Msp430Cpu &rhs) {
     << "\nm_run (active) " << rhs.m_run
     << "\nm_sleeping " << rhs.m_sleeping
     << "\nclock period " << rhs.mclk->getPeriod()
-    << "\nirq " << rhs.irq.read()
-    << "\nira " << rhs.ira.read()
-    << "\nirqIdx " << rhs.irqIdx.read()
+    << "\nirqIdx " << rhs.irqCtrl->highestPending()
     << "\nbusStall " << rhs.busStall.read()
     << "\ncpu registers:";
   for (int i = 0; i < rhs.m_cpuRegs.size(); ++i) {
@@ -867,7 +963,7 @@ std::ostream &operator<<(std::ostream &os, const Msp430Cpu &rhs) {
   }
 
   os << "\nBreakpoints:";
-  for (const auto &b : rhs.m_breakpoints) {
+  for (const auto &b : rhs.m_breakpoints.addresses()) {
     os << fmt::format("\n\t0x{:04x}", b);
   }
   os << "\n";
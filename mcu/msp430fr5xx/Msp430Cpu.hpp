@@ -12,39 +12,50 @@
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <systemc>
 #include <tlm>
 #include <unordered_set>
 #include "mcu/ClockSourceIf.hpp"
+#include "mcu/InstructionFetchExtension.hpp"
+#include "mcu/InterruptControllerIf.hpp"
 #include "ps/PowerModelChannelIf.hpp"
+#include "utilities/BreakpointMap.hpp"
+#include "utilities/Checkpoint.hpp"
+#include "utilities/Coverage.hpp"
+#include "utilities/EnergyProfiler.hpp"
+#include "utilities/InstructionTrace.hpp"
+#include "utilities/Profiler.hpp"
 #include "utilities/Utilities.hpp"
 
-class Msp430Cpu : public sc_core::sc_module, tlm::tlm_bw_transport_if<> {
+class Msp430Cpu : public sc_core::sc_module,
+                  tlm::tlm_bw_transport_if<>,
+                  public Checkpointable {
  public:
   /*------ Ports ------*/
   tlm::tlm_initiator_socket<> iSocket{"iSocket"};  //! TLM initiator socket
   sc_core::sc_port<ClockSourceConsumerIf> mclk{"mclk"};
-  sc_core::sc_in<bool> irq{"irq_in"};         //! Interrupt request line
-  sc_core::sc_in<unsigned> irqIdx{"irqIdx"};  //! Irq source index
+  //! Interrupt controller, provides pending interrupts & acknowledgement
+  sc_core::sc_port<InterruptControllerIf> irqCtrl{"irqCtrl"};
   sc_core::sc_in<bool> pwrOn{"pwrOn"};        //! "power-good" signal
   sc_core::sc_in<bool> busStall{"busStall"};  //! indicate busy bus
-  sc_core::sc_out<bool> ira{"ira_out"};       //! irq accepted
 
   //! Output port for power model events
   PowerModelEventOutPort powerModelPort{"powerModelPort"};
 
-  //! Decides whether to wait for peripheral's ack of IRA asserted or
-  //! just wait one cycle
-  sc_core::sc_in<bool> iraConnected{"iraConnected"};
-
   //*------ Types ------*/
   typedef enum { WORD, BYTE } access_t;
 
   /*------ Methods ------*/
   SC_HAS_PROCESS(Msp430Cpu);
 
-  Msp430Cpu(const sc_core::sc_module_name name, const bool logOperation = false,
-            const bool logInstruction = false);
+  /**
+   * @brief Msp430Cpu constructor
+   * @param trace write a binary trace of executed instructions & interrupt
+   * entries to <OutputDirectory>/cpu_trace.bin. Decode with
+   * tools/decode_trace.py.
+   */
+  Msp430Cpu(const sc_core::sc_module_name name, const bool trace = false);
 
   /**
    * @brief end_of_elaboration SystemC callback. Used here for registering power
@@ -52,6 +63,23 @@ class Msp430Cpu : public sc_core::sc_module, tlm::tlm_bw_transport_if<> {
    */
   virtual void end_of_elaboration() override;
 
+  /**
+   * @brief end_of_simulation SystemC callback. Used here for writing the
+   * energy profile.
+   */
+  virtual void end_of_simulation() override;
+
+  /**
+   * @brief saveState checkpoint registers and operating mode. Only consistent
+   * between instructions, see Checkpoint::request().
+   */
+  virtual void saveState(CheckpointWriter &writer) const override;
+
+  /**
+   * @brief restoreState restore registers and operating mode.
+   */
+  virtual void restoreState(CheckpointReader &reader) override;
+
   /**
    * @brief writeMem: Callback function for write operations to memory by
    * emulator
@@ -62,16 +90,16 @@ class Msp430Cpu : public sc_core::sc_module, tlm::tlm_bw_transport_if<> {
   /**
    * @brief readMem: Callback function for read operations from memory by
    * emulator
+   * @param fetch tag the read as an instruction fetch
    */
-  void readMem(const uint32_t addr, uint8_t *const data, const size_t bytelen);
+  void readMem(const uint32_t addr, uint8_t *const data, const size_t bytelen,
+               const bool fetch = false);
 
   /**
    * @brief waitCycles wait nCycles clock cycles.
    * @param nCycles  number of clock cycles to wait
    */
-  void waitCycles(unsigned nCycles) {
-    sc_core::wait(nCycles * mclk->getPeriod());
-  }
+  void waitCycles(unsigned nCycles) { wait(nCycles * mclk->getPeriod()); }
 
   /**
    * @brief dbg_readReg Read register value without consuming simulation
@@ -137,6 +165,17 @@ class Msp430Cpu : public sc_core::sc_module, tlm::tlm_bw_transport_if<> {
    */
   uint32_t n_regs() const { return N_GPR; }
 
+  /**
+   * @brief Get number of instructions executed since the start of simulation
+   */
+  uint64_t getInstructionCount() const { return m_instructionCount; }
+
+  /**
+   * @brief Get number of clock cycles spent executing instructions (including
+   * interrupt entry, excluding low-power modes) since the start of simulation
+   */
+  uint64_t getCycleCount() const { return m_cycleCount; }
+
   /**
    * @brief operator<< state printout
    */
@@ -172,9 +211,6 @@ class Msp430Cpu : public sc_core::sc_module, tlm::tlm_bw_transport_if<> {
   } operand_t;
 
   /* ------ Constants ------ */
-  const bool m_doLogInstructions;
-  const bool m_doLogOperation;
-
   static const unsigned PC_REGNUM = 0;
   static const unsigned SP_REGNUM = 1;
   static const unsigned SR_REGNUM = 2;
@@ -188,6 +224,9 @@ class Msp430Cpu : public sc_core::sc_module, tlm::tlm_bw_transport_if<> {
   bool m_sleeping{false};    //! Indicate whether cpu is sleeping
   bool m_doStep{false};      //! Set to 1 to single-step, cleared automatically.
   uint64_t m_idleCycles{0};  //! Total number of idle cycles (for logging)
+  uint64_t m_instructionCount{0};  //! Instructions executed (for logging)
+  uint64_t m_cycleCount{0};        //! Active cycles (for logging)
+  InstructionFetchExtension m_fetchExtension;  //! Tags instruction fetches
 
   /* Event and state ids for power modelling */
   int m_idleCyclesEventId{-1};
@@ -203,10 +242,17 @@ class Msp430Cpu : public sc_core::sc_module, tlm::tlm_bw_transport_if<> {
 
   std::array<uint32_t, 16> m_cpuRegs;
 
-  std::unordered_set<unsigned> m_breakpoints;  //! Set of breakpoint addresses
+  BreakpointMap m_breakpoints{0, 0x100000};  //! Breakpoint addresses
+
+  //! Binary trace of instructions & interrupts, see InstructionTrace.hpp
+  std::unique_ptr<InstructionTrace> m_trace;
+  bool m_tracing{false};  //! Trace enabled and trace window open
+
+  //! Per-PC energy profiler, only constructed if enabled
+  std::unique_ptr<EnergyProfiler> m_energyProfiler;
 
-  std::ofstream m_opsLogFile;    //! Log file (logs CPU op mode)
-  std::ofstream m_instrLogFile;  //! Log file (executed instructions)
+  //! Executed instruction bitmap, only constructed if enabled
+  std::unique_ptr<Coverage> m_coverage;
 
   /* ------ Private methods ------ */
 
@@ -218,8 +264,15 @@ class Msp430Cpu : public sc_core::sc_module, tlm::tlm_bw_transport_if<> {
   /**
    * @brief Msp430Cpu::processInterrupt Respond to an interrupt request and
    * call the corresponding interrupt routine.
+   * @param irqIdx index of the interrupt source
    */
-  void processInterrupt(void);
+  void processInterrupt(const unsigned irqIdx);
+
+  /**
+   * @brief updateTracing check whether the trace window is open, and
+   * resynchronise the trace when recording resumes after a closed window.
+   */
+  void updateTracing();
 
   /**
    * @brief handleBreakpoints Check if current PC matches any breakpoint.
@@ -482,4 +535,15 @@ class Msp430Cpu : public sc_core::sc_module, tlm::tlm_bw_transport_if<> {
    * debugger).
    */
   void waitForCommand();
+
+  /**
+   * @brief wait sc_module::wait, charging the suspended time of the CPU thread
+   * to the profiler's kernel zone and counting the resumption as an activation.
+   */
+  template <typename... Args>
+  void wait(const Args &... args) {
+    const unsigned zone = Profiler::switchTo(Profiler::OTHER_ZONE);
+    sc_core::sc_module::wait(args...);
+    Profiler::activate(zone);
+  }
 };
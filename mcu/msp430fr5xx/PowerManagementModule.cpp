@@ -36,8 +36,13 @@ PowerManagementModule::PowerManagementModule(sc_module_name name,
     : BusTarget(name, startAddress, endAddress),
       m_bootCurrentState(
           std::make_shared<BootCurrentState>("bootCurrentState")) {
+  setCheckpointStage(Stage::Power);
   m_vOn = Config::get().getDouble("PMMOn");
   m_vOff = Config::get().getDouble("PMMOff");
+  Config::get().addListener(
+      "PMMOn", [this](const std::string &v) { m_vOn = std::stod(v); });
+  Config::get().addListener(
+      "PMMOff", [this](const std::string &v) { m_vOff = std::stod(v); });
   m_vMax = Config::get().getDouble("VMAX");
 
   m_powerOnResetCount = 0;
@@ -71,6 +76,23 @@ void PowerManagementModule::end_of_elaboration() {
   SC_THREAD(process);
 }
 
+void PowerManagementModule::saveState(CheckpointWriter &writer) const {
+  BusTarget::saveState(writer);
+  writer.write(m_locked);
+  writer.write(m_isOn);
+  writer.write(m_powerOnResetCount);
+  writer.write(static_cast<uint64_t>(m_bootCurrentTraceIdx));
+}
+
+void PowerManagementModule::restoreState(CheckpointReader &reader) {
+  BusTarget::restoreState(reader);
+  reader.read(m_locked);
+  reader.read(m_isOn);
+  reader.read(m_powerOnResetCount);
+  m_bootCurrentTraceIdx = reader.read<uint64_t>();
+  pwrGood.write(m_isOn);
+}
+
 void PowerManagementModule::reset(void) {
   // Reset registers to their default values
   m_regs.reset();
@@ -96,11 +118,14 @@ void PowerManagementModule::process(void) {
     } else {
       // CPU is off, wait for supply to recover
       if (crntVcc > m_vOn) {
-        // Replay boot-current trace
-        for (const auto &v : m_bootCurrentTrace) {
-          m_bootCurrentState->setCurrent(v);
+        // Replay boot-current trace (resumes from a restored position)
+        for (; m_bootCurrentTraceIdx < m_bootCurrentTrace.size();
+             ++m_bootCurrentTraceIdx) {
+          m_bootCurrentState->setCurrent(
+              m_bootCurrentTrace[m_bootCurrentTraceIdx]);
           wait(sc_time::from_seconds(m_bootCurrentTimeResolution));
         }
+        m_bootCurrentTraceIdx = 0;
         m_bootCurrentState->setCurrent(0.0);
 
         m_isOn = true;
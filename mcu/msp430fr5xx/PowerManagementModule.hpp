@@ -50,6 +50,17 @@ class PowerManagementModule : public BusTarget {
    */
   unsigned getPowerOnResetCount() const { return m_powerOnResetCount; }
 
+  /**
+   * @brief saveState checkpoint registers and power state
+   */
+  virtual void saveState(CheckpointWriter &writer) const override;
+
+  /**
+   * @brief restoreState restore registers and power state, and drive pwrGood
+   * accordingly. Restored before other modules (Stage::Power).
+   */
+  virtual void restoreState(CheckpointReader &reader) override;
+
  private:
   /* ------ Internal classes ------ */
 
@@ -88,6 +99,7 @@ class PowerManagementModule : public BusTarget {
   unsigned m_powerOnResetCount;
 
   std::vector<double> m_bootCurrentTrace;  // Trace of boot current
+  size_t m_bootCurrentTraceIdx{0};         // Replay position in boot trace
   double m_bootCurrentTimeResolution;
 
   /* ------ Private methods ------ */
@@ -14,6 +14,8 @@
 #include "mcu/msp430fr5xx/TimerA.hpp"
 #include "ps/ConstantEnergyEvent.hpp"
 #include "utilities/Config.hpp"
+#include "utilities/Logging.hpp"
+#include "utilities/Profiler.hpp"
 #include "utilities/Utilities.hpp"
 
 extern "C" {
@@ -81,7 +83,20 @@ void TimerA::end_of_elaboration() {
 
 void TimerA::reset(void) { m_regs.reset(); }
 
+void TimerA::saveState(CheckpointWriter &writer) const {
+  BusTarget::saveState(writer);
+  writer.write(direction);
+}
+
+void TimerA::restoreState(CheckpointReader &reader) {
+  BusTarget::restoreState(reader);
+  reader.read(direction);
+  sourceChangeEvent.notify(SC_ZERO_TIME);
+  m_writeEvent.notify(SC_ZERO_TIME);  // Restart if stopped
+}
+
 void TimerA::process(void) {
+  FUSED_PROFILE("TimerA::process");
   if (pwrOn.read()) {
     // Operation
     bool stopped;
@@ -155,8 +170,8 @@ void TimerA::process(void) {
     if (!irqEnabled && (m_regs.read(OFS_TA1CTL) & TAIFG)) {
       dmaTrigger.write(true);
       m_regs.clearBitMask(OFS_TA1CTL, TAIFG);  // Auto-cleared
-      spdlog::info("{}: @{:s} DMA trigger", this->name(),
-                   sc_time_stamp().to_string());
+      FUSED_LOG(TimerA, INFO, "{}: @{:s} DMA trigger", this->name(),
+                sc_time_stamp().to_string());
     } else {
       dmaTrigger.write(false);
     }
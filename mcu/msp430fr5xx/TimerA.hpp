@@ -54,6 +54,16 @@ class TimerA : public BusTarget {
    */
   virtual void end_of_elaboration() override;
 
+  /**
+   * @brief saveState checkpoint registers and counting direction
+   */
+  virtual void saveState(CheckpointWriter &writer) const override;
+
+  /**
+   * @brief restoreState restore registers and re-select the clock source
+   */
+  virtual void restoreState(CheckpointReader &reader) override;
+
  public:
   /*------ Internal signals/channels ------*/
   sc_signal<int> clkDivAmount{"aclkDivAmount",
@@ -6,10 +6,12 @@
  */
 
 #include <stdio.h>
+#include <algorithm>
 #include <systemc>
 #include "mcu/SpiTransactionExtension.hpp"
 #include "mcu/msp430fr5xx/eUSCI_B.hpp"
 #include "utilities/Config.hpp"
+#include "utilities/Logging.hpp"
 
 extern "C" {
 #include "mcu/msp430fr5xx/device_includes/msp430fr5994.h"
@@ -34,6 +36,12 @@ eUSCI_B::eUSCI_B(sc_module_name name, const uint16_t startAddress,
     }
   }
 
+  m_burstTransfers = Config::get().contains("SpiBurstTransfers") &&
+                     Config::get().getBool("SpiBurstTransfers");
+  if (Config::get().contains("SpiBurstLength")) {
+    m_burstLength = std::max(1u, Config::get().getUint("SpiBurstLength"));
+  }
+
   SC_METHOD(reset);
   sensitive << pwrOn;
 
@@ -72,6 +80,17 @@ void eUSCI_B::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay) {
         // Transmit Buffer Register
         // Transmission starts after write.
         // UCTXIFG reset.
+        if (m_burstTransfers) {
+          if (m_txQueue.size() < m_burstLength) {
+            m_txQueue.push_back(m_regs.read(OFS_UCB0TXBUF));
+          } else {  // Written while TXIFG was clear, overwrites TXBUF
+            m_txQueue.back() = m_regs.read(OFS_UCB0TXBUF);
+          }
+          // Back-pressure: TXBUF is not free again until the burst is sent
+          if (m_txQueue.size() >= m_burstLength) {
+            m_regs.write(OFS_UCB0IFG, m_regs.read(OFS_UCB0IFG) & ~UCTXIFG);
+          }
+        }
         m_euscibTxEvent.notify();
         break;
       case OFS_UCB0IE:
@@ -97,6 +116,12 @@ void eUSCI_B::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay) {
       case OFS_UCB0RXBUF:
         // Reading from the RX buffer clears UCRXIFG and UCOE.
         m_regs.write(OFS_UCB0IFG, m_regs.read(OFS_UCB0IFG) & ~UCRXIFG);
+        // Present the next byte received in a burst
+        if (!m_rxQueue.empty()) {
+          m_regs.write(OFS_UCB0RXBUF, m_rxQueue.front());
+          m_rxQueue.pop_front();
+          m_regs.write(OFS_UCB0IFG, m_regs.read(OFS_UCB0IFG) | UCRXIFG);
+        }
         break;
       case OFS_UCB0IV:
         if (m_regs.read(OFS_UCB0IFG) & UCRXIFG) {
@@ -114,6 +139,8 @@ void eUSCI_B::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay) {
 void eUSCI_B::reset(void) {
   if (pwrOn.read()) {  // Posedge of pwrOn
     m_regs.reset();
+    m_txQueue.clear();
+    m_rxQueue.clear();
   }
 }
 
@@ -122,6 +149,23 @@ void eUSCI_B::swreset(void) {
     // Reset register file
     m_regs.write(OFS_UCB0IE, 0x0000);
     m_regs.write(OFS_UCB0IFG, 0x0002);
+    m_txQueue.clear();
+    m_rxQueue.clear();
+  }
+}
+
+void eUSCI_B::saveState(CheckpointWriter &writer) const {
+  BusTarget::saveState(writer);
+  writer.writeVector(m_txQueue);
+  writer.writeContainer(m_rxQueue);
+}
+
+void eUSCI_B::restoreState(CheckpointReader &reader) {
+  BusTarget::restoreState(reader);
+  reader.readVector(m_txQueue);
+  reader.readContainer(m_rxQueue);
+  if (!m_txQueue.empty()) {
+    m_euscibTxEvent.notify(SC_ZERO_TIME);  // Resume queued burst
   }
 }
 
@@ -148,8 +192,7 @@ void eUSCI_B::process(void) {
   tlm::tlm_generic_payload trans;
   auto *spiExtension = new SpiTransactionExtension();
   trans.set_extension(spiExtension);
-  trans.set_address(0);      // SPI doesn't use address
-  trans.set_data_length(1);  // Transfer size up to 1 byte
+  trans.set_address(0);  // SPI doesn't use address
 
   wait(SC_ZERO_TIME);  // Wait for sim to start
 
@@ -157,10 +200,18 @@ void eUSCI_B::process(void) {
     if (pwrOn.read() == false) {
       wait(pwrOn.posedge_event());
     }
-    wait(m_euscibTxEvent);
+    if (m_burstTransfers) {
+      // TXBUF is free as soon as its byte is queued, so TXIFG stays set
+      // until the queue is full
+      while (m_txQueue.empty()) {
+        wait(m_euscibTxEvent);
+      }
+    } else {
+      wait(m_euscibTxEvent);
 
-    // Clear the TXIFG flag
-    m_regs.write(OFS_UCB0IFG, m_regs.read(OFS_UCB0IFG) & ~(UCTXIFG));
+      // Clear the TXIFG flag
+      m_regs.write(OFS_UCB0IFG, m_regs.read(OFS_UCB0IFG) & ~(UCTXIFG));
+    }
     // Set the eUSCI busy flag
     m_regs.write(OFS_UCB0STATW, m_regs.read(OFS_UCB0STATW) | UCBUSY);
 
@@ -184,10 +235,23 @@ void eUSCI_B::process(void) {
         (spiParameters & UCMSB)
             ? SpiTransactionExtension::SpiBitOrder::MSB_FIRST
             : SpiTransactionExtension::SpiBitOrder::LSB_FIRST;
-    sc_time delay = spiExtension->transferTime();
 
     trans.set_command(tlm::TLM_WRITE_COMMAND);
-    trans.set_data_ptr(&data);
+    sc_time delay;
+    if (m_burstTransfers) {
+      // Ship all queued bytes in a single transaction. Bytes written while
+      // it is shifted out queue up without waking this thread, and make up
+      // the next burst.
+      m_burstBuffer.swap(m_txQueue);
+      m_txQueue.clear();
+      trans.set_data_ptr(m_burstBuffer.data());
+      trans.set_data_length(m_burstBuffer.size());
+      delay = spiExtension->transferTime(m_burstBuffer.size());
+    } else {
+      trans.set_data_ptr(&data);
+      trans.set_data_length(1);  // Transfer size up to 1 byte
+      delay = spiExtension->transferTime(1);
+    }
     trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
 
     // Blocking transport call
@@ -201,9 +265,25 @@ void eUSCI_B::process(void) {
     wait(delay);
 
     // Received payload in RXBUF
-    m_regs.write(OFS_UCB0RXBUF, spiExtension->response);
-    spdlog::info("{:s}: @{:s} spi received: {}", this->name(),
-                 sc_time_stamp().to_string(), spiExtension->response);
+    if (m_burstTransfers) {
+      if (m_burstBuffer.size() > 1) {  // Burst response is in the data buffer
+        m_rxQueue.insert(m_rxQueue.end(), m_burstBuffer.begin(),
+                         m_burstBuffer.end());
+      } else {
+        m_rxQueue.push_back(spiExtension->response);
+      }
+      if (!(m_regs.read(OFS_UCB0IFG) & UCRXIFG)) {
+        m_regs.write(OFS_UCB0RXBUF, m_rxQueue.front());
+        m_rxQueue.pop_front();
+      }
+      FUSED_LOG(eUSCI_B, INFO, "{:s}: @{:s} spi burst of {:d} bytes",
+                this->name(), sc_time_stamp().to_string(),
+                m_burstBuffer.size());
+    } else {
+      m_regs.write(OFS_UCB0RXBUF, spiExtension->response);
+      FUSED_LOG(eUSCI_B, INFO, "{:s}: @{:s} spi received: {}", this->name(),
+                sc_time_stamp().to_string(), spiExtension->response);
+    }
 
     // Tx Done, Rx Done; Set Interrupt Flags
     m_regs.write(OFS_UCB0IFG, m_regs.read(OFS_UCB0IFG) | UCTXIFG | UCRXIFG);
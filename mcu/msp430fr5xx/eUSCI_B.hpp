@@ -9,8 +9,10 @@
 
 #include <tlm_utils/simple_initiator_socket.h>
 
+#include <deque>
 #include <systemc>
 #include <tlm>
+#include <vector>
 
 #include "mcu/BusTarget.hpp"
 #include "mcu/ClockSourceIf.hpp"
@@ -19,6 +21,15 @@
 /**
  * @brief The eUSCI_B class Modelling operation of eUSCI_Bn
  * serial communication module (SPI/I2C)
+ *
+ * When the "SpiBurstTransfers" config option is set, bytes written to TXBUF
+ * while a transfer is in progress are queued rather than overwritten, and all
+ * queued bytes are shipped as a single burst transaction. A burst starts as
+ * soon as the module is idle and holds all bytes queued by then, so bytes
+ * written during a burst make up the next one, i.e. one thread wakeup per
+ * burst rather than per byte. The queue holds up to "SpiBurstLength" bytes,
+ * and TXIFG is cleared while it is full. The received bytes are queued, and presented in
+ * RXBUF one at a time as RXBUF is read.
  */
 class eUSCI_B : public BusTarget {
   SC_HAS_PROCESS(eUSCI_B);
@@ -65,11 +76,26 @@ class eUSCI_B : public BusTarget {
    */
   virtual void swreset(void);
 
+  /**
+   * @brief saveState checkpoint registers and burst queues
+   */
+  virtual void saveState(CheckpointWriter &writer) const override;
+
+  /**
+   * @brief restoreState restore registers and burst queues
+   */
+  virtual void restoreState(CheckpointReader &reader) override;
+
  private:
   /* ------ Private variables ------ */
   sc_core::sc_event m_euscibTxEvent{"euscibTxEvent"};
   sc_core::sc_event m_euscibRxEvent{"euscibRxEvent"};
   sc_core::sc_event m_dmaTriggerEvent{"dmaTriggeredEvent"};
+  bool m_burstTransfers{false};
+  unsigned m_burstLength{16};      //! Max. bytes per burst
+  std::vector<uint8_t> m_txQueue;  //! Bytes waiting for a burst transfer
+  std::deque<uint8_t> m_rxQueue;   //! Received bytes not yet in RXBUF
+  std::vector<uint8_t> m_burstBuffer;  //! Payload of the current burst
   /* ------ Private methods ------ */
 
   /**
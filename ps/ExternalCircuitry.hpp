@@ -11,7 +11,9 @@
 #include <string>
 #include <systemc-ams>
 #include <systemc>
+#include "utilities/Checkpoint.hpp"
 #include "utilities/Config.hpp"
+#include "utilities/Profiler.hpp"
 
 // Load switch with voltage detector and override input.
 // Consumes ext.dc uA  internally
@@ -32,6 +34,7 @@ SCA_TDF_MODULE(VoltageDetectorWithOverride) {
   void initialize(){};
 
   void processing() {
+    FUSED_PROFILE("AMS cluster");
     double crnt_v_in = v_in.read();
     if (forceOn.read() || (crnt_v_in > m_vOn) ||
         ((crnt_v_in > m_vOff) && m_isOn)) {
@@ -55,8 +58,24 @@ SCA_TDF_MODULE(VoltageDetectorWithOverride) {
     m_vOff = Config::get().getDouble("SVSVoff");
     m_icc = Config::get().getDouble("ext.dc");
     m_vWarn = Config::get().getDouble("VoltageWarning");
+
+    // Thresholds can be changed at run-time, e.g. by ensemble members
+    auto &config = Config::get();
+    config.addListener("SVSVon",
+                       [this](const std::string &v) { m_vOn = std::stod(v); });
+    config.addListener("SVSVoff",
+                       [this](const std::string &v) { m_vOff = std::stod(v); });
+    config.addListener("ext.dc",
+                       [this](const std::string &v) { m_icc = std::stod(v); });
+    config.addListener(
+        "VoltageWarning",
+        [this](const std::string &v) { m_vWarn = std::stod(v); });
   };
 
+  void saveState(CheckpointWriter &writer) const { writer.write(m_isOn); }
+
+  void restoreState(CheckpointReader &reader) { reader.read(m_isOn); }
+
  private:
   double m_vOn;    // On-threshold [V]
   double m_vOff;   // Off-threshold [V]
@@ -81,6 +100,7 @@ SCA_TDF_MODULE(CapacitorIdeal) {
   };
 
   void processing() {
+    FUSED_PROFILE("AMS cluster");
     m_crntVoltage += m_timestep * (i_in.read() - i_out.read()) / m_capacitance;
     if (m_crntVoltage <= 0) {
         m_crntVoltage = 0;
@@ -93,8 +113,20 @@ SCA_TDF_MODULE(CapacitorIdeal) {
   SCA_CTOR(CapacitorIdeal) {
     m_capacitance = Config::get().getDouble("CapacitorValue");
     m_crntVoltage = Config::get().getDouble("CapacitorInitialVoltage");
+    Config::get().addListener("CapacitorValue", [this](const std::string &v) {
+      m_capacitance = std::stod(v);
+    });
   };
 
+  void saveState(CheckpointWriter &writer) const {
+    writer.write(m_crntVoltage);
+  }
+
+  void restoreState(CheckpointReader &reader) { reader.read(m_crntVoltage); }
+
+  //! Voltage at the last TDF timestep
+  double getVoltage() const { return m_crntVoltage; }
+
  private:
   double m_capacitance;
   double m_crntVoltage;
@@ -113,6 +145,7 @@ SCA_TDF_MODULE(ConstantCurrentSupplyTDF) {
   void initialize(){};
 
   void processing() {
+    FUSED_PROFILE("AMS cluster");
     if ((v.read() + m_maxStepSize) < m_voltageLimit) {
       i.write(m_currentSetpoint);
     } else {
@@ -228,11 +261,13 @@ SCA_TDF_MODULE(VoltageTraceReplayTDF) {
 
   void set_attributes() { set_timestep(m_timestep); }
 
-  void initialize() {
-    m_timeElapsed = 0.0; // Initialize the elapsed time
-  }
+  // m_timeElapsed & m_traceIndex are set by the constructor, not in
+  // initialize(), so a checkpoint restored before the first TDF step keeps
+  // its position in the trace.
+  void initialize() {}
 
   void processing() {
+    FUSED_PROFILE("AMS cluster");
     // Update elapsed time
     m_timeElapsed += m_timestep.to_seconds();
 
@@ -274,10 +309,41 @@ SCA_TDF_MODULE(VoltageTraceReplayTDF) {
     readTraceFile(m_traceFile);
     m_traceIndex = 0;
     m_timeElapsed = 0.0;  // Initialize the time elapsed
+
+    // Supply parameters can be changed at run-time, e.g. by ensemble members
+    auto &config = Config::get();
+    config.addListener("SupplyCurrentLimit", [this](const std::string &v) {
+      m_currentSetpoint = std::stod(v);
+      updateMaxStepSize();
+    });
+    config.addListener("SupplyVoltageLimit", [this](const std::string &v) {
+      m_voltageLimit = std::stod(v);
+    });
+    config.addListener("LoadResistance", [this](const std::string &v) {
+      m_loadResistance = std::stod(v);
+    });
+    config.addListener("CapacitorValue",
+                       [this](const std::string &) { updateMaxStepSize(); });
   };
 
+  void saveState(CheckpointWriter &writer) const {
+    writer.write(m_traceIndex);
+    writer.write(m_timeElapsed);
+  }
+
+  void restoreState(CheckpointReader &reader) {
+    reader.read(m_traceIndex);
+    reader.read(m_timeElapsed);
+  }
+
 private:
 
+  void updateMaxStepSize() {
+    m_maxStepSize =
+        m_timestep.to_seconds() *
+        (m_currentSetpoint / Config::get().getDouble("CapacitorValue"));
+  }
+
   void readTraceFile(std::string path) {
     std::ifstream file(path);
     if (!file.is_open()) {
@@ -310,7 +376,8 @@ private:
 };
 
 
-SC_MODULE(ExternalCircuitry) {
+class ExternalCircuitry : public sc_core::sc_module, public Checkpointable {
+ public:
   sc_core::sc_in<bool> keepAlive{"keepAlive"};
   sc_core::sc_in<double> i_out{"i_out"};
 
@@ -337,8 +404,29 @@ SC_MODULE(ExternalCircuitry) {
     svs.v_out(vcc);
     svs.v_warn(v_warn);
     svs.forceOn(keepAlive);
+
+    registerCheckpointable(this->name(), Stage::Power);
+  }
+
+  //! Checkpoint capacitor voltage, supply-trace position and SVS state
+  virtual void saveState(CheckpointWriter &writer) const override {
+    supply.saveState(writer);
+    c.saveState(writer);
+    svs.saveState(writer);
   }
 
+  virtual void restoreState(CheckpointReader &reader) override {
+    supply.restoreState(reader);
+    c.restoreState(reader);
+    svs.restoreState(reader);
+  }
+
+  /**
+   * @brief getCapacitorVoltage get the capacitor voltage at the last TDF
+   * timestep, e.g. for monitoring from the discrete-event domain.
+   */
+  double getCapacitorVoltage() const { return c.getVoltage(); }
+
   // Signals
   sca_tdf::sca_signal<double> i_in_svs{"i_in_svs"};
   sca_tdf::sca_signal<double> i_supply{"i_supply"};
@@ -10,6 +10,7 @@
 #include <systemc-ams>
 #include <systemc>
 #include "ps/PowerModelChannelIf.hpp"
+#include "utilities/Profiler.hpp"
 
 /**
  * @brief PowerModelBridge bridge between PowerModelChannel and sc_signals
@@ -28,6 +29,7 @@ SC_MODULE(PowerModelBridge) {
   }
 
   void process() {
+    FUSED_PROFILE("PowerModelBridge::process");
     if (v_in.read() <= 0.0) {
       i_out.write(0.0);
       return;
@@ -35,6 +37,7 @@ SC_MODULE(PowerModelBridge) {
     const double timestep =
         (sc_core::sc_time_stamp() - m_lastReadTime).to_seconds();
     m_lastReadTime = sc_core::sc_time_stamp();
+    powerModelPort->accountStaticEnergy(v_in.read(), timestep);
 
     // Dynamic current = E/(v*ts)
     const double dynamicCurrent =
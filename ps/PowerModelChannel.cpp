@@ -17,6 +17,8 @@
 #include <vector>
 #include "ps/PowerModelChannel.hpp"
 #include "ps/PowerModelEventBase.hpp"
+#include "utilities/Profiler.hpp"
+#include "utilities/TraceWindow.hpp"
 
 using namespace sc_core;
 
@@ -39,6 +41,7 @@ PowerModelChannel::PowerModelChannel(const sc_module_name name,
               .c_str());
     }
   }
+  registerCheckpointable(this->name());
   SC_HAS_PROCESS(PowerModelChannel);
   SC_THREAD(logLoop);
 }
@@ -64,6 +67,7 @@ int PowerModelChannel::registerEvent(
     moduleId = m_moduleNames.size();
     m_moduleNames.push_back(moduleName);
     m_currentStates.push_back(-1);
+    m_stateEnteredTime.push_back(SC_ZERO_TIME);
   } else {
     // This is *not* the first event registration for this module
     // Check if event name already registered for the specified module name
@@ -84,6 +88,8 @@ int PowerModelChannel::registerEvent(
   const int id = m_events.size();
   m_events.emplace_back(std::move(eventPtr), moduleId);
   m_eventRates.push_back(0);
+  m_eventTotalCounts.push_back(0);
+  m_eventTotalEnergy.push_back(0.0);
   sc_assert(m_events.size() == m_eventRates.size());
   return id;
 }
@@ -107,6 +113,7 @@ int PowerModelChannel::registerState(
     moduleId = m_moduleNames.size();
     m_moduleNames.push_back(moduleName);
     m_currentStates.push_back(-1);
+    m_stateEnteredTime.push_back(SC_ZERO_TIME);
   } else {
     // This is *not* the first state registration for this module
     // Check if state name already registered for the specified module name
@@ -126,6 +133,8 @@ int PowerModelChannel::registerState(
   // Add state to m_states
   const int id = m_states.size();
   m_states.emplace_back(std::move(statePtr), moduleId);
+  m_stateTotalEnergy.push_back(0.0);
+  m_stateTotalTime.push_back(SC_ZERO_TIME);
 
   // Set default state to first state registered for this module
   if (m_currentStates[moduleId] == -1) {
@@ -145,7 +154,14 @@ void PowerModelChannel::reportEvent(const int eventId, const int n) {
   sc_assert(eventId >= 0 && eventId < m_log.back().size());
 
   m_eventRates[eventId] += n;
-  m_log.back()[eventId] += n;
+  if (TraceWindow::isOpen()) {
+    m_log.back()[eventId] += n;
+  }
+  if (m_doAttribution &&
+      sc_get_current_process_handle() == m_attributedProcess) {
+    m_attributedEnergy +=
+        m_events[eventId].event->calculateEnergy(m_supplyVoltage) * n;
+  }
 }
 
 void PowerModelChannel::reportState(const int stateId) {
@@ -157,7 +173,14 @@ void PowerModelChannel::reportState(const int stateId) {
   }
   sc_assert(stateId >= 0 && stateId < m_states.size());
   const auto mid = m_states[stateId].moduleId;
-  m_currentStates[mid] = stateId;
+  if (m_currentStates[mid] != stateId) {
+    const auto now = sc_time_stamp();
+    if (m_currentStates[mid] >= 0) {
+      m_stateTotalTime[m_currentStates[mid]] += now - m_stateEnteredTime[mid];
+    }
+    m_stateEnteredTime[mid] = now;
+    m_currentStates[mid] = stateId;
+  }
 }
 
 int PowerModelChannel::popEventCount(const int eventId) {
@@ -169,8 +192,12 @@ int PowerModelChannel::popEventCount(const int eventId) {
 
 double PowerModelChannel::popEventEnergy(const int eventId) {
   sc_assert(eventId >= 0 && eventId < m_log.back().size());
-  return m_events[eventId].event->calculateEnergy(m_supplyVoltage) *
-         popEventCount(eventId);
+  const auto n = popEventCount(eventId);
+  const auto energy =
+      m_events[eventId].event->calculateEnergy(m_supplyVoltage) * n;
+  m_eventTotalCounts[eventId] += n;
+  m_eventTotalEnergy[eventId] += energy;
+  return energy;
 }
 
 double PowerModelChannel::popDynamicEnergy() {
@@ -192,6 +219,145 @@ double PowerModelChannel::getStaticCurrent() {
       });
 }
 
+void PowerModelChannel::accountStaticEnergy(const double supplyVoltage,
+                                            const double timestep) {
+  for (const auto stateId : m_currentStates) {
+    if (stateId >= 0) {
+      m_stateTotalEnergy[stateId] +=
+          m_states[stateId].state->calculateCurrent(supplyVoltage) *
+          supplyVoltage * timestep;
+    }
+  }
+}
+
+double PowerModelChannel::getStateTime(const std::string &moduleName,
+                                       const std::string &stateName) const {
+  for (int i = 0; i < m_states.size(); ++i) {
+    const auto mid = m_states[i].moduleId;
+    if (m_moduleNames[mid] == moduleName &&
+        m_states[i].state->name == stateName) {
+      auto t = m_stateTotalTime[i];
+      if (m_currentStates[mid] == i) {
+        t += sc_time_stamp() - m_stateEnteredTime[mid];
+      }
+      return t.to_seconds();
+    }
+  }
+  return 0.0;
+}
+
+std::string PowerModelChannel::getCurrentState(
+    const std::string &moduleName) const {
+  for (int m = 0; m < m_moduleNames.size(); ++m) {
+    if (m_moduleNames[m] == moduleName && m_currentStates[m] >= 0) {
+      return m_states[m_currentStates[m]].state->name;
+    }
+  }
+  return "";
+}
+
+void PowerModelChannel::getTotals(std::vector<uint64_t> &eventCounts,
+                                  std::vector<double> &eventEnergy,
+                                  std::vector<double> &stateEnergy) const {
+  eventCounts.resize(m_events.size());
+  eventEnergy.resize(m_events.size());
+  for (int i = 0; i < m_events.size(); ++i) {
+    eventCounts[i] = m_eventTotalCounts[i] + m_eventRates[i];
+    eventEnergy[i] =
+        m_eventTotalEnergy[i] +
+        m_events[i].event->calculateEnergy(m_supplyVoltage) * m_eventRates[i];
+  }
+  stateEnergy = m_stateTotalEnergy;
+}
+
+std::string PowerModelChannel::getEventName(const int eventId) const {
+  sc_assert(eventId >= 0 && eventId < m_events.size());
+  return m_moduleNames[m_events[eventId].moduleId] + " " +
+         m_events[eventId].event->name;
+}
+
+std::string PowerModelChannel::getStateName(const int stateId) const {
+  sc_assert(stateId >= 0 && stateId < m_states.size());
+  return m_moduleNames[m_states[stateId].moduleId] + " " +
+         m_states[stateId].state->name;
+}
+
+void PowerModelChannel::getModuleEnergy(std::vector<double> &energy) const {
+  energy.assign(m_moduleNames.size(), 0.0);
+  for (int i = 0; i < m_events.size(); ++i) {
+    energy[m_events[i].moduleId] +=
+        m_eventTotalEnergy[i] +
+        m_events[i].event->calculateEnergy(m_supplyVoltage) * m_eventRates[i];
+  }
+  for (int i = 0; i < m_states.size(); ++i) {
+    energy[m_states[i].moduleId] += m_stateTotalEnergy[i];
+  }
+}
+
+std::string PowerModelChannel::getModuleName(const int moduleId) const {
+  sc_assert(moduleId >= 0 && moduleId < m_moduleNames.size());
+  return m_moduleNames[moduleId];
+}
+
+double PowerModelChannel::getTotalEnergy() const {
+  std::vector<uint64_t> eventCounts;
+  std::vector<double> eventEnergy, stateEnergy;
+  getTotals(eventCounts, eventEnergy, stateEnergy);
+  return std::accumulate(eventEnergy.begin(), eventEnergy.end(), 0.0) +
+         std::accumulate(stateEnergy.begin(), stateEnergy.end(), 0.0);
+}
+
+void PowerModelChannel::writeSummary(std::ostream &os,
+                                     const std::string &indent) const {
+  const auto in2 = indent + "  ";
+  const auto in3 = in2 + "  ";
+  double totalEnergy = 0.0;
+
+  // Including events that are still pending
+  std::vector<uint64_t> eventCounts;
+  std::vector<double> eventEnergy, stateEnergy;
+  getTotals(eventCounts, eventEnergy, stateEnergy);
+
+  os << "{\n" << indent << "\"modules\": {";
+  for (int m = 0; m < m_moduleNames.size(); ++m) {
+    double moduleEnergy = 0.0;
+    std::vector<std::string> events;
+    for (int i = 0; i < m_events.size(); ++i) {
+      if (m_events[i].moduleId == m) {
+        moduleEnergy += eventEnergy[i];
+        events.push_back(fmt::format(
+            "\"{:s}\": {{\"count\": {:d}, \"energy\": {:g}}}",
+            m_events[i].event->name, eventCounts[i], eventEnergy[i]));
+      }
+    }
+    std::vector<std::string> states;
+    for (int i = 0; i < m_states.size(); ++i) {
+      if (m_states[i].moduleId == m) {
+        moduleEnergy += stateEnergy[i];
+        states.push_back(fmt::format(
+            "\"{:s}\": {{\"time\": {:g}, \"energy\": {:g}}}",
+            m_states[i].state->name,
+            getStateTime(m_moduleNames[m], m_states[i].state->name),
+            stateEnergy[i]));
+      }
+    }
+    totalEnergy += moduleEnergy;
+
+    os << (m == 0 ? "\n" : ",\n") << in2 << "\"" << m_moduleNames[m]
+       << "\": {\n"
+       << in3 << "\"energy\": " << fmt::format("{:g}", moduleEnergy) << ",\n"
+       << in3 << "\"events\": {" << fmt::format("{}", fmt::join(events, ", "))
+       << "},\n"
+       << in3 << "\"states\": {" << fmt::format("{}", fmt::join(states, ", "))
+       << "}\n"
+       << in2 << "}";
+  }
+  os << "\n" << indent << "},\n";
+  os << indent << "\"total_energy\": " << fmt::format("{:g}", totalEnergy)
+     << "\n";
+  os << indent.substr(0, indent.size() >= 2 ? indent.size() - 2 : 0) << "}";
+}
+
 void PowerModelChannel::start_of_simulation() {
   // Initialize event log
   m_log.emplace_back(m_events.size() + 1, 0);
@@ -225,6 +391,11 @@ void PowerModelChannel::logLoop() {
   while (1) {
     // Wait for a timestep
     wait(m_logTimestep);
+    // Sleep while the trace window is closed, see TraceWindow.hpp
+    while (!TraceWindow::isOpen()) {
+      wait(TraceWindow::changedEvent());
+    }
+    FUSED_PROFILE("PowerModelChannel::logLoop");
 
     // Dump file when log exceeds threshold
     if (m_log.size() > m_logDumpThreshold) {
@@ -241,6 +412,9 @@ void PowerModelChannel::logLoop() {
 }
 
 void PowerModelChannel::dumpEventCsv() {
+  if (m_eventlogFileName == "none") {
+    return;
+  }
   std::ofstream f(m_eventlogFileName, std::ios::out | std::ios::app);
   if (f.tellp() == 0) {
     // Header
@@ -268,3 +442,23 @@ void PowerModelChannel::setSupplyVoltage(const double val) {
     m_supplyVoltageChangedEvent.notify(SC_ZERO_TIME);
   }
 }
+
+void PowerModelChannel::attributeEvents() {
+  m_attributedProcess = sc_get_current_process_handle();
+  m_doAttribution = m_attributedProcess.valid();
+}
+
+void PowerModelChannel::saveState(CheckpointWriter &writer) const {
+  writer.write(m_supplyVoltage);
+  writer.writeVector(m_eventRates);
+  writer.writeVector(m_currentStates);
+}
+
+void PowerModelChannel::restoreState(CheckpointReader &reader) {
+  setSupplyVoltage(reader.read<double>());
+  reader.expect(m_eventRates.size(), "number of power model events");
+  reader.readBlock(m_eventRates.data(), m_eventRates.size() * sizeof(int));
+  reader.expect(m_currentStates.size(), "number of power model modules");
+  reader.readBlock(m_currentStates.data(),
+                   m_currentStates.size() * sizeof(int));
+}
@@ -8,11 +8,13 @@
 #pragma once
 
 #include <memory>
+#include <ostream>
 #include <string>
 #include <systemc>
 #include <vector>
 #include "ps/PowerModelChannelIf.hpp"
 #include "ps/PowerModelEventBase.hpp"
+#include "utilities/Checkpoint.hpp"
 
 /**
  * class PowerModelChannel implementation of power model channel.  See
@@ -23,7 +25,8 @@
  */
 class PowerModelChannel : public virtual PowerModelChannelOutIf,
                           public virtual PowerModelChannelInIf,
-                          public sc_core::sc_module {
+                          public sc_core::sc_module,
+                          public Checkpointable {
  public:
   /* ------ Public methods ------ */
 
@@ -57,6 +60,9 @@ class PowerModelChannel : public virtual PowerModelChannelOutIf,
 
   virtual double getStaticCurrent() override;
 
+  virtual void accountStaticEnergy(const double supplyVoltage,
+                                   const double timestep) override;
+
   virtual const sc_core::sc_event& supplyVoltageChangedEvent() const override {
     return m_supplyVoltageChangedEvent;
   }
@@ -65,12 +71,62 @@ class PowerModelChannel : public virtual PowerModelChannelOutIf,
 
   virtual void setSupplyVoltage(double val) override;
 
+  virtual void attributeEvents() override;
+
+  virtual double getAttributedEnergy() const override {
+    return m_attributedEnergy;
+  }
+
+  virtual void getTotals(std::vector<uint64_t>& eventCounts,
+                         std::vector<double>& eventEnergy,
+                         std::vector<double>& stateEnergy) const override;
+
+  virtual std::string getEventName(const int eventId) const override;
+
+  virtual std::string getStateName(const int stateId) const override;
+
+  virtual void getModuleEnergy(std::vector<double>& energy) const override;
+
+  virtual std::string getModuleName(const int moduleId) const override;
+
+  virtual double getStateTime(const std::string& moduleName,
+                              const std::string& stateName) const override;
+
+  virtual std::string getCurrentState(
+      const std::string& moduleName) const override;
+
   /**
    * @brief start_of_simulation systemc callback. Used here to initialize the
    * internal event log.
    */
   virtual void start_of_simulation() override;
 
+  /**
+   * @brief getTotalEnergy get the total energy of all events and states.
+   * @retval energy in joules
+   */
+  double getTotalEnergy() const;
+
+  /**
+   * @brief writeSummary write the total energy per module, the count and
+   * energy of each event, and the time and energy of each state as a JSON
+   * object.
+   * @param os output stream
+   * @param indent indentation of the object's members
+   */
+  void writeSummary(std::ostream &os, const std::string &indent = "  ") const;
+
+  /**
+   * @brief saveState checkpoint supply voltage, event counts since the last
+   * pop and module states. The csv event log is not part of the checkpoint.
+   */
+  virtual void saveState(CheckpointWriter &writer) const override;
+
+  /**
+   * @brief restoreState restore supply voltage, event counts and module states
+   */
+  virtual void restoreState(CheckpointReader &reader) override;
+
  private:
   //! Supply voltage associated with this channel
   double m_supplyVoltage = 0.0;
@@ -116,6 +172,26 @@ class PowerModelChannel : public virtual PowerModelChannelOutIf,
   //! module. The index is the module id and the value is the state id.
   std::vector<int> m_currentStates;
 
+  // ------ Totals ------
+  //! Total count and energy of each event, updated when events are popped
+  std::vector<uint64_t> m_eventTotalCounts;
+  std::vector<double> m_eventTotalEnergy;
+
+  //! Total energy of each state, see accountStaticEnergy()
+  std::vector<double> m_stateTotalEnergy;
+
+  //! Total time in each state, excluding the current one of each module
+  std::vector<sc_core::sc_time> m_stateTotalTime;
+
+  //! Time at which each module entered its current state
+  std::vector<sc_core::sc_time> m_stateEnteredTime;
+
+  // ------ Attribution ------
+  //! Process whose reported events are attributed, see attributeEvents()
+  sc_core::sc_process_handle m_attributedProcess;
+  bool m_doAttribution{false};
+  double m_attributedEnergy{0.0};
+
   // ------ Logging ------
   std::string m_eventlogFileName;
 
@@ -7,8 +7,11 @@
 
 #pragma once
 
+#include <stdint.h>
 #include <memory>
+#include <string>
 #include <systemc>
+#include <vector>
 #include "ps/PowerModelEventBase.hpp"
 #include "ps/PowerModelStateBase.hpp"
 
@@ -89,6 +92,68 @@ class PowerModelChannelOutIf : public virtual sc_core::sc_interface {
    * supply voltage has changed.
    */
   virtual const sc_core::sc_event& supplyVoltageChangedEvent() const = 0;
+
+  /**
+   * @brief attributeEvents start accumulating the energy of events reported
+   * by the calling process (and by the modules it calls into), e.g. for
+   * profiling the energy caused by each instruction of a CPU thread.
+   */
+  virtual void attributeEvents() = 0;
+
+  /**
+   * @brief getAttributedEnergy get the energy of the events reported by the
+   * process registered with attributeEvents().
+   * @retval energy (J), at the supply voltage at the time of reporting.
+   */
+  virtual double getAttributedEnergy() const = 0;
+
+  /**
+   * @brief getTotals get the cumulative count and energy of each event, and
+   * the energy of each state, indexed by event/state id. Events not yet popped
+   * are included, at the current supply voltage. State energy is accounted
+   * every power model timestep.
+   */
+  virtual void getTotals(std::vector<uint64_t>& eventCounts,
+                         std::vector<double>& eventEnergy,
+                         std::vector<double>& stateEnergy) const = 0;
+
+  /**
+   * @brief getEventName get "<module> <event>" of an event id.
+   */
+  virtual std::string getEventName(const int eventId) const = 0;
+
+  /**
+   * @brief getStateName get "<module> <state>" of a state id.
+   */
+  virtual std::string getStateName(const int stateId) const = 0;
+
+  /**
+   * @brief getModuleEnergy get the cumulative energy of each module's events &
+   * states, indexed by module id (see getModuleName). Same accounting as
+   * getTotals.
+   */
+  virtual void getModuleEnergy(std::vector<double>& energy) const = 0;
+
+  /**
+   * @brief getModuleName get the name of a module id, as used for
+   * registerEvent/registerState.
+   */
+  virtual std::string getModuleName(const int moduleId) const = 0;
+
+  /**
+   * @brief getStateTime get the total time a module has spent in a state.
+   * @param moduleName name of the module, as used for registerState
+   * @param stateName name of the state
+   * @retval time in seconds, 0.0 if the state isn't registered.
+   */
+  virtual double getStateTime(const std::string& moduleName,
+                              const std::string& stateName) const = 0;
+
+  /**
+   * @brief getCurrentState get the name of a module's current state.
+   * @retval "" if the module hasn't reported a state
+   */
+  virtual std::string getCurrentState(const std::string& moduleName) const = 0;
 };
 
 /**
@@ -128,6 +193,15 @@ class PowerModelChannelInIf : public virtual sc_core::sc_interface {
    * */
   virtual double getStaticCurrent() = 0;
 
+  /**
+   * @brief accountStaticEnergy add the energy drawn by the current module
+   * states over a timestep to the channel's totals.
+   * @param supplyVoltage supply voltage over the timestep [V]
+   * @param timestep length of the timestep [s]
+   */
+  virtual void accountStaticEnergy(const double supplyVoltage,
+                                   const double timestep) = 0;
+
   /**
    * @brief setSupplyVoltage set the current supply voltage.
    * @param val current supply voltage in volts.
@@ -9,11 +9,12 @@
 #include <tuple>
 #include <vector>
 #include "libs/make_unique.hpp"
-#include "libs/strtk.hpp"
 #include "ps/ConstantCurrentState.hpp"
 #include "ps/ConstantEnergyEvent.hpp"
 #include "sd/Accelerometer.hpp"
+#include "utilities/Checkpoint.hpp"
 #include "utilities/Config.hpp"
+#include "utilities/SensorTrace.hpp"
 #include "utilities/Utilities.hpp"
 
 using namespace sc_core;
@@ -28,37 +29,26 @@ Accelerometer::Accelerometer(const sc_module_name name)
   m_regs.addRegister(RegisterAddress::DATA);
   m_regs.addRegister(RegisterAddress::FIFO_THR);
 
-  // Load sensor input trace
+  // Load sensor input trace, shared with other instances
   const bool validTraceFile =
       Config::get().contains("AccelerometerTraceFile")
           ? Config::get().getString("AccelerometerTraceFile") != "none"
           : false;
   if (validTraceFile) {
-    auto fn = Config::get().getString("AccelerometerTraceFile");
-    Utility::assertFileExists(fn);
-    std::ifstream file(fn);
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string content = buffer.str();
-
-    strtk::token_grid grid(content, content.size(), ",");
-    for (std::size_t i = 0; i < grid.row_count(); ++i) {
-      m_inputTrace.push_back({/*acc_x*/ grid.row(i).get<double>(1),
-                              /*acc_y*/ grid.row(i).get<double>(2),
-                              /*acc_z*/ grid.row(i).get<double>(3)});
-    }
-    m_inputTraceTimestep = sc_time(
-        1000 * (grid.row(1).get<double>(0) - grid.row(0).get<double>(0)),
-        SC_MS);
+    m_inputTrace = SensorTrace::load(
+        Config::get().getString("AccelerometerTraceFile"), 3);
   } else {  // No boot trace specified, set constant
-    m_inputTrace.push_back(InputTraceEntry{/*acc_x*/ 0.0,
-                                           /*acc_y*/ 0.0,
-                                           /*acc_z*/ 9.81});
-    m_inputTraceTimestep = sc_time(1000.0, SC_MS);
+    m_inputTrace = SensorTrace::constant({/*acc_x*/ 0.0,
+                                          /*acc_y*/ 0.0,
+                                          /*acc_z*/ 9.81});
   }
+  m_interpolateInput = Config::get().contains("SensorTraceInterpolate") &&
+                       Config::get().getBool("SensorTraceInterpolate");
 }
 
 void Accelerometer::end_of_elaboration() {
+  SpiDevice::end_of_elaboration();
+
   // Get event & state IDs
   m_sampleEventId = powerModelPort->registerEvent(
       "Accelerometer",
@@ -179,6 +169,8 @@ void Accelerometer::spiInterface(void) {
   }
 }
 
+void Accelerometer::processWord() { spiInterface(); }
+
 Accelerometer::MeasurementState Accelerometer::nextMeasurementState() {
   auto setting = static_cast<MeasurementState>(
       m_regs.read(RegisterAddress::CTRL) & BitMasks::CTRL_MODE);
@@ -232,10 +224,11 @@ void Accelerometer::measurementLoop() {
       wait(sc_time(0.1, SC_MS) * (m_regs.read(RegisterAddress::CTRL_FS) + 1));
 
       // Get current sample (wraps around input trace)
-      InputTraceEntry input =
-          m_inputTrace[static_cast<unsigned>(sc_time_stamp() /
-                                             m_inputTraceTimestep) %
-                       m_inputTrace.size()];
+      double sample[3];
+      // Continues from the checkpoint time in restored runs
+      m_inputTrace->sample(Checkpoint::now(), sample, m_interpolateInput);
+      const InputTraceEntry input{/*acc_x*/ sample[0], /*acc_y*/ sample[1],
+                                  /*acc_z*/ sample[2]};
 
       // Lambda to convert trace values into bits
       auto sampleTrace = [](const double val) -> uint8_t {
@@ -6,9 +6,11 @@
  */
 
 #include <deque>
+#include <memory>
 #include <systemc>
 #include <vector>
 #include "sd/SpiDevice.hpp"
+#include "utilities/SensorTrace.hpp"
 
 /**
  * @brief Accelerometer class to implement a simple 8-bit 3-axis accelerometer.
@@ -21,8 +23,9 @@
  * Similarly to the BMA400, we use the top bit of the SPI address to determine
  * whether the next access is a write or read. Burst reads are performed by
  * keeping chipSelect asserted after the first read, and issuing more 8-bit SPI
- * transactions. Burst reads  do not autoincrement the address, so can be used
- * to repeatedly take values from the output fifo.
+ * transactions, or a single multi-byte transaction. Burst reads  do not
+ * autoincrement the address, so can be used to repeatedly take values from the
+ * output fifo.
  *
  * Data output format:
  * -------------------
@@ -238,8 +241,8 @@ class Accelerometer : public SpiDevice {
   sc_core::sc_event m_modeUpdateEvent{"modeUpdateEvent"};
   sc_core::sc_event m_irqUpdateEvent{"irqUpdateEvent"};
   bool m_setIrq{false};
-  std::vector<InputTraceEntry> m_inputTrace;
-  sc_core::sc_time m_inputTraceTimestep;
+  std::shared_ptr<const SensorTrace> m_inputTrace;
+  bool m_interpolateInput{false};
 
   /* Event & state ids */
   int m_sampleEventId{-1};
@@ -253,6 +256,11 @@ class Accelerometer : public SpiDevice {
    */
   void spiInterface();
 
+  /**
+   * @brief processWord handle one word of a burst transaction.
+   */
+  virtual void processWord() override;
+
   /**
    * @brief main measurement state machine / loop.
    */
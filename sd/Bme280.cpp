@@ -9,10 +9,11 @@
 #include <tuple>
 #include <vector>
 #include "libs/make_unique.hpp"
-#include "libs/strtk.hpp"
 #include "ps/ConstantCurrentState.hpp"
 #include "sd/Bme280.hpp"
+#include "utilities/Checkpoint.hpp"
 #include "utilities/Config.hpp"
+#include "utilities/SensorTrace.hpp"
 #include "utilities/Utilities.hpp"
 
 using namespace sc_core;
@@ -79,45 +80,26 @@ Bme280::Bme280(const sc_module_name name)
   m_regs.addRegister(ADDR_CALIB_40, 0, RegisterFile::AccessMode::READ);
   m_regs.addRegister(ADDR_CALIB_41, 0, RegisterFile::AccessMode::READ);
 
-  // Load input trace
+  // Load input trace, shared with other instances
   const bool validTraceFile =
       Config::get().contains("Bme280TraceFile")
           ? Config::get().getString("Bme280TraceFile") != "none"
           : false;
   if (validTraceFile) {
-    auto fn = Config::get().getString("Bme280TraceFile");
-    Utility::assertFileExists(fn);
-    std::ifstream file(fn);
-
-    if (file.bad()) {
-      SC_REPORT_FATAL(this->name(),
-                      fmt::format("Couldn't open trace file {:s}", fn).c_str());
-    }
-
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string content = buffer.str();
-
-    strtk::token_grid grid(content, content.size(), ",");
-    for (std::size_t i = 0; i < grid.row_count(); ++i) {
-      m_inputTrace.push_back(InputTraceEntry(
-          /*Temperature*/ grid.row(i).get<double>(1),
-          /*Humidity*/ grid.row(i).get<double>(2),
-          /*Pressure*/ grid.row(i).get<double>(3)));
-    }
-    m_inputTraceTimestep = sc_time(
-        1000 * (grid.row(1).get<double>(0) - grid.row(0).get<double>(0)),
-        SC_MS);
+    m_inputTrace =
+        SensorTrace::load(Config::get().getString("Bme280TraceFile"), 3);
   } else {  // No boot trace specified, set constant
-    m_inputTrace.push_back(InputTraceEntry(
-        /*Temperature*/ 20.0,
-        /*Humidity*/ 30.0,
-        /*Pressure*/ 330.0));
-    m_inputTraceTimestep = sc_time(1000.0, SC_MS);
+    m_inputTrace = SensorTrace::constant({/*Temperature*/ 20.0,
+                                          /*Humidity*/ 30.0,
+                                          /*Pressure*/ 330.0});
   }
+  m_interpolateInput = Config::get().contains("SensorTraceInterpolate") &&
+                       Config::get().getBool("SensorTraceInterpolate");
 }
 
 void Bme280::end_of_elaboration() {
+  SpiDevice::end_of_elaboration();
+
   // Register power modelling states and events
   m_offStateId = powerModelPort->registerState(
       "BME280", std::make_unique<ConstantCurrentState>(this->name(), "off"));
@@ -207,6 +189,8 @@ void Bme280::spiInterface(void) {
   }
 }
 
+void Bme280::processWord() { spiInterface(); }
+
 Bme280::MeasurementState Bme280::nextMeasurementState() const {
   auto mode = m_regs.read(ADDR_CTRL_MEAS) & 0b11u;
   MeasurementState result = m_measurementState;
@@ -257,12 +241,12 @@ void Bme280::measurementLoop() {
       wait(sc_time(1, SC_MS));  // Constant part of t_measure (datasheet)
 
       // Get current sample (loops through input trace)
-      InputTraceEntry input =
-          m_inputTrace[static_cast<unsigned>(sc_time_stamp() /
-                                             m_inputTraceTimestep) %
-                       m_inputTrace.size()
-
-      ];
+      double sample[3];
+      // Continues from the checkpoint time in restored runs
+      m_inputTrace->sample(Checkpoint::now(), sample, m_interpolateInput);
+      const InputTraceEntry input(/*Temperature*/ sample[0],
+                                  /*Humidity*/ sample[1],
+                                  /*Pressure*/ sample[2]);
 
       // Lambda for calculating oversampling factor
       auto nSamples = [](unsigned samplingFactor) -> unsigned {
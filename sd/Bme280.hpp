@@ -10,9 +10,11 @@
  */
 
 #include <array>
+#include <memory>
 #include <systemc>
 #include <vector>
 #include "sd/SpiDevice.hpp"
+#include "utilities/SensorTrace.hpp"
 
 class Bme280 : public SpiDevice {
  public:
@@ -130,8 +132,8 @@ class Bme280 : public SpiDevice {
         : temperature(temperature_), humidity(humidity_), pressure(pressure_) {}
   };
 
-  std::vector<InputTraceEntry> m_inputTrace;
-  sc_core::sc_time m_inputTraceTimestep;
+  std::shared_ptr<const SensorTrace> m_inputTrace;
+  bool m_interpolateInput{false};
 
   /* Event and state ids */
   int m_offStateId{-1};
@@ -149,6 +151,11 @@ class Bme280 : public SpiDevice {
    */
   void spiInterface();
 
+  /**
+   * @brief processWord handle one word of a burst transaction.
+   */
+  virtual void processWord() override;
+
   /**
    * @brief main measurement state machine / loop.
    */
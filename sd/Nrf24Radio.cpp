@@ -9,6 +9,7 @@
 #include "libs/make_unique.hpp"
 #include "ps/ConstantCurrentState.hpp"
 #include "sd/Nrf24Radio.hpp"
+#include "utilities/Logging.hpp"
 
 using namespace sc_core;
 
@@ -49,6 +50,8 @@ Nrf24Radio::Nrf24Radio(const sc_core::sc_module_name name) : SpiDevice(name) {
 }
 
 void Nrf24Radio::end_of_elaboration() {
+  SpiDevice::end_of_elaboration();
+
   // Register power modelling states
   m_porStateId = powerModelPort->registerState(
       this->name(),
@@ -97,6 +100,10 @@ void Nrf24Radio::end_of_elaboration() {
   SC_THREAD(txEventHandler);
 
   SC_THREAD(stateChangeHandler);
+
+  if (rfMedium.size() > 0) {
+    m_mediumId = rfMedium->attach(*this, this->name());
+  }
 }
 
 void Nrf24Radio::reset(void) {
@@ -130,7 +137,7 @@ void Nrf24Radio::reset(void) {
   m_regs.write(FEATURE, 0, true);
 
   // Reset State Machines
-  m_radio_state = OpModes::UNDEFINED;
+  setState(OpModes::UNDEFINED);
   m_payloadType = PayloadType::COMMAND;
 
   // Reset SPI shift registers.
@@ -149,8 +156,8 @@ void Nrf24Radio::payloadReceivedHandler(void) {
     static uint32_t processedDataBytes;
 
     const auto payload = readSlaveIn();
-    spdlog::info("{:s}: @{:s} Received 0x{:08x}", this->name(),
-                 sc_time_stamp().to_string(), payload);
+    FUSED_LOG(Nrf24Radio, INFO, "{:s}: @{:s} Received 0x{:08x}", this->name(),
+              sc_time_stamp().to_string(), payload);
     if (m_payloadType == PayloadType::COMMAND) {
       command = payload;
       processedDataBytes = 0;
@@ -158,6 +165,10 @@ void Nrf24Radio::payloadReceivedHandler(void) {
         case R_RX_PAYLOAD:
           m_payloadType = PayloadType::DATA;
           maxDataBytes = 32;
+          m_rxReadIndex = 0;
+          writeSlaveOut(m_rxFifo.isEmpty()
+                            ? 0x00
+                            : m_rxFifo.readPayload(m_rxReadIndex++));
           break;
         case W_TX_PAYLOAD:
           m_payloadType = PayloadType::DATA;
@@ -173,12 +184,15 @@ void Nrf24Radio::payloadReceivedHandler(void) {
         case FLUSH_TX:
           break;
         case FLUSH_RX:
+          m_rxFifo.clear();
+          updateFifoStatus();
           break;
         case REUSE_TX_PL:
           break;
         case R_RX_PL_WID:
           m_payloadType = PayloadType::DATA;
           maxDataBytes = 32;
+          writeSlaveOut(m_rxFifo.isEmpty() ? 0x00 : m_rxFifo.getPayloadSize());
           break;
         case W_TX_PAYLOAD_NO_ACK:
           m_payloadType = PayloadType::DATA;
@@ -220,19 +234,29 @@ void Nrf24Radio::payloadReceivedHandler(void) {
           writeSlaveOut(m_regs.read(++targetRegister));
           break;
         case W_REGISTER:
-          m_regs.write(targetRegister, payload, true);
-          // Handle Tx irq clear
           if (targetRegister == NRF_STATUS) {
-            if ((payload & TX_DS) != 0) {
-              m_regs.write(targetRegister,
-                           m_regs.read(targetRegister) & ~TX_DS);
-              m_irqEvent.notify();
-            }
+            // Handle irq clear, RX_DR & TX_DS are write-1-to-clear
+            const auto flags =
+                m_regs.read(NRF_STATUS) & (RX_DR | TX_DS) & ~payload;
+            m_regs.write(NRF_STATUS, (payload & ~(RX_DR | TX_DS)) | flags,
+                         true);
+            m_irqEvent.notify();
+          } else {
+            m_regs.write(targetRegister, payload, true);
           }
           targetRegister++;
           m_stateChangeEvent.notify();
           break;
         case R_RX_PAYLOAD:
+          if (m_rxReadIndex < m_rxFifo.getPayloadSize()) {
+            writeSlaveOut(m_rxFifo.readPayload(m_rxReadIndex++));
+          } else if (m_rxReadIndex == m_rxFifo.getPayloadSize() &&
+                     !m_rxFifo.isEmpty()) {
+            // Last byte shifted out
+            m_rxFifo.pop();
+            m_rxReadIndex = RadioPacket::MAX_PAYLOAD_SIZE + 1;
+            updateFifoStatus();
+          }
           break;
         case W_TX_PAYLOAD:
           m_txFifo.appendPayload(payload);
@@ -251,16 +275,18 @@ void Nrf24Radio::payloadReceivedHandler(void) {
   }
 }
 
+void Nrf24Radio::processWord(void) { payloadReceivedHandler(); }
+
 void Nrf24Radio::chipSelectHandler(void) {
   if (enabled()) {
-    spdlog::info("{:s}: @{:s} CS |_; Communication starts.", this->name(),
-                 sc_time_stamp().to_string());
+    FUSED_LOG(Nrf24Radio, INFO, "{:s}: @{:s} CS |_; Communication starts.",
+              this->name(), sc_time_stamp().to_string());
     writeSlaveOut(m_regs.read(NRF_STATUS));
     m_payloadType =
         PayloadType::COMMAND;  // The next payload is expected to be a command
   } else {
-    spdlog::info("{:s}: @{:s} CS _|; Communication halted.", this->name(),
-                 sc_time_stamp().to_string());
+    FUSED_LOG(Nrf24Radio, INFO, "{:s}: @{:s} CS _|; Communication halted.",
+              this->name(), sc_time_stamp().to_string());
     if (m_radio_state != OpModes::UNDEFINED) {
       m_stateChangeEvent.notify();
     }
@@ -277,7 +303,7 @@ void Nrf24Radio::nResetHandler(void) {
   if (nReset.read()) {
     m_stateChangeEvent.notify();
   } else {
-    m_radio_state = OpModes::UNDEFINED;
+    setState(OpModes::UNDEFINED);
   }
 }
 
@@ -287,79 +313,79 @@ void Nrf24Radio::stateChangeHandler(void) {
     const bool ce = chipEnable.read() == sc_dt::SC_LOGIC_1 ? true : false;
     switch (m_radio_state) {
       case OpModes::UNDEFINED:
-        m_radio_state = OpModes::POWER_ON_RESET;
+        setState(OpModes::POWER_ON_RESET);
         powerModelPort->reportState(m_porStateId);
         wait(sc_time(10, SC_MS));
         powerModelPort->reportState(m_powerDownStateId);
-        m_radio_state = OpModes::POWER_DOWN;
+        setState(OpModes::POWER_DOWN);
         break;
       case OpModes::POWER_DOWN:
         if (m_regs.read(NRF_CONFIG) & PWR_UP) {
-          m_radio_state = OpModes::OSC_STARTUP;
+          setState(OpModes::OSC_STARTUP);
           powerModelPort->reportState(m_startUpStateId);
           wait(sc_time(150, SC_US));  // For External crystal
           powerModelPort->reportState(m_standbyOneStateId);
-          m_radio_state = OpModes::STANDBY1;
+          setState(OpModes::STANDBY1);
         }
         break;
       case OpModes::STANDBY1:
         if ((m_regs.read(NRF_CONFIG) & PWR_UP) == 0) {
           powerModelPort->reportState(m_powerDownStateId);
-          m_radio_state = OpModes::POWER_DOWN;
+          setState(OpModes::POWER_DOWN);
         } else if ((m_regs.read(NRF_CONFIG) & PRIM_RX) && ce) {
           powerModelPort->reportState(m_rxSettlingStateId);
-          m_radio_state = OpModes::RX_SETTLING;
+          setState(OpModes::RX_SETTLING);
           wait(sc_time(130, SC_US));
           powerModelPort->reportState(m_rxModeStateId);
-          m_radio_state = OpModes::RX_MODE;
+          setState(OpModes::RX_MODE);
         } else if (!(m_regs.read(NRF_CONFIG) & PRIM_RX) && ce &&
                    !m_txFifo.isEmpty()) {
           powerModelPort->reportState(m_txSettlingStateId);
-          m_radio_state = OpModes::TX_SETTLING;
+          setState(OpModes::TX_SETTLING);
           wait(sc_time(130, SC_US));
           powerModelPort->reportState(m_txModeStateId);
-          m_radio_state = OpModes::TX_MODE;
+          setState(OpModes::TX_MODE);
           m_txEvent.notify();
         } else if (!(m_regs.read(NRF_CONFIG) & PRIM_RX) && ce &&
                    m_txFifo.isEmpty()) {
           powerModelPort->reportState(m_standbyTwoStateId);
-          m_radio_state = OpModes::STANDBY2;
+          setState(OpModes::STANDBY2);
         }
         break;
       case OpModes::STANDBY2:
         if ((m_regs.read(NRF_CONFIG) & PWR_UP) == 0) {
           powerModelPort->reportState(m_powerDownStateId);
-          m_radio_state = OpModes::POWER_DOWN;
+          setState(OpModes::POWER_DOWN);
         } else if (ce && !m_txFifo.isEmpty()) {
           powerModelPort->reportState(m_txSettlingStateId);
-          m_radio_state = OpModes::TX_SETTLING;
+          setState(OpModes::TX_SETTLING);
           wait(sc_time(130, SC_US));
           powerModelPort->reportState(m_txModeStateId);
-          m_radio_state = OpModes::TX_MODE;
+          setState(OpModes::TX_MODE);
           m_txEvent.notify();
         }
         break;
       case OpModes::RX_MODE:
         if ((m_regs.read(NRF_CONFIG) & PWR_UP) == 0) {
           powerModelPort->reportState(m_powerDownStateId);
-          m_radio_state = OpModes::POWER_DOWN;
+          setState(OpModes::POWER_DOWN);
         } else if (!ce) {
           powerModelPort->reportState(m_standbyOneStateId);
-          m_radio_state = OpModes::STANDBY1;
+          setState(OpModes::STANDBY1);
         }
         break;
       case OpModes::TX_MODE:
         if ((m_regs.read(NRF_CONFIG) & PWR_UP) == 0) {
           powerModelPort->reportState(m_powerDownStateId);
-          m_radio_state = OpModes::POWER_DOWN;
+          setState(OpModes::POWER_DOWN);
         } else if (!ce) {
           powerModelPort->reportState(m_standbyOneStateId);
-          m_radio_state = OpModes::STANDBY1;
+          setState(OpModes::STANDBY1);
         } else if (ce && !m_txFifo.isEmpty()) {
           m_txEvent.notify();
         } else if (ce && m_txFifo.isEmpty()) {
           powerModelPort->reportState(m_standbyTwoStateId);
-          m_radio_state = OpModes::STANDBY2;
+          setState(OpModes::STANDBY2);
         }
         break;
       default:
@@ -411,10 +437,13 @@ void Nrf24Radio::txEventHandler(void) {
     m_txPacket.payloadSize = m_txFifo.getPayloadSize();
 
     // Tx
+    if (m_mediumId >= 0) {
+      rfMedium->transmit(m_mediumId, m_txPacket);
+    }
     wait(sc_time(m_txPacket.packetDuration(), SC_US));
     m_txFifo.pop();
-    spdlog::info("{:s}: @{:s} Packet Transmitted", this->name(),
-                 sc_time_stamp().to_string());
+    FUSED_LOG(Nrf24Radio, INFO, "{:s}: @{:s} Packet Transmitted",
+              this->name(), sc_time_stamp().to_string());
 
     // Tx interrupt request
     m_regs.write(NRF_STATUS, m_regs.read(NRF_STATUS) | TX_DS);
@@ -428,12 +457,64 @@ void Nrf24Radio::irqEventHandler(void) {
   if (nReset.read()) {
     // The TX_DS bit in STATUS will be set/cleared already
     // This handler simple controls the irqEventHandler signal
-    if ((m_regs.read(NRF_STATUS) & TX_DS) != 0) {             // Irq not set
-      if (((m_regs.read(NRF_CONFIG) & (MASK_TX_DS)) == 0)) {  // Not masked
-        interruptRequest.write(sc_dt::sc_logic(false));
-      }
-    } else {  // Irq set
+    const auto status = m_regs.read(NRF_STATUS);
+    const auto config = m_regs.read(NRF_CONFIG);
+    if (((status & TX_DS) != 0 && (config & MASK_TX_DS) == 0) ||
+        ((status & RX_DR) != 0 && (config & MASK_RX_DR) == 0)) {
+      interruptRequest.write(sc_dt::sc_logic(false));  // Irq set, not masked
+    } else {
       interruptRequest.write(sc_dt::sc_logic(true));
     }
   }
 }
+
+bool Nrf24Radio::receive(const RadioPacket &packet) {
+  // Find an enabled pipe with a matching address
+  int pipe = -1;
+  for (int i = 0; i < 6; ++i) {
+    if ((m_regs.read(EN_RXADDR) & (1u << i)) &&
+        m_regs.read(RX_ADDR_P0 + i) == packet.address[0]) {
+      pipe = i;
+      break;
+    }
+  }
+  if (pipe < 0 || m_rxFifo.isFull()) {
+    return false;
+  }
+
+  m_rxFifo.push();
+  for (unsigned i = 0; i < packet.payloadSize; i++) {
+    m_rxFifo.appendPayload(packet.payload[i]);
+  }
+  updateFifoStatus();
+  FUSED_LOG(Nrf24Radio, INFO, "{:s}: @{:s} Packet received on pipe {:d}",
+            this->name(), sc_time_stamp().to_string(), pipe);
+
+  // Rx interrupt request
+  m_regs.write(NRF_STATUS,
+               (m_regs.read(NRF_STATUS) & ~(RX_P_NO_2 | RX_P_NO_1 | RX_P_NO_0)) |
+                   RX_DR | (pipe << 1));
+  m_irqEvent.notify();
+  return true;
+}
+
+void Nrf24Radio::setState(const OpModes state) {
+  if (m_mediumId >= 0) {
+    if (state == OpModes::RX_MODE) {
+      rfMedium->listen(m_mediumId, m_regs.read(RF_CH) & 0b01111111);
+    } else if (m_radio_state == OpModes::RX_MODE) {
+      rfMedium->stopListening(m_mediumId);
+    }
+  }
+  m_radio_state = state;
+}
+
+void Nrf24Radio::updateFifoStatus(void) {
+  auto fifoStatus = m_regs.read(FIFO_STATUS) & ~(RX_FULL | RX_EMPTY);
+  if (m_rxFifo.isEmpty()) {
+    fifoStatus |= RX_EMPTY;
+  } else if (m_rxFifo.isFull()) {
+    fifoStatus |= RX_FULL;
+  }
+  m_regs.write(FIFO_STATUS, fifoStatus, true);
+}
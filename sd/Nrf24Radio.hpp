@@ -9,6 +9,8 @@
 #include <iostream>
 #include <systemc>
 
+#include "sd/RadioPacket.hpp"
+#include "sd/RfMedium.hpp"
 #include "sd/SpiDevice.hpp"
 #include "sd/nRF24L01.h"
 #include "utilities/Config.hpp"
@@ -16,12 +18,14 @@
 
 class RadioFifo {
  public:
-  RadioFifo() {
+  RadioFifo() { clear(); };
+
+  void clear(void) {
     m_fifoWriteIndex = 0;
     m_fifoReadIndex = 1;
     m_payloadIndex = 0;
     m_size = 0;
-  };
+  }
 
   void appendPayload(unsigned int b) {
     m_fifo[m_fifoWriteIndex][m_payloadIndex] = b;
@@ -65,123 +69,7 @@ class RadioFifo {
   unsigned int m_payloadSize[FifoSize];
 };
 
-class RadioPacket {
- public:
-  /* ------ Member Types ------*/
-  enum class DataRate { _1Mbps, _2Mbps, _250kbps };
-  enum class OutputPower { _n18dBm, _n12dBm, _n6dBm, _0dBm };
-
-  /* ------ Constants ------*/
-  unsigned int PREAMBLE = 0b10101010;
-  static const unsigned int MAX_ADDRESS_SIZE = 5;
-  static const unsigned int MAX_PAYLOAD_SIZE = 32;
-  static const unsigned int MAX_CRC_SIZE = 2;
-
-  /* ------ Public Variables ------ */
-  DataRate dataRate;
-  OutputPower outputPower;
-  unsigned int channelNumber;
-  unsigned int address[MAX_ADDRESS_SIZE];
-  unsigned int addressSize;
-  unsigned int payload[MAX_PAYLOAD_SIZE];
-  unsigned int payloadSize;
-  unsigned int crc[MAX_CRC_SIZE];
-  unsigned int crcSize;
-
-  /* ------ Public Methods ------ */
-
-  RadioPacket() {
-    dataRate = DataRate::_1Mbps;
-    outputPower = OutputPower::_0dBm;
-    channelNumber = 0;
-    addressSize = 0;
-    payloadSize = 0;
-    crcSize = 0;
-  }
-
-  unsigned int packetSize(void) const {
-    return addressSize + payloadSize + crcSize +
-           1;  // There is always a preamble
-  }
-
-  unsigned int bitPeriod(void) const {
-    unsigned int period = 1;  // 1 us
-    switch (dataRate) {
-      case DataRate::_1Mbps:
-        period = 1 * 8;
-        break;
-      case DataRate::_2Mbps:
-        period = 0.5 * 8;
-        break;
-      case DataRate::_250kbps:
-        period = 4 * 8;
-        break;
-      default:
-        break;
-    }
-    return period;
-  }
-
-  unsigned int packetDuration(void) const { return packetSize() * bitPeriod(); }
-
-  friend std::ostream &operator<<(std::ostream &os, const RadioPacket &rhs) {
-    os << "<Nrf24 Radio Packet>\n";
-
-    switch (rhs.dataRate) {
-      case DataRate::_1Mbps:
-        os << "\tData Rate: 1Mbps\n";
-        break;
-      case DataRate::_2Mbps:
-        os << "\tData Rate: 2Mbps\n";
-        break;
-      case DataRate::_250kbps:
-        os << "\tData Rate: 250kbps\n";
-        break;
-      default:
-        break;
-    }
-
-    switch (rhs.outputPower) {
-      case OutputPower::_n18dBm:
-        os << "\tOutput Power: -18dBm\n";
-        break;
-      case OutputPower::_n12dBm:
-        os << "\tOutput Power: -12dBm\n";
-        break;
-      case OutputPower::_n6dBm:
-        os << "\tOutput Power: -6dBm\n";
-        break;
-      case OutputPower::_0dBm:
-        os << "\tOutput Power: 0dBm\n";
-        break;
-      default:
-        break;
-    }
-
-    os << "\tChannel Number: " << rhs.channelNumber << "\n";
-    os << "\tPreamble: " << fmt::format("0b{:08b}", rhs.PREAMBLE) << "\n";
-    os << "\tAddress: ";
-    for (int i = 0; i < rhs.addressSize; i++) {
-      os << fmt::format("{:02x}", rhs.address[i]);
-    }
-    os << "\n";
-    os << "\tPayload: ";
-    for (int i = 0; i < rhs.payloadSize; i++) {
-      os << fmt::format("{:02x}", rhs.payload[i]);
-    }
-    os << "\n";
-    os << "\tCRC: ";
-    for (int i = 0; i < rhs.crcSize; i++) {
-      os << fmt::format("{:02x}", rhs.crc[i]);
-    }
-    os << "\n";
-    os << "\tPacket Duration: " << rhs.packetDuration() << "\n";
-
-    return os;
-  }
-};
-
-class Nrf24Radio : public SpiDevice {
+class Nrf24Radio : public SpiDevice, public RfTransceiverIf {
   SC_HAS_PROCESS(Nrf24Radio);
 
  public:
@@ -189,6 +77,10 @@ class Nrf24Radio : public SpiDevice {
   sc_core::sc_out_resolved interruptRequest{"interruptRequest"};
   sc_core::sc_in_resolved chipEnable{"chipEnable"};
 
+  //! Shared RF medium, optional. Without a medium packets go nowhere.
+  sc_core::sc_port<RfMediumIf, 1, sc_core::SC_ZERO_OR_MORE_BOUND> rfMedium{
+      "rfMedium"};
+
   /* ------ Public Types ------ */
   enum class OpModes {
     UNDEFINED,
@@ -234,6 +126,11 @@ class Nrf24Radio : public SpiDevice {
    */
   void payloadReceivedHandler(void);
 
+  /**
+   * @brief processWord Handles one word of a burst transaction.
+   */
+  virtual void processWord() override;
+
   /**
    * @brief stateChangeHandler Manages the radio state machine.
    */
@@ -253,6 +150,12 @@ class Nrf24Radio : public SpiDevice {
 
   void irqEventHandler(void);
 
+  /**
+   * @brief receive put a packet from the RF medium into the RX FIFO, if its
+   * address matches an enabled pipe.
+   */
+  virtual bool receive(const RadioPacket &packet) override;
+
  private:
   sc_core::sc_event m_stateChangeEvent{"m_stateChangeEvent"};
   sc_core::sc_event m_txEvent{"m_txEvent"};
@@ -268,4 +171,21 @@ class Nrf24Radio : public SpiDevice {
   int m_txSettlingStateId{-1};
   int m_rxModeStateId{-1};
   int m_txModeStateId{-1};
+
+  //! Node id on the RF medium, -1 if not attached
+  int m_mediumId{-1};
+
+  //! Next byte of the RX payload being read out
+  unsigned int m_rxReadIndex{0};
+
+  /**
+   * @brief setState change the state machine's state, and open or close the
+   * RX window on the RF medium when entering or leaving RX_MODE.
+   */
+  void setState(const OpModes state);
+
+  /**
+   * @brief updateFifoStatus update the RX flags of FIFO_STATUS.
+   */
+  void updateFifoStatus(void);
 };
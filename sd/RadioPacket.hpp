@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2019-2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <spdlog/fmt/fmt.h>
+#include <iostream>
+
+class RadioPacket {
+ public:
+  /* ------ Member Types ------*/
+  enum class DataRate { _1Mbps, _2Mbps, _250kbps };
+  enum class OutputPower { _n18dBm, _n12dBm, _n6dBm, _0dBm };
+
+  /* ------ Constants ------*/
+  unsigned int PREAMBLE = 0b10101010;
+  static const unsigned int MAX_ADDRESS_SIZE = 5;
+  static const unsigned int MAX_PAYLOAD_SIZE = 32;
+  static const unsigned int MAX_CRC_SIZE = 2;
+
+  /* ------ Public Variables ------ */
+  DataRate dataRate;
+  OutputPower outputPower;
+  unsigned int channelNumber;
+  unsigned int address[MAX_ADDRESS_SIZE];
+  unsigned int addressSize;
+  unsigned int payload[MAX_PAYLOAD_SIZE];
+  unsigned int payloadSize;
+  unsigned int crc[MAX_CRC_SIZE];
+  unsigned int crcSize;
+
+  /* ------ Public Methods ------ */
+
+  RadioPacket() {
+    dataRate = DataRate::_1Mbps;
+    outputPower = OutputPower::_0dBm;
+    channelNumber = 0;
+    addressSize = 0;
+    payloadSize = 0;
+    crcSize = 0;
+  }
+
+  unsigned int packetSize(void) const {
+    return addressSize + payloadSize + crcSize +
+           1;  // There is always a preamble
+  }
+
+  unsigned int bitPeriod(void) const {
+    unsigned int period = 1;  // 1 us
+    switch (dataRate) {
+      case DataRate::_1Mbps:
+        period = 1 * 8;
+        break;
+      case DataRate::_2Mbps:
+        period = 0.5 * 8;
+        break;
+      case DataRate::_250kbps:
+        period = 4 * 8;
+        break;
+      default:
+        break;
+    }
+    return period;
+  }
+
+  unsigned int packetDuration(void) const { return packetSize() * bitPeriod(); }
+
+  friend std::ostream &operator<<(std::ostream &os, const RadioPacket &rhs) {
+    os << "<Nrf24 Radio Packet>\n";
+
+    switch (rhs.dataRate) {
+      case DataRate::_1Mbps:
+        os << "\tData Rate: 1Mbps\n";
+        break;
+      case DataRate::_2Mbps:
+        os << "\tData Rate: 2Mbps\n";
+        break;
+      case DataRate::_250kbps:
+        os << "\tData Rate: 250kbps\n";
+        break;
+      default:
+        break;
+    }
+
+    switch (rhs.outputPower) {
+      case OutputPower::_n18dBm:
+        os << "\tOutput Power: -18dBm\n";
+        break;
+      case OutputPower::_n12dBm:
+        os << "\tOutput Power: -12dBm\n";
+        break;
+      case OutputPower::_n6dBm:
+        os << "\tOutput Power: -6dBm\n";
+        break;
+      case OutputPower::_0dBm:
+        os << "\tOutput Power: 0dBm\n";
+        break;
+      default:
+        break;
+    }
+
+    os << "\tChannel Number: " << rhs.channelNumber << "\n";
+    os << "\tPreamble: " << fmt::format("0b{:08b}", rhs.PREAMBLE) << "\n";
+    os << "\tAddress: ";
+    for (int i = 0; i < rhs.addressSize; i++) {
+      os << fmt::format("{:02x}", rhs.address[i]);
+    }
+    os << "\n";
+    os << "\tPayload: ";
+    for (int i = 0; i < rhs.payloadSize; i++) {
+      os << fmt::format("{:02x}", rhs.payload[i]);
+    }
+    os << "\n";
+    os << "\tCRC: ";
+    for (int i = 0; i < rhs.crcSize; i++) {
+      os << fmt::format("{:02x}", rhs.crc[i]);
+    }
+    os << "\n";
+    os << "\tPacket Duration: " << rhs.packetDuration() << "\n";
+
+    return os;
+  }
+};
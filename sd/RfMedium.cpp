@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <systemc>
+#include <vector>
+#include "sd/RfMedium.hpp"
+#include "utilities/Config.hpp"
+#include "utilities/Utilities.hpp"
+
+using namespace sc_core;
+
+namespace {
+
+// Longest possible packet: preamble, address, payload & crc at 250 kbps
+const sc_time MAX_PACKET_DURATION(
+    (1 + RadioPacket::MAX_ADDRESS_SIZE + RadioPacket::MAX_PAYLOAD_SIZE +
+     RadioPacket::MAX_CRC_SIZE) *
+        32,
+    SC_US);
+
+sc_time packetDuration(const RadioPacket &packet) {
+  return sc_time(packet.packetDuration(), SC_US);
+}
+
+}  // namespace
+
+RfMedium::RfMedium(const sc_module_name name)
+    : sc_module(name),
+      m_rng(Config::get().contains("RfSeed") ? Config::get().getUint("RfSeed")
+                                             : 0) {
+  SC_METHOD(arrivalHandler);
+  sensitive << m_arrivalEvent;
+  dont_initialize();
+}
+
+int RfMedium::attach(RfTransceiverIf &radio, const std::string &name) {
+  sc_assert(!sc_is_running());
+  m_nodes.emplace_back();
+  m_nodes.back().radio = &radio;
+  m_nodes.back().name = name;
+  return m_nodes.size() - 1;
+}
+
+void RfMedium::start_of_simulation() {
+  const auto &config = Config::get();
+  const Link defaultLink{
+      sc_time::from_seconds(config.contains("RfLinkDelay")
+                                ? config.getDouble("RfLinkDelay")
+                                : 0.0),
+      config.contains("RfLinkLoss") ? config.getDouble("RfLinkLoss") : 0.0};
+  m_links.assign(m_nodes.size() * m_nodes.size(), defaultLink);
+
+  if (config.contains("RfLinkFile") &&
+      config.getString("RfLinkFile") != "none") {
+    const auto &path = config.getString("RfLinkFile");
+    Utility::assertFileExists(path);
+    const auto names = nodeNames();
+    const auto nodeId = [&names, &path](const std::string &name) {
+      const auto it = std::find(names.begin(), names.end(), name);
+      if (it == names.end()) {
+        SC_REPORT_FATAL("RfMedium", fmt::format("{:s}: unknown node \"{:s}\"",
+                                                path, name)
+                                        .c_str());
+      }
+      return it - names.begin();
+    };
+
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+      if (line.empty() || line[0] == '#') {
+        continue;
+      }
+      std::stringstream ss(line);
+      std::string src, dst, delay, loss;
+      std::getline(ss, src, ',');
+      std::getline(ss, dst, ',');
+      std::getline(ss, delay, ',');
+      std::getline(ss, loss, ',');
+      m_links[nodeId(src) * m_nodes.size() + nodeId(dst)] =
+          Link{sc_time::from_seconds(std::stod(delay)), std::stod(loss)};
+    }
+  }
+
+  for (const auto &l : m_links) {
+    m_maxDelay = std::max(m_maxDelay, l.delay);
+  }
+  spdlog::info("{:s}: {:d} nodes", this->name(), m_nodes.size());
+}
+
+void RfMedium::transmit(const int node, const RadioPacket &packet) {
+  const auto now = sc_time_stamp();
+
+  // Forget packets that can no longer overlap an arrival
+  while (!m_air.empty() &&
+         m_air.front().end + m_maxDelay + MAX_PACKET_DURATION <= now) {
+    m_air.pop_front();
+  }
+
+  const auto id = m_nextId++;
+  m_air.push_back(
+      Transmission{id, node, now, now + packetDuration(packet), packet});
+  ++m_nodes[node].stats.transmitted;
+
+  for (int n = 0; n < m_nodes.size(); ++n) {
+    if (n != node) {
+      m_arrivals.push(Arrival{m_air.back().end + link(node, n).delay, n, id});
+    }
+  }
+  m_arrivalEvent.notify(m_arrivals.top().time - now);
+}
+
+void RfMedium::listen(const int node, const unsigned channel) {
+  auto &n = m_nodes[node];
+  if (n.listening) {
+    stopListening(node);
+  }
+  n.listening = true;
+  n.channel = channel;
+  n.listenStart = sc_time_stamp();
+}
+
+void RfMedium::stopListening(const int node) {
+  auto &n = m_nodes[node];
+  if (n.listening) {
+    n.listening = false;
+    n.rxTime += sc_time_stamp() - n.listenStart;
+    ++n.rxWindows;
+  }
+}
+
+void RfMedium::arrivalHandler() {
+  const auto now = sc_time_stamp();
+  while (!m_arrivals.empty() && m_arrivals.top().time <= now) {
+    resolve(m_arrivals.top());
+    m_arrivals.pop();
+  }
+  if (!m_arrivals.empty()) {
+    m_arrivalEvent.notify(m_arrivals.top().time - now);
+  }
+}
+
+void RfMedium::resolve(const Arrival &arrival) {
+  const auto &tx = transmission(arrival.id);
+  auto &node = m_nodes[arrival.node];
+  const auto channel = tx.packet.channelNumber;
+  const auto start = arrival.time - (tx.end - tx.start);
+
+  if (!node.listening || node.channel != channel ||
+      node.listenStart > start) {
+    ++node.stats.missed;
+    return;
+  }
+
+  // Any other packet on the channel overlapping this one at the receiver
+  const bool collision = std::any_of(
+      m_air.begin(), m_air.end(), [&](const Transmission &other) {
+        if (other.id == tx.id || other.source == arrival.node ||
+            other.packet.channelNumber != channel) {
+          return false;
+        }
+        const auto d = link(other.source, arrival.node).delay;
+        return other.start + d < arrival.time && other.end + d > start;
+      });
+  if (collision) {
+    ++node.stats.collided;
+    return;
+  }
+
+  if (m_uniform(m_rng) < link(tx.source, arrival.node).loss) {
+    ++node.stats.lost;
+    return;
+  }
+
+  if (!node.radio->receive(tx.packet)) {
+    ++node.stats.rejected;
+    return;
+  }
+  const auto latency = (arrival.time - tx.start).to_seconds();
+  ++node.stats.received;
+  node.stats.latencySum += latency;
+  node.stats.latencyMax = std::max(node.stats.latencyMax, latency);
+}
+
+std::vector<std::string> RfMedium::nodeNames() const {
+  std::vector<std::string> names;
+  for (const auto &n : m_nodes) {
+    names.push_back(n.name);
+  }
+  return names;
+}
+
+std::string RfMedium::statsJson(const Stats &s) {
+  return fmt::format(
+      "\"transmitted\": {:d}, \"received\": {:d}, \"rejected\": {:d}, "
+      "\"collided\": {:d}, \"lost\": {:d}, \"missed\": {:d}, "
+      "\"latency_mean_s\": {:g}, \"latency_max_s\": {:g}",
+      s.transmitted, s.received, s.rejected, s.collided, s.lost, s.missed,
+      s.received > 0 ? s.latencySum / s.received : 0.0, s.latencyMax);
+}
+
+void RfMedium::writeSummary(std::ostream &os,
+                            const std::string &indent) const {
+  const auto in2 = indent + "  ";
+  Stats total;
+  double rxTime = 0.0;
+
+  os << "{\n" << indent << "\"nodes\": {";
+  for (int i = 0; i < m_nodes.size(); ++i) {
+    const auto &n = m_nodes[i];
+    // Include the currently open RX window
+    auto t = n.rxTime;
+    if (n.listening) {
+      t += sc_time_stamp() - n.listenStart;
+    }
+    rxTime += t.to_seconds();
+    total.transmitted += n.stats.transmitted;
+    total.received += n.stats.received;
+    total.rejected += n.stats.rejected;
+    total.collided += n.stats.collided;
+    total.lost += n.stats.lost;
+    total.missed += n.stats.missed;
+    total.latencySum += n.stats.latencySum;
+    total.latencyMax = std::max(total.latencyMax, n.stats.latencyMax);
+
+    os << (i == 0 ? "\n" : ",\n") << in2 << "\"" << n.name << "\": {"
+       << statsJson(n.stats)
+       << fmt::format(", \"rx_windows\": {:d}, \"rx_time_s\": {:g}}}",
+                      n.rxWindows + (n.listening ? 1 : 0), t.to_seconds());
+  }
+  os << "\n" << indent << "},\n";
+  os << indent << "\"network\": {" << statsJson(total)
+     << fmt::format(", \"rx_time_s\": {:g}}}\n", rxTime);
+  os << indent.substr(0, indent.size() >= 2 ? indent.size() - 2 : 0) << "}";
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <deque>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <systemc>
+#include <vector>
+#include "sd/RadioPacket.hpp"
+
+/**
+ * @brief RfTransceiverIf receiving side of a radio attached to an RfMedium.
+ */
+class RfTransceiverIf {
+ public:
+  virtual ~RfTransceiverIf() {}
+
+  /**
+   * @brief receive deliver a packet that was received without collision or
+   * loss, at the end of the packet.
+   * @retval true if the packet was accepted (address match, room in the RX
+   * FIFO)
+   */
+  virtual bool receive(const RadioPacket &packet) = 0;
+};
+
+/**
+ * @brief RfMediumIf interface radios use to transmit to, and listen on, a
+ * shared RF medium.
+ */
+class RfMediumIf : public virtual sc_core::sc_interface {
+ public:
+  /**
+   * @brief attach add a radio to the medium, during elaboration.
+   * @param radio receiving side of the radio
+   * @param name node name, used in the link file and summary
+   * @retval node id
+   */
+  virtual int attach(RfTransceiverIf &radio, const std::string &name) = 0;
+
+  /**
+   * @brief transmit put a packet on air, from now until the end of its
+   * packetDuration.
+   */
+  virtual void transmit(const int node, const RadioPacket &packet) = 0;
+
+  /**
+   * @brief listen open an RX window on a channel. Only packets that arrive
+   * entirely within the window can be received.
+   */
+  virtual void listen(const int node, const unsigned channel) = 0;
+
+  /**
+   * @brief stopListening close the node's RX window.
+   */
+  virtual void stopListening(const int node) = 0;
+};
+
+/*
+ * Shared RF medium connecting any number of radios, across boards.
+ *
+ * A transmitted packet reaches each other node after the delay of the link,
+ * unless it's dropped according to the link's loss probability. It is received
+ * if the node listened on the packet's channel for the whole packet, and no
+ * other packet on that channel overlapped it at the receiver (collision).
+ *
+ * Nodes only interact at packet boundaries: the medium schedules a single
+ * event at the end of the next pending packet arrival, and doesn't observe
+ * the radios otherwise, so boards run independently between packets.
+ *
+ * Links default to RfLinkDelay (s) and RfLinkLoss (probability). RfLinkFile
+ * overrides individual directed links, as csv lines of
+ * "source,destination,delay,loss" using node names. RfSeed seeds the loss
+ * process.
+ */
+class RfMedium : public sc_core::sc_module, public RfMediumIf {
+  SC_HAS_PROCESS(RfMedium);
+
+ public:
+  //! Constructor
+  explicit RfMedium(const sc_core::sc_module_name name);
+
+  // See RfMediumIf for description of the following methods
+  virtual int attach(RfTransceiverIf &radio, const std::string &name) override;
+  virtual void transmit(const int node, const RadioPacket &packet) override;
+  virtual void listen(const int node, const unsigned channel) override;
+  virtual void stopListening(const int node) override;
+
+  /**
+   * @brief start_of_simulation systemc callback. Used here to set up links.
+   */
+  virtual void start_of_simulation() override;
+
+  /**
+   * @brief writeSummary write packet counts, latency and RX window time per
+   * node, and for the whole network, as a JSON object.
+   * @param os output stream
+   * @param indent indentation of the object's members
+   */
+  void writeSummary(std::ostream &os, const std::string &indent = "  ") const;
+
+  /**
+   * @brief nodeNames names of the attached nodes, by node id.
+   */
+  std::vector<std::string> nodeNames() const;
+
+ private:
+  //! Packet statistics of a node (as receiver, except for transmitted)
+  struct Stats {
+    uint64_t transmitted{0};
+    uint64_t received{0};
+    uint64_t rejected{0};  //! Received, but no address match or FIFO full
+    uint64_t collided{0};
+    uint64_t lost{0};
+    uint64_t missed{0};  //! Not listening on the channel for the whole packet
+    double latencySum{0.0};
+    double latencyMax{0.0};
+  };
+
+  struct Node {
+    RfTransceiverIf *radio;
+    std::string name;
+    bool listening{false};
+    unsigned channel{0};
+    sc_core::sc_time listenStart{sc_core::SC_ZERO_TIME};
+    sc_core::sc_time rxTime{sc_core::SC_ZERO_TIME};  //! Closed RX windows
+    uint64_t rxWindows{0};
+    Stats stats;
+  };
+
+  struct Link {
+    sc_core::sc_time delay;
+    double loss;
+  };
+
+  //! A packet on air
+  struct Transmission {
+    uint64_t id;
+    int source;
+    sc_core::sc_time start;
+    sc_core::sc_time end;
+    RadioPacket packet;
+  };
+
+  //! Arrival of the end of a packet at a node
+  struct Arrival {
+    sc_core::sc_time time;
+    int node;
+    uint64_t id;
+    bool operator>(const Arrival &rhs) const { return time > rhs.time; }
+  };
+
+  std::vector<Node> m_nodes;
+  std::vector<Link> m_links;  //! Index is source * nodes + destination
+  sc_core::sc_time m_maxDelay{sc_core::SC_ZERO_TIME};
+
+  //! Recent transmissions, by increasing start time & id
+  std::deque<Transmission> m_air;
+  uint64_t m_nextId{0};
+
+  std::priority_queue<Arrival, std::vector<Arrival>, std::greater<Arrival>>
+      m_arrivals;
+  sc_core::sc_event m_arrivalEvent{"arrivalEvent"};
+
+  std::mt19937 m_rng;
+  std::uniform_real_distribution<double> m_uniform{0.0, 1.0};
+
+  /**
+   * @brief arrivalHandler resolve all packet arrivals due now.
+   */
+  void arrivalHandler();
+
+  /**
+   * @brief resolve decide whether a packet is received by a node.
+   */
+  void resolve(const Arrival &arrival);
+
+  const Transmission &transmission(const uint64_t id) const {
+    return m_air[id - m_air.front().id];
+  }
+
+  const Link &link(const int source, const int destination) const {
+    return m_links[source * m_nodes.size() + destination];
+  }
+
+  static std::string statsJson(const Stats &s);
+};
@@ -6,7 +6,10 @@
  */
 
 #include <systemc>
+#include "libs/make_unique.hpp"
+#include "ps/ConstantEnergyEvent.hpp"
 #include "sd/SpiDevice.hpp"
+#include "utilities/Utilities.hpp"
 
 using namespace sc_core;
 
@@ -17,16 +20,38 @@ SpiDevice::SpiDevice(const sc_module_name nm, ChipSelectPolarity polarity)
   sensitive << nReset;
 }
 
+void SpiDevice::end_of_elaboration() {
+  m_wordsTransferredEventId = powerModelPort->registerEvent(
+      this->name(),
+      std::make_unique<ConstantEnergyEvent>(this->name(), "words transferred"));
+}
+
 void SpiDevice::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay) {
   if (enabled() && nReset.read()) {
     // Read from the received payload & set response
     auto *ptr = trans.get_data_ptr();
     auto len = trans.get_data_length();
     auto *spiExtension = trans.get_extension<SpiTransactionExtension>();
-    spiExtension->response = readSlaveOut();
-    writeSlaveIn(trans.get_data_ptr()[0]);
+    const auto nWords = spiExtension->nWords(len);
+    if (nWords > 1) {
+      // Burst: shift all words through the device now, and return the
+      // slave-out words in the data buffer.
+      const auto wordSize = spiExtension->bytesPerWord();
+      for (unsigned i = 0; i < nWords; ++i) {
+        auto *word = &ptr[i * wordSize];
+        spiExtension->response = readSlaveOut();
+        writeSlaveIn(Utility::packBytes(word, wordSize));
+        Utility::unpackBytes(word, spiExtension->response, wordSize);
+        processWord();
+      }
+      powerModelPort->reportEvent(m_wordsTransferredEventId, nWords);
+    } else {
+      spiExtension->response = readSlaveOut();
+      writeSlaveIn(ptr[0]);
+      powerModelPort->reportEvent(m_wordsTransferredEventId);
+      m_transactionEvent.notify(delay);
+    }
     trans.set_response_status(tlm::TLM_OK_RESPONSE);
-    m_transactionEvent.notify(delay);
   }
 }
 
@@ -18,6 +18,12 @@
 
 /**
  * Base class for SPI devices.
+ *
+ * A transaction normally carries a single data word, which is handled by the
+ * device's processes after the annotated delay. A transaction carrying more
+ * than one word is a burst: each word is shifted through the device
+ * immediately (see processWord), and the data buffer is overwritten with the
+ * words shifted out by the device.
  */
 class SpiDevice : public sc_core::sc_module {
   SC_HAS_PROCESS(SpiDevice);
@@ -52,6 +58,12 @@ class SpiDevice : public sc_core::sc_module {
   virtual void b_transport(tlm::tlm_generic_payload &trans,
                            sc_core::sc_time &delay);
 
+  /**
+   * @brief end_of_elaboration register power model events. Derived classes
+   * overriding this must call SpiDevice::end_of_elaboration().
+   */
+  virtual void end_of_elaboration() override;
+
  protected:
   /* ------ Protected variables ------ */
   uint32_t m_SlaveInRegister;
@@ -65,6 +77,13 @@ class SpiDevice : public sc_core::sc_module {
    */
   virtual void reset() = 0;
 
+  /**
+   * @brief processWord handle the word in the slave-in register, and prepare
+   * the slave-out register for the next word. Called for every word of a burst
+   * transaction.
+   */
+  virtual void processWord() = 0;
+
   /**
    * @brief check whether enabled or not according to chipSelect signal and
    * chipSelectPolarity.
@@ -100,4 +119,7 @@ class SpiDevice : public sc_core::sc_module {
   const ChipSelectPolarity m_chipSelectPolarity;
   sc_core::sc_event m_transactionEvent{"m_transactionEvent"};
   RegisterFile m_regs;
+
+  /* Event ids */
+  int m_wordsTransferredEventId{-1};
 };
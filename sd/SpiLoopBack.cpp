@@ -33,3 +33,5 @@ void SpiLoopBack::reset(void) {
   m_SlaveOutRegister = 0;
   m_SlaveInRegister = 0;
 }
+
+void SpiLoopBack::processWord(void) { writeSlaveOut(readSlaveIn()); }
@@ -42,4 +42,9 @@ class SpiLoopBack : public SpiDevice {
    *              the SPI shift registers.
    */
   void reset() override;
+
+  /**
+   * @brief processWord Echo the slave-in word.
+   */
+  void processWord() override;
 };
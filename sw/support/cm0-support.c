@@ -18,6 +18,18 @@ void indicate_workload_begin() {
 
 void indicate_workload_end() { SIMPLE_MONITOR = SIMPLE_MONITOR_INDICATE_END; }
 
+void roi_begin(uint8_t id) { SIMPLE_MONITOR = SIMPLE_MONITOR_ROI_BEGIN(id); }
+
+void roi_end(uint8_t id) { SIMPLE_MONITOR = SIMPLE_MONITOR_ROI_END(id); }
+
+void indicate_boot_done() { SIMPLE_MONITOR = SIMPLE_MONITOR_BOOT_DONE; }
+
+void indicate_restore_done() { SIMPLE_MONITOR = SIMPLE_MONITOR_RESTORE_DONE; }
+
+void trace_start() { SIMPLE_MONITOR = SIMPLE_MONITOR_START_EVENT_LOG; }
+
+void trace_stop() { SIMPLE_MONITOR = SIMPLE_MONITOR_STOP_EVENT_LOG; }
+
 void indicate_test_fail() { SIMPLE_MONITOR = SIMPLE_MONITOR_TEST_FAIL; }
 
 void end_experiment() {
@@ -36,6 +36,42 @@ void indicate_workload_end() {
 #endif
 }
 
+void roi_begin(uint8_t id) {
+#ifdef SIMULATION
+  SIMPLE_MONITOR = SIMPLE_MONITOR_ROI_BEGIN(id);
+#endif
+}
+
+void roi_end(uint8_t id) {
+#ifdef SIMULATION
+  SIMPLE_MONITOR = SIMPLE_MONITOR_ROI_END(id);
+#endif
+}
+
+void indicate_boot_done() {
+#ifdef SIMULATION
+  SIMPLE_MONITOR = SIMPLE_MONITOR_BOOT_DONE;
+#endif
+}
+
+void indicate_restore_done() {
+#ifdef SIMULATION
+  SIMPLE_MONITOR = SIMPLE_MONITOR_RESTORE_DONE;
+#endif
+}
+
+void trace_start() {
+#ifdef SIMULATION
+  SIMPLE_MONITOR = SIMPLE_MONITOR_START_EVENT_LOG;
+#endif
+}
+
+void trace_stop() {
+#ifdef SIMULATION
+  SIMPLE_MONITOR = SIMPLE_MONITOR_STOP_EVENT_LOG;
+#endif
+}
+
 void indicate_test_fail() {
   P1OUT &= ~BIT3;
 #ifdef SIMULATION
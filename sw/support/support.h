@@ -30,6 +30,20 @@ void indicate_workload_begin();
 // Indicate end of workload
 void indicate_workload_end();
 
+// Open region of interest id (0-255), measured by the simulator
+void roi_begin(uint8_t id);
+
+// Close region of interest id
+void roi_end(uint8_t id);
+
+// Mark the end of boot/state restoration in the current power cycle
+void indicate_boot_done();
+void indicate_restore_done();
+
+// Open/close the simulator's trace window (detailed logging & tracing)
+void trace_start();
+void trace_stop();
+
 // Indicate test fail
 void indicate_test_fail();
 
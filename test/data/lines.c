@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Source of the ElfLines & Coverage test fixtures, 32-bit little-endian ELF
+ * files with a DWARF 4 & 5 line table, built in this directory with
+ *   gcc -m32 -g -gdwarf-<N> -O0 -fno-pie -nostdlib -static
+ *       -fdebug-prefix-map=$PWD=. -Wl,-Ttext=0x4400 -Wl,-e,main
+ *       -Wl,--build-id=none -Wl,-N -o lines_dwarf<N>.elf lines.c
+ *
+ * Test expectations depend on the line numbers below.
+ */
+
+int x;
+
+void set(void) {
+  x = 1;
+}
+
+void unused(void) {
+  x = 2;
+}
+
+int main(void) {
+  set();
+  return x;
+}
@@ -319,6 +319,39 @@ SC_MODULE(tester) {
     sc_assert(spiRead(Accelerometer::RegisterAddress::CTRL, 1)[0] &
               Accelerometer::BitMasks::CTRL_MODE_STANDBY);
 
+    //-------------------------------------------------------------------------
+    spdlog::info("TEST: Burst read of measurement frames");
+    resetDut();
+
+    // Move to standby mode
+    spiWrite(Accelerometer::RegisterAddress::CTRL,
+             Accelerometer::BitMasks::CTRL_MODE_STANDBY);
+    wait(sc_time::from_seconds(Accelerometer::DELAY_SLEEP_TO_STANDBY));
+
+    // 1 ms sampling time
+    spiWrite(Accelerometer::RegisterAddress::CTRL_FS, 10);
+
+    // Sample all axes in continuous mode, stop after two frames
+    spiWrite(Accelerometer::RegisterAddress::CTRL,
+             Accelerometer::BitMasks::CTRL_MODE_CONTINUOUS |
+                 Accelerometer::BitMasks::CTRL_X_EN |
+                 Accelerometer::BitMasks::CTRL_Y_EN |
+                 Accelerometer::BitMasks::CTRL_Z_EN);
+    wait(sc_time(2.5, SC_MS));
+    spiWrite(Accelerometer::RegisterAddress::CTRL,
+             Accelerometer::BitMasks::CTRL_MODE_STANDBY);
+
+    // Read both frames in a single transaction
+    sc_time burstStart = sc_time_stamp();
+    resvec = spiBurstRead(Accelerometer::RegisterAddress::DATA, 2 * 4);
+    sc_assert(sc_time_stamp() - burstStart == sc_time(10 * 8 * 9, SC_US));
+    for (int i = 0; i < 2; i++) {
+      sc_assert(resvec[4 * i + 0] == 7);   // header
+      sc_assert(resvec[4 * i + 1] == 0);   // x
+      sc_assert(resvec[4 * i + 2] == 0);   // y
+      sc_assert(resvec[4 * i + 3] == 62);  // z
+    }
+
     sc_stop();
   }
 
@@ -402,6 +435,40 @@ SC_MODULE(tester) {
     return response;
   }
 
+  std::vector<uint8_t> spiBurstRead(const uint8_t addr, const size_t len) {
+    // Prepare payload object: address followed by len dummy bytes
+    std::vector<uint8_t> data(len + 1, 0);
+    data[0] = addr | READ_BIT;
+    tlm::tlm_generic_payload trans;
+
+    auto *spiExtension = new SpiTransactionExtension();
+
+    spiExtension->clkPeriod = sc_core::sc_time(10, sc_core::SC_US);
+    spiExtension->nDataBits = 8;
+    spiExtension->phase = SpiTransactionExtension::SpiPhase::CAPTURE_FIRST_EDGE;
+    spiExtension->polarity = SpiTransactionExtension::SpiPolarity::HIGH;
+    spiExtension->bitOrder = SpiTransactionExtension::SpiBitOrder::MSB_FIRST;
+
+    trans.set_extension(spiExtension);
+    trans.set_address(0);  // SPI doesn't use address
+    trans.set_data_length(data.size());
+    trans.set_command(tlm::TLM_WRITE_COMMAND);
+    trans.set_data_ptr(&data[0]);
+    sc_time delay = spiExtension->transferTime(data.size());
+
+    // Transfer address and data in one go
+    test.chipSelect.write(sc_dt::SC_LOGIC_0);
+    wait(SC_ZERO_TIME);
+    test.iSpiSocket->b_transport(trans, delay);
+    sc_assert(trans.is_response_ok());
+    wait(delay);
+    test.chipSelect.write(sc_dt::SC_LOGIC_1);
+    wait(SC_ZERO_TIME);
+
+    // Response to the address byte is discarded
+    return std::vector<uint8_t>(data.begin() + 1, data.end());
+  }
+
   static const unsigned READ_BIT = (1u << 7);
 
   dut test{"dut"};
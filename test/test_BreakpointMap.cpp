@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/spdlog.h>
+#include <stdint.h>
+#include <systemc>
+#include <vector>
+#include "utilities/BreakpointMap.hpp"
+
+int sc_main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[]) {
+  const uint32_t codeStart = 0x4000;
+  const uint32_t codeEnd = 0x4400;
+  BreakpointMap bp(codeStart, codeEnd);
+
+  spdlog::info("TEST: Empty map");
+  sc_assert(bp.size() == 0);
+  sc_assert(!bp.contains(codeStart));
+  sc_assert(!bp.contains(0));
+  sc_assert(bp.addresses().empty());
+
+  spdlog::info("TEST: Insert in the code region");
+  bp.insert(codeStart);
+  bp.insert(codeStart + 0x7e);  // Last slot of the first bitmap word
+  bp.insert(codeStart + 0x80);  // First slot of the second bitmap word
+  bp.insert(codeEnd - 2);
+  sc_assert(bp.size() == 4);
+  sc_assert(bp.contains(codeStart));
+  sc_assert(bp.contains(codeStart + 0x7e));
+  sc_assert(bp.contains(codeStart + 0x80));
+  sc_assert(bp.contains(codeEnd - 2));
+  sc_assert(!bp.contains(codeStart + 2));
+  sc_assert(!bp.contains(codeStart + 0x7c));
+  sc_assert(!bp.contains(codeEnd));
+
+  spdlog::info("TEST: Duplicates are counted once");
+  bp.insert(codeStart);
+  sc_assert(bp.size() == 4);
+
+  spdlog::info("TEST: Outside the code region & unaligned");
+  bp.insert(codeStart - 2);
+  bp.insert(codeEnd);
+  bp.insert(codeStart + 3);
+  sc_assert(bp.size() == 7);
+  sc_assert(bp.contains(codeStart - 2));
+  sc_assert(bp.contains(codeEnd));
+  sc_assert(bp.contains(codeStart + 3));
+  sc_assert(!bp.contains(codeStart + 2));  // Doesn't alias the unaligned one
+  sc_assert(!bp.contains(codeStart + 1));
+
+  spdlog::info("TEST: Addresses are sorted");
+  const std::vector<uint32_t> expected{
+      codeStart - 2,     codeStart,   codeStart + 3, codeStart + 0x7e,
+      codeStart + 0x80,  codeEnd - 2, codeEnd};
+  sc_assert(bp.addresses() == expected);
+
+  spdlog::info("TEST: Erase");
+  bp.erase(codeStart + 0x7e);
+  bp.erase(codeEnd);
+  bp.erase(codeStart + 3);
+  bp.erase(codeStart + 0x100);  // Not set
+  sc_assert(bp.size() == 4);
+  sc_assert(!bp.contains(codeStart + 0x7e));
+  sc_assert(!bp.contains(codeEnd));
+  sc_assert(!bp.contains(codeStart + 3));
+  sc_assert(bp.contains(codeStart + 0x80));
+
+  bp.erase(codeStart - 2);
+  bp.erase(codeStart);
+  bp.erase(codeStart + 0x80);
+  bp.erase(codeEnd - 2);
+  sc_assert(bp.size() == 0);
+  sc_assert(!bp.contains(codeStart + 0x80));
+  sc_assert(bp.addresses().empty());
+
+  spdlog::info("Test successful.");
+  return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/spdlog.h>
+#include <tlm_utils/simple_initiator_socket.h>
+#include <string>
+#include <systemc>
+#include <tlm>
+#include <vector>
+#include "mcu/Bus.hpp"
+#include "mcu/ClockSourceChannel.hpp"
+#include "mcu/DummyPeripheral.hpp"
+#include "mcu/InstructionFetchExtension.hpp"
+#include "ps/PowerModelChannel.hpp"
+#include "utilities/Config.hpp"
+
+using namespace sc_core;
+
+//! Watchpoint hit, as seen by the handler
+struct Hit {
+  unsigned addr;
+  Bus::WatchType type;
+};
+
+SC_MODULE(dut) {
+ public:
+  sc_signal<bool> pwrGood{"pwrGood", true};
+  tlm_utils::simple_initiator_socket<dut> iSocket{"iSocket"};
+  ClockSourceChannel clk{"clk", sc_time(1, SC_NS)};
+  PowerModelChannel powerModelChannel{"powerModelChannel", "/tmp",
+                                      sc_time(1, SC_US)};
+
+  SC_CTOR(dut) {
+    mem.pwrOn.bind(pwrGood);
+    mem.systemClk.bind(clk);
+    mem.powerModelPort.bind(powerModelChannel);
+    iSocket.bind(bus.tSocket);
+    bus.bindTarget(mem);
+    bus.setWatchpointHandler([this](unsigned addr, Bus::WatchType type) {
+      hits.push_back(Hit{addr, type});
+    });
+  }
+
+  Bus bus{"bus"};
+  DummyPeripheral mem{"mem", 0x1000, 0x1fff};
+  std::vector<Hit> hits;
+};
+
+SC_MODULE(tester) {
+ public:
+  SC_CTOR(tester) { SC_THREAD(runtests); }
+
+  void runtests() {
+    wait(SC_ZERO_TIME);
+
+    spdlog::info("TEST: No watchpoints");
+    access(0x1000, tlm::TLM_WRITE_COMMAND);
+    access(0x1000, tlm::TLM_READ_COMMAND);
+    sc_assert(test.hits.empty());
+
+    spdlog::info("TEST: Write watchpoint");
+    test.bus.insertWatchpoint(0x1100, 4, Bus::WatchType::Write);
+    access(0x1100, tlm::TLM_READ_COMMAND);
+    sc_assert(test.hits.empty());
+    access(0x1102, tlm::TLM_WRITE_COMMAND);
+    sc_assert(test.hits.size() == 1);
+    sc_assert(test.hits[0].addr == 0x1102);
+    sc_assert(test.hits[0].type == Bus::WatchType::Write);
+
+    spdlog::info("TEST: Range bounds");
+    access(0x10fe, tlm::TLM_WRITE_COMMAND);  // Just below
+    access(0x1104, tlm::TLM_WRITE_COMMAND);  // Just above
+    sc_assert(test.hits.size() == 1);
+    access(0x1100, tlm::TLM_WRITE_COMMAND, 1);
+    sc_assert(test.hits.size() == 2);
+    test.hits.clear();
+
+    spdlog::info("TEST: Remove");
+    sc_assert(!test.bus.removeWatchpoint(0x1100, 4, Bus::WatchType::Read));
+    sc_assert(!test.bus.removeWatchpoint(0x1100, 2, Bus::WatchType::Write));
+    sc_assert(test.bus.removeWatchpoint(0x1100, 4, Bus::WatchType::Write));
+    access(0x1100, tlm::TLM_WRITE_COMMAND);
+    sc_assert(test.hits.empty());
+
+    spdlog::info("TEST: Read watchpoint ignores writes & instruction fetches");
+    test.bus.insertWatchpoint(0x1200, 2, Bus::WatchType::Read);
+    access(0x1200, tlm::TLM_WRITE_COMMAND);
+    access(0x1200, tlm::TLM_READ_COMMAND, 2, /*fetch=*/true);
+    sc_assert(test.hits.empty());
+    access(0x1200, tlm::TLM_READ_COMMAND);
+    sc_assert(test.hits.size() == 1);
+    sc_assert(test.hits[0].type == Bus::WatchType::Read);
+    test.bus.removeWatchpoint(0x1200, 2, Bus::WatchType::Read);
+    test.hits.clear();
+
+    spdlog::info("TEST: Access watchpoint ignores instruction fetches");
+    test.bus.insertWatchpoint(0x1300, 2, Bus::WatchType::Access);
+    access(0x1300, tlm::TLM_READ_COMMAND, 2, /*fetch=*/true);
+    sc_assert(test.hits.empty());
+    access(0x1300, tlm::TLM_READ_COMMAND);
+    access(0x1300, tlm::TLM_WRITE_COMMAND);
+    sc_assert(test.hits.size() == 2);
+    sc_assert(test.hits[0].type == Bus::WatchType::Access);
+    test.hits.clear();
+
+    spdlog::info("TEST: Zero length watches one byte");
+    test.bus.insertWatchpoint(0x1401, 0, Bus::WatchType::Write);
+    access(0x1400, tlm::TLM_WRITE_COMMAND, 1);
+    access(0x1402, tlm::TLM_WRITE_COMMAND, 1);
+    sc_assert(test.hits.empty());
+    access(0x1400, tlm::TLM_WRITE_COMMAND, 2);
+    sc_assert(test.hits.size() == 1);
+    sc_assert(test.bus.removeWatchpoint(0x1401, 0, Bus::WatchType::Write));
+
+    spdlog::info("Test successful.");
+    sc_stop();
+  }
+
+  void access(const uint32_t addr, const tlm::tlm_command cmd,
+              const unsigned len = 2, const bool fetch = false) {
+    sc_time delay = SC_ZERO_TIME;
+    tlm::tlm_generic_payload trans;
+    unsigned char data[4] = {0};
+    trans.set_data_ptr(data);
+    trans.set_data_length(len);
+    trans.set_command(cmd);
+    trans.set_address(addr);
+    if (fetch) {
+      trans.set_extension(&m_fetch);
+    }
+    test.iSocket->b_transport(trans, delay);
+    if (fetch) {
+      trans.clear_extension(&m_fetch);
+    }
+    wait(delay);
+  }
+
+  InstructionFetchExtension m_fetch;
+  dut test{"dut"};
+};
+
+int sc_main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[]) {
+  auto &config = Config::get();
+  config.parseFile();
+
+  tester t("tester");
+  sc_start();
+  return 0;
+}
@@ -19,6 +19,7 @@
 #include "mcu/ClockSourceIf.hpp"
 #include "mcu/NonvolatileMemory.hpp"
 #include "ps/PowerModelChannel.hpp"
+#include "utilities/Checkpoint.hpp"
 #include "utilities/Config.hpp"
 #include "utilities/Utilities.hpp"
 
@@ -95,6 +96,19 @@ SC_MODULE(tester) {
       sc_assert(readWord(test.cacheSocket, addresses[i]) == (values[i] & mask));
     }
 
+    // ------ TEST: Checkpoint & restore cache and memory contents
+    // Dirty lines (write-back) must survive the round trip
+    const std::string checkpointPath = "/tmp/fused_test_cache.ckp";
+    Checkpoint::save(checkpointPath);
+    for (int addr = 0; addr < NVM_SIZE; addr += TARGET_WORD_SIZE) {
+      writeWord(test.cacheSocket, addr, 0x5A5A);
+    }
+    Checkpoint::restore(checkpointPath);
+    for (int i = 0; i < addresses.size(); i++) {
+      unsigned mask = (1ull << 8 * TARGET_WORD_SIZE) - 1;
+      sc_assert(readWord(test.cacheSocket, addresses[i]) == (values[i] & mask));
+    }
+
     spdlog::info("Test successful.");
     sc_stop();
   }
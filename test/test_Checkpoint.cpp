@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/spdlog.h>
+#include <stdint.h>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <systemc>
+#include <vector>
+#include "utilities/Checkpoint.hpp"
+
+using namespace sc_core;
+
+namespace {
+
+//! Offset of the time field in the checkpoint header (after magic & version)
+const size_t TIME_POS = 8 + sizeof(uint32_t);
+
+class TestState : public Checkpointable {
+ public:
+  explicit TestState(const std::string &name) {
+    registerCheckpointable(name);
+  }
+
+  virtual void saveState(CheckpointWriter &writer) const override {
+    writer.write(scalar);
+    writer.writeVector(image);
+    writer.writeContainer(queue);
+  }
+
+  virtual void restoreState(CheckpointReader &reader) override {
+    reader.read(scalar);
+    reader.readVector(image);
+    reader.readContainer(queue);
+  }
+
+  uint32_t scalar{0};
+  std::vector<uint8_t> image;
+  std::deque<uint16_t> queue;
+};
+
+std::vector<uint8_t> readFile(const char *path) {
+  std::ifstream is(path, std::ios::binary);
+  return std::vector<uint8_t>((std::istreambuf_iterator<char>(is)),
+                              std::istreambuf_iterator<char>());
+}
+
+void writeFile(const char *path, const std::vector<uint8_t> &data) {
+  std::ofstream os(path, std::ios::binary);
+  os.write(reinterpret_cast<const char *>(data.data()), data.size());
+}
+
+uint64_t timeField(const std::vector<uint8_t> &data) {
+  uint64_t t;
+  std::memcpy(&t, &data[TIME_POS], sizeof(t));
+  return t;
+}
+
+bool exists(const char *path) { return std::ifstream(path).good(); }
+
+}  // namespace
+
+int sc_main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[]) {
+  TestState a("a"), b("b");
+  const sc_time t0(10, SC_MS);
+  sc_start(t0);
+
+  a.scalar = 0xdeadbeef;
+  a.image = std::vector<uint8_t>(4096, 0x5a);
+  a.queue = {1, 2, 3};
+  b.scalar = 42;
+
+  spdlog::info("TEST: Save -> restore -> compare");
+  Checkpoint::save("/tmp/testCheckpoint0.bin");
+  a.scalar = 0;
+  a.image.clear();
+  a.queue.clear();
+  b.scalar = 0;
+  sc_assert(Checkpoint::restore("/tmp/testCheckpoint0.bin") == t0);
+  sc_assert(a.scalar == 0xdeadbeef);
+  sc_assert(a.image == std::vector<uint8_t>(4096, 0x5a));
+  sc_assert(a.queue == std::deque<uint16_t>({1, 2, 3}));
+  sc_assert(b.scalar == 42);
+
+  spdlog::info("TEST: Restored state saves to the same checkpoint");
+  Checkpoint::save("/tmp/testCheckpoint1.bin");
+  const auto ckp0 = readFile("/tmp/testCheckpoint0.bin");
+  sc_assert(!ckp0.empty() && ckp0 == readFile("/tmp/testCheckpoint1.bin"));
+
+  spdlog::info("TEST: Time continues from the checkpoint time");
+  // As if taken at 1 s by an earlier run; this run restores it at 10 ms
+  const sc_time taken(1, SC_SEC), dt(5, SC_MS);
+  auto later = ckp0;
+  const uint64_t t = taken.value();
+  std::memcpy(&later[TIME_POS], &t, sizeof(t));
+  writeFile("/tmp/testCheckpoint1.bin", later);
+  sc_assert(Checkpoint::restore("/tmp/testCheckpoint1.bin") == taken);
+  sc_assert(Checkpoint::now() == taken);
+  sc_start(dt);
+  sc_assert(Checkpoint::now() == taken + dt);
+  Checkpoint::save("/tmp/testCheckpoint1.bin");
+  sc_assert(timeField(readFile("/tmp/testCheckpoint1.bin")) ==
+            (taken + dt).value());
+
+  spdlog::info("TEST: Requests are deferred, unless the CPU is idle");
+  std::remove("/tmp/testCheckpoint2.bin");
+  Checkpoint::request("/tmp/testCheckpoint2.bin");
+  sc_assert(!exists("/tmp/testCheckpoint2.bin"));
+  Checkpoint::serviceRequest();
+  sc_assert(exists("/tmp/testCheckpoint2.bin"));
+  sc_assert(!Checkpoint::g_requestPending);
+
+  std::remove("/tmp/testCheckpoint3.bin");
+  Checkpoint::setIdle(true);
+  Checkpoint::request("/tmp/testCheckpoint3.bin");
+  sc_assert(exists("/tmp/testCheckpoint3.bin"));
+  sc_assert(!Checkpoint::g_requestPending);
+  Checkpoint::setIdle(false);
+
+  return 0;
+}
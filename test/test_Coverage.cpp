@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/spdlog.h>
+#include <stdint.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <systemc>
+#include "utilities/Config.hpp"
+#include "utilities/Coverage.hpp"
+#include "utilities/ElfLines.hpp"
+
+// Built from data/lines.c, see there for the expected lines
+const std::string DWARF4_ELF = std::string(TEST_DATA_DIR) + "/lines_dwarf4.elf";
+const std::string DWARF5_ELF = std::string(TEST_DATA_DIR) + "/lines_dwarf5.elf";
+
+const uint32_t CODE_START = 0x4400;
+const uint32_t CODE_END = 0x4430;
+
+std::string readFile(const std::string &path) {
+  std::ifstream f(path);
+  std::stringstream ss;
+  ss << f.rdbuf();
+  return ss.str();
+}
+
+void testLines(const std::string &path, const std::string &file) {
+  spdlog::info("TEST: Line table of {:s}", path);
+  const ElfLines lines(path);
+  sc_assert(lines.isValid());
+  sc_assert(lines.files().size() == 1);
+  sc_assert(lines.rows().size() == 10);
+
+  // Address ranges of set() (lines 20-22), unused() & main()
+  const struct {
+    uint32_t addr;
+    uint32_t end;
+    unsigned line;
+  } expected[] = {{0x4400, 0x4403, 20}, {0x4403, 0x440d, 21},
+                  {0x440d, 0x4410, 22}, {0x4410, 0x4413, 24},
+                  {0x4413, 0x441d, 25}, {0x441d, 0x4420, 26},
+                  {0x4420, 0x4423, 28}, {0x4423, 0x4428, 29},
+                  {0x4428, 0x442d, 30}, {0x442d, 0x442f, 31}};
+  for (size_t i = 0; i < lines.rows().size(); ++i) {
+    const auto &row = lines.rows()[i];
+    sc_assert(row.addr == expected[i].addr);
+    sc_assert(row.end == expected[i].end);
+    sc_assert(row.line == expected[i].line);
+    sc_assert(lines.files()[row.file] == file);
+  }
+
+  spdlog::info("TEST: Address lookup");
+  sc_assert(lines.find(0x4400) == 0);
+  sc_assert(lines.find(0x440c) == 1);
+  sc_assert(lines.rows()[lines.find(0x4424)].line == 29);
+  sc_assert(lines.rows()[lines.find(0x442e)].line == 31);
+  sc_assert(lines.find(0x43ff) == -1);
+  sc_assert(lines.find(0x442f) == -1);
+}
+
+void testCoverage() {
+  spdlog::info("TEST: lcov output");
+  auto &config = Config::get();
+  config.set("Coverage", "True");
+  config.set("CoverageElf", DWARF5_ELF);
+  config.set("OutputDirectory", "/tmp");
+  sc_assert(Coverage::isEnabled());
+
+  Coverage coverage("testCoverage", CODE_START, CODE_END);
+  coverage.reset();  // Power-on, nothing executed yet
+  coverage.mark(0x4420);  // main() entry, line 28
+  coverage.mark(0x4428);  // Line 30
+  coverage.mark(0x5000);  // Outside the code region, ignored
+  coverage.reset();       // Power failure
+  coverage.mark(0x4400);  // set() entry, line 20
+  coverage.mark(0x4406);  // Line 21
+  coverage.mark(0x4420);  // Again
+  coverage.write();
+
+  const std::string all =
+      "TN:fused\nSF:./lines.c\n"
+      "FN:28,main\nFN:20,set\nFN:24,unused\n"
+      "FNDA:1,main\nFNDA:1,set\nFNDA:0,unused\n"
+      "FNF:3\nFNH:2\n"
+      "DA:20,1\nDA:21,1\nDA:22,0\nDA:24,0\nDA:25,0\nDA:26,0\n"
+      "DA:28,1\nDA:29,0\nDA:30,1\nDA:31,0\n"
+      "LF:10\nLH:4\nend_of_record\n";
+  sc_assert(readFile("/tmp/testCoverage_coverage.info") == all);
+
+  spdlog::info("TEST: lcov output, only after reboot");
+  const std::string afterReboot =
+      "TN:fused_after_reboot\nSF:./lines.c\n"
+      "FN:20,set\nFNDA:1,set\nFNF:1\nFNH:1\n"
+      "DA:20,1\nDA:21,1\nLF:2\nLH:2\nend_of_record\n";
+  sc_assert(readFile("/tmp/testCoverage_coverage_after_reboot.info") ==
+            afterReboot);
+}
+
+int sc_main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[]) {
+  // The compilation directory is implicit in DWARF 4, file 0 in DWARF 5
+  testLines(DWARF4_ELF, "lines.c");
+  testLines(DWARF5_ELF, "./lines.c");
+
+  spdlog::info("TEST: Missing file");
+  sc_assert(!ElfLines("/nonexistent.elf").isValid());
+
+  testCoverage();
+
+  spdlog::info("Test successful.");
+  return 0;
+}
@@ -148,6 +148,27 @@ SC_MODULE(tester) {
       }
     }
 
+    // ------ TEST: Input edges & interrupt flags
+    test.m_dut.reset();
+    writeWord(OFS_PADIR, 0x0000);
+    writeWord(OFS_PAIES, 0x0100);  // Pin 8 interrupts on falling edge
+    writeWord(OFS_PAIE, 0x0108);
+
+    test.port[3].write(sc_dt::SC_LOGIC_1);
+    test.port[8].write(sc_dt::SC_LOGIC_1);
+    wait(sc_time(1, SC_NS));  // Wait for pins to be sampled
+    sc_assert(readWord(OFS_PAIN) == 0x0108);
+    sc_assert(readWord(OFS_PAIFG) == 0x0008);  // Only rising edge on pin 3
+    sc_assert(test.m_dut.portState.read() == 0x0108);
+    sc_assert(test.irq0.read());
+    sc_assert(!test.irq1.read());
+
+    test.port[8].write(sc_dt::SC_LOGIC_0);
+    wait(sc_time(1, SC_NS));
+    sc_assert(readWord(OFS_PAIN) == 0x0008);
+    sc_assert(readWord(OFS_PAIFG) == 0x0108);
+    sc_assert(test.irq1.read());
+
     spdlog::info("Test successful.");
     sc_stop();
   }
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/spdlog.h>
+#include <stdint.h>
+#include <systemc>
+#include "mcu/InterruptController.hpp"
+
+using namespace sc_core;
+
+SC_MODULE(tester) {
+ public:
+  // MSP430: one priority level, as in Msp430Microcontroller
+  InterruptController msp430{"msp430", 37};
+  // Cortex-M0: 4 priority levels, as in Nvic
+  InterruptController cm0{"cm0", 32, 4};
+
+  // Peripheral-side ports, bound like a peripheral's irq/ira
+  sc_out<bool> timerIrq{"timerIrq"};
+  sc_in<bool> timerIra{"timerIra"};
+  sc_out<bool> portIrq{"portIrq"};
+  sc_in<bool> portIra{"portIra"};
+
+  SC_CTOR(tester) {
+    timerIrq.bind(msp430.irqLine(10));
+    timerIra.bind(msp430.iraLine(10));
+    portIrq.bind(msp430.irqLine(36));
+    portIra.bind(msp430.iraLine(36));
+
+    SC_METHOD(countPendingChanges);
+    sensitive << msp430;
+    dont_initialize();
+
+    SC_THREAD(peripheral);
+    SC_THREAD(runtests);
+  }
+
+  void countPendingChanges() { ++m_pendingChanges; }
+
+  //! Requests an interrupt, and withdraws it once accepted
+  void peripheral() {
+    wait(m_startPeripheral);
+    portIrq.write(true);
+    wait(portIra.posedge_event());
+    portIrq.write(false);
+    m_peripheralDone = true;
+  }
+
+  void runtests() {
+    wait(SC_ZERO_TIME);
+    testMsp430();
+    testMsp430Handshake();
+    testCm0();
+    spdlog::info("Test successful.");
+    sc_stop();
+  }
+
+  void testMsp430() {
+    spdlog::info("TEST: MSP430 nothing pending");
+    sc_assert(msp430.highestPending() == -1);
+    sc_assert(msp430.pendingMask() == 0);
+
+    spdlog::info("TEST: MSP430 irq lines set the pending mask immediately");
+    timerIrq.write(true);
+    sc_assert(msp430.isPending(10));
+    sc_assert(msp430.pendingMask() == (uint64_t(1) << 10));
+    sc_assert(msp430.highestPending() == 10);
+    portIrq.write(true);
+    sc_assert(msp430.isPending(36));
+    sc_assert(msp430.highestPending() == 10);
+
+    spdlog::info("TEST: MSP430 pending changes notify the default event");
+    wait(1, SC_NS);
+    sc_assert(m_pendingChanges == 1);  // Both writes in one delta
+
+    spdlog::info("TEST: MSP430 lowest index wins");
+    msp430.setPending(0, true);
+    sc_assert(msp430.highestPending() == 0);
+    msp430.setPending(0, false);
+    sc_assert(msp430.highestPending() == 10);
+
+    spdlog::info("TEST: MSP430 clearing a request");
+    timerIrq.write(false);
+    sc_assert(!msp430.isPending(10));
+    sc_assert(msp430.highestPending() == 36);
+    wait(1, SC_NS);
+    sc_assert(m_pendingChanges == 2);
+
+    spdlog::info("TEST: MSP430 disabled sources are skipped");
+    timerIrq.write(true);
+    msp430.setEnableMask(~(uint64_t(1) << 10));
+    sc_assert(msp430.isPending(10));
+    sc_assert(msp430.highestPending() == 36);
+    msp430.setEnableMask(~uint64_t(0));
+    sc_assert(msp430.enableMask() == (uint64_t(1) << 37) - 1);
+    sc_assert(msp430.highestPending() == 10);
+
+    spdlog::info("TEST: MSP430 masks are limited to the sources");
+    msp430.setPendingMask(~uint64_t(0));
+    sc_assert(msp430.pendingMask() == (uint64_t(1) << 37) - 1);
+    sc_assert(msp430.highestPending() == 0);
+    msp430.setPendingMask(0);
+    sc_assert(msp430.highestPending() == -1);
+    timerIrq.write(false);
+    portIrq.write(false);
+    wait(SC_ZERO_TIME);
+  }
+
+  void testMsp430Handshake() {
+    spdlog::info("TEST: MSP430 acknowledge drives the ira line");
+    sc_assert(!timerIra.read());
+    msp430.acknowledge(10, true);
+    sc_assert(timerIra.read());
+    sc_assert(!portIra.read());
+    wait(timerIra.posedge_event());
+    msp430.acknowledge(10, false);
+    sc_assert(!timerIra.read());
+    wait(timerIra.negedge_event());
+
+    spdlog::info("TEST: MSP430 request, accept & withdraw");
+    m_startPeripheral.notify();
+    wait(msp430.default_event());
+    const int idx = msp430.highestPending();
+    sc_assert(idx == 36);
+    msp430.acknowledge(idx, true);
+    wait(1, SC_NS);  // Let the peripheral react
+    sc_assert(m_peripheralDone);
+    sc_assert(!msp430.isPending(36));
+    sc_assert(msp430.highestPending() == -1);
+    msp430.acknowledge(idx, false);
+    sc_assert(!portIra.read());
+  }
+
+  void testCm0() {
+    spdlog::info("TEST: Cm0 all sources start at the highest level");
+    cm0.setPending(3, true);
+    cm0.setPending(20, true);
+    sc_assert(cm0.highestPending() == 3);
+
+    spdlog::info("TEST: Cm0 higher priority level wins over lower index");
+    cm0.setPriority(3, 2);
+    cm0.setPriority(20, 1);
+    sc_assert(cm0.highestPending() == 20);
+    cm0.setPending(25, true);  // Still at level 0
+    sc_assert(cm0.highestPending() == 25);
+    cm0.setPriority(25, 3);
+    sc_assert(cm0.highestPending() == 20);
+
+    spdlog::info("TEST: Cm0 lowest index wins within a level");
+    cm0.setPriority(4, 1);
+    cm0.setPending(4, true);
+    sc_assert(cm0.highestPending() == 4);
+
+    spdlog::info("TEST: Cm0 moving a source between levels");
+    cm0.setPriority(4, 3);
+    sc_assert(cm0.highestPending() == 20);
+    cm0.setPriority(20, 3);
+    sc_assert(cm0.highestPending() == 3);
+
+    spdlog::info("TEST: Cm0 enable mask & clear");
+    cm0.setEnableMask(~(uint64_t(1) << 3));
+    sc_assert(cm0.highestPending() == 4);
+    cm0.setPending(4, false);
+    sc_assert(cm0.highestPending() == 20);
+    cm0.setEnableMask(~uint64_t(0));
+    sc_assert(cm0.enableMask() == 0xffffffff);
+    cm0.setPendingMask(0);
+    sc_assert(cm0.highestPending() == -1);
+
+    spdlog::info("TEST: Cm0 ira lines");
+    cm0.acknowledge(31, true);
+    sc_assert(cm0.iraLine(31).read());
+    sc_assert(!cm0.iraLine(30).read());
+    cm0.acknowledge(31, false);
+    sc_assert(!cm0.iraLine(31).read());
+  }
+
+  sc_event m_startPeripheral;
+  unsigned m_pendingChanges{0};
+  bool m_peripheralDone{false};
+};
+
+int sc_main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[]) {
+  tester t("tester");
+  sc_start();
+  return 0;
+}
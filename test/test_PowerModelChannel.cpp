@@ -6,6 +6,8 @@
  */
 
 #include <spdlog/spdlog.h>
+#include <cmath>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <systemc>
@@ -131,6 +133,32 @@ SC_MODULE(tester) {
     test.outport->reportState(sid3);
     sc_assert(test.inport->getStaticCurrent() == 0.0);
 
+    spdlog::info("------ TEST: Time and static energy per state add up");
+    test.outport->reportState(sid2);
+    wait(10, SC_US);
+    test.inport->accountStaticEnergy(2.0, 10.0e-6);
+    test.outport->reportState(sid1);
+    sc_assert(std::abs(test.ch.getStateTime("module0", "on") - 10.0e-6) <
+              1.0e-12);
+    sc_assert(std::abs(test.ch.getStateTime("module1", "off") - 10.0e-6) <
+              1.0e-12);
+    sc_assert(test.ch.getStateTime("module0", "sleep") == 0.0);
+
+    spdlog::info("------ TEST: Summary holds popped event and static energy");
+    std::ostringstream summary;
+    test.ch.writeSummary(summary);
+    // 8 pJ of popped events, 1 uA * 2 V * 10 us static
+    sc_assert(summary.str().find("\"total_energy\": 2.8e-11") !=
+              std::string::npos);
+
+    spdlog::info("------ TEST: Summary includes pending events");
+    test.outport->reportEvent(eid2, 1);  // Not popped
+    std::ostringstream pending;
+    test.ch.writeSummary(pending);
+    sc_assert(pending.str().find("\"total_energy\": 3e-11") !=
+              std::string::npos);
+    sc_assert(std::abs(test.ch.getTotalEnergy() - 3.0e-11) < 1.0e-20);
+
     sc_stop();
   }
 
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/spdlog.h>
+#include <sstream>
+#include <systemc>
+#include <vector>
+#include "sd/RfMedium.hpp"
+#include "utilities/Config.hpp"
+
+using namespace sc_core;
+
+// Radio stand-in, accepts every packet it's given
+class FakeRadio : public RfTransceiverIf {
+ public:
+  virtual bool receive(const RadioPacket &packet) override {
+    received.push_back(packet);
+    return true;
+  }
+
+  std::vector<RadioPacket> received;
+};
+
+SC_MODULE(tester) {
+ public:
+  SC_CTOR(tester) {
+    a = medium.attach(radioA, "a");
+    b = medium.attach(radioB, "b");
+    c = medium.attach(radioC, "c");
+    SC_THREAD(runtests);
+  }
+
+  RadioPacket makePacket(const unsigned channel, const unsigned tag) {
+    RadioPacket p;
+    p.channelNumber = channel;
+    p.addressSize = 3;
+    p.payloadSize = 4;
+    for (unsigned i = 0; i < p.payloadSize; ++i) {
+      p.payload[i] = tag;
+    }
+    return p;  // 8 bytes at 1 Mbps: 64 us
+  }
+
+  void runtests() {
+    // Delivery to all listening nodes, at the end of the packet
+    medium.listen(b, 1);
+    medium.listen(c, 1);
+    wait(sc_time(10, SC_US));
+    medium.transmit(a, makePacket(1, 0x11));
+    wait(sc_time(63, SC_US));
+    sc_assert(radioB.received.empty());
+    wait(sc_time(2, SC_US));
+    sc_assert(radioB.received.size() == 1);
+    sc_assert(radioB.received.back().payload[0] == 0x11);
+    sc_assert(radioC.received.size() == 1);
+    sc_assert(radioA.received.empty());
+
+    // Wrong channel
+    medium.listen(c, 2);
+    medium.transmit(a, makePacket(1, 0x22));
+    wait(sc_time(100, SC_US));
+    sc_assert(radioB.received.size() == 2);
+    sc_assert(radioC.received.size() == 1);
+
+    // Listening only started during the packet
+    medium.stopListening(b);
+    medium.transmit(a, makePacket(1, 0x33));
+    wait(sc_time(10, SC_US));
+    medium.listen(b, 1);
+    wait(sc_time(100, SC_US));
+    sc_assert(radioB.received.size() == 2);
+
+    // Overlapping packets on the same channel collide at the receiver
+    medium.transmit(a, makePacket(1, 0x44));
+    wait(sc_time(30, SC_US));
+    medium.transmit(c, makePacket(1, 0x55));
+    wait(sc_time(100, SC_US));
+    sc_assert(radioB.received.size() == 2);
+
+    // ... but not on different channels
+    medium.transmit(a, makePacket(1, 0x66));
+    wait(sc_time(30, SC_US));
+    medium.transmit(c, makePacket(3, 0x77));
+    wait(sc_time(100, SC_US));
+    sc_assert(radioB.received.size() == 3);
+    sc_assert(radioB.received.back().payload[0] == 0x66);
+
+    std::stringstream summary;
+    medium.writeSummary(summary);
+    spdlog::info("{:s}", summary.str());
+
+    spdlog::info("{:s}: Testing Done @{:s} ", this->name(),
+                 sc_time_stamp().to_string());
+    sc_stop();
+  }
+
+  RfMedium medium{"medium"};
+  FakeRadio radioA, radioB, radioC;
+  int a, b, c;
+};
+
+int sc_main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[]) {
+  auto &config = Config::get();
+  config.parseFile();
+
+  tester t("tester");
+  sc_start();
+  return false;
+}
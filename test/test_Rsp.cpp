@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <spdlog/spdlog.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <string>
+#include <systemc>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include "mcu/Microcontroller.hpp"
+#include "utilities/RspProxy.hpp"
+#include "utilities/SimulationController.hpp"
+
+using namespace sc_core;
+
+namespace {
+
+const int PROXY_PORT = 51100;
+const int SERVER_PORT = 51101;
+
+//! Records watchpoint calls, reports a configurable watchpoint hit
+class MockMcu : public Microcontroller {
+ public:
+  explicit MockMcu(sc_module_name nm) : Microcontroller(nm) {}
+
+  virtual void stall() override {}
+  virtual void unstall() override {}
+  virtual bool isStalled() override { return true; }
+  virtual void step() override {}
+  virtual void reset() override {}
+  virtual uint32_t dbgReadReg(size_t) override { return 0; }
+  virtual void dbgWriteReg(size_t, uint32_t) override {}
+  virtual bool dbgReadMem(uint8_t *, size_t, size_t) override { return true; }
+  virtual bool dbgWriteMem(uint8_t *, size_t, size_t) override { return true; }
+  virtual void insertBreakpoint(unsigned) override {}
+  virtual void removeBreakpoint(unsigned) override {}
+
+  virtual bool insertWatchpoint(int type, unsigned addr,
+                                unsigned len) override {
+    watchpoints.emplace_back(type, addr, len);
+    return type >= 2 && type <= 4;
+  }
+
+  virtual bool removeWatchpoint(int type, unsigned addr,
+                                unsigned len) override {
+    for (auto it = watchpoints.begin(); it != watchpoints.end(); ++it) {
+      if (*it == std::make_tuple(type, addr, len)) {
+        watchpoints.erase(it);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  virtual bool stoppedByWatchpoint(unsigned &addr, int &type) const override {
+    addr = hitAddr;
+    type = hitType;
+    return hit;
+  }
+
+  virtual unsigned getPowerOnResetCount() const override { return 0; }
+  virtual uint64_t getInstructionCount() const override { return 0; }
+  virtual uint64_t getCycleCount() const override { return 0; }
+  virtual std::string getCpuName() const override { return "cpu"; }
+  virtual uint32_t pc_regnum() override { return 0; }
+  virtual uint32_t n_regs() override { return 16; }
+
+  std::vector<std::tuple<int, unsigned, unsigned>> watchpoints;
+  bool hit{false};
+  unsigned hitAddr{0};
+  int hitType{0};
+};
+
+int listenOn(const int port) {
+  const int fd = socket(AF_INET, SOCK_STREAM, 0);
+  const int yes = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+  sc_assert(bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+  sc_assert(listen(fd, 1) == 0);
+  return fd;
+}
+
+int connectTo(const int port) {
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+  for (int attempt = 0; attempt < 100; ++attempt) {
+    const int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0) {
+      return fd;
+    }
+    close(fd);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  sc_assert(false);
+  return -1;
+}
+
+std::string readN(const int fd, const size_t n) {
+  std::string s;
+  char c;
+  while (s.size() < n && read(fd, &c, 1) == 1) {
+    s += c;
+  }
+  return s;
+}
+
+void writeAll(const int fd, const std::string &s) {
+  sc_assert(write(fd, s.data(), s.size()) == static_cast<ssize_t>(s.size()));
+}
+
+}  // namespace
+
+int sc_main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[]) {
+  spdlog::info("TEST: Packet framing");
+  sc_assert(Rsp::checksum("") == 0);
+  sc_assert(Rsp::frame("OK") == "$OK#9a");
+  sc_assert(Rsp::frame("S05") == "$S05#b8");
+  sc_assert(Rsp::isStopReply("S05"));
+  sc_assert(Rsp::isStopReply("T05thread:01;"));
+  sc_assert(!Rsp::isStopReply("S0"));
+  sc_assert(!Rsp::isStopReply("S05x"));
+  sc_assert(!Rsp::isStopReply("OK"));
+  sc_assert(!Rsp::isStopReply("E01"));
+
+  spdlog::info("TEST: Watchpoint packet parser");
+  Rsp::WatchpointPacket w;
+  sc_assert(Rsp::parseWatchpointPacket("Z2,1c00,2", w) == Rsp::ParseResult::Ok);
+  sc_assert(w.insert && w.type == 2 && w.addr == 0x1c00 && w.len == 2);
+  sc_assert(Rsp::parseWatchpointPacket("z4,FFfe,1", w) == Rsp::ParseResult::Ok);
+  sc_assert(!w.insert && w.type == 4 && w.addr == 0xfffe && w.len == 1);
+  sc_assert(Rsp::parseWatchpointPacket("Z3,20000000,4;X1,0", w) ==
+            Rsp::ParseResult::Ok);
+  sc_assert(w.type == 3 && w.addr == 0x20000000 && w.len == 4);
+  // Breakpoints & others are left to the server
+  sc_assert(Rsp::parseWatchpointPacket("Z0,4400,2", w) ==
+            Rsp::ParseResult::NotWatchpoint);
+  sc_assert(Rsp::parseWatchpointPacket("Z1,4400,2", w) ==
+            Rsp::ParseResult::NotWatchpoint);
+  sc_assert(Rsp::parseWatchpointPacket("Z5,4400,2", w) ==
+            Rsp::ParseResult::NotWatchpoint);
+  sc_assert(Rsp::parseWatchpointPacket("m1c00,2", w) ==
+            Rsp::ParseResult::NotWatchpoint);
+  sc_assert(Rsp::parseWatchpointPacket("", w) ==
+            Rsp::ParseResult::NotWatchpoint);
+  // Malformed
+  sc_assert(Rsp::parseWatchpointPacket("Z2", w) ==
+            Rsp::ParseResult::Malformed);
+  sc_assert(Rsp::parseWatchpointPacket("Z2,", w) ==
+            Rsp::ParseResult::Malformed);
+  sc_assert(Rsp::parseWatchpointPacket("Z2,xyz,2", w) ==
+            Rsp::ParseResult::Malformed);
+  sc_assert(Rsp::parseWatchpointPacket("Z2,1c00", w) ==
+            Rsp::ParseResult::Malformed);
+  sc_assert(Rsp::parseWatchpointPacket("Z2,1c00,", w) ==
+            Rsp::ParseResult::Malformed);
+  sc_assert(Rsp::parseWatchpointPacket("Z2,1c00,2x", w) ==
+            Rsp::ParseResult::Malformed);
+
+  MockMcu mcu("mcu");
+  SimulationController simCtrl(&mcu);
+
+  spdlog::info("TEST: SimulationController watchpoint packets");
+  std::string reply;
+  sc_assert(!simCtrl.handleWatchpointPacket("Z0,4400,2", reply));
+  sc_assert(simCtrl.handleWatchpointPacket("Z3,1c00,2", reply));
+  sc_assert(reply == "OK");
+  sc_assert(mcu.watchpoints.size() == 1);
+  sc_assert(mcu.watchpoints[0] == std::make_tuple(3, 0x1c00u, 2u));
+  sc_assert(simCtrl.handleWatchpointPacket("Z2,1c00,q", reply));
+  sc_assert(reply == "E01");
+  sc_assert(simCtrl.handleWatchpointPacket("z3,1c00,2", reply));
+  sc_assert(reply == "OK");
+  sc_assert(mcu.watchpoints.empty());
+  sc_assert(simCtrl.handleWatchpointPacket("z3,1c00,2", reply));
+  sc_assert(reply == "E01");
+
+  spdlog::info("TEST: Stop replies");
+  sc_assert(simCtrl.stopReply() == "S05");
+  mcu.hit = true;
+  mcu.hitAddr = 0x1c02;
+  mcu.hitType = 2;
+  sc_assert(simCtrl.stopReply() == "T05watch:1c02;");
+  mcu.hitType = 3;
+  sc_assert(simCtrl.stopReply() == "T05rwatch:1c02;");
+  mcu.hitType = 4;
+  sc_assert(simCtrl.stopReply() == "T05awatch:1c02;");
+  mcu.hit = false;
+
+  spdlog::info("TEST: Proxy answers watchpoints, relays everything else");
+  const int serverListener = listenOn(SERVER_PORT);
+  RspProxy proxy(&simCtrl, PROXY_PORT, SERVER_PORT);
+  std::thread proxyThread(&RspProxy::run, &proxy);
+  const int gdb = connectTo(PROXY_PORT);
+  const int server = accept(serverListener, nullptr, nullptr);
+  sc_assert(server >= 0);
+
+  // Answered by the proxy, gdb's ack for the reply isn't forwarded
+  writeAll(gdb, Rsp::frame("Z2,1c00,2"));
+  sc_assert(readN(gdb, 7) == "+$OK#9a");
+  sc_assert(mcu.watchpoints.size() == 1);
+  writeAll(gdb, "+");
+
+  // Relayed both ways
+  writeAll(gdb, Rsp::frame("?"));
+  sc_assert(readN(server, 5) == "$?#3f");
+  writeAll(server, "+" + Rsp::frame("S05"));
+  sc_assert(readN(gdb, 8) == "+$S05#b8");
+  writeAll(gdb, "+");
+  sc_assert(readN(server, 1) == "+");
+
+  // Stop reply rewritten after a watchpoint hit
+  mcu.hit = true;
+  mcu.hitAddr = 0x1c00;
+  mcu.hitType = 2;
+  writeAll(gdb, Rsp::frame("?"));
+  sc_assert(readN(server, 5) == "$?#3f");
+  writeAll(server, "+" + Rsp::frame("S05"));
+  const auto expected = "+" + Rsp::frame("T05watch:1c00;");
+  sc_assert(readN(gdb, expected.size()) == expected);
+
+  close(gdb);
+  proxyThread.join();
+  close(server);
+  close(serverListener);
+
+  spdlog::info("Test successful.");
+  return 0;
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/spdlog.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <cmath>
+#include <systemc>
+#include "utilities/SensorTrace.hpp"
+
+using namespace sc_core;
+
+namespace {
+
+const unsigned N_SAMPLES = 5;
+const double TIMESTEP = 0.5;
+
+// Sample i of channel c is i * 10^c
+double value(const unsigned i, const unsigned c) { return i * std::pow(10, c); }
+
+void writeCsv(const char *path) {
+  FILE *f = fopen(path, "w");
+  for (unsigned i = 0; i < N_SAMPLES; ++i) {
+    fprintf(f, "%g,%g,%g,%g\n", i * TIMESTEP, value(i, 0), value(i, 1),
+            value(i, 2));
+  }
+  fclose(f);
+}
+
+void writeBinary(const char *path) {
+  FILE *f = fopen(path, "wb");
+  const uint32_t version = SensorTrace::VERSION, nChannels = 3;
+  const double start = 0.0, timestep = TIMESTEP;
+  const uint64_t nSamples = N_SAMPLES;
+  fwrite("FUSEDSNS", 1, 8, f);
+  fwrite(&version, sizeof(version), 1, f);
+  fwrite(&nChannels, sizeof(nChannels), 1, f);
+  fwrite(&start, sizeof(start), 1, f);
+  fwrite(&timestep, sizeof(timestep), 1, f);
+  fwrite(&nSamples, sizeof(nSamples), 1, f);
+  for (unsigned i = 0; i < N_SAMPLES; ++i) {
+    for (unsigned c = 0; c < nChannels; ++c) {
+      const double v = value(i, c);
+      fwrite(&v, sizeof(v), 1, f);
+    }
+  }
+  fclose(f);
+}
+
+}  // namespace
+
+int sc_main([[maybe_unused]] int argc, [[maybe_unused]] char *argv[]) {
+  writeCsv("/tmp/testSensorTrace.csv");
+  writeBinary("/tmp/testSensorTrace.bin");
+
+  const auto csv = SensorTrace::load("/tmp/testSensorTrace.csv", 3);
+  const auto bin = SensorTrace::load("/tmp/testSensorTrace.bin", 3);
+
+  spdlog::info("TEST: Traces are shared");
+  sc_assert(SensorTrace::load("/tmp/testSensorTrace.bin", 3) == bin);
+
+  spdlog::info("TEST: Csv & binary traces hold the same samples");
+  sc_assert(csv->size() == N_SAMPLES && bin->size() == N_SAMPLES);
+  sc_assert(csv->timestep() == TIMESTEP && bin->timestep() == TIMESTEP);
+  double a[3], b[3];
+  for (unsigned ms = 0; ms < 6000; ms += 100) {
+    csv->sample(sc_time(ms, SC_MS), a);
+    bin->sample(sc_time(ms, SC_MS), b);
+    for (unsigned c = 0; c < 3; ++c) {
+      sc_assert(a[c] == b[c]);
+      sc_assert(b[c] == value((ms / 500) % N_SAMPLES, c));
+    }
+  }
+
+  spdlog::info("TEST: Interpolation, wrapping around the end of the trace");
+  bin->sample(sc_time(750, SC_MS), b, /*interpolate=*/true);
+  sc_assert(std::fabs(b[1] - 15.0) < 1e-9);
+  bin->sample(sc_time(2250, SC_MS), b, /*interpolate=*/true);
+  sc_assert(std::fabs(b[0] - 2.0) < 1e-9);
+
+  spdlog::info("TEST: Constant trace");
+  SensorTrace::constant({1.0, 2.0, 3.0})->sample(sc_time(12, SC_SEC), a, true);
+  sc_assert(a[0] == 1.0 && a[1] == 2.0 && a[2] == 3.0);
+
+  spdlog::info("Testing Done");
+  return false;
+}
@@ -28,7 +28,6 @@ SC_MODULE(dut) {
   sc_signal<int> pending{"pending"};
   sc_signal<int> returning{"returning", -1};
   sc_signal<int> active{"active", -1};
-  std::array<sc_signal<bool>, 32> irq;
   tlm_utils::simple_initiator_socket<dut> iSocket{"iSocket"};
   ClockSourceChannel clk{"clk", sc_time(1, SC_US)};
   PowerModelChannel powerModelChannel{"powerModelChannel", "/tmp",
@@ -38,16 +37,15 @@ SC_MODULE(dut) {
     m_dut.pwrOn.bind(pwrGood);
     m_dut.systemClk.bind(clk);
     m_dut.tSocket.bind(iSocket);
-    for (unsigned i = 0; i < irq.size(); i++) {
-      m_dut.irq[i].bind(irq[i]);
-      irq[i].write(false);
-    }
     m_dut.pending.bind(pending);
     m_dut.returning.bind(returning);
     m_dut.active.bind(active);
     m_dut.powerModelPort.bind(powerModelChannel);
   }
 
+  //! irq n, driven directly on the NVIC's request line
+  sc_signal_inout_if<bool> &irq(const unsigned n) { return m_dut.irqLine(n); }
+
   Nvic m_dut{"dut"};
 };
 
@@ -88,7 +86,7 @@ SC_MODULE(tester) {
 
     // ------ TEST: Enable & Level-sensitive IRQ
     test.m_dut.reset();
-    test.irq[3].write(true);
+    test.irq(3).write(true);
     write32(OFS_NVIC_ISER, ~(1u << 3), false);  // Wrong enable bits
     wait(sc_time(3, SC_US));
     sc_assert(test.m_dut.pending.read() == -1);
@@ -102,9 +100,9 @@ SC_MODULE(tester) {
     // ------ TEST: Pulsed IRQ
     test.m_dut.reset();
     write32(OFS_NVIC_ISER, (1u << 3), false);  // Correct enable bit
-    test.irq[3].write(true);
+    test.irq(3).write(true);
     wait(sc_time(1, SC_US));
-    test.irq[3].write(false);
+    test.irq(3).write(false);
     wait(sc_time(1, SC_US));
     sc_assert(test.m_dut.pending.read() == 3 + NVIC_EXCEPT_ID_BASE);
 
@@ -122,7 +120,7 @@ SC_MODULE(tester) {
 
     // ------ TEST: Software-clear pending IRQ
     test.m_dut.reset();
-    test.irq[3].write(true);
+    test.irq(3).write(true);
     write32(OFS_NVIC_ISER, (1u << 3), false);  // Correct enable bit
     wait(sc_time(1, SC_US));
     sc_assert(test.m_dut.pending.read() == 3 + NVIC_EXCEPT_ID_BASE);
@@ -134,7 +132,7 @@ SC_MODULE(tester) {
     sc_assert(
         test.m_dut.pending.read() ==
         3 + NVIC_EXCEPT_ID_BASE);  // Should still be active (irq still high)
-    test.irq[3].write(false);
+    test.irq(3).write(false);
     write32(OFS_NVIC_ICPR, (1u << 3), false);  // Clear pending register
     wait(sc_time(1, SC_US));
     sc_assert(test.m_dut.pending.read() == -1);  // Should be cleared
@@ -146,15 +144,15 @@ SC_MODULE(tester) {
     write32(OFS_NVIC_IPR2, 0x40404040, false);  // irq[11:8] prio 1
     write32(OFS_NVIC_IPR3, 0x00000000, false);  // irq[15:12] prio 0
     write32(OFS_NVIC_ISER, 0xffff, false);
-    test.irq[0].write(true);
-    test.irq[4].write(true);
-    test.irq[8].write(true);
-    test.irq[12].write(true);
+    test.irq(0).write(true);
+    test.irq(4).write(true);
+    test.irq(8).write(true);
+    test.irq(12).write(true);
     wait(sc_time(1, SC_US));
-    test.irq[0].write(false);
-    test.irq[4].write(false);
-    test.irq[8].write(false);
-    test.irq[12].write(false);
+    test.irq(0).write(false);
+    test.irq(4).write(false);
+    test.irq(8).write(false);
+    test.irq(12).write(false);
 
     // Test & clear registers in priority order
     sc_assert(test.m_dut.pending.read() == 12 + NVIC_EXCEPT_ID_BASE);
@@ -174,9 +172,9 @@ SC_MODULE(tester) {
     // ------ TEST: Accept an interrupt
     test.m_dut.reset();
     write32(OFS_NVIC_ISER, (1u << 3), false);  // Correct enable bit
-    test.irq[3].write(true);
+    test.irq(3).write(true);
     wait(sc_time(1, SC_US));
-    test.irq[3].write(false);
+    test.irq(3).write(false);
     wait(sc_time(1, SC_US));
     sc_assert(test.pending.read() == 3 + NVIC_EXCEPT_ID_BASE);
     test.active.write(3 + NVIC_EXCEPT_ID_BASE);
@@ -189,7 +187,7 @@ SC_MODULE(tester) {
     // ------ TEST: Interrupt still requesting during exception return
     test.m_dut.reset();
     write32(OFS_NVIC_ISER, (1u << 3), false);  // Correct enable bit
-    test.irq[3].write(true);
+    test.irq(3).write(true);
     wait(sc_time(1, SC_US));
     sc_assert(test.pending.read() == 3 + NVIC_EXCEPT_ID_BASE);
     test.active.write(3 + NVIC_EXCEPT_ID_BASE);
@@ -201,7 +199,7 @@ SC_MODULE(tester) {
     // Reset
     test.active.write(-1);
     test.returning.write(-1);
-    test.irq[3].write(false);
+    test.irq(3).write(false);
 
     sc_stop();
   }
@@ -13,6 +13,7 @@
 #include "mcu/ClockSourceChannel.hpp"
 #include "mcu/ClockSourceIf.hpp"
 #include "mcu/GenericMemory.hpp"
+#include "mcu/InterruptController.hpp"
 #include "mcu/msp430fr5xx/Msp430Cpu.hpp"
 #include "ps/PowerModelChannel.hpp"
 #include "utilities/Config.hpp"
@@ -29,11 +30,8 @@ SC_MODULE(dut) {
  public:
   // Signals
   sc_signal<bool> nreset{"nreset", false};
-  sc_signal<bool> irq{"irq"};
-  sc_signal<bool> ira{"ira"};
   sc_signal<bool> stallCpu{"stallCpu"};
-  sc_signal<unsigned> irqIdx{"irqIdx"};
-  sc_signal<bool> iraConnected{"iraConnected"};
+  InterruptController irqCtrl{"irqCtrl", 37};
   GenericMemory mem{"mem", 0, 0xFFFF};  //! 65k memory
   ClockSourceChannel mclk{"mclk", sc_time(125, SC_NS)};
   PowerModelChannel powerModelChannel{"powerModelChannel", "/tmp",
@@ -46,10 +44,7 @@ SC_MODULE(dut) {
     mem.powerModelPort.bind(powerModelChannel);
     m_dut.mclk.bind(mclk);
     m_dut.pwrOn.bind(nreset);
-    m_dut.irq.bind(irq);
-    m_dut.ira.bind(ira);
-    m_dut.irqIdx.bind(irqIdx);
-    m_dut.iraConnected.bind(iraConnected);
+    m_dut.irqCtrl.bind(irqCtrl);
     m_dut.busStall.bind(stallCpu);
     m_dut.powerModelPort.bind(powerModelChannel);
   }
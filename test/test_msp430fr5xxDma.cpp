@@ -162,6 +162,49 @@ SC_MODULE(tester) {
       sc_assert(readMemory16(2 * i + 256) == i);
     }
 
+    // TEST -- Burst-block transfer
+    //   - CPU is released for 2 cycles every 4 beats
+    spdlog::info("Testing burst-block transfer");
+
+    // Configure DMA
+    write16(OFS_DMA0SA, 0);
+    write16(OFS_DMA0DA, 384);
+    write16(OFS_DMA0SZ, 32);
+    write16(OFS_DMA0CTL, DMADT_2 | DMADSTINCR_3 | DMASRCINCR_3 |
+                             DMADSTBYTE__WORD | DMASRCBYTE__WORD |
+                             DMALEVEL__EDGE | DMAEN_1 | DMAIE);
+    // Trigger
+    wait(test.mclk.getPeriod());
+    test.trigger[0].write(true);
+    wait(test.mclk.getPeriod());
+    test.trigger[0].write(false);
+
+    // First burst: 4 beats of 2 cycles each, then CPU window
+    wait(4 * test.mclk.getPeriod());
+    sc_assert(test.m_dut.m_channels[0]->enable);
+    sc_assert(test.stallCpu.read());
+    wait(5 * test.mclk.getPeriod());
+    sc_assert(test.m_dut.m_channels[0]->enable);
+    sc_assert(!test.stallCpu.read());
+
+    // 8 bursts of 8 cycles + 7 CPU windows of 2 cycles
+    wait(80 * test.mclk.getPeriod());
+    sc_assert(!test.m_dut.m_channels[0]->enable);
+    sc_assert(!test.stallCpu.read());
+    sc_assert(read16(OFS_DMA0SZ) == 32u);
+
+    // Check interrupt flag
+    sc_assert(test.m_dut.m_channels[0]->interruptFlag);
+    sc_assert(test.irq.read());
+    sc_assert(read16(OFS_DMAIV) == 2u);  // Clears irq
+    wait(test.mclk.getPeriod());
+    sc_assert(read16(OFS_DMAIV) == 0);
+
+    // Check memory contents
+    for (auto i = 0; i < 32; i++) {
+      sc_assert(readMemory16(2 * i + 384) == i);
+    }
+
     // TEST -- Software trigger
     //   - Transfermode Single,
     //   - increment source and destination address
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020, University of Southampton and Contributors.
+# All rights reserved.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+
+# Convert a csv sensor trace ("time,ch0,ch1,..." rows, time in seconds) into
+# the binary sensor trace format (see utilities/SensorTrace.hpp), which is
+# memory-mapped by the simulator instead of being parsed on every run.
+#
+# Rows must be in increasing time order. If they aren't equally spaced, the
+# trace is resampled (linear interpolation) at --timestep.
+#
+# usage: csv_to_sensor_trace.py <trace.csv> <trace.bin> [--timestep S]
+#                               [--keep-start]
+
+import argparse
+import csv
+import struct
+import sys
+
+MAGIC = b'FUSEDSNS'
+VERSION = 1
+HEADER = struct.Struct('<8sIIddQ')
+
+
+def readCsv(path):
+    times = []
+    rows = []
+    with open(path, newline='') as f:
+        for line, row in enumerate(csv.reader(f), 1):
+            if not row or row[0].lstrip().startswith('#'):
+                continue
+            try:
+                values = [float(v) for v in row]
+            except ValueError:
+                if not times:
+                    continue  # Column headings
+                sys.exit('{}:{}: invalid row'.format(path, line))
+            if rows and len(values) - 1 != len(rows[0]):
+                sys.exit('{}:{}: expected {} channels'.format(
+                    path, line, len(rows[0])))
+            times.append(values[0])
+            rows.append(values[1:])
+    if not rows or not rows[0]:
+        sys.exit('{}: no samples'.format(path))
+    return times, rows
+
+
+def resample(times, rows, timestep):
+    out = []
+    i = 0
+    t = times[0]
+    while t <= times[-1]:
+        while times[i + 1] < t:
+            i += 1
+        frac = (t - times[i]) / (times[i + 1] - times[i])
+        out.append(
+            [a + frac * (b - a) for a, b in zip(rows[i], rows[i + 1])])
+        t = times[0] + len(out) * timestep
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Convert a csv sensor trace to the binary format')
+    parser.add_argument('csv', help='Input csv trace')
+    parser.add_argument('output', help='Output binary trace')
+    parser.add_argument('--timestep',
+                        type=float,
+                        help='Sample period (s), defaults to the first row '
+                        'spacing')
+    parser.add_argument('--keep-start',
+                        action='store_true',
+                        help='Start the trace at the time of the first row, '
+                        'rather than at 0 s')
+    args = parser.parse_args()
+
+    times, rows = readCsv(args.csv)
+    timestep = args.timestep
+    if timestep is None:
+        timestep = times[1] - times[0] if len(times) > 1 else 1.0
+    if timestep <= 0:
+        sys.exit('Timestep must be positive')
+
+    # Resample unless the rows are already equally spaced at timestep
+    regular = all(
+        abs(t - (times[0] + i * timestep)) <= 1e-9 * max(1.0, abs(t))
+        for i, t in enumerate(times))
+    if not regular:
+        print('Rows are not equally spaced at {:g} s, resampling'.format(
+            timestep),
+              file=sys.stderr)
+        rows = resample(times, rows, timestep)
+
+    start = times[0] if args.keep_start else 0.0
+    nChannels = len(rows[0])
+    with open(args.output, 'wb') as f:
+        f.write(
+            HEADER.pack(MAGIC, VERSION, nChannels, start, timestep,
+                        len(rows)))
+        sample = struct.Struct('<{}d'.format(nChannels))
+        for r in rows:
+            f.write(sample.pack(*r))
+    print('{}: {} samples of {} channels, {:g} s timestep'.format(
+        args.output, len(rows), nChannels, timestep))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020, University of Southampton and Contributors.
+# All rights reserved.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+
+# Decode a binary bus transaction trace (bus_trace.bin, see mcu/BusTracer.hpp)
+# into text, one line per transaction.
+#
+# usage: decode_bus_trace.py <bus_trace.bin> [--target NAME ...]
+
+import argparse
+import struct
+import sys
+
+MAGIC = b'FUSEDBUS'
+VERSION = 1
+RECORD = struct.Struct('<QQIIBBBBI')
+COMMANDS = ['R', 'W', '-']
+
+
+def formatTime(ps):
+    """Format a time like SystemC's sc_time::to_string (1 ps resolution)."""
+    if ps == 0:
+        return '0 s'
+    units = ['ps', 'ns', 'us', 'ms', 's']
+    i = 0
+    while i < len(units) - 1 and ps % 1000 == 0:
+        ps //= 1000
+        i += 1
+    return '{} {}'.format(ps, units[i])
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Decode a binary bus transaction trace')
+    parser.add_argument('trace', help='Path to bus_trace.bin')
+    parser.add_argument('--target',
+                        nargs='+',
+                        help='Only print transactions to these targets')
+    args = parser.parse_args()
+
+    with open(args.trace, 'rb') as f:
+        data = f.read()
+
+    if data[:len(MAGIC)] != MAGIC:
+        sys.exit('Not a binary bus trace')
+    version, recordSize, nTargets = struct.unpack_from('<III', data, 8)
+    if version != VERSION or recordSize != RECORD.size:
+        sys.exit('Unsupported trace version {}'.format(version))
+    pos = 20
+    targets = []
+    for i in range(nTargets):
+        end = data.index(b'\0', pos)
+        targets.append(data[pos:end].decode())
+        pos = end + 1
+
+    for (time, latency, addr, val, initiator, target, size, command,
+         _) in RECORD.iter_unpack(data[pos:pos + (len(data) - pos) //
+                                       RECORD.size * RECORD.size]):
+        name = targets[target] if target < len(targets) else str(target)
+        if args.target and not any(
+                name == t or name.endswith('.' + t) for t in args.target):
+            continue
+        print('@{}: {} {} 0x{:08x} 0x{:0{}x} initiator {} latency {} {}'.format(
+            formatTime(time), COMMANDS[min(command, 2)], size, addr,
+            val & ((1 << (8 * min(size, 4))) - 1), 2 * min(size, 4),
+            initiator, formatTime(latency), name))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020, University of Southampton and Contributors.
+# All rights reserved.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+
+# Decode a binary log written by the "ringbuffer" log sink (see
+# utilities/Logging.hpp) into text, one line per record.
+#
+# usage: decode_log.py <log.bin> [--module NAME ...]
+
+import argparse
+import struct
+import sys
+
+LEVELS = ['trace', 'debug', 'info', 'warning', 'error', 'critical', 'off']
+RECORD_SIZE = 64
+PAYLOAD_SIZE = 48
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def unpack(self, fmt):
+        vals = struct.unpack_from('<' + fmt, self.data, self.pos)
+        self.pos += struct.calcsize('<' + fmt)
+        return vals if len(vals) > 1 else vals[0]
+
+    def string(self):
+        n = self.unpack('H')
+        s = self.data[self.pos:self.pos + n].decode('utf-8', 'replace')
+        self.pos += n
+        return s
+
+
+def decodeArgs(payload):
+    args = []
+    pos = 0
+    while pos < len(payload):
+        tag = chr(payload[pos])
+        pos += 1
+        if tag == 'i':
+            args.append(struct.unpack_from('<q', payload, pos)[0])
+            pos += 8
+        elif tag == 'u':
+            args.append(struct.unpack_from('<Q', payload, pos)[0])
+            pos += 8
+        elif tag == 'd':
+            args.append(struct.unpack_from('<d', payload, pos)[0])
+            pos += 8
+        elif tag == 's':
+            n = payload[pos]
+            args.append(payload[pos + 1:pos + 1 + n].decode(
+                'utf-8', 'replace'))
+            pos += 1 + n
+        else:
+            raise ValueError('Invalid argument tag {!r}'.format(tag))
+    return args
+
+
+def formatMessage(fmt, args):
+    # fmt and python share most of the format-spec mini language
+    try:
+        return fmt.format(*args)
+    except (IndexError, ValueError, KeyError):
+        # Truncated or incompatible arguments
+        return '{} {}'.format(fmt, args)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('logfile')
+    parser.add_argument('--module',
+                        action='append',
+                        help='only print records from these modules')
+    opts = parser.parse_args()
+
+    with open(opts.logfile, 'rb') as f:
+        r = Reader(f.read())
+
+    if r.data[:8] != b'FUSEDLOG':
+        sys.exit('{}: not a fused log file'.format(opts.logfile))
+    r.pos = 8
+    version = r.unpack('I')
+    if version != 1:
+        sys.exit('Unsupported log file version {}'.format(version))
+    resolution = r.unpack('d')
+
+    modules = [r.string() for _ in range(r.unpack('I'))]
+
+    sites = []
+    for _ in range(r.unpack('I')):
+        module, level, line = r.unpack('BBI')
+        sites.append((modules[module], LEVELS[level], r.string(), line,
+                      r.string()))
+
+    nRecords, nDropped = r.unpack('QQ')
+    if nDropped:
+        print('# {} older records were overwritten'.format(nDropped))
+
+    for _ in range(nRecords):
+        time, site, size, _reserved = r.unpack('QHHI')
+        payload = r.data[r.pos:r.pos + size]
+        r.pos += PAYLOAD_SIZE
+        module, level, file, line, fmt = sites[site]
+        if opts.module and module not in opts.module:
+            continue
+        print('[{:.9f}] [{}] [{}] {}'.format(time * resolution, module, level,
+                                             formatMessage(
+                                                 fmt, decodeArgs(payload))))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,182 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020, University of Southampton and Contributors.
+# All rights reserved.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+
+# Decode a binary CPU trace (cpu_trace.bin, see utilities/InstructionTrace.hpp)
+# into text. By default one line per instruction with its cycles, register
+# writes and memory accesses. --ops renders the former cpu_op.log format
+# (interrupt entries & RETIs), --gdb renders the register state before each
+# instruction like gdb's "info registers", as read by
+# test-misc/msp430-cpu-trace/verify-execution-traces.py.
+#
+# usage: decode_trace.py <cpu_trace.bin> [--ops | --gdb]
+
+import argparse
+import struct
+import sys
+
+MAGIC = b'FUSEDTRC'
+VERSION = 1
+SYNC = 0x00
+IRQ = 0x01
+INSN = 0x80
+INST_RETI = 0x1300
+
+MSP430_REGS = [
+    'pc', 'sp', 'sr', 'cg', 'r4', 'r5', 'r6', 'r7', 'r8', 'r9', 'r10', 'r11',
+    'r12', 'r13', 'r14', 'r15'
+]
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def u8(self):
+        b = self.data[self.pos]
+        self.pos += 1
+        return b
+
+    def varint(self):
+        val = 0
+        shift = 0
+        while True:
+            b = self.u8()
+            val |= (b & 0x7f) << shift
+            shift += 7
+            if b < 0x80:
+                return val
+
+    def signed(self):
+        return unzigzag(self.varint())
+
+
+def unzigzag(val):
+    return (val >> 1) ^ -(val & 1)
+
+
+def formatTime(ps):
+    """Format a time like SystemC's sc_time::to_string (1 ps resolution)."""
+    if ps == 0:
+        return '0 s'
+    units = ['ps', 'ns', 'us', 'ms', 's']
+    i = 0
+    while i < len(units) - 1 and ps % 1000 == 0:
+        ps //= 1000
+        i += 1
+    return '{} {}'.format(ps, units[i])
+
+
+def records(data):
+    """Yield (kind, fields) for every record, tracking time & registers."""
+    if data[:len(MAGIC)] != MAGIC:
+        sys.exit('Not a binary CPU trace')
+    version, nRegs, pcRegnum = struct.unpack_from('<BBB', data, len(MAGIC))
+    if version != VERSION:
+        sys.exit('Unsupported trace version {}'.format(version))
+
+    pos = len(MAGIC) + 4
+    regs = [0] * nRegs
+    time = period = pc = addr = 0
+    while pos + 4 <= len(data):
+        length = struct.unpack_from('<I', data, pos)[0]
+        r = Reader(data[pos + 4:pos + 4 + length])
+        pos += 4 + length
+        while r.pos < len(r.data):
+            tag = r.u8()
+            if tag == SYNC:
+                time = r.varint()
+                period = r.varint()
+                regs = [r.varint() for i in range(nRegs)]
+                pc = regs[pcRegnum]
+                addr = 0
+            elif tag == IRQ:
+                yield 'irq', {'time': time, 'vector': r.varint()}
+            elif tag & INSN:
+                before = list(regs)
+                pc += r.signed()
+                before[pcRegnum] = pc
+                opcode = r.varint()
+                cycles = r.varint()
+                time += cycles * period
+                writes = []
+                for i in range(tag & 0xf):
+                    idx = r.u8()
+                    regs[idx] = r.varint()
+                    writes.append((idx, regs[idx]))
+                accesses = []
+                for i in range((tag >> 4) & 0x7):
+                    val = r.varint()
+                    addr += unzigzag(val >> 2)
+                    accesses.append((addr, bool(val & 2), bool(val & 1)))
+                yield 'insn', {
+                    'time': time,
+                    'pc': pc,
+                    'opcode': opcode,
+                    'cycles': cycles,
+                    'regs': before,
+                    'writes': writes,
+                    'accesses': accesses
+                }
+            else:
+                sys.exit('Corrupt trace at offset {}'.format(pos))
+
+
+def regName(idx):
+    return MSP430_REGS[idx] if idx < len(MSP430_REGS) else 'r{}'.format(idx)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode a binary CPU trace')
+    parser.add_argument('trace', help='Path to cpu_trace.bin')
+    mode = parser.add_mutually_exclusive_group()
+    mode.add_argument('--ops',
+                      action='store_true',
+                      help='Only interrupt entries & RETIs (cpu_op.log)')
+    mode.add_argument('--gdb',
+                      action='store_true',
+                      help='Register state before each instruction')
+    args = parser.parse_args()
+
+    with open(args.trace, 'rb') as f:
+        data = f.read()
+
+    # Time of the previous retirement, i.e. the start of the next instruction
+    start = 0
+    out = sys.stdout
+    for kind, r in records(data):
+        if args.ops:
+            if kind == 'irq':
+                out.write('@{:>10s}: IRQHANDLER 0x{:4x}\n'.format(
+                    formatTime(start), r['vector']))
+            elif r['opcode'] == INST_RETI:
+                out.write('@{}: RETI\n'.format(formatTime(start)))
+        elif args.gdb:
+            if kind == 'insn':
+                out.write('\n0x{:08x} in ?? ()\n'.format(r['pc']))
+                for i, val in enumerate(r['regs']):
+                    out.write('{:<15s}0x{:<18x}0x{:x}\n'.format(
+                        regName(i), val, val))
+        elif kind == 'irq':
+            out.write('@{}: IRQ 0x{:04x}\n'.format(formatTime(start),
+                                                    r['vector']))
+        else:
+            line = '@{}: 0x{:05x} {:04x} {:3d}'.format(
+                formatTime(r['time']), r['pc'], r['opcode'], r['cycles'])
+            for idx, val in r['writes']:
+                line += ' {}=0x{:x}'.format(regName(idx), val)
+            for addr, write, byte in r['accesses']:
+                line += ' {}{} 0x{:05x}'.format('W' if write else 'R',
+                                                '.b' if byte else '', addr)
+            out.write(line + '\n')
+        if kind == 'insn':
+            start = r['time']
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020, University of Southampton and Contributors.
+# All rights reserved.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+
+# End-to-end simulation speed regression suite. Runs the sw/validation and
+# sw/microbenchmarks programs in batch mode under a fixed set of scenarios,
+# collects the speed metrics from each run's summary.json and compares them
+# against a checked-in baseline.
+#
+# Runs without a baseline entry fail (status NO BASELINE), so a missing or
+# stale baseline can't pass the gate silently.
+#
+# usage: perf_regression.py <fused> [--config FILE] [--baseline FILE]
+#                           [--tolerance FRAC] [--update-baseline]
+#                           [--allow-missing-baseline]
+
+import argparse
+import glob
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+REPO = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# Fixed configurations, applied with --set on top of the config file
+POWER = {
+    'continuous': {
+        'VoltageTraceFile': os.path.join(REPO, 'backup/trace_constant5.csv'),
+        'LoadResistance': '200',
+    },
+    'intermittent': {
+        'VoltageTraceFile': os.path.join(REPO, 'backup/trace.csv'),
+        'LoadResistance': '100',
+    },
+}
+
+# Boards with a configurable cache
+CACHE_KEYS = {
+    'Msp430TestBoard': 'Msp430TestBoard.mcu.cache.CacheEnabled',
+}
+
+# Metrics compared against the baseline: name -> higher is better.
+# Kernel activations are counted as SystemC delta cycles.
+METRICS = {
+    'ips': True,
+    'activations': False,
+    'peak_rss_kb': False,
+}
+
+
+def findPrograms(swBuild, boards):
+    programs = []
+    for board in boards:
+        pattern = os.path.join(swBuild, 'validation', board, '**', '*.hex')
+        for hexfile in sorted(glob.glob(pattern, recursive=True)):
+            programs.append((board, hexfile))
+    # Microbenchmarks are built for the MSP430 test board only
+    if 'Msp430TestBoard' in boards:
+        pattern = os.path.join(swBuild, 'microbenchmarks', '**', '*.hex')
+        for hexfile in sorted(glob.glob(pattern, recursive=True)):
+            programs.append(('Msp430TestBoard', hexfile))
+    return programs
+
+
+def scenarios(board):
+    for power, settings in POWER.items():
+        if board in CACHE_KEYS:
+            for cache in ['on', 'off']:
+                s = dict(settings)
+                s[CACHE_KEYS[board]] = 'True' if cache == 'on' else 'False'
+                yield '{}/cache-{}'.format(power, cache), s
+        else:
+            yield power, settings
+
+
+def run(args, board, hexfile, settings, odir):
+    cmd = [args.fused, '--batch', '-B', board, '-x', hexfile, '-O', odir]
+    if args.config:
+        cmd += ['-C', args.config]
+    settings = dict(settings, SimTimeLimit=str(args.sim_time))
+    for k, v in settings.items():
+        cmd += ['--set', '{}={}'.format(k, v)]
+    try:
+        subprocess.run(cmd, stdout=subprocess.DEVNULL,
+                       stderr=subprocess.DEVNULL, timeout=args.timeout,
+                       check=True)
+        with open(os.path.join(odir, 'summary.json')) as f:
+            summary = json.load(f)
+    except (subprocess.SubprocessError, OSError, ValueError) as e:
+        print('{}: {}'.format(os.path.basename(hexfile), e), file=sys.stderr)
+        return None
+
+    return {
+        'ips': summary['instructions'] / max(summary['wall_time_s'], 1e-9),
+        'activations': summary['delta_cycles'],
+        'peak_rss_kb': summary['peak_rss_kb'],
+        'wall_time_s': summary['wall_time_s'],
+    }
+
+
+def compare(result, base, tolerance):
+    """ Return a list of regressed metrics. """
+    if base is None:
+        return []
+    regressions = []
+    for k, higherIsBetter in METRICS.items():
+        if not base.get(k):
+            continue
+        if higherIsBetter and result[k] < base[k] * (1.0 - tolerance):
+            regressions.append(k)
+        elif not higherIsBetter and result[k] > base[k] * (1.0 + tolerance):
+            regressions.append(k)
+    return regressions
+
+
+def change(result, base, key):
+    if base is None or not base.get(key):
+        return ''
+    return '{:+.1f}%'.format(100.0 * (result[key] / base[key] - 1.0))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Run the end-to-end simulation speed regression suite.')
+    parser.add_argument('fused', help='path to the fused binary')
+    parser.add_argument('--config', help='config file passed to fused')
+    parser.add_argument('--sw-build', default=os.path.join(REPO, 'sw/build'),
+                        help='sw build directory containing the .hex files')
+    parser.add_argument('--boards', nargs='+', default=['Msp430TestBoard'])
+    parser.add_argument('--baseline',
+                        default=os.path.join(REPO, 'test/perf/baseline.json'))
+    parser.add_argument('--tolerance', type=float, default=0.2,
+                        help='allowed relative slowdown (default 0.2)')
+    parser.add_argument('--sim-time', type=float, default=1.0,
+                        help='SimTimeLimit of each run, in seconds')
+    parser.add_argument('--timeout', type=float, default=300.0,
+                        help='host time limit of each run, in seconds')
+    parser.add_argument('--output', help='write results to this JSON file')
+    parser.add_argument('--update-baseline', action='store_true',
+                        help='overwrite the baseline with this run\'s results')
+    parser.add_argument('--allow-missing-baseline', action='store_true',
+                        help='don\'t fail runs without a baseline entry')
+    args = parser.parse_args()
+
+    programs = findPrograms(args.sw_build, args.boards)
+    if not programs:
+        print('No programs found in {}, build sw first'.format(args.sw_build),
+              file=sys.stderr)
+        return 1
+
+    baseline = {}
+    if os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f).get('results', {})
+    if not baseline and not args.update_baseline:
+        print('*** NO BASELINE in {}: nothing to compare against, generate '
+              'one on the reference host with --update-baseline ***'.format(
+                  args.baseline), file=sys.stderr)
+
+    results = {}
+    failed = []
+    regressed = []
+    missing = []
+    row = '{:<56} {:>12} {:>8} {:>12} {:>10} {:>8}  {}'
+    print(row.format('test', 'instr/s', 'change', 'activations', 'rss(kB)',
+                     'change', 'status'))
+    for board, hexfile in programs:
+        prog = os.path.splitext(os.path.basename(hexfile))[0]
+        for scenario, settings in scenarios(board):
+            name = '{}/{}/{}'.format(board, prog, scenario)
+            with tempfile.TemporaryDirectory() as odir:
+                result = run(args, board, hexfile, settings, odir)
+            if result is None:
+                failed.append(name)
+                print(row.format(name, '-', '', '-', '-', '', 'FAILED'))
+                continue
+            results[name] = result
+            base = baseline.get(name)
+            regressions = compare(result, base, args.tolerance)
+            if regressions:
+                regressed.append(name)
+            if base is None:
+                missing.append(name)
+            status = ('NO BASELINE' if base is None else
+                      'REGRESSED ({})'.format(', '.join(regressions))
+                      if regressions else 'ok')
+            print(row.format(name, '{:.4g}'.format(result['ips']),
+                             change(result, base, 'ips'),
+                             result['activations'], result['peak_rss_kb'],
+                             change(result, base, 'peak_rss_kb'), status))
+            sys.stdout.flush()
+
+    report = {'tolerance': args.tolerance, 'sim_time_s': args.sim_time,
+              'results': results}
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(report, f, indent=2, sort_keys=True)
+    if args.update_baseline:
+        report['note'] = ('Host-specific, regenerate with '
+                          'perf_regression.py --update-baseline')
+        with open(args.baseline, 'w') as f:
+            json.dump(report, f, indent=2, sort_keys=True)
+            f.write('\n')
+        print('Baseline written to {}'.format(args.baseline))
+
+    print('\n{} runs, {} failed, {} regressed, {} without baseline '
+          '(tolerance {:.0%})'.format(
+              len(results) + len(failed), len(failed), len(regressed),
+              len(missing), args.tolerance))
+    if args.update_baseline:
+        return 1 if failed else 0
+    if missing and not args.allow_missing_baseline:
+        print('*** NO BASELINE for {} runs, failing ***'.format(len(missing)),
+              file=sys.stderr)
+        return 1
+    return 1 if failed or regressed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
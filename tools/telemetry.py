@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020, University of Southampton and Contributors.
+# All rights reserved.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+
+# Print the live telemetry page of a running simulation (see
+# utilities/Telemetry.hpp), once or every --interval seconds until the
+# simulation finishes.
+#
+# usage: telemetry.py [segment] [--follow] [--interval S] [--modules]
+
+import argparse
+import mmap
+import os
+import struct
+import sys
+import time
+
+MAGIC = b'FUSEDTEL'
+VERSION = 1
+MAX_MODULES = 32
+NAME_LENGTH = 48
+HEADER = struct.Struct('<8sIIQQIIIIdddddQd')
+NAMES_OFFSET = HEADER.size
+ENERGY_OFFSET = NAMES_OFFSET + MAX_MODULES * NAME_LENGTH
+PAGE_SIZE = ENERGY_OFFSET + MAX_MODULES * 8
+POWER_STATES = ['off', 'active', 'lpm']
+
+
+def segmentPath(segment):
+    return '/dev/shm/' + segment.lstrip('/')
+
+
+def readPage(m):
+    """Copy a consistent page, retrying while the simulator updates it"""
+    while True:
+        seq = struct.unpack_from('<Q', m, 16)[0]
+        if seq % 2 == 0:
+            data = m[:PAGE_SIZE]
+            if struct.unpack_from('<Q', m, 16)[0] == seq:
+                return data
+        time.sleep(0.001)
+
+
+def decode(data):
+    (magic, version, nModules, seq, pid, state, cycles, finished, _, simTime,
+     wallTime, speed, vcc, vcap, instructions,
+     energy) = HEADER.unpack_from(data)
+    if magic != MAGIC:
+        sys.exit('Not a telemetry segment')
+    if version != VERSION:
+        sys.exit('Unsupported version {}'.format(version))
+    modules = []
+    for i in range(nModules):
+        name = data[NAMES_OFFSET + i * NAME_LENGTH:NAMES_OFFSET +
+                    (i + 1) * NAME_LENGTH]
+        modules.append((name.split(b'\0', 1)[0].decode('utf-8', 'replace'),
+                        struct.unpack_from('<d', data,
+                                           ENERGY_OFFSET + i * 8)[0]))
+    return dict(pid=pid,
+                state=POWER_STATES[state]
+                if state < len(POWER_STATES) else str(state),
+                cycles=cycles,
+                finished=bool(finished),
+                simTime=simTime,
+                wallTime=wallTime,
+                speed=speed,
+                vcc=vcc,
+                vcap=vcap,
+                instructions=instructions,
+                energy=energy,
+                modules=modules)
+
+
+def show(page, modules):
+    print('pid {pid}: sim {simTime:.6f} s, wall {wallTime:.1f} s, '
+          'speed {speed:.4g}x, vcc {vcc:.3f} V, vcap {vcap:.3f} V, {state}, '
+          '{cycles} power cycles, {instructions} instructions, '
+          '{energy:.6g} J{done}'.format(
+              done=' (finished)' if page['finished'] else '', **page))
+    if modules:
+        for name, energy in page['modules']:
+            print('  {:<40s} {:.6g} J'.format(name, energy))
+    sys.stdout.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Print the telemetry of a running simulation')
+    parser.add_argument('segment',
+                        nargs='?',
+                        default='/fused-telemetry',
+                        help='Shared memory segment (TelemetrySegment)')
+    parser.add_argument('--follow',
+                        '-f',
+                        action='store_true',
+                        help='Keep printing until the simulation finishes')
+    parser.add_argument('--interval',
+                        type=float,
+                        default=1.0,
+                        help='Seconds between prints with --follow')
+    parser.add_argument('--modules',
+                        '-m',
+                        action='store_true',
+                        help='Print the energy of each module')
+    args = parser.parse_args()
+
+    path = segmentPath(args.segment)
+    try:
+        fd = os.open(path, os.O_RDONLY)
+    except OSError as e:
+        sys.exit('{}: {}'.format(path, e.strerror))
+    m = mmap.mmap(fd, PAGE_SIZE, mmap.MAP_SHARED, mmap.PROT_READ)
+    os.close(fd)
+
+    while True:
+        page = decode(readPage(m))
+        show(page, args.modules)
+        if not args.follow or page['finished']:
+            break
+        time.sleep(args.interval)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <algorithm>
+#include <set>
+#include <vector>
+
+/**
+ * @brief The BreakpointMap class Set of breakpoint addresses, checked by the
+ * CPU before every instruction.
+ *
+ * Addresses in the code region are kept in a bitmap with one bit per 16-bit
+ * instruction slot, others in a set. contains() is a single test while no
+ * breakpoints are set, and a bit test otherwise.
+ */
+class BreakpointMap {
+ public:
+  /**
+   * @brief BreakpointMap constructor
+   * @param codeStart start address of the code region
+   * @param codeEnd end address (exclusive) of the code region
+   */
+  BreakpointMap(const uint32_t codeStart, const uint32_t codeEnd)
+      : m_codeStart(codeStart),
+        m_nSlots((codeEnd - codeStart) / 2),
+        m_bitmap((m_nSlots + 63) / 64, 0) {}
+
+  /**
+   * @brief contains check if there is a breakpoint at an address.
+   */
+  bool contains(const uint32_t addr) const {
+    if (m_count == 0) {
+      return false;
+    }
+    const uint32_t i = (addr - m_codeStart) >> 1;
+    if (i < m_nSlots && !(addr & 1)) {
+      return m_bitmap[i >> 6] & (uint64_t(1) << (i & 63));
+    }
+    return m_other.count(addr) > 0;
+  }
+
+  void insert(const uint32_t addr) {
+    if (!contains(addr)) {
+      set(addr, true);
+      ++m_count;
+    }
+  }
+
+  void erase(const uint32_t addr) {
+    if (contains(addr)) {
+      set(addr, false);
+      --m_count;
+    }
+  }
+
+  size_t size() const { return m_count; }
+
+  /**
+   * @brief addresses get the breakpoint addresses, in ascending order.
+   */
+  std::vector<uint32_t> addresses() const {
+    std::vector<uint32_t> result;
+    for (uint32_t i = 0; i < m_nSlots && result.size() < m_count; ++i) {
+      if (m_bitmap[i >> 6] & (uint64_t(1) << (i & 63))) {
+        result.push_back(m_codeStart + 2 * i);
+      }
+    }
+    result.insert(result.end(), m_other.begin(), m_other.end());
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+ private:
+  const uint32_t m_codeStart;
+  const uint32_t m_nSlots;
+  std::vector<uint64_t> m_bitmap;
+  std::set<uint32_t> m_other;  //! Outside the code region, or unaligned
+  size_t m_count{0};
+
+  void set(const uint32_t addr, const bool value) {
+    const uint32_t i = (addr - m_codeStart) >> 1;
+    if (i < m_nSlots && !(addr & 1)) {
+      const auto bit = uint64_t(1) << (i & 63);
+      m_bitmap[i >> 6] = value ? (m_bitmap[i >> 6] | bit)
+                               : (m_bitmap[i >> 6] & ~bit);
+    } else if (value) {
+      m_other.insert(addr);
+    } else {
+      m_other.erase(addr);
+    }
+  }
+};
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <systemc>
+#include <vector>
+#include "utilities/Checkpoint.hpp"
+
+namespace {
+
+struct Entry {
+  std::string name;
+  Checkpointable *obj;
+  Checkpointable::Stage stage;
+};
+
+//! File format version, bump on incompatible changes
+const uint32_t CHECKPOINT_FILE_VERSION = 1;
+
+const char MAGIC[] = "FUSEDCKP";
+const size_t MAGIC_LEN = 8;
+
+//! Never destroyed, so modules with static storage can unregister at exit
+std::vector<Entry> &registry() {
+  static auto *r = new std::vector<Entry>();
+  return *r;
+}
+
+std::string g_requestedPath;
+
+//! Time at which the restored checkpoint was taken
+sc_core::sc_time g_timeOffset{sc_core::SC_ZERO_TIME};
+
+//! CPU blocked at a consistent point, see Checkpoint::setIdle()
+bool g_idle{false};
+
+void fatal(const std::string &msg) {
+  SC_REPORT_FATAL("Checkpoint", msg.c_str());
+}
+
+}  // namespace
+
+/* ------ Checkpointable ------ */
+
+Checkpointable::~Checkpointable() {
+  auto &r = registry();
+  r.erase(std::remove_if(r.begin(), r.end(),
+                         [this](const Entry &e) { return e.obj == this; }),
+          r.end());
+}
+
+void Checkpointable::registerCheckpointable(const std::string &name,
+                                            const Stage stage) {
+  for (const auto &e : registry()) {
+    if (e.name == name) {
+      fatal("Duplicate checkpoint section \"" + name + "\"");
+    }
+  }
+  registry().push_back(Entry{name, this, stage});
+}
+
+void Checkpointable::setCheckpointStage(const Stage stage) {
+  for (auto &e : registry()) {
+    if (e.obj == this) {
+      e.stage = stage;
+    }
+  }
+}
+
+namespace Checkpoint {
+
+bool g_requestPending{false};
+
+void save(const std::string &path) {
+  CheckpointWriter w;
+
+  // Header
+  w.writeBlock(MAGIC, MAGIC_LEN);
+  w.write(CHECKPOINT_FILE_VERSION);
+  w.write(static_cast<uint64_t>(now().value()));
+  w.write(sc_core::sc_get_time_resolution().to_seconds());
+  w.write(static_cast<uint32_t>(registry().size()));
+
+  // Sections, with the payload size patched in after serialisation
+  for (const auto &e : registry()) {
+    w.write(static_cast<uint16_t>(e.name.size()));
+    w.writeBlock(e.name.data(), e.name.size());
+    const size_t sizePos = w.buffer().size();
+    w.write(uint64_t(0));
+    e.obj->saveState(w);
+    const uint64_t size = w.buffer().size() - sizePos - sizeof(uint64_t);
+    std::memcpy(&w.buffer()[sizePos], &size, sizeof(size));
+  }
+
+  const std::string tmpPath = path + ".tmp";
+  std::ofstream os(tmpPath, std::ios::binary);
+  os.write(reinterpret_cast<const char *>(w.buffer().data()),
+           w.buffer().size());
+  os.close();
+  if (!os.good() || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+    spdlog::error("Checkpoint: failed to write {:s}", path);
+    return;
+  }
+  spdlog::info("Checkpoint: saved {:d} bytes to {:s} @{:s}",
+               w.buffer().size(), path, now().to_string());
+}
+
+sc_core::sc_time restore(const std::string &path) {
+  std::ifstream is(path, std::ios::binary);
+  if (!is.good()) {
+    fatal("Failed to open " + path);
+  }
+  const std::vector<uint8_t> data((std::istreambuf_iterator<char>(is)),
+                                  std::istreambuf_iterator<char>());
+
+  CheckpointReader header(path, data.data(), data.size());
+  char magic[MAGIC_LEN];
+  header.readBlock(magic, MAGIC_LEN);
+  if (std::memcmp(magic, MAGIC, MAGIC_LEN) != 0) {
+    fatal(path + " is not a checkpoint file");
+  }
+  const auto version = header.read<uint32_t>();
+  if (version != CHECKPOINT_FILE_VERSION) {
+    fatal(fmt::format("Unsupported checkpoint version {:d}", version));
+  }
+  const auto time = header.read<uint64_t>();
+  const auto resolution = header.read<double>();
+  if (resolution != sc_core::sc_get_time_resolution().to_seconds()) {
+    fatal("Checkpoint was taken with a different time resolution");
+  }
+
+  // Index sections by name
+  struct Section {
+    size_t offset;
+    size_t size;
+  };
+  std::map<std::string, Section> sections;
+  const auto nSections = header.read<uint32_t>();
+  for (uint32_t i = 0; i < nSections; ++i) {
+    std::string name(header.read<uint16_t>(), '\0');
+    header.readBlock(&name[0], name.size());
+    const auto size = header.read<uint64_t>();
+    const size_t offset = data.size() - header.remaining();
+    sections[name] = Section{offset, size_t(size)};
+    header.skip(size);
+  }
+
+  auto restoreStage = [&](const Checkpointable::Stage stage) {
+    unsigned n = 0;
+    for (const auto &e : registry()) {
+      if (e.stage != stage) {
+        continue;
+      }
+      const auto it = sections.find(e.name);
+      if (it == sections.end()) {
+        fatal("Checkpoint has no section for \"" + e.name + "\"");
+      }
+      CheckpointReader r(e.name, &data[it->second.offset], it->second.size);
+      e.obj->restoreState(r);
+      if (r.remaining() != 0) {
+        fatal("Checkpoint section \"" + e.name + "\" has trailing data");
+      }
+      sections.erase(it);
+      ++n;
+    }
+    return n;
+  };
+
+  // Power on first, and let the power-on resets run, so they don't clobber
+  // the state restored afterwards.
+  if (restoreStage(Checkpointable::Stage::Power) > 0) {
+    do {
+      sc_core::sc_start(sc_core::SC_ZERO_TIME);
+    } while (sc_core::sc_pending_activity_at_current_time());
+  }
+  restoreStage(Checkpointable::Stage::Default);
+
+  for (const auto &s : sections) {
+    spdlog::warn("Checkpoint: ignoring unknown section \"{:s}\"", s.first);
+  }
+
+  const auto t = sc_core::sc_time(time * resolution, sc_core::SC_SEC);
+  const auto stamp = sc_core::sc_time_stamp();
+  g_timeOffset = t > stamp ? t - stamp : sc_core::SC_ZERO_TIME;
+  spdlog::info("Checkpoint: restored {:s} (taken @{:s})", path, t.to_string());
+  return t;
+}
+
+sc_core::sc_time now() { return sc_core::sc_time_stamp() + g_timeOffset; }
+
+void request(const std::string &path) {
+  g_requestedPath = path;
+  g_requestPending = true;
+  if (g_idle) {
+    saveRequested();
+  }
+}
+
+void setIdle(const bool idle) { g_idle = idle; }
+
+void saveRequested() {
+  g_requestPending = false;
+  save(g_requestedPath);
+}
+
+}  // namespace Checkpoint
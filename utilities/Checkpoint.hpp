@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <systemc>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Full-system checkpoints.
+ *
+ * Every stateful module implements Checkpointable and registers itself under
+ * its hierarchical name. A checkpoint file holds one section per registered
+ * object:
+ *
+ *   "FUSEDCKP" | u32 version | u64 time | f64 time resolution | u32 nSections
+ *   nSections x ( u16 name length | name | u64 payload size | payload )
+ *
+ * Payloads are raw host-endian copies of the state, memory images are written
+ * and read back with a single memcpy each.
+ *
+ * Only architectural state is captured; pending SystemC events and the stacks
+ * of SC_THREADs are not. Checkpoints should therefore be taken at instruction
+ * boundaries, see Checkpoint::request().
+ *
+ * SystemC time cannot be set, so sc_time_stamp() restarts at zero in a restored
+ * run. Time-indexed inputs (e.g. sensor traces) use Checkpoint::now() instead,
+ * which adds the time at which the checkpoint was taken.
+ */
+
+class CheckpointWriter;
+class CheckpointReader;
+
+/**
+ * @brief The Checkpointable class Interface for modules whose state is saved
+ * to and restored from checkpoints.
+ */
+class Checkpointable {
+ public:
+  //! Restore order. Power state is restored (and settled) before the rest.
+  enum class Stage { Power, Default };
+
+  virtual ~Checkpointable();
+
+  /**
+   * @brief saveState append the state of this object to a checkpoint.
+   */
+  virtual void saveState(CheckpointWriter &writer) const = 0;
+
+  /**
+   * @brief restoreState restore the state of this object, reading fields in
+   * the order they were written by saveState.
+   */
+  virtual void restoreState(CheckpointReader &reader) = 0;
+
+ protected:
+  /**
+   * @brief registerCheckpointable add this object to the checkpoint registry.
+   * @param name unique name, typically the hierarchical module name
+   * @param stage restore order
+   */
+  void registerCheckpointable(const std::string &name,
+                              const Stage stage = Stage::Default);
+
+  /**
+   * @brief setCheckpointStage change the restore order of an object that was
+   * registered by a base class.
+   */
+  void setCheckpointStage(const Stage stage);
+};
+
+/**
+ * @brief The CheckpointWriter class Serialises state into an in-memory buffer.
+ */
+class CheckpointWriter {
+ public:
+  /**
+   * @brief writeBlock append a raw block of bytes.
+   */
+  void writeBlock(const void *src, const size_t len) {
+    const size_t pos = m_buf.size();
+    m_buf.resize(pos + len);
+    std::memcpy(&m_buf[pos], src, len);
+  }
+
+  /**
+   * @brief write append a trivially copyable value.
+   */
+  template <typename T>
+  void write(const T &val) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable types can be written directly");
+    writeBlock(&val, sizeof(val));
+  }
+
+  /**
+   * @brief writeVector append the length and contents of a vector.
+   */
+  template <typename T>
+  void writeVector(const std::vector<T> &vec) {
+    write(static_cast<uint64_t>(vec.size()));
+    if (!vec.empty()) {
+      writeBlock(vec.data(), vec.size() * sizeof(T));
+    }
+  }
+
+  /**
+   * @brief writeContainer append the length and elements of any container of
+   * trivially copyable elements (e.g. std::list, std::deque).
+   */
+  template <typename C>
+  void writeContainer(const C &container) {
+    write(static_cast<uint64_t>(container.size()));
+    for (const auto &e : container) {
+      write(e);
+    }
+  }
+
+  std::vector<uint8_t> &buffer() { return m_buf; }
+
+ private:
+  std::vector<uint8_t> m_buf;
+};
+
+/**
+ * @brief The CheckpointReader class Deserialises state from a section of a
+ * checkpoint file. Reading past the end of the section is fatal.
+ */
+class CheckpointReader {
+ public:
+  CheckpointReader(const std::string &name, const uint8_t *data,
+                   const size_t len)
+      : m_name(name), m_data(data), m_len(len) {}
+
+  /**
+   * @brief readBlock copy a raw block of bytes.
+   */
+  void readBlock(void *dst, const size_t len) {
+    if (m_pos + len > m_len) {
+      SC_REPORT_FATAL(m_name.c_str(), "Checkpoint section is too short");
+    }
+    std::memcpy(dst, m_data + m_pos, len);
+    m_pos += len;
+  }
+
+  /**
+   * @brief skip advance past a block of bytes without copying it.
+   */
+  void skip(const size_t len) {
+    if (m_pos + len > m_len) {
+      SC_REPORT_FATAL(m_name.c_str(), "Checkpoint section is too short");
+    }
+    m_pos += len;
+  }
+
+  /**
+   * @brief read read a trivially copyable value.
+   */
+  template <typename T>
+  void read(T &val) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable types can be read directly");
+    readBlock(&val, sizeof(val));
+  }
+
+  template <typename T>
+  T read() {
+    T val;
+    read(val);
+    return val;
+  }
+
+  /**
+   * @brief readVector read a vector written by CheckpointWriter::writeVector.
+   */
+  template <typename T>
+  void readVector(std::vector<T> &vec) {
+    vec.resize(read<uint64_t>());
+    if (!vec.empty()) {
+      readBlock(vec.data(), vec.size() * sizeof(T));
+    }
+  }
+
+  /**
+   * @brief readContainer read a container written by
+   * CheckpointWriter::writeContainer.
+   */
+  template <typename C>
+  void readContainer(C &container) {
+    container.clear();
+    const auto n = read<uint64_t>();
+    for (uint64_t i = 0; i < n; ++i) {
+      container.push_back(read<typename C::value_type>());
+    }
+  }
+
+  /**
+   * @brief expect read a size field and check it against the expected value,
+   * e.g. to detect a checkpoint taken with a different configuration.
+   */
+  void expect(const uint64_t expected, const char *what) {
+    if (read<uint64_t>() != expected) {
+      SC_REPORT_FATAL(m_name.c_str(),
+                      (std::string("Checkpoint mismatch: ") + what).c_str());
+    }
+  }
+
+  //! Number of bytes not yet read
+  size_t remaining() const { return m_len - m_pos; }
+
+ private:
+  const std::string m_name;
+  const uint8_t *const m_data;
+  const size_t m_len;
+  size_t m_pos{0};
+};
+
+namespace Checkpoint {
+
+//! Set by request(), cleared once the checkpoint has been written
+extern bool g_requestPending;
+
+/**
+ * @brief save write the state of all registered objects to a file.
+ * @param path output file. Written to a temporary file first, then renamed,
+ * so a crash never leaves a truncated checkpoint behind.
+ */
+void save(const std::string &path);
+
+/**
+ * @brief restore restore the state of all registered objects from a file.
+ * Call after elaboration (i.e. after sc_start(SC_ZERO_TIME)) and with the CPU
+ * unstalled. Restores Stage::Power objects first and, if there were any, runs
+ * delta cycles until power-on resets have settled, then restores everything
+ * else. Without Stage::Power objects it may also be called from a process.
+ * @param path checkpoint file
+ * @retval simulation time at which the checkpoint was taken
+ */
+sc_core::sc_time restore(const std::string &path);
+
+/**
+ * @brief now simulation time, continuing from the time at which a restored
+ * checkpoint was taken.
+ */
+sc_core::sc_time now();
+
+/**
+ * @brief request ask for a checkpoint to be written at the next consistent
+ * point, i.e. the next instruction boundary of the CPU. If the CPU is idle
+ * (see setIdle), the checkpoint is written immediately instead.
+ * @param path output file
+ */
+void request(const std::string &path);
+
+/**
+ * @brief setIdle mark the CPU as blocked at a consistent point, e.g. while
+ * waiting for power, where it would not service a request until it resumes.
+ */
+void setIdle(const bool idle);
+
+/**
+ * @brief saveRequested write a requested checkpoint. Use serviceRequest().
+ */
+void saveRequested();
+
+/**
+ * @brief serviceRequest write a checkpoint if one was requested. Called by the
+ * CPU between instructions.
+ */
+inline void serviceRequest() {
+  if (g_requestPending) {
+    saveRequested();
+  }
+}
+
+}  // namespace Checkpoint
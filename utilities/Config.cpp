@@ -21,11 +21,18 @@ void Config::parseCli(int argc, char *argv[]) {
 
   for (int i = 1; i < argc; i++) {
     if (std::string(argv[i]) == "-h" || std::string(argv[i]) == "--help") {
-      std::cout << "\nusage: fused [-B board] [-O odir] [-x program] [-C config] \n\n";
+      std::cout << "\nusage: fused [-B board] [-O odir] [-x program] [-C config] [-S sweep]\n"
+                   "             [-E ensemble] [-L programs] [--batch]\n"
+                   "             [--set key=value ...]\n\n";
       std::cout << "-B, --board \t : which board to run\n";
       std::cout << "-O, --odir \t : path to output directory\n";
       std::cout << "-x, --program \t : path to program hex file\n";
       std::cout << "-C, --config \t : path to config file\n";
+      std::cout << "-S, --sweep \t : path to parameter sweep spec\n";
+      std::cout << "-E, --ensemble \t : path to ensemble spec\n";
+      std::cout << "-L, --programs \t : path to list of program hex files, run on one elaboration\n";
+      std::cout << "--batch \t : headless, no traces, write summary.json\n";
+      std::cout << "--set \t\t : override a config file setting, e.g. --set SimTimeLimit=1.0\n";
       exit(0);
     } else if (std::string(argv[i]) == "-C" || std::string(argv[i]) == "--config") {
       m_config["ConfigFile"] = std::string(argv[i + 1]);
@@ -44,6 +51,30 @@ void Config::parseCli(int argc, char *argv[]) {
       spdlog::info("Loading and immediately running program from: {:s}",
                    m_config["ProgramHexFile"]);
       i++;
+    } else if ((std::string(argv[i]) == "-S") ||
+               (std::string(argv[i]) == "--sweep")) {
+      m_config["SweepFile"] = std::string(argv[i + 1]);
+      i++;
+    } else if ((std::string(argv[i]) == "-E") ||
+               (std::string(argv[i]) == "--ensemble")) {
+      m_config["EnsembleFile"] = std::string(argv[i + 1]);
+      i++;
+    } else if ((std::string(argv[i]) == "-L") ||
+               (std::string(argv[i]) == "--programs")) {
+      m_config["GdbServer"] = "False";
+      m_config["ProgramList"] = std::string(argv[i + 1]);
+      i++;
+    } else if (std::string(argv[i]) == "--batch") {
+      m_config["BatchMode"] = "True";
+    } else if (std::string(argv[i]) == "--set") {
+      const std::string kv = i + 1 < argc ? argv[i + 1] : "";
+      const auto eq = kv.find('=');
+      if (eq == std::string::npos || eq == 0) {
+        spdlog::error("--set expects key=value, got \"{}\" exiting...", kv);
+        exit(1);
+      }
+      m_config[kv.substr(0, eq)] = kv.substr(eq + 1);
+      i++;
     } else if ((std::string(argv[i]) == "-B") ||
                (std::string(argv[i]) == "--board")) {
       m_config["Board"] = std::string(argv[i + 1]);
@@ -73,7 +104,7 @@ void Config::parseFile(const std::string &fn) {
 }
 
 const std::string &Config::getString(const std::string &key) const {
-  auto it = m_config.find(key);
+  auto it = find(key);
   if (it != m_config.end()) {
     return it->second;
   } else {
@@ -102,5 +133,37 @@ bool Config::getBool(const std::string &key) const {
 }
 
 bool Config::contains(const std::string &key) const {
-  return m_config.find(key) != m_config.end();
+  return find(key) != m_config.end();
+}
+
+void Config::set(const std::string &key, const std::string &value) {
+  m_config[key] = value;
+  const auto range = m_listeners.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    it->second(value);
+  }
+}
+
+void Config::addListener(const std::string &key, Listener listener) {
+  m_listeners.emplace(key, listener);
+}
+
+bool Config::hasListener(const std::string &key) const {
+  return m_listeners.find(key) != m_listeners.end();
+}
+
+void Config::addAlias(const std::string &instance, const std::string &target) {
+  m_aliases[instance] = target;
+}
+
+std::map<std::string, std::string>::const_iterator Config::find(
+    const std::string &key) const {
+  auto it = m_config.find(key);
+  if (it == m_config.end() && !m_aliases.empty()) {
+    const auto alias = m_aliases.find(key.substr(0, key.find('.')));
+    if (alias != m_aliases.end()) {
+      it = m_config.find(alias->second + key.substr(alias->first.size()));
+    }
+  }
+  return it;
 }
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <string>
@@ -71,12 +72,55 @@ class Config {
    */
   bool contains(const std::string &key) const;
 
+  /**
+   * @brief set override a configuration value, e.g. for one point of a
+   * parameter sweep. Only modules constructed afterwards, and listeners of the
+   * key, see the new value.
+   * @param key configuration key (yaml key).
+   * @param value new value.
+   */
+  void set(const std::string &key, const std::string &value);
+
+  //! Called with the new value when a key is changed through set()
+  typedef std::function<void(const std::string &value)> Listener;
+
+  /**
+   * @brief addListener register a listener for a key, for modules that can
+   * apply the key at run-time, e.g. to members of a forked ensemble.
+   * @param key configuration key (yaml key).
+   * @param listener callback.
+   */
+  void addListener(const std::string &key, Listener listener);
+
+  /**
+   * @brief hasListener check if any module applies the key at run-time.
+   * @param key configuration key (yaml key).
+   */
+  bool hasListener(const std::string &key) const;
+
+  /**
+   * @brief addAlias make the keys of a module instance default to those of
+   * another, e.g. for several instances of a board in one simulation. After
+   * addAlias("node1", "Msp430RadioNode"), "node1.mcu.CPU on" falls back to
+   * "Msp430RadioNode.mcu.CPU on" if it isn't set itself.
+   * @param instance name of the top-level instance
+   * @param target name whose keys are used instead
+   */
+  void addAlias(const std::string &instance, const std::string &target);
+
  private:
   /* ------ Private variables ------ */
   std::map<std::string, std::string> m_config{};  //! Configuration
   std::string m_configFileName;                   //! Path to Yaml-file
+  std::multimap<std::string, Listener> m_listeners{};  //! Run-time listeners
+  std::map<std::string, std::string> m_aliases{};  //! Instance -> target
 
   /* ------ Private methods ------ */
+  /**
+   * @brief find look up a key, falling back to its alias if it has one.
+   */
+  std::map<std::string, std::string>::const_iterator find(
+      const std::string &key) const;
 
   // Private constructor
   Config() {}
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <string>
+#include <systemc>
+#include <vector>
+#include "utilities/Config.hpp"
+#include "utilities/Coverage.hpp"
+#include "utilities/ElfLines.hpp"
+#include "utilities/ElfSymbols.hpp"
+#include "utilities/Utilities.hpp"
+
+namespace {
+
+//! Hit status of the lines & functions of a source file
+struct FileCoverage {
+  std::map<unsigned, bool> lines;
+  std::map<std::string, std::pair<unsigned, bool>> functions;  //! line, hit
+};
+
+//! Write an lcov tracefile, see geninfo(1)
+void writeLcov(const std::string &path, const std::string &test,
+               const std::vector<std::string> &files,
+               const std::map<unsigned, FileCoverage> &coverage) {
+  std::ofstream os(path);
+  // Sort by path, files are indexed in line table order
+  std::vector<std::pair<std::string, const FileCoverage *>> sorted;
+  for (const auto &f : coverage) {
+    sorted.emplace_back(files[f.first], &f.second);
+  }
+  std::sort(sorted.begin(), sorted.end(),
+            [](const std::pair<std::string, const FileCoverage *> &a,
+               const std::pair<std::string, const FileCoverage *> &b) {
+              return a.first < b.first;
+            });
+
+  for (const auto &f : sorted) {
+    os << "TN:" << test << "\nSF:" << f.first << '\n';
+    unsigned fnHit = 0;
+    for (const auto &fn : f.second->functions) {
+      os << fmt::format("FN:{:d},{:s}\n", fn.second.first, fn.first);
+    }
+    for (const auto &fn : f.second->functions) {
+      os << fmt::format("FNDA:{:d},{:s}\n", fn.second.second ? 1 : 0,
+                        fn.first);
+      fnHit += fn.second.second;
+    }
+    os << fmt::format("FNF:{:d}\nFNH:{:d}\n", f.second->functions.size(),
+                      fnHit);
+    unsigned lineHit = 0;
+    for (const auto &l : f.second->lines) {
+      os << fmt::format("DA:{:d},{:d}\n", l.first, l.second ? 1 : 0);
+      lineHit += l.second;
+    }
+    os << fmt::format("LF:{:d}\nLH:{:d}\nend_of_record\n",
+                      f.second->lines.size(), lineHit);
+  }
+}
+
+}  // namespace
+
+Coverage::Coverage(const std::string &name, const uint32_t codeStart,
+                   const uint32_t codeEnd)
+    : m_name(name),
+      m_codeStart(codeStart),
+      m_nSlots((codeEnd - codeStart) / 2),
+      m_bitmap((m_nSlots + 63) / 64, 0) {
+  m_perCycle = Config::get().contains("CoveragePerCycle") &&
+               Config::get().getBool("CoveragePerCycle");
+  if (m_perCycle) {
+    m_previousCycles = m_bitmap;
+  }
+}
+
+bool Coverage::isEnabled() {
+  return Config::get().contains("Coverage") &&
+         Config::get().getBool("Coverage");
+}
+
+uint64_t Coverage::covered(const Bitmap &bitmap) {
+  uint64_t n = 0;
+  for (const auto w : bitmap) {
+    n += __builtin_popcountll(w);
+  }
+  return n;
+}
+
+bool Coverage::anySet(const Bitmap &bitmap, const uint32_t begin,
+                      const uint32_t end) const {
+  for (uint32_t pc = begin; pc < end; pc += 2) {
+    const uint32_t i = (pc - m_codeStart) >> 1;
+    if (i < m_nSlots && (bitmap[i >> 6] & (uint64_t(1) << (i & 63)))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Coverage::reset() {
+  if (std::all_of(m_bitmap.begin(), m_bitmap.end(),
+                  [](const uint64_t w) { return w == 0; })) {
+    return;  // Initial reset, nothing executed yet
+  }
+  if (!m_rebooted) {
+    m_firstCycle = m_bitmap;
+    m_rebooted = true;
+  }
+  if (m_perCycle) {
+    writeCycle();
+  }
+}
+
+void Coverage::writeCycle() {
+  uint64_t newSlots = 0;
+  for (size_t i = 0; i < m_bitmap.size(); ++i) {
+    newSlots += __builtin_popcountll(m_bitmap[i] & ~m_previousCycles[i]);
+  }
+  m_previousCycles = m_bitmap;
+
+  const auto path =
+      Utility::outputDirectory(m_name) + "/" + m_name + "_coverage_cycles.csv";
+  std::ofstream f(path, m_cycle == 0 ? std::ios::trunc : std::ios::app);
+  if (m_cycle == 0) {
+    f << "cycle,time(s),new_instructions,instructions\n";
+  }
+  f << fmt::format("{:d},{:.9g},{:d},{:d}\n", m_cycle,
+                   sc_core::sc_time_stamp().to_seconds(), newSlots,
+                   covered(m_bitmap));
+  ++m_cycle;
+}
+
+void Coverage::write() {
+  if (m_perCycle) {
+    writeCycle();  // The cycle cut short by the end of simulation
+  }
+
+  const auto elf = Utility::elfPath("CoverageElf", m_name);
+  const ElfLines lines(elf);
+  const ElfSymbols symbols(elf);
+  const auto nCovered = covered(m_bitmap);
+  if (!lines.isValid()) {
+    spdlog::warn("Coverage: {:d} instruction addresses executed, no line "
+                 "table to map them to source",
+                 nCovered);
+    return;
+  }
+
+  // Lines hit if any of their instructions was executed, only after reboot
+  // if none was executed in the first power cycle
+  const Bitmap &first = m_rebooted ? m_firstCycle : m_bitmap;
+  std::map<unsigned, FileCoverage> all, before, afterReboot;
+  for (const auto &row : lines.rows()) {
+    if (row.addr - m_codeStart >= 2 * m_nSlots) {
+      continue;
+    }
+    auto &line = all[row.file].lines[row.line];
+    line = line || anySet(m_bitmap, row.addr, row.end);
+    auto &lineBefore = before[row.file].lines[row.line];
+    lineBefore = lineBefore || anySet(first, row.addr, row.end);
+  }
+  for (const auto &f : all) {
+    const auto &linesBefore = before[f.first].lines;
+    for (const auto &l : f.second.lines) {
+      if (l.second && !linesBefore.at(l.first)) {
+        afterReboot[f.first].lines[l.first] = true;
+      }
+    }
+  }
+
+  // Functions hit if their entry point was executed
+  for (const auto &s : symbols.symbols()) {
+    const int r = lines.find(s.addr);
+    if (r < 0 || s.addr - m_codeStart >= 2 * m_nSlots) {
+      continue;
+    }
+    const auto &row = lines.rows()[r];
+    const bool hit = anySet(m_bitmap, s.addr, s.addr + 2);
+    all[row.file].functions[s.name] = std::make_pair(row.line, hit);
+    if (hit && !anySet(first, s.addr, s.addr + 2)) {
+      afterReboot[row.file].functions[s.name] = std::make_pair(row.line, true);
+    }
+  }
+
+  const auto prefix = Utility::outputDirectory(m_name) + "/" + m_name;
+  writeLcov(prefix + "_coverage.info", "fused", lines.files(), all);
+  writeLcov(prefix + "_coverage_after_reboot.info", "fused_after_reboot",
+            lines.files(), afterReboot);
+
+  unsigned nLines = 0, nHit = 0, nAfterReboot = 0;
+  for (const auto &f : all) {
+    for (const auto &l : f.second.lines) {
+      ++nLines;
+      nHit += l.second;
+    }
+  }
+  for (const auto &f : afterReboot) {
+    nAfterReboot += f.second.lines.size();
+  }
+  spdlog::info("Coverage: {:d} instruction addresses, {:d}/{:d} lines "
+               "executed ({:d} only after reboot), written to "
+               "{:s}_coverage.info",
+               nCovered, nHit, nLines, nAfterReboot, prefix);
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*
+ * Firmware coverage, cheap enough to leave enabled in CI.
+ *
+ * The CPU marks every executed instruction address in a flat bitmap of the code
+ * region (one bit per 16-bit instruction slot), so the cost is a single bit-set
+ * per instruction. The bitmap is only interpreted at the end of simulation,
+ * when it is mapped to source lines & functions through the line table and
+ * symbols of the firmware ELF file (CoverageElf, or ProgramHexFile with .elf
+ * extension), and written in lcov tracefile format (genhtml, gcovr, ...):
+ *  - <OutputDirectory>/<name>_coverage.info: all lines & functions;
+ *  - <OutputDirectory>/<name>_coverage_after_reboot.info: only the lines &
+ *    functions first executed after the first power failure, e.g. restore &
+ *    recovery paths of intermittent firmware.
+ *
+ * With CoveragePerCycle: True, the number of instructions first covered in each
+ * power cycle is appended to <OutputDirectory>/<name>_coverage_cycles.csv.
+ *
+ * Enabled with Coverage: True.
+ */
+class Coverage {
+ public:
+  /**
+   * @brief Coverage constructor.
+   * @param name name of the CPU, prefix of the output files
+   * @param codeStart start address of the code region
+   * @param codeEnd end address (exclusive) of the code region
+   */
+  Coverage(const std::string &name, const uint32_t codeStart,
+           const uint32_t codeEnd);
+
+  /**
+   * @brief isEnabled check if coverage is enabled in the config.
+   */
+  static bool isEnabled();
+
+  /**
+   * @brief mark mark an instruction address as executed. Addresses outside
+   * the code region are ignored.
+   */
+  void mark(const uint32_t pc) {
+    const uint32_t i = (pc - m_codeStart) >> 1;
+    if (i < m_nSlots) {
+      m_bitmap[i >> 6] |= uint64_t(1) << (i & 63);
+    }
+  }
+
+  /**
+   * @brief reset call on CPU reset, i.e. at power-on. Closes the previous
+   * power cycle, if any instruction was executed.
+   */
+  void reset();
+
+  /**
+   * @brief write map the bitmap to source lines and write the lcov files.
+   */
+  void write();
+
+ private:
+  typedef std::vector<uint64_t> Bitmap;
+
+  const std::string m_name;
+  const uint32_t m_codeStart;
+  const uint32_t m_nSlots;  //! Number of 16-bit instruction slots
+  Bitmap m_bitmap;
+  Bitmap m_firstCycle;      //! Bitmap at the first power failure
+  Bitmap m_previousCycles;  //! Bitmap at the last reset, for CoveragePerCycle
+  bool m_rebooted{false};
+  bool m_perCycle{false};
+  unsigned m_cycle{0};
+
+  /**
+   * @brief covered count the instruction slots set in a bitmap.
+   */
+  static uint64_t covered(const Bitmap &bitmap);
+
+  /**
+   * @brief anySet check if any slot of an address range is set in a bitmap.
+   */
+  bool anySet(const Bitmap &bitmap, const uint32_t begin,
+              const uint32_t end) const;
+
+  /**
+   * @brief writeCycle append the coverage of the last power cycle to the
+   * per-cycle csv file.
+   */
+  void writeCycle();
+};
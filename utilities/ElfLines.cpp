@@ -0,0 +1,444 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <elf.h>
+#include <spdlog/spdlog.h>
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+#include "utilities/ElfLines.hpp"
+
+namespace {
+
+// DWARF constants, see the DWARF 5 standard, section 6.2 & 7.22
+enum : uint8_t {
+  DW_LNS_copy = 1,
+  DW_LNS_advance_pc = 2,
+  DW_LNS_advance_line = 3,
+  DW_LNS_set_file = 4,
+  DW_LNS_const_add_pc = 8,
+  DW_LNS_fixed_advance_pc = 9,
+  DW_LNE_end_sequence = 1,
+  DW_LNE_set_address = 2,
+  DW_LNE_define_file = 3,
+  DW_LNCT_path = 1,
+  DW_LNCT_directory_index = 2,
+  DW_FORM_block = 0x09,
+  DW_FORM_data1 = 0x0b,
+  DW_FORM_data2 = 0x05,
+  DW_FORM_data4 = 0x06,
+  DW_FORM_data8 = 0x07,
+  DW_FORM_data16 = 0x1e,
+  DW_FORM_string = 0x08,
+  DW_FORM_strp = 0x0e,
+  DW_FORM_udata = 0x0f,
+  DW_FORM_line_strp = 0x1f,
+};
+
+//! Bounds-checked little-endian reader, reads zeros once past the end
+class Reader {
+ public:
+  Reader(const char *begin, const char *end) : m_p(begin), m_end(end) {}
+
+  bool ok() const { return m_ok; }
+  bool atEnd() const { return m_p >= m_end; }
+  const char *pos() const { return m_p; }
+
+  uint64_t u(const unsigned n) {
+    if (m_end - m_p < static_cast<ptrdiff_t>(n)) {
+      m_ok = false;
+      m_p = m_end;
+      return 0;
+    }
+    uint64_t v = 0;
+    for (unsigned i = 0; i < n; ++i) {
+      v |= static_cast<uint64_t>(static_cast<uint8_t>(m_p[i])) << (8 * i);
+    }
+    m_p += n;
+    return v;
+  }
+
+  uint64_t uleb() {
+    uint64_t v = 0;
+    unsigned shift = 0;
+    uint8_t b;
+    do {
+      b = u(1);
+      v |= shift < 64 ? static_cast<uint64_t>(b & 0x7f) << shift : 0;
+      shift += 7;
+    } while ((b & 0x80) && m_ok);
+    return v;
+  }
+
+  int64_t sleb() {
+    int64_t v = 0;
+    unsigned shift = 0;
+    uint8_t b;
+    do {
+      b = u(1);
+      v |= shift < 64 ? static_cast<int64_t>(b & 0x7f) << shift : 0;
+      shift += 7;
+    } while ((b & 0x80) && m_ok);
+    if (shift < 64 && (b & 0x40)) {
+      v |= -(static_cast<int64_t>(1) << shift);
+    }
+    return v;
+  }
+
+  std::string str() {
+    const char *nul = static_cast<const char *>(memchr(m_p, 0, m_end - m_p));
+    if (nul == nullptr) {
+      m_ok = false;
+      m_p = m_end;
+      return "";
+    }
+    std::string s(m_p, nul);
+    m_p = nul + 1;
+    return s;
+  }
+
+  void skip(const uint64_t n) {
+    if (static_cast<uint64_t>(m_end - m_p) < n) {
+      m_ok = false;
+      m_p = m_end;
+    } else {
+      m_p += n;
+    }
+  }
+
+ private:
+  const char *m_p;
+  const char *m_end;
+  bool m_ok{true};
+};
+
+struct Section {
+  const char *begin;
+  const char *end;
+};
+
+//! String at an offset into a string section
+std::string sectionString(const Section &s, const uint64_t offset) {
+  if (s.begin == nullptr || offset >= static_cast<uint64_t>(s.end - s.begin)) {
+    return "";
+  }
+  Reader r(s.begin + offset, s.end);
+  return r.str();
+}
+
+//! Join a directory & file name
+std::string joinPath(const std::string &dir, const std::string &name) {
+  if (dir.empty() || name.empty() || name[0] == '/') {
+    return name;
+  }
+  return dir.back() == '/' ? dir + name : dir + "/" + name;
+}
+
+}  // namespace
+
+ElfLines::ElfLines(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  const std::vector<char> data((std::istreambuf_iterator<char>(file)),
+                               std::istreambuf_iterator<char>());
+
+  Elf32_Ehdr ehdr;
+  if (data.size() < sizeof(ehdr)) {
+    spdlog::warn("ElfLines: can't read {:s}", path);
+    return;
+  }
+  memcpy(&ehdr, &data[0], sizeof(ehdr));
+  if (memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0 ||
+      ehdr.e_ident[EI_CLASS] != ELFCLASS32 ||
+      ehdr.e_ident[EI_DATA] != ELFDATA2LSB ||
+      ehdr.e_shentsize != sizeof(Elf32_Shdr) ||
+      ehdr.e_shoff + ehdr.e_shnum * sizeof(Elf32_Shdr) > data.size() ||
+      ehdr.e_shstrndx >= ehdr.e_shnum) {
+    spdlog::warn("ElfLines: {:s} is not a 32-bit little-endian ELF file",
+                 path);
+    return;
+  }
+
+  std::vector<Elf32_Shdr> sections(ehdr.e_shnum);
+  memcpy(sections.data(), &data[ehdr.e_shoff],
+         ehdr.e_shnum * sizeof(Elf32_Shdr));
+  const auto &shstrtab = sections[ehdr.e_shstrndx];
+
+  Section debugLine{}, debugStr{}, debugLineStr{};
+  std::vector<std::pair<uint32_t, uint32_t>> code;  // Executable ranges
+  for (const auto &sh : sections) {
+    if ((sh.sh_flags & SHF_ALLOC) && (sh.sh_flags & SHF_EXECINSTR)) {
+      code.emplace_back(sh.sh_addr, sh.sh_size);
+    }
+    if (sh.sh_type == SHT_NOBITS || sh.sh_offset + sh.sh_size > data.size() ||
+        sh.sh_name >= shstrtab.sh_size ||
+        shstrtab.sh_offset + shstrtab.sh_size > data.size()) {
+      continue;
+    }
+    const std::string name(&data[shstrtab.sh_offset + sh.sh_name]);
+    const Section s{&data[0] + sh.sh_offset,
+                    &data[0] + sh.sh_offset + sh.sh_size};
+    if (name == ".debug_line") {
+      debugLine = s;
+    } else if (name == ".debug_str") {
+      debugStr = s;
+    } else if (name == ".debug_line_str") {
+      debugLineStr = s;
+    }
+  }
+  if (debugLine.begin == nullptr) {
+    spdlog::warn("ElfLines: {:s} has no line table (build with -g)", path);
+    return;
+  }
+  const auto isCode = [&code](const uint32_t addr) {
+    for (const auto &c : code) {
+      if (addr - c.first < c.second) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  std::map<std::string, unsigned> fileIds;
+  const auto fileId = [&fileIds, this](const std::string &name) {
+    auto it = fileIds.find(name);
+    if (it == fileIds.end()) {
+      it = fileIds.emplace(name, m_files.size()).first;
+      m_files.push_back(name);
+    }
+    return it->second;
+  };
+
+  Reader units(debugLine.begin, debugLine.end);
+  while (!units.atEnd() && units.ok()) {
+    // ------ Unit header ------
+    uint64_t unitLength = units.u(4);
+    unsigned offsetSize = 4;
+    if (unitLength == 0xffffffff) {  // 64-bit DWARF
+      unitLength = units.u(8);
+      offsetSize = 8;
+    }
+    const char *unitBegin = units.pos();
+    units.skip(unitLength);
+    if (!units.ok()) {
+      break;
+    }
+    Reader r(unitBegin, unitBegin + unitLength);
+
+    const unsigned version = r.u(2);
+    if (version < 2 || version > 5) {
+      spdlog::warn("ElfLines: unsupported line table version {:d} in {:s}",
+                   version, path);
+      continue;
+    }
+    if (version >= 5) {
+      r.skip(2);  // address_size, segment_selector_size
+    }
+    const uint64_t headerLength = r.u(offsetSize);
+    const char *unitEnd = unitBegin + unitLength;
+    if (headerLength > static_cast<uint64_t>(unitEnd - r.pos())) {
+      continue;
+    }
+    const char *program = r.pos() + headerLength;
+    const unsigned minInstLength = r.u(1);
+    if (version >= 4) {
+      r.skip(1);  // maximum_operations_per_instruction, VLIW only
+    }
+    r.skip(1);  // default_is_stmt, all rows are used
+    const int lineBase = static_cast<int8_t>(r.u(1));
+    const unsigned lineRange = r.u(1);
+    const unsigned opcodeBase = r.u(1);
+    std::vector<unsigned> opcodeLengths(opcodeBase, 0);
+    for (unsigned i = 1; i < opcodeBase; ++i) {
+      opcodeLengths[i] = r.u(1);
+    }
+    if (lineRange == 0) {
+      continue;
+    }
+
+    std::vector<std::string> dirs;
+    std::vector<unsigned> files;  // Unit's file indices to fileIds
+    if (version < 5) {
+      dirs.push_back("");  // Compilation directory
+      for (auto d = r.str(); !d.empty() && r.ok(); d = r.str()) {
+        dirs.push_back(d);
+      }
+      files.push_back(0);  // File numbers start at 1
+      for (auto f = r.str(); !f.empty() && r.ok(); f = r.str()) {
+        const auto dir = r.uleb();
+        r.uleb();  // Modification time
+        r.uleb();  // Length
+        files.push_back(
+            fileId(joinPath(dir < dirs.size() ? dirs[dir] : "", f)));
+      }
+    } else {
+      // Entries are described by (content type, form) pairs
+      const auto readEntries = [&](std::vector<std::string> &paths,
+                                   std::vector<uint64_t> &dirIndex) {
+        std::vector<std::pair<uint64_t, uint64_t>> format(r.u(1));
+        for (auto &f : format) {
+          f.first = r.uleb();
+          f.second = r.uleb();
+        }
+        const uint64_t count = r.uleb();
+        for (uint64_t i = 0; i < count && r.ok(); ++i) {
+          std::string name;
+          uint64_t dir = 0;
+          for (const auto &f : format) {
+            std::string s;
+            uint64_t v = 0;
+            switch (f.second) {
+              case DW_FORM_string:
+                s = r.str();
+                break;
+              case DW_FORM_strp:
+                s = sectionString(debugStr, r.u(offsetSize));
+                break;
+              case DW_FORM_line_strp:
+                s = sectionString(debugLineStr, r.u(offsetSize));
+                break;
+              case DW_FORM_udata:
+                v = r.uleb();
+                break;
+              case DW_FORM_data1:
+                v = r.u(1);
+                break;
+              case DW_FORM_data2:
+                v = r.u(2);
+                break;
+              case DW_FORM_data4:
+                v = r.u(4);
+                break;
+              case DW_FORM_data8:
+                v = r.u(8);
+                break;
+              case DW_FORM_data16:
+                r.skip(16);
+                break;
+              case DW_FORM_block:
+                r.skip(r.uleb());
+                break;
+              default:
+                spdlog::warn("ElfLines: unsupported form 0x{:x} in {:s}",
+                             f.second, path);
+                return false;
+            }
+            if (f.first == DW_LNCT_path) {
+              name = s;
+            } else if (f.first == DW_LNCT_directory_index) {
+              dir = v;
+            }
+          }
+          paths.push_back(name);
+          dirIndex.push_back(dir);
+        }
+        return r.ok();
+      };
+      std::vector<uint64_t> unused, fileDirs;
+      std::vector<std::string> names;
+      if (!readEntries(dirs, unused) || !readEntries(names, fileDirs)) {
+        continue;
+      }
+      for (unsigned i = 1; i < dirs.size(); ++i) {
+        dirs[i] = joinPath(dirs[0], dirs[i]);  // Relative to the compile dir
+      }
+      for (unsigned i = 0; i < names.size(); ++i) {
+        const auto dir = i < fileDirs.size() ? fileDirs[i] : 0;
+        files.push_back(
+            fileId(joinPath(dir < dirs.size() ? dirs[dir] : "", names[i])));
+      }
+    }
+    if (!r.ok() || program < r.pos()) {
+      continue;
+    }
+
+    // ------ Line number program ------
+    Reader p(program, unitBegin + unitLength);
+    uint32_t addr = 0;
+    unsigned file = 1;
+    unsigned line = 1;
+    std::vector<Row> sequence;
+    const auto emit = [&]() {
+      if (!sequence.empty() && sequence.back().addr == addr) {
+        sequence.pop_back();  // Only the last row at an address counts
+      }
+      sequence.push_back(Row{addr, addr,
+                             file < files.size() ? files[file] : ~0u, line});
+    };
+    while (!p.atEnd() && p.ok()) {
+      const unsigned op = p.u(1);
+      if (op >= opcodeBase) {  // Special opcode
+        const unsigned adjusted = op - opcodeBase;
+        addr += (adjusted / lineRange) * minInstLength;
+        line += lineBase + static_cast<int>(adjusted % lineRange);
+        emit();
+      } else if (op == 0) {  // Extended opcode
+        const uint64_t length = p.uleb();
+        const char *next = p.pos() + length;
+        const unsigned sub = length > 0 ? p.u(1) : 0;
+        if (sub == DW_LNE_end_sequence) {
+          // Each row extends to the next, the last one ends the sequence
+          for (unsigned i = 0; i < sequence.size(); ++i) {
+            auto &row = sequence[i];
+            row.end = i + 1 < sequence.size() ? sequence[i + 1].addr : addr;
+            if (row.end > row.addr && row.file != ~0u && isCode(row.addr)) {
+              m_rows.push_back(row);
+            }
+          }
+          sequence.clear();
+          addr = 0;
+          file = 1;
+          line = 1;
+        } else if (sub == DW_LNE_set_address) {
+          addr = p.u(std::min<uint64_t>(length - 1, 8));
+        } else if (sub == DW_LNE_define_file && version < 5) {
+          const auto f = p.str();
+          const auto dir = p.uleb();
+          files.push_back(
+              fileId(joinPath(dir < dirs.size() ? dirs[dir] : "", f)));
+        }
+        p.skip(next - p.pos());
+      } else if (op == DW_LNS_copy) {
+        emit();
+      } else if (op == DW_LNS_advance_pc) {
+        addr += p.uleb() * minInstLength;
+      } else if (op == DW_LNS_advance_line) {
+        line += p.sleb();
+      } else if (op == DW_LNS_set_file) {
+        file = p.uleb();
+      } else if (op == DW_LNS_const_add_pc) {
+        addr += ((255 - opcodeBase) / lineRange) * minInstLength;
+      } else if (op == DW_LNS_fixed_advance_pc) {
+        addr += p.u(2);
+      } else {  // Skip the operands of other standard opcodes
+        for (unsigned i = 0; i < opcodeLengths[op]; ++i) {
+          p.uleb();
+        }
+      }
+    }
+  }
+
+  std::sort(m_rows.begin(), m_rows.end(),
+            [](const Row &a, const Row &b) { return a.addr < b.addr; });
+  m_valid = !m_rows.empty();
+  spdlog::info("ElfLines: read {:d} line table rows for {:d} files from {:s}",
+               m_rows.size(), m_files.size(), path);
+}
+
+int ElfLines::find(const uint32_t addr) const {
+  auto it = std::upper_bound(
+      m_rows.begin(), m_rows.end(), addr,
+      [](const uint32_t a, const Row &r) { return a < r.addr; });
+  if (it == m_rows.begin()) {
+    return -1;
+  }
+  --it;
+  return (addr - it->addr < it->end - it->addr) ? it - m_rows.begin() : -1;
+}
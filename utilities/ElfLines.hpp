@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The ElfLines class Reads the DWARF line table (.debug_line, versions
+ * 2 to 5) of a 32-bit little-endian ELF file, for resolving addresses to
+ * source lines.
+ *
+ * Only sequences within executable sections are kept, i.e. not those of
+ * functions discarded by the linker. File paths are as recorded by the
+ * compiler, relative paths are relative to the compilation directory.
+ */
+class ElfLines {
+ public:
+  //! Address range of a source line
+  struct Row {
+    uint32_t addr;
+    uint32_t end;   //! Exclusive
+    unsigned file;  //! Index into files()
+    unsigned line;
+  };
+
+  /**
+   * @brief ElfLines load the line table from an ELF file.
+   * @param path path to the ELF file. An invalid file, or one without debug
+   * info, results in an empty table.
+   */
+  explicit ElfLines(const std::string &path);
+
+  /**
+   * @brief isValid check if a line table was read successfully.
+   */
+  bool isValid() const { return m_valid; }
+
+  /**
+   * @brief files get the source files.
+   */
+  const std::vector<std::string> &files() const { return m_files; }
+
+  /**
+   * @brief rows get the rows, sorted by address.
+   */
+  const std::vector<Row> &rows() const { return m_rows; }
+
+  /**
+   * @brief find get the index of the row containing an address.
+   * @retval index into rows(), or -1 if no row contains the address.
+   */
+  int find(const uint32_t addr) const;
+
+ private:
+  bool m_valid{false};
+  std::vector<std::string> m_files;
+  std::vector<Row> m_rows;
+};
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <elf.h>
+#include <spdlog/spdlog.h>
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "utilities/ElfSymbols.hpp"
+
+ElfSymbols::ElfSymbols(const std::string &path, const bool objects) {
+  std::ifstream file(path, std::ios::binary);
+  const std::vector<char> data((std::istreambuf_iterator<char>(file)),
+                               std::istreambuf_iterator<char>());
+
+  Elf32_Ehdr ehdr;
+  if (data.size() < sizeof(ehdr)) {
+    spdlog::warn("ElfSymbols: can't read {:s}", path);
+    return;
+  }
+  memcpy(&ehdr, &data[0], sizeof(ehdr));
+  if (memcmp(ehdr.e_ident, ELFMAG, SELFMAG) != 0 ||
+      ehdr.e_ident[EI_CLASS] != ELFCLASS32 ||
+      ehdr.e_ident[EI_DATA] != ELFDATA2LSB ||
+      ehdr.e_shentsize != sizeof(Elf32_Shdr) ||
+      ehdr.e_shoff + ehdr.e_shnum * sizeof(Elf32_Shdr) > data.size()) {
+    spdlog::warn("ElfSymbols: {:s} is not a 32-bit little-endian ELF file",
+                 path);
+    return;
+  }
+
+  std::vector<Elf32_Shdr> sections(ehdr.e_shnum);
+  memcpy(sections.data(), &data[ehdr.e_shoff],
+         ehdr.e_shnum * sizeof(Elf32_Shdr));
+  const bool isThumb = ehdr.e_machine == EM_ARM;
+
+  for (const auto &sh : sections) {
+    if (sh.sh_type != SHT_SYMTAB || sh.sh_link >= sections.size()) {
+      continue;
+    }
+    const auto &strtab = sections[sh.sh_link];
+    if (sh.sh_offset + sh.sh_size > data.size() ||
+        strtab.sh_offset + strtab.sh_size > data.size()) {
+      break;
+    }
+    for (unsigned i = 0; i < sh.sh_size / sizeof(Elf32_Sym); ++i) {
+      Elf32_Sym sym;
+      memcpy(&sym, &data[sh.sh_offset + i * sizeof(Elf32_Sym)], sizeof(sym));
+      const auto type = ELF32_ST_TYPE(sym.st_info);
+      if (sym.st_shndx == SHN_UNDEF || sym.st_name >= strtab.sh_size) {
+        continue;
+      }
+      const std::string name(&data[strtab.sh_offset + sym.st_name]);
+      if (!name.empty() && type != STT_SECTION && type != STT_FILE) {
+        m_values.emplace(name, sym.st_value);
+      }
+      if (sym.st_shndx >= sections.size()) {
+        continue;  // Absolute & common symbols
+      }
+      const auto flags = sections[sym.st_shndx].sh_flags;
+      const bool isCode = flags & SHF_EXECINSTR;
+      const bool isGlobal = ELF32_ST_BIND(sym.st_info) != STB_LOCAL;
+      if (objects) {
+        if (isCode || !(flags & SHF_ALLOC) || type != STT_OBJECT) {
+          continue;  // Only variables
+        }
+      } else if (!isCode ||
+                 (type != STT_FUNC && !(type == STT_NOTYPE && isGlobal))) {
+        continue;  // Only functions & global code labels
+      }
+      if (name.empty() || name[0] == '$' || name[0] == '.') {
+        continue;  // Mapping symbols & local labels
+      }
+      const uint32_t addr =
+          isThumb && !objects ? (sym.st_value & ~1u) : sym.st_value;
+      m_symbols.push_back(Symbol{name, addr, sym.st_size});
+    }
+  }
+
+  // Sort by address, prefer sized (typed) symbols for aliases
+  std::sort(m_symbols.begin(), m_symbols.end(),
+            [](const Symbol &a, const Symbol &b) {
+              return a.addr != b.addr ? a.addr < b.addr : a.size > b.size;
+            });
+  m_symbols.erase(std::unique(m_symbols.begin(), m_symbols.end(),
+                              [](const Symbol &a, const Symbol &b) {
+                                return a.addr == b.addr;
+                              }),
+                  m_symbols.end());
+
+  // Drop labels within functions, unsized symbols extend to the next symbol
+  std::vector<Symbol> symbols;
+  for (const auto &s : m_symbols) {
+    if (symbols.empty() || s.size > 0 ||
+        s.addr - symbols.back().addr >= symbols.back().size) {
+      symbols.push_back(s);
+    }
+  }
+  for (unsigned i = 0; i + 1 < symbols.size(); ++i) {
+    if (symbols[i].size == 0) {
+      symbols[i].size = symbols[i + 1].addr - symbols[i].addr;
+    }
+  }
+  m_symbols.swap(symbols);
+
+  m_valid = true;
+  spdlog::info("ElfSymbols: read {:d} {:s} symbols from {:s}",
+               m_symbols.size(), objects ? "object" : "function", path);
+}
+
+int ElfSymbols::find(const uint32_t addr) const {
+  auto it = std::upper_bound(
+      m_symbols.begin(), m_symbols.end(), addr,
+      [](const uint32_t a, const Symbol &s) { return a < s.addr; });
+  if (it == m_symbols.begin()) {
+    return -1;
+  }
+  --it;
+  return (addr - it->addr < it->size) ? it - m_symbols.begin() : -1;
+}
+
+bool ElfSymbols::value(const std::string &name, uint32_t &value) const {
+  const auto it = m_values.find(name);
+  if (it == m_values.end()) {
+    return false;
+  }
+  value = it->second;
+  return true;
+}
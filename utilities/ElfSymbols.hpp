@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The ElfSymbols class Reads the function (or data object) symbols of a
+ * 32-bit little-endian ELF file (as built by the sw/ toolchains), for
+ * resolving addresses to function (or variable) names.
+ */
+class ElfSymbols {
+ public:
+  struct Symbol {
+    std::string name;
+    uint32_t addr;  //! Start address, thumb bit cleared
+    uint32_t size;  //! Size in bytes, extended to the next symbol if unsized
+  };
+
+  /**
+   * @brief ElfSymbols load the function symbols from an ELF file. Code labels
+   * without a type (e.g. assembly routines) are included.
+   * @param path path to the ELF file. An invalid file results in an empty
+   * table.
+   * @param objects load the data object symbols instead, i.e. variables in
+   * allocated, non-executable sections.
+   */
+  explicit ElfSymbols(const std::string &path, const bool objects = false);
+
+  /**
+   * @brief ElfSymbols empty table.
+   */
+  ElfSymbols() {}
+
+  /**
+   * @brief isValid check if the file was read successfully.
+   */
+  bool isValid() const { return m_valid; }
+
+  /**
+   * @brief symbols get the symbols, sorted by address.
+   */
+  const std::vector<Symbol> &symbols() const { return m_symbols; }
+
+  /**
+   * @brief find get the index of the symbol containing an address.
+   * @retval index into symbols(), or -1 if no symbol contains the address.
+   */
+  int find(const uint32_t addr) const;
+
+  /**
+   * @brief value look up the value of any symbol by name, e.g. linker script
+   * symbols such as __stack.
+   * @retval true if the symbol exists.
+   */
+  bool value(const std::string &name, uint32_t &value) const;
+
+ private:
+  bool m_valid{false};
+  std::vector<Symbol> m_symbols;
+  std::map<std::string, uint32_t> m_values;  //! All named symbols
+};
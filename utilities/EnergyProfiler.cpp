@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <string>
+#include <systemc>
+#include <vector>
+#include "utilities/Config.hpp"
+#include "utilities/EnergyProfiler.hpp"
+#include "utilities/Utilities.hpp"
+
+using namespace sc_core;
+
+namespace {
+
+// Number of hottest instructions listed in the report
+const unsigned N_HOT_PCS = 20;
+
+}  // namespace
+
+EnergyProfiler::EnergyProfiler(const std::string &name,
+                               const uint32_t codeStart,
+                               const uint32_t codeEnd)
+    : m_name(name),
+      m_codeStart(codeStart),
+      m_codeEnd(codeEnd),
+      m_pcs((codeEnd - codeStart) / 2 + 1) {
+  m_nodes.emplace_back(-1, -1);
+}
+
+void EnergyProfiler::load() {
+  m_symbols = ElfSymbols(Utility::elfPath("EnergyProfileElf", m_name));
+  m_funcAt.assign(m_pcs.size(), -1);
+  const auto &symbols = m_symbols.symbols();
+  for (unsigned f = 0; f < symbols.size(); ++f) {
+    const auto &s = symbols[f];
+    for (uint32_t pc = s.addr; pc - s.addr < s.size; pc += 2) {
+      if (pc - m_codeStart < m_codeEnd - m_codeStart) {
+        m_funcAt[(pc - m_codeStart) >> 1] = f;
+      }
+    }
+  }
+}
+
+bool EnergyProfiler::isEnabled() {
+  return Config::get().contains("EnergyProfile") &&
+         Config::get().getBool("EnergyProfile");
+}
+
+void EnergyProfiler::reset() {
+  m_node = 0;
+  m_frameSp.clear();
+}
+
+void EnergyProfiler::push(const int func, const uint32_t sp) {
+  if (m_frameSp.size() == MAX_DEPTH) {
+    return;  // Runaway stack, keep charging the current frame
+  }
+  const uint64_t key = (static_cast<uint64_t>(m_node) << 32) |
+                       static_cast<uint32_t>(func);
+  auto it = m_children.find(key);
+  if (it == m_children.end()) {
+    it = m_children.emplace(key, m_nodes.size()).first;
+    m_nodes.emplace_back(m_node, func);
+  }
+  m_node = it->second;
+  m_frameSp.push_back(sp);
+}
+
+std::string EnergyProfiler::functionName(const int func) const {
+  return func >= 0 ? m_symbols.symbols()[func].name : "[unknown]";
+}
+
+void EnergyProfiler::write() const {
+  struct Totals {
+    uint64_t count{0};
+    uint64_t cycles{0};
+    double energy{0.0};
+  };
+
+  // Resolve PCs to functions
+  std::map<std::string, Totals> functions;
+  Totals total;
+  for (unsigned i = 0; i < m_pcs.size(); ++i) {
+    const auto &pc = m_pcs[i];
+    if (pc.count == 0) {
+      continue;
+    }
+    std::string name;
+    if (i == m_pcs.size() - 1) {
+      name = "[outside code range]";
+    } else if (m_funcAt[i] >= 0) {
+      name = functionName(m_funcAt[i]);
+    } else {
+      name = fmt::format("0x{:05x}", m_codeStart + 2 * i);
+    }
+    auto &t = functions[name];
+    t.count += pc.count;
+    t.cycles += pc.cycles;
+    t.energy += pc.energy;
+    total.count += pc.count;
+    total.cycles += pc.cycles;
+    total.energy += pc.energy;
+  }
+
+  std::vector<std::pair<std::string, Totals>> sorted(functions.begin(),
+                                                     functions.end());
+  std::sort(sorted.begin(), sorted.end(),
+            [](const std::pair<std::string, Totals> &a,
+               const std::pair<std::string, Totals> &b) {
+              return a.second.energy > b.second.energy;
+            });
+
+  const auto odir = Utility::outputDirectory(m_name);
+  std::ofstream os(odir + "/energy_profile.txt");
+  os << fmt::format(
+      "Dynamic energy {:.3f} nJ, {:d} cycles, {:d} instructions\n\n",
+      total.energy * 1e9, total.cycles, total.count);
+  os << fmt::format("{:>14s} {:>7s} {:>12s} {:>7s} {:>12s} {:>10s}  {:s}\n",
+                    "energy (nJ)", "%", "cycles", "%", "instructions",
+                    "pJ/cycle", "function");
+  for (const auto &f : sorted) {
+    const auto &t = f.second;
+    os << fmt::format(
+        "{:14.3f} {:7.2f} {:12d} {:7.2f} {:12d} {:10.3f}  {:s}\n",
+        t.energy * 1e9,
+        total.energy > 0.0 ? 100.0 * t.energy / total.energy : 0.0, t.cycles,
+        total.cycles > 0 ? 100.0 * t.cycles / total.cycles : 0.0, t.count,
+        t.cycles > 0 ? t.energy * 1e12 / t.cycles : 0.0, f.first);
+  }
+
+  // Hottest instructions
+  std::vector<unsigned> hot;
+  for (unsigned i = 0; i + 1 < m_pcs.size(); ++i) {
+    if (m_pcs[i].count > 0) {
+      hot.push_back(i);
+    }
+  }
+  const auto nHot = std::min<size_t>(N_HOT_PCS, hot.size());
+  std::partial_sort(hot.begin(), hot.begin() + nHot, hot.end(),
+                    [this](const unsigned a, const unsigned b) {
+                      return m_pcs[a].energy > m_pcs[b].energy;
+                    });
+  os << fmt::format("\n{:>14s} {:>12s} {:>12s}  {:s}\n", "energy (nJ)",
+                    "cycles", "executions", "pc");
+  for (unsigned i = 0; i < nHot; ++i) {
+    const auto &pc = m_pcs[hot[i]];
+    const int func = m_funcAt[hot[i]];
+    const uint32_t addr = m_codeStart + 2 * hot[i];
+    os << fmt::format(
+        "{:14.3f} {:12d} {:12d}  0x{:05x}{:s}\n", pc.energy * 1e9, pc.cycles,
+        pc.count, addr,
+        func >= 0 ? fmt::format(" <{:s}+0x{:x}>", functionName(func),
+                                addr - m_symbols.symbols()[func].addr)
+                  : "");
+  }
+
+  // Collapsed stacks, one line per call stack: "main;f;g <energy in pJ>"
+  std::ofstream folded(odir + "/energy_profile.folded");
+  std::vector<std::string> stacks(m_nodes.size());
+  for (unsigned n = 1; n < m_nodes.size(); ++n) {
+    // Parents are always created before their children
+    const auto &node = m_nodes[n];
+    stacks[n] = (node.parent == 0 ? "" : stacks[node.parent] + ";") +
+                functionName(node.func);
+    const auto pJ = std::llround(node.energy * 1e12);
+    if (pJ > 0) {
+      folded << stacks[n] << ' ' << pJ << '\n';
+    }
+  }
+
+  spdlog::info("Energy profile written to {:s}/energy_profile.txt", odir);
+}
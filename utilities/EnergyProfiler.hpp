@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <systemc>
+#include <unordered_map>
+#include <vector>
+#include "utilities/ElfSymbols.hpp"
+
+/*
+ * Firmware energy profiler.
+ *
+ * Each retired instruction is charged its cycles and the dynamic energy of
+ * the power model events reported by the CPU thread while executing it
+ * (instruction, memory & peripheral accesses, see
+ * PowerModelChannelOutIf::attributeEvents). Costs accumulate in flat arrays
+ * indexed by PC, and per call stack. The call stack is reconstructed from
+ * function entries and the stack pointer, using the ELF symbol table.
+ *
+ * Enabled with EnergyProfile: True. Symbols are read from EnergyProfileElf,
+ * or from the .elf next to ProgramHexFile. At the end of simulation, the CPU
+ * writes <OutputDirectory>/energy_profile.txt (functions sorted by energy)
+ * and <OutputDirectory>/energy_profile.folded (collapsed stacks in pJ, for
+ * flamegraph.pl).
+ */
+class EnergyProfiler {
+ public:
+  /**
+   * @brief EnergyProfiler constructor
+   * @param name name of the CPU
+   * @param codeStart lowest profiled PC
+   * @param codeEnd highest profiled PC + 1. PCs outside the range are charged
+   * to a single bucket.
+   */
+  EnergyProfiler(const std::string &name, const uint32_t codeStart,
+                 const uint32_t codeEnd);
+
+  /**
+   * @brief isEnabled check if the energy profiler is enabled in the config.
+   */
+  static bool isEnabled();
+
+  /**
+   * @brief begin mark the start of an instruction, including any interrupt
+   * entry preceding it.
+   * @param energy energy attributed to the CPU thread so far
+   */
+  void begin(const double energy) {
+    if (m_funcAt.empty()) {
+      load();
+    }
+    m_beginTime = sc_core::sc_time_stamp();
+    m_beginEnergy = energy;
+  }
+
+  /**
+   * @brief retire charge the instruction at pc with the cycles and energy
+   * since begin().
+   * @param pc address of the instruction
+   * @param sp stack pointer before executing the instruction
+   * @param period clock period
+   * @param energy energy attributed to the CPU thread so far
+   */
+  void retire(const uint32_t pc, const uint32_t sp,
+              const sc_core::sc_time &period, const double energy) {
+    const uint64_t cycles = static_cast<uint64_t>(
+        (sc_core::sc_time_stamp() - m_beginTime) / period + 0.5);
+    const double e = energy - m_beginEnergy;
+    const uint32_t idx =
+        (pc - m_codeStart < m_codeEnd - m_codeStart) ? (pc - m_codeStart) >> 1
+                                                      : m_pcs.size() - 1;
+    auto &entry = m_pcs[idx];
+    ++entry.count;
+    entry.cycles += cycles;
+    entry.energy += e;
+
+    track(pc, sp, m_funcAt[idx]);
+    auto &node = m_nodes[m_node];
+    node.cycles += cycles;
+    node.energy += e;
+  }
+
+  /**
+   * @brief reset clear the call stack, e.g. at power-on reset.
+   */
+  void reset();
+
+  /**
+   * @brief write write the function report and collapsed stacks to the
+   * output directory.
+   */
+  void write() const;
+
+ private:
+  static const unsigned MAX_DEPTH = 256;
+
+  struct PcEntry {
+    uint64_t count{0};
+    uint64_t cycles{0};
+    double energy{0.0};
+  };
+
+  //! Call stack trie node
+  struct StackNode {
+    int parent;
+    int func;  //! Symbol index, -1 for unknown code
+    uint64_t cycles{0};
+    double energy{0.0};
+    StackNode(const int parent_, const int func_)
+        : parent(parent_), func(func_) {}
+  };
+
+  const std::string m_name;
+  const uint32_t m_codeStart;
+  const uint32_t m_codeEnd;
+  ElfSymbols m_symbols;  //! Loaded by load()
+
+  //! Costs per PC (index (pc - codeStart) / 2), plus an out-of-range bucket
+  std::vector<PcEntry> m_pcs;
+
+  //! Symbol index per PC, -1 for unknown code. Empty until load()
+  std::vector<int> m_funcAt;
+
+  std::vector<StackNode> m_nodes;  //! Node 0 is the root (empty stack)
+  std::unordered_map<uint64_t, int> m_children;  //! (parent, func) -> node
+  int m_node{0};                   //! Current call stack
+  std::vector<uint32_t> m_frameSp;  //! Stack pointer at entry of each frame
+
+  sc_core::sc_time m_beginTime;
+  double m_beginEnergy{0.0};
+
+  /**
+   * @brief track update the call stack for the instruction at pc.
+   */
+  void track(const uint32_t pc, const uint32_t sp, const int func) {
+    const bool sameFunc = m_node != 0 && m_nodes[m_node].func == func;
+    if (func >= 0 && pc == m_symbols.symbols()[func].addr &&
+        (!sameFunc || sp < m_frameSp.back())) {
+      push(func, sp);  // Call (or interrupt entry)
+      return;
+    }
+    if (sameFunc) {
+      return;
+    }
+    // Return (or jump) out of the current function
+    while (m_node != 0 && m_nodes[m_node].func != func &&
+           sp >= m_frameSp.back()) {
+      m_node = m_nodes[m_node].parent;
+      m_frameSp.pop_back();
+    }
+    if (m_node == 0 || m_nodes[m_node].func != func) {
+      push(func, sp);
+    }
+  }
+
+  /**
+   * @brief load read the symbols of the firmware. Deferred to the first
+   * instruction, as the program is loaded after elaboration (and may differ
+   * between the children of a program list, see ProgramSuite.hpp).
+   */
+  void load();
+
+  void push(const int func, const uint32_t sp);
+
+  std::string functionName(const int func) const;
+};
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/spdlog.h>
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <string>
+#include <systemc>
+#include <vector>
+#include "utilities/Config.hpp"
+#include "utilities/Ensemble.hpp"
+#include "utilities/Sweep.hpp"
+
+namespace {
+
+//! Keys read by sc_main after the fork
+const char *const LATE_KEYS[] = {"SimTimeLimit", "CheckpointPeriod",
+                                 "CheckpointFile", "PowerCyclesOutPutFile",
+                                 "OutputDirectory"};
+
+Ensemble::Trigger parseTrigger(const std::string &name) {
+  if (name == "Time") {
+    return Ensemble::Trigger::Time;
+  } else if (name == "PowerOff") {
+    return Ensemble::Trigger::PowerOff;
+  } else if (name == "Marker") {
+    return Ensemble::Trigger::Marker;
+  } else if (name == "Pc") {
+    return Ensemble::Trigger::Pc;
+  }
+  SC_REPORT_FATAL("Ensemble",
+                  fmt::format("invalid ForkAt Trigger \"{:s}\"", name).c_str());
+  return Ensemble::Trigger::None;
+}
+
+}  // namespace
+
+namespace Ensemble {
+
+Trigger g_armed{Trigger::None};
+uint32_t g_value{0};
+
+void fire() {
+  g_armed = Trigger::None;
+  spdlog::info("Ensemble: trigger fired @{:s}",
+               sc_core::sc_time_stamp().to_string());
+  sc_core::sc_pause();
+}
+
+bool run(const std::string &path) {
+  using namespace sc_core;
+  auto &config = Config::get();
+
+  unsigned jobs;
+  const auto points = Sweep::parseSpec(path, jobs);
+  const auto spec = YAML::LoadFile(path);
+  if (!spec["ForkAt"] || !spec["ForkAt"]["Trigger"]) {
+    SC_REPORT_FATAL("Ensemble", (path + " has no ForkAt Trigger").c_str());
+  }
+  const auto trigger = parseTrigger(spec["ForkAt"]["Trigger"].as<std::string>());
+  const auto value = spec["ForkAt"]["Value"]
+                         ? spec["ForkAt"]["Value"].as<std::string>()
+                         : std::string("0");
+
+  // Run the shared prefix, up to the fork point
+  const auto timeLimit = sc_time::from_seconds(config.getDouble("SimTimeLimit"));
+  auto prefixLimit = timeLimit;
+  if (trigger == Trigger::Time) {
+    prefixLimit = std::min(timeLimit, sc_time::from_seconds(std::stod(value)));
+  } else {
+    g_armed = trigger;
+    g_value = static_cast<uint32_t>(std::stoul(value, nullptr, 0));
+  }
+  spdlog::info("Ensemble: simulating shared prefix of {:d} members",
+               points.size());
+  sc_start(prefixLimit);  // Returns early if the trigger paused the simulation
+
+  const bool running =
+      !sc_end_of_simulation_invoked() && sc_get_status() != SC_STOPPED;
+  const bool fired = running && (trigger == Trigger::Time
+                                     ? sc_time_stamp() < timeLimit
+                                     : g_armed == Trigger::None);
+  g_armed = Trigger::None;
+  if (!fired) {
+    spdlog::warn("Ensemble: fork point not reached, members not run");
+    return true;
+  }
+  spdlog::info("Ensemble: forking {:d} members @{:s}", points.size(),
+               sc_time_stamp().to_string());
+
+  std::set<std::string> ignored;
+  for (const auto &p : points) {
+    for (const auto &kv : p) {
+      if (!config.hasListener(kv.first) &&
+          std::find(std::begin(LATE_KEYS), std::end(LATE_KEYS), kv.first) ==
+              std::end(LATE_KEYS)) {
+        ignored.insert(kv.first);
+      }
+    }
+  }
+  for (const auto &key : ignored) {
+    spdlog::warn("Ensemble: {:s} can't be changed after the fork, ignored",
+                 key);
+  }
+
+  const auto parentOdir = config.getString("OutputDirectory");
+  if (!Sweep::runPoints(points, jobs)) {
+    return false;
+  }
+
+  // Member
+  Sweep::redirectOutputs(parentOdir, config.getString("OutputDirectory"));
+  return true;
+}
+
+}  // namespace Ensemble
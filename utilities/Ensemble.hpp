@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+/*
+ * Ensemble simulation.
+ *
+ * An ensemble is a sweep whose points share an execution prefix. The prefix
+ * is simulated once, up to a fork point, after which one copy-on-write child
+ * is forked per point. Each child applies its config delta and simulates the
+ * remainder. The spec uses the sweep format (see Sweep.hpp), plus the fork
+ * point:
+ *
+ *   ForkAt:
+ *     Trigger: PowerOff     # Time, PowerOff, Marker or Pc
+ *     Value: 0              # [s] for Time, marker value or PC address
+ *
+ * PowerOff fires when the CPU first loses power, Marker when the value is
+ * written to the SimpleMonitor, and Pc when the CPU is about to execute the
+ * instruction at the address.
+ *
+ * Only keys that are read after the fork (e.g. SimTimeLimit, CheckpointPeriod)
+ * or that have a run-time listener (see Config::addListener) can differ
+ * between members; other keys are ignored with a warning.
+ */
+
+namespace Ensemble {
+
+//! Fork points
+enum class Trigger { None, Time, PowerOff, Marker, Pc };
+
+//! Armed trigger, None once it has fired
+extern Trigger g_armed;
+
+//! Marker value or PC of the armed trigger
+extern uint32_t g_value;
+
+/**
+ * @brief fire disarm the trigger and pause the simulation, so the ensemble
+ * can fork. Use check().
+ */
+void fire();
+
+/**
+ * @brief check fire the armed trigger if it matches. Called from the modules
+ * observing each trigger.
+ * @param trigger trigger observed
+ * @param value marker value or PC, 0 for PowerOff
+ */
+inline void check(const Trigger trigger, const uint32_t value = 0) {
+  if (trigger == g_armed && value == g_value) {
+    fire();
+  }
+}
+
+/**
+ * @brief run simulate the shared prefix of an ensemble, then fork its members.
+ * Call after elaboration, with the CPU unstalled.
+ * @param path path to ensemble spec (yaml)
+ * @retval true in a member, which should go on to simulate up to SimTimeLimit,
+ * and if the trigger never fired, in which case the prefix has already reached
+ * SimTimeLimit or ended. false in the parent once all members have completed.
+ */
+bool run(const std::string &path);
+
+}  // namespace Ensemble
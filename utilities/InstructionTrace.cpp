@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <pthread.h>
+#include <spdlog/spdlog.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <string>
+#include <systemc>
+#include <thread>
+#include <vector>
+#include "utilities/InstructionTrace.hpp"
+
+using namespace sc_core;
+
+namespace {
+
+//! Open traces, for draining the writer threads before a fork
+std::vector<InstructionTrace *> g_traces;
+
+}  // namespace
+
+InstructionTrace::InstructionTrace(const std::string &path,
+                                   const unsigned nRegs,
+                                   const unsigned pcRegnum)
+    : m_nRegs(nRegs), m_pcRegnum(pcRegnum), m_regs(nRegs, 0) {
+  m_file = fopen(path.c_str(), "wb");
+  if (m_file == nullptr) {
+    SC_REPORT_FATAL("InstructionTrace",
+                    ("Can't open " + path + " for writing").c_str());
+  }
+  const uint8_t header[12] = {'F', 'U', 'S', 'E', 'D', 'T', 'R', 'C',
+                              static_cast<uint8_t>(VERSION),
+                              static_cast<uint8_t>(nRegs),
+                              static_cast<uint8_t>(pcRegnum), 0};
+  fwrite(header, 1, sizeof(header), m_file);
+  m_block.reserve(BLOCK_SIZE);
+
+  static std::once_flag registered;
+  std::call_once(registered, [] {
+    pthread_atfork(&InstructionTrace::prepareFork,
+                   &InstructionTrace::afterFork,
+                   &InstructionTrace::afterForkChild);
+  });
+  g_traces.push_back(this);
+  startWriter();
+}
+
+InstructionTrace::~InstructionTrace() {
+  flush();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  if (m_writer && m_writerPid == getpid()) {
+    m_writer->join();
+  }
+  fclose(m_file);
+  g_traces.erase(std::remove(g_traces.begin(), g_traces.end(), this),
+                 g_traces.end());
+}
+
+void InstructionTrace::sync(const sc_time &period) {
+  const auto now = sc_time_stamp();
+  const bool aligned = period == m_period && period > SC_ZERO_TIME &&
+                       (now - m_time).value() % period.value() == 0;
+  if (!m_block.empty() && aligned) {
+    return;
+  }
+  if (!aligned && period > SC_ZERO_TIME) {
+    // Absorb the remainder into the sync time, cycles stay whole
+    m_time = now - period * static_cast<double>((now - m_time).value() /
+                                                period.value());
+  }
+  m_period = period;
+  putSync();
+}
+
+void InstructionTrace::putSync() {
+  put(SYNC);
+  putVarint(std::llround(m_time.to_seconds() * 1e12));
+  putVarint(std::llround(m_period.to_seconds() * 1e12));
+  for (const auto r : m_regs) {
+    putVarint(r);
+  }
+  m_pc = m_regs[m_pcRegnum];
+  m_addr = 0;
+}
+
+void InstructionTrace::resume(const uint32_t *const regs,
+                              const sc_time &period) {
+  if (m_block.size() > BLOCK_SIZE - MAX_RECORD) {
+    flush();
+  }
+  std::copy(regs, regs + m_nRegs, m_regs.begin());
+  m_time = sc_time_stamp();
+  m_period = period;
+  m_nAccesses = 0;
+  putSync();
+}
+
+void InstructionTrace::instruction(const uint32_t pc, const uint32_t opcode,
+                                   const uint32_t *const regs,
+                                   const sc_time &period) {
+  if (m_block.size() > BLOCK_SIZE - MAX_RECORD) {
+    flush();
+  }
+  sync(period);
+
+  const auto now = sc_time_stamp();
+  const uint64_t cycles = (now - m_time).value() / period.value();
+  m_time = now;
+
+  // Tag is completed once the changed registers are known
+  const size_t tagPos = m_block.size();
+  put(INSN);
+  putSigned(static_cast<int64_t>(pc) - m_pc);
+  putVarint(opcode);
+  putVarint(cycles);
+
+  unsigned nWrites = 0;
+  for (unsigned i = 0; i < m_nRegs; ++i) {
+    if (i != m_pcRegnum && regs[i] != m_regs[i]) {
+      put(static_cast<uint8_t>(i));
+      putVarint(regs[i]);
+      m_regs[i] = regs[i];
+      ++nWrites;
+    }
+  }
+  for (unsigned i = 0; i < m_nAccesses; ++i) {
+    const auto &a = m_accesses[i];
+    putVarint(zigzag(static_cast<int64_t>(a.addr) - m_addr) << 2 |
+              a.write << 1 | a.byte);
+    m_addr = a.addr;
+  }
+  m_block[tagPos] = INSN | (m_nAccesses << 4) | nWrites;
+  m_nAccesses = 0;
+  m_pc = pc;
+  m_regs[m_pcRegnum] = regs[m_pcRegnum];
+}
+
+void InstructionTrace::irq(const uint32_t vector) {
+  if (m_block.size() > BLOCK_SIZE - MAX_RECORD) {
+    flush();
+  }
+  if (m_block.empty()) {
+    sync(m_period);
+  }
+  put(IRQ);
+  putVarint(vector);
+}
+
+void InstructionTrace::flush() {
+  if (m_block.empty()) {
+    return;
+  }
+  if (m_writerPid != getpid()) {
+    startWriter();  // Forked
+  }
+  std::vector<uint8_t> block;
+  block.reserve(BLOCK_SIZE);
+  block.swap(m_block);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.push_back(std::move(block));
+  }
+  m_cv.notify_all();
+}
+
+void InstructionTrace::startWriter() {
+  m_writerPid = getpid();
+  m_writer.reset(new std::thread(&InstructionTrace::writerLoop, this));
+}
+
+void InstructionTrace::writerLoop() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+    if (m_queue.empty()) {
+      return;  // Stopped
+    }
+    auto block = std::move(m_queue.front());
+    m_queue.pop_front();
+    m_writing = true;
+    lock.unlock();
+
+    const uint8_t len[4] = {static_cast<uint8_t>(block.size()),
+                            static_cast<uint8_t>(block.size() >> 8),
+                            static_cast<uint8_t>(block.size() >> 16),
+                            static_cast<uint8_t>(block.size() >> 24)};
+    fwrite(len, 1, sizeof(len), m_file);
+    fwrite(block.data(), 1, block.size(), m_file);
+
+    lock.lock();
+    m_writing = false;
+    m_cv.notify_all();
+  }
+}
+
+/* ------ Fork handling ------ */
+
+void InstructionTrace::prepareFork() {
+  // Drain all queues, and hold the locks across the fork
+  for (auto *t : g_traces) {
+    std::unique_lock<std::mutex> lock(t->m_mutex);
+    t->m_cv.wait(lock, [t] { return t->m_queue.empty() && !t->m_writing; });
+    fflush(t->m_file);
+    lock.release();
+  }
+}
+
+void InstructionTrace::afterFork() {
+  for (auto *t : g_traces) {
+    t->m_mutex.unlock();
+  }
+}
+
+void InstructionTrace::afterForkChild() {
+  for (auto *t : g_traces) {
+    t->m_mutex.unlock();
+    // The parent's writer thread doesn't exist in the child, a new one is
+    // started on the next flush
+    t->m_writer.release();
+  }
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <systemc>
+#include <thread>
+#include <vector>
+
+/*
+ * Compact binary CPU trace.
+ *
+ * File layout: an 8-byte magic "FUSEDTRC", a 4-byte header (version, number
+ * of registers, PC register index, 0), then blocks of records. Each block is
+ * a little-endian u32 payload length followed by the payload, and starts with
+ * a SYNC record so blocks decode independently. Integers are LEB128 varints,
+ * signed deltas are zigzag-encoded.
+ *
+ *   SYNC  0x00 time(ps) period(ps) reg[0..n-1]
+ *   IRQ   0x01 vector address
+ *   INSN  0x80 | nMem << 4 | nRegWrites
+ *         zigzag(pc - previous pc) opcode cycles
+ *         {reg index (u8), value} x nRegWrites
+ *         {zigzag(addr - previous addr) << 2 | write << 1 | byte} x nMem
+ *
+ * Cycles count clock periods since the previous instruction retired, i.e.
+ * including interrupt entry and sleep. Register writes are the registers
+ * (other than the PC) changed since the previous record. A SYNC is inserted
+ * whenever the clock period changes, elapsed time isn't a whole number of
+ * cycles (e.g. after a power loss), or recording resumes after instructions
+ * were skipped, so decoders can reconstruct time exactly.
+ *
+ * Records are encoded into blocks on the simulation thread. Full blocks are
+ * written by a background thread. Decode with tools/decode_trace.py.
+ */
+class InstructionTrace {
+ public:
+  /**
+   * @brief InstructionTrace open a trace file and start the writer thread.
+   * @param path path to the trace file
+   * @param nRegs number of registers
+   * @param pcRegnum index of the program counter in the register file
+   */
+  InstructionTrace(const std::string &path, const unsigned nRegs,
+                   const unsigned pcRegnum);
+
+  //! Flush remaining records and stop the writer thread
+  ~InstructionTrace();
+
+  /**
+   * @brief access record a data memory access of the current instruction.
+   * Instruction fetches are not recorded.
+   */
+  void access(const uint32_t addr, const bool write, const bool byte) {
+    if (m_nAccesses < MAX_ACCESSES) {
+      m_accesses[m_nAccesses++] = Access{addr, write, byte};
+    }
+  }
+
+  /**
+   * @brief instruction record a retired instruction, with the accesses
+   * recorded since the previous instruction.
+   * @param pc address of the instruction
+   * @param opcode first instruction word
+   * @param regs register file after executing the instruction
+   * @param period clock period
+   */
+  void instruction(const uint32_t pc, const uint32_t opcode,
+                   const uint32_t *const regs, const sc_core::sc_time &period);
+
+  /**
+   * @brief irq record entry to an interrupt handler.
+   * @param vector address of the interrupt vector
+   */
+  void irq(const uint32_t vector);
+
+  /**
+   * @brief resume write a SYNC record before the next instruction, after
+   * instructions were not recorded (e.g. outside a trace window). Otherwise the
+   * skipped time would be counted as cycles of the next instruction.
+   * @param regs register file before executing the next instruction
+   * @param period clock period
+   */
+  void resume(const uint32_t *const regs, const sc_core::sc_time &period);
+
+  /**
+   * @brief flush hand the current block to the writer thread.
+   */
+  void flush();
+
+ private:
+  static const unsigned VERSION = 1;
+  static const unsigned MAX_ACCESSES = 7;
+  static const size_t BLOCK_SIZE = 256 * 1024;
+  //! Upper bound on the size of a SYNC plus an INSN record
+  static const size_t MAX_RECORD = 512;
+
+  enum Tag : uint8_t { SYNC = 0x00, IRQ = 0x01, INSN = 0x80 };
+
+  struct Access {
+    uint32_t addr;
+    bool write;
+    bool byte;
+  };
+
+  const unsigned m_nRegs;
+  const unsigned m_pcRegnum;
+  FILE *m_file{nullptr};
+
+  // ------ Encoder state ------
+  std::vector<uint8_t> m_block;
+  std::vector<uint32_t> m_regs;  //! Registers as of the last record
+  uint32_t m_pc{0};
+  uint32_t m_addr{0};
+  sc_core::sc_time m_time{sc_core::SC_ZERO_TIME};
+  sc_core::sc_time m_period{sc_core::SC_ZERO_TIME};
+  Access m_accesses[MAX_ACCESSES];
+  unsigned m_nAccesses{0};
+
+  // ------ Writer thread ------
+  std::deque<std::vector<uint8_t>> m_queue;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_writing{false};
+  bool m_stop{false};
+  std::unique_ptr<std::thread> m_writer;
+  pid_t m_writerPid{0};
+
+  void writerLoop();
+
+  /**
+   * @brief startWriter start the writer thread, also in a forked child (see
+   * Ensemble), which doesn't inherit the parent's.
+   */
+  void startWriter();
+
+  /**
+   * @brief sync write a SYNC record if starting a block, or if time can't be
+   * expressed in whole cycles since the last record.
+   */
+  void sync(const sc_core::sc_time &period);
+
+  //! Write a SYNC record of m_time, m_period & m_regs
+  void putSync();
+
+  void put(const uint8_t byte) { m_block.push_back(byte); }
+
+  void putVarint(uint64_t val) {
+    while (val >= 0x80) {
+      put(static_cast<uint8_t>(val) | 0x80);
+      val >>= 7;
+    }
+    put(static_cast<uint8_t>(val));
+  }
+
+  static uint64_t zigzag(const int64_t val) {
+    return (static_cast<uint64_t>(val) << 1) ^ static_cast<uint64_t>(val >> 63);
+  }
+
+  void putSigned(const int64_t val) { putVarint(zigzag(val)); }
+
+  static void prepareFork();
+  static void afterFork();
+  static void afterForkChild();
+};
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/spdlog.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <systemc>
+#include <vector>
+#include "utilities/Config.hpp"
+#include "utilities/Logging.hpp"
+#include "utilities/TraceWindow.hpp"
+
+namespace Logging {
+
+uint32_t g_enabledModules{~0u};
+Sink g_sink{Sink::Spdlog};
+
+namespace {
+
+struct Site {
+  Module module;
+  int level;
+  std::string file;
+  int line;
+  std::string fmt;
+};
+
+//! File format version, bump on incompatible changes
+const uint32_t LOG_FILE_VERSION = 1;
+
+const unsigned DEFAULT_RING_BUFFER_ENTRIES = 65536;
+
+const char *const MODULE_NAMES[] = {"TimerA", "eUSCI_B", "Nrf24Radio", "Gpio",
+                                    "CortexM0Cpu"};
+
+std::vector<Site> &sites() {
+  static std::vector<Site> s;
+  return s;
+}
+
+std::vector<Record> &ringBuffer() {
+  static std::vector<Record> rb(DEFAULT_RING_BUFFER_ENTRIES);
+  return rb;
+}
+
+uint64_t g_nRecords{0};  //! Total number of records written
+
+//! Enable bits to restore when the trace window opens
+uint32_t g_windowModules{0};
+
+template <typename T>
+void writeRaw(std::ofstream &os, const T &val) {
+  os.write(reinterpret_cast<const char *>(&val), sizeof(val));
+}
+
+void writeString(std::ofstream &os, const std::string &str) {
+  writeRaw(os, static_cast<uint16_t>(str.size()));
+  os.write(str.data(), str.size());
+}
+
+}  // namespace
+
+void setEnabled(const Module module, const bool enable) {
+  const uint32_t bit = 1u << static_cast<unsigned>(module);
+  g_enabledModules = enable ? (g_enabledModules | bit)
+                            : (g_enabledModules & ~bit);
+}
+
+const char *moduleName(const Module module) {
+  return MODULE_NAMES[static_cast<unsigned>(module)];
+}
+
+void configure() {
+  auto &config = Config::get();
+
+  if (config.contains("LogModules")) {
+    const auto &setting = config.getString("LogModules");
+    if (setting == "all") {
+      g_enabledModules = ~0u;
+    } else {
+      g_enabledModules = 0;
+      std::stringstream ss(setting);
+      std::string item;
+      while (std::getline(ss, item, ',')) {
+        item.erase(0, item.find_first_not_of(' '));
+        item.erase(item.find_last_not_of(' ') + 1);
+        if (item.empty() || item == "none") {
+          continue;
+        }
+        bool found = false;
+        for (unsigned i = 0; i < unsigned(Module::NumModules); ++i) {
+          if (item == MODULE_NAMES[i]) {
+            setEnabled(static_cast<Module>(i), true);
+            found = true;
+          }
+        }
+        if (!found) {
+          SC_REPORT_FATAL("Logging",
+                          fmt::format("Unknown module \"{:s}\" in LogModules",
+                                      item)
+                              .c_str());
+        }
+      }
+    }
+  }
+
+  if (config.contains("LogSink")) {
+    const auto &sink = config.getString("LogSink");
+    if (sink == "spdlog") {
+      g_sink = Sink::Spdlog;
+    } else if (sink == "ringbuffer") {
+      g_sink = Sink::RingBuffer;
+    } else {
+      SC_REPORT_FATAL(
+          "Logging",
+          fmt::format("Invalid setting for LogSink \"{:s}\"", sink).c_str());
+    }
+  }
+
+  if (config.contains("LogRingBufferEntries")) {
+    const auto n = config.getUint("LogRingBufferEntries");
+    if (n == 0) {
+      SC_REPORT_FATAL("Logging", "LogRingBufferEntries must be nonzero");
+    }
+    ringBuffer().assign(n, Record());
+    g_nRecords = 0;
+  }
+
+  // Mute all modules while the trace window is closed
+  TraceWindow::onChange([](bool open) {
+    if (open) {
+      g_enabledModules = g_windowModules;
+    } else {
+      g_windowModules = g_enabledModules;
+      g_enabledModules = 0;
+    }
+  });
+}
+
+unsigned registerSite(const Module module, const int level, const char *file,
+                      const int line, const char *fmt) {
+  sites().push_back(Site{module, level, file, line, fmt});
+  return sites().size() - 1;
+}
+
+Record &nextRecord(const unsigned site) {
+  auto &rb = ringBuffer();
+  Record &r = rb[g_nRecords % rb.size()];
+  ++g_nRecords;
+  r.time = sc_core::sc_time_stamp().value();
+  r.site = site;
+  r.size = 0;
+  return r;
+}
+
+void dumpRingBuffer(const std::string &path) {
+  std::ofstream os(path, std::ios::binary);
+  if (!os.good()) {
+    spdlog::error("Logging: failed to open {:s}", path);
+    return;
+  }
+
+  const auto &rb = ringBuffer();
+  const uint64_t nValid = std::min<uint64_t>(g_nRecords, rb.size());
+
+  // Header
+  os.write("FUSEDLOG", 8);
+  writeRaw(os, LOG_FILE_VERSION);
+  writeRaw(os, sc_core::sc_get_time_resolution().to_seconds());
+
+  // Module names
+  writeRaw(os, static_cast<uint32_t>(Module::NumModules));
+  for (unsigned i = 0; i < unsigned(Module::NumModules); ++i) {
+    writeString(os, MODULE_NAMES[i]);
+  }
+
+  // Site table
+  writeRaw(os, static_cast<uint32_t>(sites().size()));
+  for (const auto &s : sites()) {
+    writeRaw(os, static_cast<uint8_t>(s.module));
+    writeRaw(os, static_cast<uint8_t>(s.level));
+    writeRaw(os, static_cast<uint32_t>(s.line));
+    writeString(os, s.file);
+    writeString(os, s.fmt);
+  }
+
+  // Records, oldest first
+  writeRaw(os, nValid);
+  writeRaw(os, g_nRecords - nValid);  // Number of overwritten records
+  for (uint64_t i = g_nRecords - nValid; i < g_nRecords; ++i) {
+    writeRaw(os, rb[i % rb.size()]);
+  }
+}
+
+}  // namespace Logging
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <spdlog/spdlog.h>
+#include <stdint.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <systemc>
+#include <type_traits>
+
+/*
+ * Per-module logging for hot paths.
+ *
+ * Log sites are written as
+ *
+ *   FUSED_LOG(TimerA, INFO, "{}: @{:s} DMA trigger", this->name(),
+ *             sc_time_stamp().to_string());
+ *
+ * A site is compiled out entirely when its level is below the compile-time
+ * minimum of its module (FUSED_LOG_MIN_LEVEL_<module>, which defaults to
+ * FUSED_LOG_MIN_LEVEL, set through the FUSED_LOG_LEVEL CMake option). Sites
+ * that are compiled in check the module's runtime enable bit before any
+ * argument is evaluated.
+ *
+ * Enabled sites are forwarded to spdlog, or recorded into a binary ring buffer
+ * that is dumped at the end of the simulation, and decoded offline with
+ * tools/decode_log.py.
+ */
+
+// clang-format off
+#define FUSED_LOG_LEVEL_TRACE 0
+#define FUSED_LOG_LEVEL_DEBUG 1
+#define FUSED_LOG_LEVEL_INFO  2
+#define FUSED_LOG_LEVEL_WARN  3
+#define FUSED_LOG_LEVEL_ERROR 4
+#define FUSED_LOG_LEVEL_OFF   6
+// clang-format on
+
+#ifndef FUSED_LOG_MIN_LEVEL
+#define FUSED_LOG_MIN_LEVEL FUSED_LOG_LEVEL_TRACE
+#endif
+
+#ifndef FUSED_LOG_MIN_LEVEL_TimerA
+#define FUSED_LOG_MIN_LEVEL_TimerA FUSED_LOG_MIN_LEVEL
+#endif
+#ifndef FUSED_LOG_MIN_LEVEL_eUSCI_B
+#define FUSED_LOG_MIN_LEVEL_eUSCI_B FUSED_LOG_MIN_LEVEL
+#endif
+#ifndef FUSED_LOG_MIN_LEVEL_Nrf24Radio
+#define FUSED_LOG_MIN_LEVEL_Nrf24Radio FUSED_LOG_MIN_LEVEL
+#endif
+#ifndef FUSED_LOG_MIN_LEVEL_Gpio
+#define FUSED_LOG_MIN_LEVEL_Gpio FUSED_LOG_MIN_LEVEL
+#endif
+#ifndef FUSED_LOG_MIN_LEVEL_CortexM0Cpu
+#define FUSED_LOG_MIN_LEVEL_CortexM0Cpu FUSED_LOG_MIN_LEVEL
+#endif
+
+/**
+ * @brief FUSED_LOG log a message from a hot path.
+ * @param module one of Logging::Module
+ * @param level one of TRACE, DEBUG, INFO, WARN, ERROR
+ * @param msg format string (fmt/spdlog syntax)
+ */
+#define FUSED_LOG(module, level, msg, ...)                                    \
+  do {                                                                        \
+    if ((FUSED_LOG_LEVEL_##level >= FUSED_LOG_MIN_LEVEL_##module) &&          \
+        Logging::enabled(Logging::Module::module)) {                          \
+      static const unsigned fusedLogSite_ = Logging::registerSite(            \
+          Logging::Module::module, FUSED_LOG_LEVEL_##level, __FILE__,         \
+          __LINE__, msg);                                                     \
+      Logging::log(fusedLogSite_, FUSED_LOG_LEVEL_##level, msg,               \
+                   ##__VA_ARGS__);                                            \
+    }                                                                         \
+  } while (0)
+
+namespace Logging {
+
+//! Modules with hot-path log sites
+enum class Module : unsigned {
+  TimerA,
+  eUSCI_B,
+  Nrf24Radio,
+  Gpio,
+  CortexM0Cpu,
+  NumModules
+};
+
+//! Where enabled log sites end up
+enum class Sink { Spdlog, RingBuffer };
+
+//! Runtime enable bits, bit n corresponds to Module n
+extern uint32_t g_enabledModules;
+
+//! Active sink
+extern Sink g_sink;
+
+/**
+ * @brief enabled check the runtime enable bit of a module
+ */
+inline bool enabled(const Module module) {
+  return g_enabledModules & (1u << static_cast<unsigned>(module));
+}
+
+/**
+ * @brief setEnabled set or clear the runtime enable bit of a module
+ */
+void setEnabled(const Module module, const bool enable);
+
+/**
+ * @brief moduleName name of a module, as used in the config & log file
+ */
+const char *moduleName(const Module module);
+
+/**
+ * @brief configure set up enable bits and sink from the config. Reads
+ * "LogModules" (comma-separated module names, "all" or "none"), "LogSink"
+ * ("spdlog" or "ringbuffer") and "LogRingBufferEntries".
+ */
+void configure();
+
+/**
+ * @brief registerSite register a log site. Called once per site, the first
+ * time it is enabled.
+ * @retval site id
+ */
+unsigned registerSite(const Module module, const int level, const char *file,
+                      const int line, const char *fmt);
+
+/**
+ * @brief dumpRingBuffer write the ring buffer contents and the site table to a
+ * binary file.
+ * @param path output file path
+ */
+void dumpRingBuffer(const std::string &path);
+
+/* ------ Ring buffer records ------ */
+
+/**
+ * @brief The Record struct Fixed-size ring buffer entry. The payload holds
+ * the encoded arguments of the log site, each as a one-byte type tag followed
+ * by its value. Arguments that don't fit are dropped.
+ */
+struct Record {
+  static const unsigned PAYLOAD_SIZE = 48;
+
+  uint64_t time;      //! Simulation time, in time resolution units
+  uint16_t site;      //! Site id
+  uint16_t size;      //! Number of valid payload bytes
+  uint32_t reserved;  //! Padding
+  uint8_t payload[PAYLOAD_SIZE];
+};
+
+//! Argument type tags
+enum ArgType : uint8_t {
+  ARG_INT = 'i',     //! int64_t
+  ARG_UINT = 'u',    //! uint64_t
+  ARG_DOUBLE = 'd',  //! double
+  ARG_STRING = 's'   //! uint8_t length, followed by characters
+};
+
+/**
+ * @brief nextRecord claim the next ring buffer slot, overwriting the oldest
+ * record if the buffer is full.
+ */
+Record &nextRecord(const unsigned site);
+
+/* ------ Argument encoding ------ */
+
+inline void encode(Record &r, const uint8_t tag, const void *data,
+                   const unsigned len) {
+  if (unsigned(r.size) + 1 + len <= Record::PAYLOAD_SIZE) {
+    r.payload[r.size] = tag;
+    std::memcpy(&r.payload[r.size + 1], data, len);
+    r.size += 1 + len;
+  }
+}
+
+inline void encodeString(Record &r, const char *str, size_t len) {
+  if (unsigned(r.size) + 2 > Record::PAYLOAD_SIZE) {
+    return;
+  }
+  len = std::min<size_t>(len, Record::PAYLOAD_SIZE - r.size - 2);
+  r.payload[r.size] = ARG_STRING;
+  r.payload[r.size + 1] = static_cast<uint8_t>(len);
+  std::memcpy(&r.payload[r.size + 2], str, len);
+  r.size += 2 + len;
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value &&
+                        std::is_signed<T>::value>::type
+encodeArg(Record &r, const T &val) {
+  const int64_t v = val;
+  encode(r, ARG_INT, &v, sizeof(v));
+}
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value &&
+                        !std::is_signed<T>::value>::type
+encodeArg(Record &r, const T &val) {
+  const uint64_t v = val;
+  encode(r, ARG_UINT, &v, sizeof(v));
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value>::type encodeArg(
+    Record &r, const T &val) {
+  const double v = val;
+  encode(r, ARG_DOUBLE, &v, sizeof(v));
+}
+
+template <typename T>
+typename std::enable_if<std::is_enum<T>::value>::type encodeArg(Record &r,
+                                                               const T &val) {
+  encodeArg(r, static_cast<typename std::underlying_type<T>::type>(val));
+}
+
+inline void encodeArg(Record &r, const char *val) {
+  encodeString(r, val, std::strlen(val));
+}
+
+inline void encodeArg(Record &r, const std::string &val) {
+  encodeString(r, val.data(), val.size());
+}
+
+inline void encodeArgs(Record &r) {}
+
+template <typename T, typename... Args>
+void encodeArgs(Record &r, const T &first, const Args &... rest) {
+  encodeArg(r, first);
+  encodeArgs(r, rest...);
+}
+
+/**
+ * @brief log emit an enabled log site to the active sink. Use FUSED_LOG
+ * rather than calling this directly.
+ */
+template <typename... Args>
+void log(const unsigned site, const int level, const char *fmt,
+         const Args &... args) {
+  if (g_sink == Sink::RingBuffer) {
+    encodeArgs(nextRecord(site), args...);
+  } else {
+    spdlog::log(static_cast<spdlog::level::level_enum>(level), fmt, args...);
+  }
+}
+
+}  // namespace Logging
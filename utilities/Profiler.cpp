@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <string>
+#include <systemc>
+#include <vector>
+#include "utilities/Config.hpp"
+#include "utilities/Profiler.hpp"
+
+using namespace sc_core;
+
+namespace Profiler {
+
+bool g_enabled{false};
+unsigned g_current{OTHER_ZONE};
+uint64_t g_lastTick{0};
+std::vector<Zone> g_zones{Zone{"kernel & other"}};
+
+unsigned registerZone(const std::string &name) {
+  for (unsigned i = 0; i < g_zones.size(); ++i) {
+    if (g_zones[i].name == name) {
+      return i;
+    }
+  }
+  g_zones.push_back(Zone{name});
+  return g_zones.size() - 1;
+}
+
+/* ------ Reporter ------ */
+
+Reporter::Reporter(const sc_module_name name) : sc_module(name) {
+  if (Config::get().contains("ProfilerPeriod")) {
+    m_period = sc_time::from_seconds(Config::get().getDouble("ProfilerPeriod"));
+  }
+  if (m_period > SC_ZERO_TIME) {
+    SC_THREAD(process);
+  }
+}
+
+void Reporter::start_of_simulation() {
+  if (m_period > SC_ZERO_TIME) {
+    m_startTime = std::chrono::steady_clock::now();
+    m_startTick = m_lastTick = g_lastTick = ticks();
+    g_enabled = true;
+  }
+}
+
+void Reporter::process() {
+  while (true) {
+    wait(m_period);
+    report(/*final=*/false);
+  }
+}
+
+void Reporter::end_of_simulation() {
+  if (g_enabled) {
+    switchTo(g_current);  // Charge time up to now
+    report(/*final=*/true);
+    g_enabled = false;
+  }
+}
+
+void Reporter::report(const bool final) {
+  const uint64_t now = ticks();
+  const double wallSinceStart =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                    m_startTime)
+          .count();
+  const double ticksPerSecond =
+      wallSinceStart > 0.0 ? (now - m_startTick) / wallSinceStart : 1.0;
+
+  // Interval covered by this report
+  m_lastZones.resize(g_zones.size());
+  const auto &base = final ? std::vector<Zone>(g_zones.size()) : m_lastZones;
+  const double wall =
+      (now - (final ? m_startTick : m_lastTick)) / ticksPerSecond;
+  const double sim =
+      (sc_time_stamp() - (final ? SC_ZERO_TIME : m_lastSimTime)).to_seconds();
+
+  spdlog::info("Profiler{:s}: @{:s}, {:.3f} s wall, sim/real {:.4f}",
+               final ? " summary" : "", sc_time_stamp().to_string(), wall,
+               wall > 0.0 ? sim / wall : 0.0);
+  spdlog::info("  {:<40s} {:>14s} {:>8s}", "zone", "activations/s", "wall %");
+
+  // Sort by time spent
+  std::vector<unsigned> order(g_zones.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](unsigned a, unsigned b) {
+    return g_zones[a].ticks - base[a].ticks > g_zones[b].ticks - base[b].ticks;
+  });
+  for (const auto i : order) {
+    const double t = (g_zones[i].ticks - base[i].ticks) / ticksPerSecond;
+    const auto n = g_zones[i].activations - base[i].activations;
+    spdlog::info("  {:<40s} {:>14.0f} {:>8.2f}", g_zones[i].name,
+                 wall > 0.0 ? n / wall : 0.0,
+                 wall > 0.0 ? 100.0 * t / wall : 0.0);
+  }
+
+  m_lastZones = g_zones;
+  m_lastSimTime = sc_time_stamp();
+  m_lastTick = now;
+}
+
+}  // namespace Profiler
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+#include <string>
+#include <systemc>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*
+ * Simulation-speed profiler.
+ *
+ * Counts activations and accumulates host time per profiling zone, i.e. per
+ * SystemC process body or AMS cluster:
+ *
+ *   void TimerA::process() {
+ *     FUSED_PROFILE("TimerA::process");
+ *     ...
+ *   }
+ *
+ * Time is attributed exclusively: a zone is charged from its activation until
+ * it returns (or, for threads, until it yields, see Msp430Cpu::wait). Time
+ * spent in the kernel and in uninstrumented processes is charged to zone 0.
+ *
+ * Enabled by a non-zero ProfilerPeriod, in which case a table of activations/s
+ * and share of wall time is reported every ProfilerPeriod of simulated time,
+ * and once more at the end of the simulation.
+ */
+
+/**
+ * @brief FUSED_PROFILE charge the rest of the enclosing scope to a zone.
+ * @param name zone name, sites with the same name share a zone
+ */
+#define FUSED_PROFILE(name)                                               \
+  static const unsigned fusedProfileZone_ = Profiler::registerZone(name); \
+  const Profiler::Scope fusedProfileScope_(fusedProfileZone_)
+
+namespace Profiler {
+
+//! Zone charged when no instrumented process is active
+const unsigned OTHER_ZONE = 0;
+
+struct Zone {
+  std::string name;
+  uint64_t activations{0};
+  uint64_t ticks{0};
+};
+
+extern bool g_enabled;
+extern unsigned g_current;   //! Zone currently charged
+extern uint64_t g_lastTick;  //! Tick of the last zone switch
+extern std::vector<Zone> g_zones;
+
+//! Host clock ticks (TSC where available)
+inline uint64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+/**
+ * @brief registerZone get the id of a zone, registering it on first use.
+ */
+unsigned registerZone(const std::string &name);
+
+/**
+ * @brief current zone currently charged
+ */
+inline unsigned current() { return g_current; }
+
+/**
+ * @brief switchTo charge the time since the last switch to the current zone,
+ * and make another zone current.
+ * @retval previously current zone
+ */
+inline unsigned switchTo(const unsigned zone) {
+  const unsigned prev = g_current;
+  if (g_enabled) {
+    const uint64_t now = ticks();
+    g_zones[g_current].ticks += now - g_lastTick;
+    g_lastTick = now;
+    g_current = zone;
+  }
+  return prev;
+}
+
+/**
+ * @brief activate count an activation of a zone and make it current.
+ * @retval previously current zone
+ */
+inline unsigned activate(const unsigned zone) {
+  if (g_enabled) {
+    ++g_zones[zone].activations;
+  }
+  return switchTo(zone);
+}
+
+/**
+ * @brief The Scope class Charge a scope to a zone, see FUSED_PROFILE.
+ */
+class Scope {
+ public:
+  explicit Scope(const unsigned zone) : m_prev(activate(zone)) {}
+  ~Scope() { switchTo(m_prev); }
+
+ private:
+  const unsigned m_prev;
+};
+
+/**
+ * @brief The Reporter class Enables the profiler if ProfilerPeriod is set, and
+ * reports periodically and at the end of the simulation.
+ */
+class Reporter : public sc_core::sc_module {
+ public:
+  SC_HAS_PROCESS(Reporter);
+  explicit Reporter(const sc_core::sc_module_name name);
+
+  virtual void start_of_simulation() override;
+  virtual void end_of_simulation() override;
+
+ private:
+  sc_core::sc_time m_period{sc_core::SC_ZERO_TIME};
+
+  //! Snapshot of the zones at the previous report
+  std::vector<Zone> m_lastZones;
+  sc_core::sc_time m_lastSimTime{sc_core::SC_ZERO_TIME};
+  uint64_t m_lastTick{0};
+
+  //! Calibration of ticks against wall-clock time
+  std::chrono::steady_clock::time_point m_startTime;
+  uint64_t m_startTick{0};
+
+  void process();
+
+  /**
+   * @brief report print activations/s and share of wall time per zone
+   * since the last report, or since the start for the final summary.
+   */
+  void report(const bool final);
+};
+
+}  // namespace Profiler
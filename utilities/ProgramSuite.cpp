@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utilities/Config.hpp"
+#include "utilities/ProgramSuite.hpp"
+#include "utilities/Sweep.hpp"
+#include "utilities/Utilities.hpp"
+
+namespace ProgramSuite {
+
+std::vector<std::string> parseList(const std::string &path) {
+  Utility::assertFileExists(path);
+  std::ifstream f(path);
+  std::vector<std::string> programs;
+  std::string line;
+  while (std::getline(f, line)) {
+    line.erase(0, line.find_first_not_of(" \t"));
+    line.erase(line.find_last_not_of(" \t\r") + 1);
+    if (!line.empty() && line[0] != '#') {
+      programs.push_back(line);
+    }
+  }
+
+  if (programs.empty()) {
+    spdlog::error("ProgramSuite: {:s} lists no programs", path);
+    exit(1);
+  }
+  return programs;
+}
+
+bool run(const std::string &path, unsigned &failed) {
+  auto &config = Config::get();
+  const auto programs = parseList(path);
+
+  std::vector<Sweep::Point> points;
+  for (const auto &p : programs) {
+    points.push_back({{"ProgramHexFile", p}});
+  }
+  unsigned jobs = config.contains("ProgramListJobs")
+                      ? config.getUint("ProgramListJobs")
+                      : 0;
+  if (jobs == 0) {
+    jobs = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  spdlog::info("ProgramSuite: running {:d} programs on one elaboration",
+               programs.size());
+  const auto parentOdir = config.getString("OutputDirectory");
+  failed = 0;
+  if (!Sweep::runPoints(points, jobs, &failed)) {
+    spdlog::info("ProgramSuite: {:d}/{:d} programs passed",
+                 programs.size() - failed, programs.size());
+    return false;
+  }
+
+  // Child
+  Sweep::redirectOutputs(parentOdir, config.getString("OutputDirectory"));
+  return true;
+}
+
+}  // namespace ProgramSuite
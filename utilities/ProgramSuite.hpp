@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/*
+ * Program suites: many firmware images on one elaborated system.
+ *
+ * Elaborating the board (modules, power model channel, AMS cluster) costs more
+ * than simulating a small test program. For a program list, the system is
+ * elaborated once, up to the point where a single run would load its program.
+ * One copy-on-write child per program is then forked from this state, so each
+ * program starts from power-on state at simulated time zero, with the memories
+ * still blank. The child loads its program (ProgramHexFile) and simulates it
+ * as a single run would.
+ *
+ * The list is a text file with one hex file per line; blank lines and lines
+ * starting with '#' are ignored. Children run on a bounded pool of
+ * ProgramListJobs workers (0 for one per core). As for sweeps (see Sweep.hpp),
+ * the outputs of program n go to <OutputDirectory>/pointNNNN, and the result
+ * of each program (exit status, wall time, power cycles) to
+ * <OutputDirectory>/sweep_summary.csv.
+ */
+
+namespace ProgramSuite {
+
+/**
+ * @brief parseList read a program list.
+ * @param path path to program list
+ * @retval hex files, in execution order
+ */
+std::vector<std::string> parseList(const std::string &path);
+
+/**
+ * @brief run fork one child per program of a list. Call after elaboration,
+ * before loading the program.
+ * @param path path to program list
+ * @param failed set to the number of programs that failed (in the parent)
+ * @retval true in a child, which should go on to load ProgramHexFile and
+ * simulate it. false in the parent once all programs have completed.
+ */
+bool run(const std::string &path, unsigned &failed);
+
+}  // namespace ProgramSuite
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <spdlog/spdlog.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include "utilities/RspProxy.hpp"
+#include "utilities/SimulationController.hpp"
+
+namespace Rsp {
+
+ParseResult parseWatchpointPacket(const std::string &packet,
+                                  WatchpointPacket &out) {
+  if (packet.size() < 2 || (packet[0] != 'Z' && packet[0] != 'z') ||
+      packet[1] < '2' || packet[1] > '4') {
+    return ParseResult::NotWatchpoint;
+  }
+  if (packet.size() < 3 || packet[2] != ',') {
+    return ParseResult::Malformed;
+  }
+
+  // <type>,<addr>,<kind>, both hex
+  const char *const addrStart = packet.c_str() + 3;
+  char *end;
+  const unsigned long addr = std::strtoul(addrStart, &end, 16);
+  if (end == addrStart || *end != ',') {
+    return ParseResult::Malformed;
+  }
+  const char *const lenStart = end + 1;
+  const unsigned long len = std::strtoul(lenStart, &end, 16);
+  if (end == lenStart || (*end != '\0' && *end != ';')) {
+    return ParseResult::Malformed;
+  }
+
+  out.insert = packet[0] == 'Z';
+  out.type = packet[1] - '0';
+  out.addr = addr;
+  out.len = len;
+  return ParseResult::Ok;
+}
+
+bool isStopReply(const std::string &packet) {
+  return packet.size() >= 3 && (packet[0] == 'S' || packet[0] == 'T') &&
+         std::isxdigit(packet[1]) && std::isxdigit(packet[2]) &&
+         (packet[0] == 'T' || packet.size() == 3);
+}
+
+uint8_t checksum(const std::string &packet) {
+  uint8_t sum = 0;
+  for (const char c : packet) {
+    sum += static_cast<uint8_t>(c);
+  }
+  return sum;
+}
+
+std::string frame(const std::string &packet) {
+  return fmt::format("${:s}#{:02x}", packet, checksum(packet));
+}
+
+}  // namespace Rsp
+
+void RspProxy::run() {
+  const int listener = socket(AF_INET, SOCK_STREAM, 0);
+  const int yes = 1;
+  setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(m_port);
+  if (listener < 0 ||
+      bind(listener, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) ||
+      listen(listener, 1)) {
+    spdlog::error("RspProxy: can't listen on port {:d}", m_port);
+    close(listener);
+    return;
+  }
+  spdlog::info("RspProxy: waiting for gdb on port {:d}", m_port);
+  m_gdb = accept(listener, nullptr, nullptr);
+  close(listener);
+  if (m_gdb < 0) {
+    spdlog::error("RspProxy: accept failed");
+    return;
+  }
+
+  // The server may still be starting up
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(m_serverPort);
+  for (int attempt = 0; attempt < 100; ++attempt) {
+    m_server = socket(AF_INET, SOCK_STREAM, 0);
+    if (connect(m_server, reinterpret_cast<sockaddr *>(&addr),
+                sizeof(addr)) == 0) {
+      break;
+    }
+    close(m_server);
+    m_server = -1;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  if (m_server < 0) {
+    spdlog::error("RspProxy: can't connect to the gdb server on port {:d}",
+                  m_serverPort);
+    close(m_gdb);
+    return;
+  }
+
+  pollfd fds[2] = {{m_gdb, POLLIN, 0}, {m_server, POLLIN, 0}};
+  char buf[4096];
+  bool open = true;
+  while (open) {
+    if (poll(fds, 2, -1) < 0) {
+      open = errno == EINTR;
+      continue;
+    }
+    for (int i = 0; i < 2; ++i) {
+      if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+        const auto n = read(fds[i].fd, buf, sizeof(buf));
+        if (n <= 0) {
+          open = false;
+          break;
+        }
+        relay(buf, n, i == 0);
+      }
+    }
+  }
+  close(m_gdb);
+  close(m_server);
+}
+
+void RspProxy::relay(const char *data, const size_t len, const bool fromGdb) {
+  auto &partial = fromGdb ? m_fromGdb : m_fromServer;
+  for (size_t i = 0; i < len; ++i) {
+    const char c = data[i];
+    if (partial.empty() && c != '$') {
+      // Acks & interrupts
+      if (fromGdb && m_swallowAck && (c == '+' || c == '-')) {
+        m_swallowAck = c == '-';
+        if (c == '-') {
+          send(m_gdb, m_lastReply);  // Retransmit
+        }
+        continue;
+      }
+      send(fromGdb ? m_server : m_gdb, std::string(1, c));
+      continue;
+    }
+
+    partial += c;
+    const auto hash = partial.find('#');
+    if (hash != std::string::npos && partial.size() == hash + 3) {
+      if (fromGdb) {
+        handleGdbPacket(partial);
+      } else {
+        handleServerPacket(partial);
+      }
+      partial.clear();
+    }
+  }
+}
+
+void RspProxy::handleGdbPacket(const std::string &raw) {
+  const auto payload = raw.substr(1, raw.find('#') - 1);
+  std::string reply;
+  if (m_simCtrl->handleWatchpointPacket(payload, reply)) {
+    m_lastReply = Rsp::frame(reply);
+    send(m_gdb, m_noAck ? m_lastReply : "+" + m_lastReply);
+    m_swallowAck = !m_noAck;
+    return;
+  }
+
+  if (payload == "QStartNoAckMode") {
+    m_noAckRequested = true;
+  }
+  send(m_server, raw);
+}
+
+void RspProxy::handleServerPacket(const std::string &raw) {
+  const auto payload = raw.substr(1, raw.find('#') - 1);
+  if (m_noAckRequested) {
+    m_noAckRequested = false;
+    m_noAck = payload == "OK";
+  }
+
+  unsigned addr;
+  int type;
+  if (Rsp::isStopReply(payload) &&
+      m_simCtrl->stoppedByWatchpoint(addr, type)) {
+    send(m_gdb, Rsp::frame(m_simCtrl->stopReply()));
+    return;
+  }
+  send(m_gdb, raw);
+}
+
+void RspProxy::send(const int fd, const std::string &data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    const auto n = write(fd, data.data() + sent, data.size() - sent);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    } else if (n <= 0) {
+      spdlog::warn("RspProxy: write failed");
+      return;
+    }
+    sent += n;
+  }
+}
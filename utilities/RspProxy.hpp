@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+class SimulationController;
+
+/*
+ * gdb remote serial protocol (RSP) front end.
+ *
+ * The gdb server (gdb-server library) doesn't know watchpoints. RspProxy sits
+ * between gdb and the server: it listens for gdb on the debug port, and
+ * connects to the server on a loopback port. Watchpoint packets (Z2/Z3/Z4 &
+ * z2/z3/z4) are answered by SimulationController, stop replies after a
+ * watchpoint hit are replaced by SimulationController::stopReply, and
+ * everything else is relayed unchanged.
+ */
+
+namespace Rsp {
+
+//! Watchpoint packet, see parseWatchpointPacket
+struct WatchpointPacket {
+  bool insert;    //! Z (true) or z (false)
+  int type;       //! 2 (write), 3 (read) or 4 (access)
+  unsigned addr;  //! Start address
+  unsigned len;   //! Length in bytes
+};
+
+//! Result of parseWatchpointPacket
+enum class ParseResult { NotWatchpoint, Malformed, Ok };
+
+/**
+ * @brief parseWatchpointPacket parse a Z2/Z3/Z4 or z2/z3/z4 packet
+ * ("Z2,addr,kind", hex), without the leading '$' and trailing checksum.
+ * @param packet packet payload
+ * @param out set to the parsed packet if the result is Ok
+ * @retval NotWatchpoint for other packets, including Z0/Z1 (breakpoints)
+ */
+ParseResult parseWatchpointPacket(const std::string &packet,
+                                  WatchpointPacket &out);
+
+/**
+ * @brief isStopReply check if a packet is a stop reply ("Sxx" or "Txx...").
+ */
+bool isStopReply(const std::string &packet);
+
+/**
+ * @brief checksum RSP checksum of a packet payload (sum modulo 256).
+ */
+uint8_t checksum(const std::string &packet);
+
+/**
+ * @brief frame wrap a packet payload as "$payload#xx".
+ */
+std::string frame(const std::string &packet);
+
+}  // namespace Rsp
+
+/**
+ * @brief The RspProxy class Relays a gdb connection to the gdb server, and
+ * handles the watchpoint packets itself (see above).
+ */
+class RspProxy {
+ public:
+  /**
+   * @brief RspProxy constructor
+   * @param simCtrl simulation controller handling watchpoint packets
+   * @param port port to listen on for gdb
+   * @param serverPort loopback port of the gdb server
+   */
+  RspProxy(SimulationController *simCtrl, const int port,
+           const int serverPort)
+      : m_simCtrl(simCtrl), m_port(port), m_serverPort(serverPort) {}
+
+  /**
+   * @brief run accept one gdb connection and relay it until either side
+   * closes. Run in its own thread, alongside the server's.
+   */
+  void run();
+
+ private:
+  /* ------ Private variables ------ */
+  SimulationController *m_simCtrl;
+  const int m_port;
+  const int m_serverPort;
+
+  int m_gdb{-1};     //! Socket connected to gdb
+  int m_server{-1};  //! Socket connected to the server
+
+  std::string m_fromGdb{};     //! Partial packet from gdb
+  std::string m_fromServer{};  //! Partial packet from the server
+  std::string m_lastReply{};   //! Last reply sent by the proxy itself
+  bool m_swallowAck{false};    //! Next ack from gdb is for m_lastReply
+  bool m_noAckRequested{false};  //! QStartNoAckMode forwarded
+  bool m_noAck{false};           //! No-ack mode agreed
+
+  /* ------ Private methods ------ */
+  /**
+   * @brief relay consume bytes from one side, and forward or answer them.
+   * @param fromGdb true for bytes from gdb, false for bytes from the server
+   */
+  void relay(const char *data, const size_t len, const bool fromGdb);
+
+  /**
+   * @brief handleGdbPacket forward a complete packet from gdb, or answer it.
+   * @param raw packet as received, "$payload#xx"
+   */
+  void handleGdbPacket(const std::string &raw);
+
+  /**
+   * @brief handleServerPacket forward a complete packet from the server,
+   * rewriting stop replies after a watchpoint hit.
+   */
+  void handleServerPacket(const std::string &raw);
+
+  /**
+   * @brief send write a whole buffer to a socket.
+   */
+  static void send(const int fd, const std::string &data);
+};
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <fcntl.h>
+#include <spdlog/spdlog.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <systemc>
+#include "libs/strtk.hpp"
+#include "utilities/SensorTrace.hpp"
+#include "utilities/Utilities.hpp"
+
+using namespace sc_core;
+
+namespace {
+
+const char MAGIC[8] = {'F', 'U', 'S', 'E', 'D', 'S', 'N', 'S'};
+
+//! Traces by path, shared by all sensors
+std::map<std::string, std::shared_ptr<const SensorTrace>> g_traces;
+
+void fatal(const std::string &path, const std::string &msg) {
+  SC_REPORT_FATAL("SensorTrace", fmt::format("{:s}: {:s}", path, msg).c_str());
+}
+
+}  // namespace
+
+std::shared_ptr<const SensorTrace> SensorTrace::load(const std::string &path,
+                                                     const unsigned nChannels) {
+  auto it = g_traces.find(path);
+  if (it == g_traces.end()) {
+    Utility::assertFileExists(path);
+    char magic[sizeof(MAGIC)] = {0};
+    std::ifstream(path, std::ios::binary).read(magic, sizeof(magic));
+    std::shared_ptr<const SensorTrace> trace =
+        std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0 ? loadBinary(path)
+                                                       : loadCsv(path);
+    spdlog::info("SensorTrace: {:s}: {:d} samples of {:d} channels, {:g} s "
+                 "timestep",
+                 path, trace->size(), trace->channels(), trace->timestep());
+    it = g_traces.emplace(path, trace).first;
+  }
+
+  if (it->second->channels() != nChannels) {
+    fatal(path, fmt::format("expected {:d} channels, found {:d}", nChannels,
+                            it->second->channels()));
+  }
+  return it->second;
+}
+
+std::shared_ptr<const SensorTrace> SensorTrace::constant(
+    const std::vector<double> &values) {
+  std::shared_ptr<SensorTrace> trace(new SensorTrace());
+  trace->m_owned = values;
+  trace->m_data = trace->m_owned.data();
+  trace->m_nChannels = values.size();
+  trace->m_nSamples = 1;
+  return trace;
+}
+
+SensorTrace::~SensorTrace() {
+  if (m_map != nullptr) {
+    munmap(m_map, m_mapLength);
+  }
+}
+
+std::unique_ptr<SensorTrace> SensorTrace::loadBinary(const std::string &path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    fatal(path, "couldn't open trace file");
+  }
+  const size_t length = st.st_size;
+  if (length < sizeof(Header)) {
+    fatal(path, "truncated header");
+  }
+  void *map = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);  // The mapping stays valid
+  if (map == MAP_FAILED) {
+    fatal(path, fmt::format("mmap failed: {:s}", std::strerror(errno)));
+  }
+
+  std::unique_ptr<SensorTrace> trace(new SensorTrace());
+  trace->m_map = map;
+  trace->m_mapLength = length;
+
+  Header header;
+  std::memcpy(&header, map, sizeof(header));
+  if (header.version != VERSION) {
+    fatal(path, fmt::format("unsupported version {:d}", header.version));
+  }
+  if (header.nChannels == 0 || header.nSamples == 0 ||
+      !(header.timestep > 0.0) ||
+      length < sizeof(Header) +
+                   header.nSamples * header.nChannels * sizeof(double)) {
+    fatal(path, "invalid header, or truncated samples");
+  }
+  trace->m_data = reinterpret_cast<const double *>(
+      static_cast<const char *>(map) + sizeof(Header));
+  trace->m_nChannels = header.nChannels;
+  trace->m_nSamples = header.nSamples;
+  trace->m_start = header.start;
+  trace->m_timestep = header.timestep;
+  return trace;
+}
+
+std::unique_ptr<SensorTrace> SensorTrace::loadCsv(const std::string &path) {
+  spdlog::warn(
+      "SensorTrace: {:s} is a csv trace, convert it with "
+      "tools/csv_to_sensor_trace.py to load it faster",
+      path);
+  std::ifstream file(path);
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  std::string content = buffer.str();
+
+  strtk::token_grid grid(content, content.size(), ",");
+  if (grid.row_count() == 0 || grid.row(0).size() < 2) {
+    fatal(path, "expected \"time,ch0,ch1,...\" rows");
+  }
+
+  std::unique_ptr<SensorTrace> trace(new SensorTrace());
+  trace->m_nChannels = grid.row(0).size() - 1;
+  trace->m_nSamples = grid.row_count();
+  trace->m_owned.reserve(trace->m_nSamples * trace->m_nChannels);
+  for (std::size_t i = 0; i < grid.row_count(); ++i) {
+    for (unsigned c = 0; c < trace->m_nChannels; ++c) {
+      trace->m_owned.push_back(grid.row(i).get<double>(c + 1));
+    }
+  }
+  trace->m_data = trace->m_owned.data();
+  if (grid.row_count() > 1) {
+    trace->m_timestep =
+        grid.row(1).get<double>(0) - grid.row(0).get<double>(0);
+  }
+  return trace;
+}
+
+void SensorTrace::sample(const sc_time &t, double *out,
+                         const bool interpolate) const {
+  const double pos = (t.to_seconds() - m_start) / m_timestep;
+  const double whole = std::floor(pos);
+  auto i = static_cast<int64_t>(whole) % static_cast<int64_t>(m_nSamples);
+  if (i < 0) {
+    i += m_nSamples;
+  }
+
+  const double *a = &m_data[i * m_nChannels];
+  if (!interpolate || m_nSamples == 1) {
+    std::memcpy(out, a, m_nChannels * sizeof(double));
+    return;
+  }
+
+  // Interpolate towards the next sample, wrapping around to the first one
+  const double *b = &m_data[((i + 1) % m_nSamples) * m_nChannels];
+  const double frac = pos - whole;
+  for (unsigned c = 0; c < m_nChannels; ++c) {
+    out[c] = a[c] + frac * (b[c] - a[c]);
+  }
+}
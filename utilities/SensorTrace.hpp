@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <systemc>
+#include <vector>
+
+/*
+ * Sensor input trace: equally spaced samples of one or more channels, looped
+ * over simulation time.
+ *
+ * Binary file layout (little-endian): an 8-byte magic "FUSEDSNS", u32
+ * version, u32 number of channels, f64 start time (s), f64 timestep (s), u64
+ * number of samples, then the samples as f64 [sample][channel]. Sample i
+ * applies from start + i * timestep. Convert csv traces with
+ * tools/csv_to_sensor_trace.py.
+ *
+ * Binary traces are memory-mapped read-only, so they cost neither parsing
+ * nor private memory, and their pages are shared with forked processes (see
+ * Sweep, Ensemble). Traces are also shared between all sensor instances
+ * loading the same file. Csv traces ("time,ch0,ch1,...", constant timestep)
+ * are still accepted, but are parsed into memory.
+ */
+class SensorTrace {
+ public:
+  static const unsigned VERSION = 1;
+
+  /**
+   * @brief load get the trace in a file, loading it on first use.
+   * @param path binary or csv trace file
+   * @param nChannels expected number of channels
+   */
+  static std::shared_ptr<const SensorTrace> load(const std::string &path,
+                                                 const unsigned nChannels);
+
+  /**
+   * @brief constant a trace with a single sample.
+   */
+  static std::shared_ptr<const SensorTrace> constant(
+      const std::vector<double> &values);
+
+  //! Unmaps the file
+  ~SensorTrace();
+
+  SensorTrace(const SensorTrace &) = delete;
+  SensorTrace &operator=(const SensorTrace &) = delete;
+
+  /**
+   * @brief sample get all channels at time t, wrapping around the end of the
+   * trace.
+   * @param t simulation time
+   * @param out nChannels values
+   * @param interpolate interpolate linearly between samples, rather than
+   * holding the previous sample.
+   */
+  void sample(const sc_core::sc_time &t, double *out,
+              const bool interpolate = false) const;
+
+  unsigned channels() const { return m_nChannels; }
+  size_t size() const { return m_nSamples; }
+  double timestep() const { return m_timestep; }
+
+ private:
+  //! Binary file header
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t nChannels;
+    double start;
+    double timestep;
+    uint64_t nSamples;
+  };
+
+  SensorTrace() = default;
+
+  static std::unique_ptr<SensorTrace> loadBinary(const std::string &path);
+  static std::unique_ptr<SensorTrace> loadCsv(const std::string &path);
+
+  const double *m_data{nullptr};
+  unsigned m_nChannels{0};
+  size_t m_nSamples{0};
+  double m_start{0.0};
+  double m_timestep{1.0};
+
+  void *m_map{nullptr};  //! Mapped file, or nullptr if m_owned holds the data
+  size_t m_mapLength{0};
+  std::vector<double> m_owned;
+};
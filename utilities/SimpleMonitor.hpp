@@ -7,15 +7,25 @@
 #pragma once
 
 #include <spdlog/spdlog.h>
+#include <chrono>
+#include <functional>
 #include <mcu/BusTarget.hpp>
 #include <systemc>
 #include <vector>
 #include "include/peripheral-defines.h"
+#include "mcu/Microcontroller.hpp"
+#include "mcu/PowerCycleLedger.hpp"
+#include "mcu/RegionProfiler.hpp"
 #include "utilities/Config.hpp"
+#include "utilities/Ensemble.hpp"
+#include "utilities/TraceWindow.hpp"
 
 /** SC Module SimpleMonitor
  * SimpleMonitor implements a single register to control simulation and reports
- * written values to the console.
+ * written values to the console. Begin/end markers open and close regions of
+ * interest, see RegionProfiler. Start/stop event log markers open and close the
+ * trace window, see TraceWindow. Power cycles are recorded at the power edges,
+ * with boot/restore markers, see PowerCycleLedger.
  */
 class SimpleMonitor : public BusTarget {
   SC_HAS_PROCESS(SimpleMonitor);
@@ -23,20 +33,68 @@ class SimpleMonitor : public BusTarget {
  public:
   /**
    * Constructor
+   * @param mcu microcontroller whose CPU cycles & instructions are counted in
+   * regions of interest and power cycles
    */
-  SimpleMonitor(const sc_core::sc_module_name nm, const unsigned startAddress)
-      : BusTarget(nm, startAddress, startAddress + 4 - 1) {
+  SimpleMonitor(const sc_core::sc_module_name nm, const unsigned startAddress,
+                Microcontroller *mcu = nullptr)
+      : BusTarget(nm, startAddress, startAddress + 4 - 1),
+        m_mcu(mcu),
+        m_regions(this->name()),
+        m_ledger(this->name()) {
     SC_METHOD(process);
     sensitive << m_writeEvent;
     m_regs.addRegister(0, 0);
+
+    if (m_mcu != nullptr && PowerCycleLedger::isEnabled()) {
+      SC_METHOD(powerChanged);
+      sensitive << pwrOn;
+    }
+  }
+
+  /**
+   * @brief setCapacitorVoltage set the probe of the energy storage voltage,
+   * recorded by the power cycle ledger. Without a probe, the ledger records
+   * the MCU supply (vcc), which drops to zero as soon as the supply switches
+   * off.
+   */
+  void setCapacitorVoltage(std::function<double()> probe) {
+    m_capacitorVoltage = probe;
+  }
+
+  /**
+   * @brief end_of_simulation systemc callback. Used here to close the open
+   * power cycle and regions of interest. sc_main writes the reports of all
+   * monitors once simulation has stopped.
+   */
+  virtual void end_of_simulation() override {
+    if (m_ledger.isOn()) {
+      m_ledger.powerOff(ledgerSnapshot(), m_mcu->dbgReadReg(m_mcu->pc_regnum()),
+                        /*terminated=*/false);
+    }
+    m_ledger.flush();
+
+    if (m_regions.depth() > 0) {
+      spdlog::warn("{}: {:d} regions of interest still open", this->name(),
+                   m_regions.depth());
+      m_regions.closeAll(snapshot());
+    }
   }
 
  private:
   /*------ Private variables ------*/
+  Microcontroller *m_mcu;
+  RegionProfiler m_regions;
+  PowerCycleLedger m_ledger;
+  std::function<double()> m_capacitorVoltage;  //! See setCapacitorVoltage
+  bool m_moduleNamesSet{false};
+  const std::chrono::steady_clock::time_point m_wallStart{
+      std::chrono::steady_clock::now()};
 
   /* ------ Private functions ------*/
   void process() {
     auto reg = m_regs.read(0);  // Get written value
+    Ensemble::check(Ensemble::Trigger::Marker, reg);
 
     spdlog::info(
         "{}: {:010d} ns 0x{:08x}", this->name(),
@@ -55,13 +113,111 @@ class SimpleMonitor : public BusTarget {
         SC_REPORT_FATAL(this->name(),
                         "SW_TEST_FAIL: CPU reported software test fail");
         break;
+      case SIMPLE_MONITOR_START_EVENT_LOG:
+        TraceWindow::firmware(true);
+        break;
+      case SIMPLE_MONITOR_STOP_EVENT_LOG:
+        TraceWindow::firmware(false);
+        break;
+      case SIMPLE_MONITOR_BOOT_DONE:
+        if (m_mcu != nullptr) {
+          m_ledger.bootDone(m_mcu->getCycleCount());
+        }
+        break;
+      case SIMPLE_MONITOR_RESTORE_DONE:
+        if (m_mcu != nullptr) {
+          m_ledger.restoreDone(m_mcu->getCycleCount());
+        }
+        break;
       case SIMPLE_MONITOR_INDICATE_BEGIN:
+        beginRegion(0);
         break;
       case SIMPLE_MONITOR_INDICATE_END:
+        endRegion(0);
+        break;
+      default:
+        if ((reg & ~0xffu) == SIMPLE_MONITOR_ROI_BEGIN(0)) {
+          beginRegion(reg & 0xff);
+        } else if ((reg & ~0xffu) == SIMPLE_MONITOR_ROI_END(0)) {
+          endRegion(reg & 0xff);
+        }
         break;
     }
   }
 
+  void beginRegion(const unsigned id) {
+    if (m_regions.depth() == 0) {
+      m_regions.setNames(
+          [this](int i) { return powerModelPort->getEventName(i); },
+          [this](int i) { return powerModelPort->getStateName(i); });
+    }
+    m_regions.begin(id, snapshot());
+  }
+
+  void endRegion(const unsigned id) {
+    if (!m_regions.end(id, snapshot())) {
+      spdlog::warn("{}: end of region {:d}, which isn't open", this->name(),
+                   id);
+    }
+  }
+
+  /**
+   * @brief powerChanged open/close a power cycle on the edges of pwrOn. Also
+   * runs at initialization, in case the MCU starts powered.
+   */
+  void powerChanged() {
+    if (pwrOn.read() == m_ledger.isOn()) {
+      return;
+    }
+    if (pwrOn.read()) {
+      const auto s = ledgerSnapshot();
+      if (!m_moduleNamesSet) {
+        std::vector<std::string> names;
+        for (int i = 0; i < s.moduleEnergy.size(); ++i) {
+          names.push_back(powerModelPort->getModuleName(i));
+        }
+        m_ledger.setModuleNames(names);
+        m_moduleNamesSet = true;
+      }
+      m_ledger.powerOn(s);
+    } else {
+      // The CPU is only reset at power-up, so its PC is still valid
+      m_ledger.powerOff(ledgerSnapshot(),
+                        m_mcu->dbgReadReg(m_mcu->pc_regnum()));
+    }
+  }
+
+  /**
+   * @brief ledgerSnapshot get the cumulative counters for power edges.
+   */
+  PowerCycleLedger::Snapshot ledgerSnapshot() const {
+    PowerCycleLedger::Snapshot s;
+    s.time = sc_core::sc_time_stamp();
+    s.vcap = m_capacitorVoltage ? m_capacitorVoltage() : m_mcu->vcc.read();
+    s.instructions = m_mcu->getInstructionCount();
+    s.cycles = m_mcu->getCycleCount();
+    s.lpmTime = powerModelPort->getStateTime(m_mcu->getCpuName(), "sleep");
+    powerModelPort->getModuleEnergy(s.moduleEnergy);
+    return s;
+  }
+
+  /**
+   * @brief snapshot get the cumulative counters for region boundaries.
+   */
+  RegionProfiler::Snapshot snapshot() const {
+    RegionProfiler::Snapshot s;
+    s.time = sc_core::sc_time_stamp();
+    if (m_mcu != nullptr) {
+      s.cycles = m_mcu->getCycleCount();
+      s.instructions = m_mcu->getInstructionCount();
+    }
+    s.wallTime = std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - m_wallStart)
+                     .count();
+    powerModelPort->getTotals(s.eventCounts, s.eventEnergy, s.stateEnergy);
+    return s;
+  }
+
   virtual void reset() override { /* Do nothing */
   }
 };
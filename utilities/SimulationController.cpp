@@ -7,7 +7,9 @@
 
 #include <spdlog/spdlog.h>
 #include <gdb-server/SimulationControlInterface.hpp>
+#include <string>
 #include <mcu/Microcontroller.hpp>
+#include "utilities/RspProxy.hpp"
 #include "utilities/SimulationController.hpp"
 #include "utilities/Utilities.hpp"
 
@@ -18,3 +20,33 @@ void SimulationController::kill() {
 }
 
 uint32_t SimulationController::wordSize() { return TARGET_WORD_SIZE; }
+
+bool SimulationController::handleWatchpointPacket(const std::string &packet,
+                                                  std::string &reply) {
+  Rsp::WatchpointPacket w;
+  switch (Rsp::parseWatchpointPacket(packet, w)) {
+    case Rsp::ParseResult::NotWatchpoint:
+      return false;
+    case Rsp::ParseResult::Malformed:
+      reply = "E01";
+      return true;
+    case Rsp::ParseResult::Ok:
+      break;
+  }
+
+  const bool ok = w.insert ? insertWatchpoint(w.type, w.addr, w.len)
+                           : removeWatchpoint(w.type, w.addr, w.len);
+  reply = ok ? "OK" : "E01";
+  return true;
+}
+
+std::string SimulationController::stopReply() {
+  unsigned addr;
+  int type;
+  if (!stoppedByWatchpoint(addr, type)) {
+    return "S05";
+  }
+  const char *const kind =
+      type == 3 ? "rwatch" : (type == 4 ? "awatch" : "watch");
+  return fmt::format("T05{:s}:{:x};", kind, addr);
+}
@@ -44,6 +44,38 @@ class SimulationController : public SimulationControlInterface {
     m_mcu->removeBreakpoint(addr);
   }
 
+  // Watchpoints, for gdb's Z2/Z3/Z4 & z2/z3/z4 packets (type 2: write,
+  // 3: read, 4: access)
+  virtual bool insertWatchpoint(int type, unsigned addr, unsigned len) {
+    return m_mcu->insertWatchpoint(type, addr, len);
+  }
+  virtual bool removeWatchpoint(int type, unsigned addr, unsigned len) {
+    return m_mcu->removeWatchpoint(type, addr, len);
+  }
+  // Watchpoint hit, for the stop reply ("watch", "rwatch" or "awatch")
+  virtual bool stoppedByWatchpoint(unsigned &addr, int &type) {
+    return m_mcu->stoppedByWatchpoint(addr, type);
+  }
+
+  /**
+   * @brief handleWatchpointPacket handle a gdb remote protocol watchpoint
+   * packet ("Z2,addr,kind" to "Z4,addr,kind" and the matching "z" packets),
+   * with the leading '$' and trailing checksum stripped. Called by RspProxy.
+   * @param packet packet payload
+   * @param reply set to the reply payload: "OK", or "E01" on failure
+   * @retval false if the packet is not a watchpoint packet, so reply is not
+   * set
+   */
+  virtual bool handleWatchpointPacket(const std::string &packet,
+                                      std::string &reply);
+
+  /**
+   * @brief stopReply get the stop reply payload for a halted target:
+   * "T05watch:addr;", "T05rwatch:addr;" or "T05awatch:addr;" after a
+   * watchpoint hit, "S05" otherwise.
+   */
+  virtual std::string stopReply();
+
   // Register access
   virtual uint32_t readReg(size_t num) override {
     return Utility::ttohl(m_mcu->dbgReadReg(num));
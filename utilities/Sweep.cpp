@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <spdlog/spdlog.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "utilities/Config.hpp"
+#include "utilities/Sweep.hpp"
+#include "utilities/Utilities.hpp"
+
+namespace {
+
+//! Keys read by sc_main after forkElaborated
+const char *const LATE_KEYS[] = {
+    "ProgramHexFile",        "EnsembleFile",   "SimTimeLimit",
+    "CheckpointPeriod",      "CheckpointFile", "PowerCyclesOutPutFile",
+    "OutputDirectory"};
+
+//! Exit status of the elaborating process when a point needs its own
+//! elaboration
+const int ELABORATE_PER_POINT = 3;
+
+//! Points deferred to forkElaborated, set in the elaborating process only
+std::vector<Sweep::Point> g_deferredPoints{};
+unsigned g_deferredJobs{0};
+
+//! Result of one sweep point, as seen by the parent
+struct Result {
+  std::string status{"not run"};
+  double wallTime{0.0};
+};
+
+std::string realPath(const std::string &path) {
+  char buf[PATH_MAX];
+  return realpath(path.c_str(), buf) ? std::string(buf) : path;
+}
+
+bool startsWith(const std::string &s, const std::string &prefix) {
+  return s.compare(0, prefix.size(), prefix) == 0;
+}
+
+std::string pointDirectory(const std::string &odir, const size_t idx) {
+  return fmt::format("{:s}/point{:04d}", odir, idx);
+}
+
+/**
+ * @brief applyPoint set up Config and stdio for a worker process
+ */
+void applyPoint(const Sweep::Point &point, const std::string &dir) {
+  auto &config = Config::get();
+  for (const auto &kv : point) {
+    config.set(kv.first, kv.second);
+  }
+  config.set("OutputDirectory", dir);
+  config.set("PowerCyclesOutPutFile", dir + "/power_cycles.txt");
+  config.set("CheckpointFile", dir + "/checkpoint.bin");
+
+  if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+    spdlog::error("Sweep: failed to create {:s}", dir);
+    exit(1);
+  }
+
+  // Keep worker output apart
+  const auto logPath = dir + "/fused.log";
+  if (freopen(logPath.c_str(), "w", stdout) == nullptr) {
+    exit(1);
+  }
+  dup2(fileno(stdout), fileno(stderr));
+}
+
+std::string describeStatus(const int status) {
+  if (WIFEXITED(status)) {
+    return WEXITSTATUS(status) == 0
+               ? "ok"
+               : fmt::format("exit {:d}", WEXITSTATUS(status));
+  } else if (WIFSIGNALED(status)) {
+    return fmt::format("signal {:d}", WTERMSIG(status));
+  }
+  return "unknown";
+}
+
+void writeSummary(const std::string &path,
+                  const std::vector<Sweep::Point> &points,
+                  const std::vector<Result> &results,
+                  const std::string &odir) {
+  // Columns: union of all overridden keys, in order of first appearance
+  std::vector<std::string> keys;
+  for (const auto &p : points) {
+    for (const auto &kv : p) {
+      if (std::find(keys.begin(), keys.end(), kv.first) == keys.end()) {
+        keys.push_back(kv.first);
+      }
+    }
+  }
+
+  std::ofstream os(path);
+  os << "point,status,wall_time_s";
+  for (const auto &k : keys) {
+    os << "," << k;
+  }
+  os << ",power_cycles\n";
+
+  for (size_t i = 0; i < points.size(); ++i) {
+    os << i << "," << results[i].status << "," << results[i].wallTime;
+    for (const auto &k : keys) {
+      const auto it = points[i].find(k);
+      os << "," << (it != points[i].end() ? it->second : "");
+    }
+    std::string powerCycles;
+    std::ifstream pc(pointDirectory(odir, i) + "/power_cycles.txt");
+    pc >> powerCycles;
+    os << "," << powerCycles << "\n";
+  }
+}
+
+}  // namespace
+
+namespace Sweep {
+
+std::vector<Point> parseSpec(const std::string &path, unsigned &jobs) {
+  Utility::assertFileExists(path);
+  const auto spec = YAML::LoadFile(path);
+
+  jobs = spec["Jobs"] ? spec["Jobs"].as<unsigned>() : 0;
+  if (jobs == 0) {
+    jobs = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  std::vector<Point> points;
+
+  // Full-factorial product
+  if (spec["Parameters"]) {
+    points.push_back(Point());
+    for (const auto &param : spec["Parameters"]) {
+      const auto key = param.first.as<std::string>();
+      std::vector<Point> expanded;
+      for (const auto &p : points) {
+        for (const auto &val : param.second) {
+          expanded.push_back(p);
+          expanded.back()[key] = val.as<std::string>();
+        }
+      }
+      points.swap(expanded);
+    }
+  }
+
+  // Explicit points
+  if (spec["Points"]) {
+    for (const auto &node : spec["Points"]) {
+      points.push_back(node.as<Point>());
+    }
+  }
+
+  if (points.empty()) {
+    spdlog::error("Sweep: {:s} defines no points", path);
+    exit(1);
+  }
+  return points;
+}
+
+bool forkWorkers(const std::string &path, const bool elaborateOnce) {
+  unsigned jobs;
+  const auto points = parseSpec(path, jobs);
+  if (!elaborateOnce) {
+    return runPoints(points, jobs);
+  }
+
+  // Elaborate in a child, which forks the workers from the elaborated system
+  std::fflush(nullptr);  // Don't duplicate buffered output in the child
+  const pid_t pid = fork();
+  if (pid == 0) {
+    g_deferredPoints = points;
+    g_deferredJobs = jobs;
+    return true;
+  } else if (pid < 0) {
+    spdlog::warn("Sweep: fork failed, elaborating each point");
+    return runPoints(points, jobs);
+  }
+
+  int status;
+  while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {
+  }
+  if (WIFEXITED(status) && WEXITSTATUS(status) == ELABORATE_PER_POINT) {
+    return runPoints(points, jobs);
+  } else if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    spdlog::error("Sweep: elaborating process failed ({:s})",
+                  describeStatus(status));
+  }
+  return false;
+}
+
+bool forkElaborated() {
+  if (g_deferredPoints.empty()) {
+    return true;
+  }
+  auto &config = Config::get();
+  const auto points = std::move(g_deferredPoints);
+  g_deferredPoints.clear();
+
+  std::set<std::string> early;
+  for (const auto &p : points) {
+    for (const auto &kv : p) {
+      if (!config.hasListener(kv.first) &&
+          std::find(std::begin(LATE_KEYS), std::end(LATE_KEYS), kv.first) ==
+              std::end(LATE_KEYS)) {
+        early.insert(kv.first);
+      }
+    }
+  }
+  if (!early.empty()) {
+    for (const auto &key : early) {
+      spdlog::info("Sweep: {:s} is only read during elaboration", key);
+    }
+    spdlog::info("Sweep: elaborating each point");
+    std::fflush(nullptr);
+    exit(ELABORATE_PER_POINT);
+  }
+
+  spdlog::info("Sweep: elaborated once, forking points");
+  const auto parentOdir = config.getString("OutputDirectory");
+  if (!runPoints(points, g_deferredJobs)) {
+    return false;
+  }
+
+  // Worker
+  redirectOutputs(parentOdir, config.getString("OutputDirectory"));
+  return true;
+}
+
+bool runPoints(const std::vector<Point> &points, const unsigned jobs,
+               unsigned *failed) {
+  const auto odir = Config::get().getString("OutputDirectory");
+
+  auto sysStatus = system(std::string("mkdir -p " + odir).c_str());
+  if (sysStatus) {
+    spdlog::error("Failed to create output directory at {} ... exiting", odir);
+    exit(1);
+  }
+
+  spdlog::info("Sweep: running {:d} points on {:d} workers", points.size(),
+               jobs);
+
+  typedef std::chrono::steady_clock Clock;
+  std::map<pid_t, std::pair<size_t, Clock::time_point>> running;
+  std::vector<Result> results(points.size());
+
+  auto reapOne = [&]() {
+    int status;
+    const pid_t pid = wait(&status);
+    if (pid < 0) {
+      return;
+    }
+    const auto it = running.find(pid);
+    if (it == running.end()) {
+      return;
+    }
+    const auto idx = it->second.first;
+    results[idx].status = describeStatus(status);
+    results[idx].wallTime =
+        std::chrono::duration<double>(Clock::now() - it->second.second)
+            .count();
+    spdlog::info("Sweep: point {:d} finished ({:s})", idx,
+                 results[idx].status);
+    running.erase(it);
+  };
+
+  for (size_t i = 0; i < points.size(); ++i) {
+    while (running.size() >= jobs) {
+      reapOne();
+    }
+
+    std::fflush(nullptr);  // Don't duplicate buffered output in the child
+    const pid_t pid = fork();
+    if (pid == 0) {
+      applyPoint(points[i], pointDirectory(odir, i));
+      return true;
+    } else if (pid < 0) {
+      spdlog::error("Sweep: fork failed for point {:d}", i);
+      results[i].status = "fork failed";
+      continue;
+    }
+    running[pid] = std::make_pair(i, Clock::now());
+  }
+
+  while (!running.empty()) {
+    reapOne();
+  }
+
+  if (failed != nullptr) {
+    *failed = std::count_if(results.begin(), results.end(),
+                            [](const Result &r) { return r.status != "ok"; });
+  }
+
+  const auto summaryPath = odir + "/sweep_summary.csv";
+  writeSummary(summaryPath, points, results, odir);
+  spdlog::info("Sweep: summary written to {:s}", summaryPath);
+  return false;
+}
+
+void redirectOutputs(const std::string &fromDir, const std::string &toDir) {
+  const auto from = realPath(fromDir) + "/";
+  const auto to = realPath(toDir) + "/";
+
+  std::vector<int> fds;
+  DIR *d = opendir("/proc/self/fd");
+  if (d == nullptr) {
+    spdlog::warn("Sweep: can't list open files, outputs are shared");
+    return;
+  }
+  while (const auto *e = readdir(d)) {
+    if (e->d_name[0] != '.') {
+      fds.push_back(std::atoi(e->d_name));
+    }
+  }
+  closedir(d);
+
+  for (const int fd : fds) {
+    char buf[PATH_MAX];
+    const auto link = "/proc/self/fd/" + std::to_string(fd);
+    const auto len = readlink(link.c_str(), buf, sizeof(buf) - 1);
+    struct stat st;
+    if (len <= 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+      continue;
+    }
+    const std::string target(buf, len);
+    if (!startsWith(target, from) || startsWith(target, to)) {
+      continue;
+    }
+
+    const auto copyPath = to + target.substr(from.size());
+    const int src = open(target.c_str(), O_RDONLY);
+    const int dst = open(copyPath.c_str(),
+                         O_WRONLY | O_CREAT | O_TRUNC |
+                             (fcntl(fd, F_GETFL) & O_APPEND),
+                         0644);
+    if (src < 0 || dst < 0) {
+      spdlog::warn("Sweep: failed to copy {:s} to {:s}", target, copyPath);
+      close(src);
+      close(dst);
+      continue;
+    }
+    char chunk[1 << 16];
+    ssize_t n;
+    while ((n = read(src, chunk, sizeof(chunk))) > 0) {
+      if (write(dst, chunk, n) != n) {
+        spdlog::warn("Sweep: failed to copy {:s}", target);
+        break;
+      }
+    }
+    close(src);
+    lseek(dst, lseek(fd, 0, SEEK_CUR), SEEK_SET);
+    dup2(dst, fd);
+    close(dst);
+  }
+}
+
+
+}  // namespace Sweep
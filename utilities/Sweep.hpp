@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+/*
+ * Parameter sweeps.
+ *
+ * A sweep spec is a yaml file of the form
+ *
+ *   Jobs: 0                 # Worker processes, 0 for one per core
+ *   Parameters:             # Full-factorial product of the listed values
+ *     CapacitorValue: [4.7e-6, 10.0e-6, 22.0e-6]
+ *     SVSVon: [3.3, 3.5]
+ *   Points:                 # Additional, explicit override sets
+ *     - {CapacitorValue: 1.0e-6, ProgramHexFile: other.hex}
+ *
+ * The parent process parses the configuration once, then forks one process
+ * that elaborates the system. If every swept key is applied at run-time (it
+ * has a Config listener, or is read after elaboration, e.g. ProgramHexFile),
+ * that process forks a bounded pool of workers from the elaborated state, as
+ * for program suites (see ProgramSuite.hpp). Otherwise, it exits without
+ * simulating, and the parent forks the workers instead, each of which
+ * elaborates the system with its point applied. Either way, each worker
+ * applies the overrides of one point to Config and returns to sc_main to
+ * simulate it. Outputs of point n go to <OutputDirectory>/pointNNNN, and the
+ * results are merged into <OutputDirectory>/sweep_summary.csv.
+ */
+
+namespace Sweep {
+
+//! Config overrides of one sweep point
+typedef std::map<std::string, std::string> Point;
+
+/**
+ * @brief parseSpec expand a sweep spec into its points.
+ * @param path path to sweep spec (yaml)
+ * @param jobs set to the number of worker processes requested by the spec
+ * @retval list of points, in execution order
+ */
+std::vector<Point> parseSpec(const std::string &path, unsigned &jobs);
+
+/**
+ * @brief runPoints fork a bounded pool of workers, one per point. Each worker
+ * applies its point to Config (through Config::set, so run-time listeners see
+ * the overrides) and redirects its output to <OutputDirectory>/pointNNNN.
+ * @param points config overrides of each point
+ * @param jobs maximum number of concurrent workers
+ * @param failed if set, set to the number of workers that did not exit with
+ * status 0 (in the parent)
+ * @retval true in a worker process, false in the parent once all workers have
+ * completed and the summary has been written.
+ */
+bool runPoints(const std::vector<Point> &points, const unsigned jobs,
+               unsigned *failed = nullptr);
+
+/**
+ * @brief redirectOutputs give a worker forked after elaboration its own copy
+ * of every file the parent opened in its output directory (VCD/tabular
+ * traces, logs), so workers don't interleave writes to shared file
+ * descriptors. Each copy holds what the parent wrote, and the worker continues
+ * writing at the same offset.
+ * @param fromDir output directory of the parent
+ * @param toDir output directory of the worker
+ */
+void redirectOutputs(const std::string &fromDir, const std::string &toDir);
+
+/**
+ * @brief forkWorkers run a sweep. Must be called before the board is
+ * constructed, as modules read Config during elaboration.
+ * @param path path to sweep spec (yaml)
+ * @param elaborateOnce try to fork the workers after elaboration (see
+ * forkElaborated). Set to false if sc_main can't reach forkElaborated, e.g.
+ * when restoring a checkpoint.
+ * @retval true in a process that should go on to elaborate the system: a
+ * worker with its point applied to Config, or the process that calls
+ * forkElaborated. false in the parent process, once all points have completed
+ * and the summary has been written.
+ */
+bool forkWorkers(const std::string &path, const bool elaborateOnce);
+
+/**
+ * @brief forkElaborated fork the workers of a sweep from the elaborated
+ * system, if forkWorkers deferred them. Call after elaboration, before loading
+ * the program. Exits, so that forkWorkers forks the workers before
+ * elaboration instead, if a swept key has no run-time listener.
+ * @retval true in a worker, or if there is no deferred sweep, which should go
+ * on to load the program and simulate. false in the elaborating process once
+ * all points have completed.
+ */
+bool forkElaborated();
+
+}  // namespace Sweep
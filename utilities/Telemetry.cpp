@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <spdlog/spdlog.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <systemc>
+#include <vector>
+#include "utilities/Config.hpp"
+#include "utilities/Telemetry.hpp"
+
+using namespace sc_core;
+
+namespace Telemetry {
+
+namespace {
+
+const char MAGIC[8] = {'F', 'U', 'S', 'E', 'D', 'T', 'E', 'L'};
+
+//! Publisher with a mapped segment, see afterForkChild
+Publisher *g_publisher{nullptr};
+
+}  // namespace
+
+Publisher::Publisher(const sc_module_name name, Microcontroller &mcu,
+                     PowerModelChannelOutIf &powerModel,
+                     std::function<double()> capacitorVoltage)
+    : sc_module(name),
+      m_mcu(mcu),
+      m_powerModel(powerModel),
+      m_capacitorVoltage(capacitorVoltage) {
+  auto &config = Config::get();
+  if (config.contains("TelemetryPeriod")) {
+    m_period = sc_time::from_seconds(config.getDouble("TelemetryPeriod"));
+  }
+  if (m_period == SC_ZERO_TIME) {
+    return;
+  }
+
+  m_segment = config.contains("TelemetrySegment")
+                  ? config.getString("TelemetrySegment")
+                  : "/fused-telemetry";
+  if (m_segment.empty() || m_segment[0] != '/') {
+    m_segment = "/" + m_segment;
+  }
+  open(m_segment);
+
+  static std::once_flag registered;
+  std::call_once(registered,
+                 [] { pthread_atfork(nullptr, nullptr, &afterForkChild); });
+  g_publisher = this;
+  SC_THREAD(process);
+}
+
+Publisher::~Publisher() {
+  if (m_page != nullptr) {
+    munmap(m_page, sizeof(Page));
+    shm_unlink(m_segment.c_str());
+  }
+  if (g_publisher == this) {
+    g_publisher = nullptr;
+  }
+}
+
+void Publisher::open(const std::string &segment) {
+  const int fd = shm_open(segment.c_str(), O_CREAT | O_RDWR, 0644);
+  if (fd < 0 || ftruncate(fd, sizeof(Page)) != 0) {
+    SC_REPORT_FATAL(this->name(),
+                    fmt::format("Can't create shared memory segment {:s}: {:s}",
+                                segment, std::strerror(errno))
+                        .c_str());
+  }
+  void *map = mmap(nullptr, sizeof(Page), PROT_READ | PROT_WRITE, MAP_SHARED,
+                   fd, 0);
+  close(fd);  // The mapping stays valid
+  if (map == MAP_FAILED) {
+    SC_REPORT_FATAL(
+        this->name(),
+        fmt::format("mmap failed: {:s}", std::strerror(errno)).c_str());
+  }
+
+  auto *page = static_cast<Page *>(map);
+  if (m_page != nullptr) {
+    std::memcpy(static_cast<void *>(page), m_page, sizeof(Page));
+    munmap(m_page, sizeof(Page));
+  } else {
+    std::memset(static_cast<void *>(page), 0, sizeof(Page));
+    std::memcpy(page->magic, MAGIC, sizeof(MAGIC));
+    page->version = VERSION;
+  }
+  page->pid = getpid();
+  m_page = page;
+  spdlog::info("Telemetry: publishing to shared memory segment {:s}", segment);
+}
+
+void Publisher::afterForkChild() {
+  if (g_publisher != nullptr && g_publisher->m_page != nullptr) {
+    // Leave the parent's segment to the parent
+    g_publisher->m_segment += fmt::format("-{:d}", getpid());
+    g_publisher->open(g_publisher->m_segment);
+  }
+}
+
+void Publisher::start_of_simulation() {
+  if (m_page == nullptr) {
+    return;
+  }
+  std::vector<double> energy;
+  m_powerModel.getModuleEnergy(energy);
+  if (energy.size() > MAX_MODULES) {
+    spdlog::warn("Telemetry: only the first {:d} of {:d} modules are published",
+                 MAX_MODULES, energy.size());
+  }
+  m_page->nModules = std::min<size_t>(energy.size(), MAX_MODULES);
+  for (unsigned i = 0; i < m_page->nModules; ++i) {
+    std::strncpy(m_page->moduleNames[i],
+                 m_powerModel.getModuleName(i).c_str(), NAME_LENGTH - 1);
+  }
+  m_wallStart = m_lastWall = std::chrono::steady_clock::now();
+}
+
+void Publisher::end_of_simulation() {
+  if (m_page != nullptr) {
+    update();
+    m_page->finished = 1;
+  }
+}
+
+void Publisher::process() {
+  while (true) {
+    wait(m_period);
+    update();
+  }
+}
+
+void Publisher::update() {
+  // Gather first, so the page is inconsistent for as short as possible
+  const auto wall = std::chrono::steady_clock::now();
+  const auto simTime = sc_time_stamp();
+  const double wallDelta =
+      std::chrono::duration<double>(wall - m_lastWall).count();
+  const double speed =
+      wallDelta > 0.0 ? (simTime - m_lastSimTime).to_seconds() / wallDelta
+                      : 0.0;
+  m_lastWall = wall;
+  m_lastSimTime = simTime;
+
+  PowerState state = Off;
+  if (m_mcu.nReset.read()) {
+    state = m_powerModel.getCurrentState(m_mcu.getCpuName()) == "sleep"
+                ? LowPower
+                : Active;
+  }
+  std::vector<double> energy;
+  m_powerModel.getModuleEnergy(energy);
+
+  // Sequence lock, see Telemetry.hpp
+  const uint64_t seq = m_page->sequence.load(std::memory_order_relaxed);
+  m_page->sequence.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  m_page->simTime = simTime.to_seconds();
+  m_page->wallTime = std::chrono::duration<double>(wall - m_wallStart).count();
+  m_page->speed = speed;
+  m_page->vcc = m_mcu.vcc.read();
+  m_page->vcap = m_capacitorVoltage();
+  m_page->powerState = state;
+  m_page->powerCycles = m_mcu.getPowerOnResetCount();
+  m_page->instructions = m_mcu.getInstructionCount();
+  m_page->totalEnergy = 0.0;
+  for (unsigned i = 0; i < energy.size(); ++i) {
+    m_page->totalEnergy += energy[i];
+    if (i < m_page->nModules) {
+      m_page->moduleEnergy[i] = energy[i];
+    }
+  }
+
+  m_page->sequence.store(seq + 2, std::memory_order_release);
+}
+
+}  // namespace Telemetry
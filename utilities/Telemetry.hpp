@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <systemc>
+#include "mcu/Microcontroller.hpp"
+#include "ps/PowerModelChannelIf.hpp"
+
+/*
+ * Live telemetry, for watching long runs.
+ *
+ * Every TelemetryPeriod of simulated time, a fixed-layout Page is published to
+ * the POSIX shared memory segment TelemetrySegment (/dev/shm/<name> on Linux):
+ * simulated time & speed, vcc & capacitor voltage, power state & cycles,
+ * instructions retired and energy per power model module. Read it with
+ * tools/telemetry.py.
+ *
+ * Updates are guarded by a sequence lock: the simulator never waits, readers
+ * retry if the sequence number was odd or changed while they copied the page.
+ * The segment is removed when the simulator exits. Ensemble & sweep members
+ * publish to <TelemetrySegment>-<pid>.
+ */
+namespace Telemetry {
+
+const uint32_t VERSION = 1;
+const unsigned MAX_MODULES = 32;
+const unsigned NAME_LENGTH = 48;  //! Including the terminating NUL
+
+enum PowerState : uint32_t { Off = 0, Active = 1, LowPower = 2 };
+
+//! Shared memory layout, all little-endian (see tools/telemetry.py)
+struct Page {
+  char magic[8];                         //! "FUSEDTEL"
+  uint32_t version;
+  uint32_t nModules;
+  std::atomic<uint64_t> sequence;        //! Odd while an update is in progress
+  uint64_t pid;                          //! Of the simulator
+  uint32_t powerState;                   //! See PowerState
+  uint32_t powerCycles;
+  uint32_t finished;                     //! Set at the end of simulation
+  uint32_t reserved;
+  double simTime;                        //! [s]
+  double wallTime;                       //! [s] since the start of simulation
+  double speed;                          //! Simulated / wall time, last period
+  double vcc;                            //! [V]
+  double vcap;                           //! [V]
+  uint64_t instructions;
+  double totalEnergy;                    //! [J]
+  char moduleNames[MAX_MODULES][NAME_LENGTH];
+  double moduleEnergy[MAX_MODULES];      //! [J]
+};
+
+static_assert(sizeof(std::atomic<uint64_t>) == 8,
+              "Unexpected size of Telemetry::Page::sequence");
+static_assert(offsetof(Page, moduleEnergy) == 1640 && sizeof(Page) == 1896,
+              "Telemetry::Page layout changed, update tools/telemetry.py");
+
+/**
+ * @brief The Publisher class Publishes the telemetry page of a microcontroller
+ * and its power model, if TelemetryPeriod is set.
+ */
+class Publisher : public sc_core::sc_module {
+ public:
+  SC_HAS_PROCESS(Publisher);
+
+  /**
+   * @brief Publisher constructor
+   * @param mcu microcontroller, for power state & cycles, vcc and instructions
+   * @param powerModel power model channel, for energy per module
+   * @param capacitorVoltage reads the voltage of the energy storage
+   */
+  Publisher(const sc_core::sc_module_name name, Microcontroller &mcu,
+            PowerModelChannelOutIf &powerModel,
+            std::function<double()> capacitorVoltage);
+
+  //! Unmap and remove the segment
+  ~Publisher();
+
+  virtual void start_of_simulation() override;
+  virtual void end_of_simulation() override;
+
+ private:
+  Microcontroller &m_mcu;
+  PowerModelChannelOutIf &m_powerModel;
+  std::function<double()> m_capacitorVoltage;
+
+  sc_core::sc_time m_period{sc_core::SC_ZERO_TIME};
+  std::string m_segment;  //! Name of the segment
+  Page *m_page{nullptr};
+
+  std::chrono::steady_clock::time_point m_wallStart;
+  std::chrono::steady_clock::time_point m_lastWall;
+  sc_core::sc_time m_lastSimTime{sc_core::SC_ZERO_TIME};
+
+  void process();
+
+  /**
+   * @brief open create & map a segment, copying the current page if any.
+   */
+  void open(const std::string &segment);
+
+  /**
+   * @brief update publish the current values.
+   */
+  void update();
+
+  //! pthread_atfork child handler, moves the child to its own segment
+  static void afterForkChild();
+};
+
+}  // namespace Telemetry
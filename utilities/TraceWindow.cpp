@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <systemc>
+#include <utility>
+#include <vector>
+#include "utilities/Config.hpp"
+#include "utilities/TraceWindow.hpp"
+
+using namespace sc_core;
+
+namespace TraceWindow {
+
+bool g_open{true};
+bool g_pcGated{false};
+
+namespace {
+
+bool g_configured{false};      //! Any source is configured
+bool g_firmwareGated{false};   //! TraceWindowFirmware is set
+bool g_timeOpen{false};
+bool g_pcOpen{false};
+bool g_firmwareOpen{false};
+
+std::vector<std::pair<uint32_t, uint32_t>> g_pcRanges;
+std::vector<Listener> g_listeners;
+sc_event *g_changedEvent{nullptr};
+
+/**
+ * @brief parseRanges parse a comma-separated list of "low-high" ranges.
+ * @param convert conversion of each bound
+ */
+template <typename T>
+std::vector<std::pair<T, T>> parseRanges(
+    const std::string &key, std::function<T(const std::string &)> convert) {
+  std::vector<std::pair<T, T>> ranges;
+  const auto setting = Config::get().getString(key);
+  std::stringstream ss(setting);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    item.erase(0, item.find_first_not_of(' '));
+    item.erase(item.find_last_not_of(' ') + 1);
+    if (item.empty()) {
+      continue;
+    }
+    const auto dash = item.find('-', 1);
+    try {
+      if (dash == std::string::npos) {
+        throw std::invalid_argument(item);
+      }
+      ranges.emplace_back(convert(item.substr(0, dash)),
+                          convert(item.substr(dash + 1)));
+    } catch (const std::exception &) {
+      SC_REPORT_FATAL("TraceWindow",
+                      fmt::format("Invalid range \"{:s}\" in {:s}, expected "
+                                  "\"low-high\"",
+                                  item, key)
+                          .c_str());
+    }
+    if (ranges.back().second < ranges.back().first) {
+      SC_REPORT_FATAL(
+          "TraceWindow",
+          fmt::format("Empty range \"{:s}\" in {:s}", item, key).c_str());
+    }
+  }
+  return ranges;
+}
+
+bool isSet(const std::string &key) {
+  return Config::get().contains(key) && Config::get().getString(key) != "none";
+}
+
+void update() {
+  const bool open = !g_configured || g_timeOpen || g_pcOpen || g_firmwareOpen;
+  if (open == g_open) {
+    return;
+  }
+  g_open = open;
+  for (const auto &listener : g_listeners) {
+    listener(open);
+  }
+  if (g_changedEvent != nullptr) {
+    g_changedEvent->notify(SC_ZERO_TIME);
+  }
+}
+
+}  // namespace
+
+void onChange(Listener listener) { g_listeners.push_back(listener); }
+
+const sc_event &changedEvent() {
+  sc_assert(g_changedEvent != nullptr);
+  return *g_changedEvent;
+}
+
+void updatePc(const uint32_t pc) {
+  bool inRange = false;
+  for (const auto &r : g_pcRanges) {
+    if (pc >= r.first && pc <= r.second) {
+      inRange = true;
+      break;
+    }
+  }
+  if (inRange != g_pcOpen) {
+    g_pcOpen = inRange;
+    update();
+  }
+}
+
+void firmware(const bool open) {
+  if (g_firmwareGated) {
+    g_firmwareOpen = open;
+    update();
+  }
+}
+
+/* ------ Controller ------ */
+
+Controller::Controller(const sc_module_name name) : sc_module(name) {
+  auto &config = Config::get();
+
+  if (isSet("TraceWindowTimes")) {
+    m_times = parseRanges<sc_time>(
+        "TraceWindowTimes",
+        [](const std::string &s) { return sc_time::from_seconds(std::stod(s)); });
+    std::sort(m_times.begin(), m_times.end());
+    // Merge overlapping windows
+    for (size_t i = 1; i < m_times.size();) {
+      if (m_times[i].first <= m_times[i - 1].second) {
+        m_times[i - 1].second = std::max(m_times[i - 1].second,
+                                         m_times[i].second);
+        m_times.erase(m_times.begin() + i);
+      } else {
+        ++i;
+      }
+    }
+    g_configured = true;
+    SC_THREAD(process);
+  }
+
+  if (isSet("TraceWindowPc")) {
+    g_pcRanges = parseRanges<uint32_t>(
+        "TraceWindowPc",
+        [](const std::string &s) { return std::stoul(s, nullptr, 0); });
+    g_configured = g_pcGated = true;
+  }
+
+  if (config.contains("TraceWindowFirmware") &&
+      config.getBool("TraceWindowFirmware")) {
+    g_configured = g_firmwareGated = true;
+  }
+
+  g_open = !g_configured;
+  g_changedEvent = &m_changedEvent;
+}
+
+Controller::~Controller() { g_changedEvent = nullptr; }
+
+void Controller::start_of_simulation() {
+  if (!g_open) {
+    spdlog::info("TraceWindow: detailed logging & tracing starts disabled");
+    for (const auto &listener : g_listeners) {
+      listener(false);
+    }
+  }
+}
+
+void Controller::process() {
+  for (const auto &w : m_times) {
+    if (w.second <= sc_time_stamp()) {
+      continue;
+    }
+    if (w.first > sc_time_stamp()) {
+      wait(w.first - sc_time_stamp());
+    }
+    g_timeOpen = true;
+    update();
+    wait(w.second - sc_time_stamp());
+    g_timeOpen = false;
+    update();
+  }
+}
+
+}  // namespace TraceWindow
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2020, University of Southampton and Contributors.
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <systemc>
+#include <utility>
+#include <vector>
+
+/*
+ * Trace window, gating detailed logging & tracing to windows of interest.
+ *
+ * The window is open while any of the configured sources is:
+ *  - TraceWindowTimes: comma-separated simulated time ranges "start-end" in
+ *    seconds, e.g. "0.1-0.102, 1.5-1.6".
+ *  - TraceWindowPc: comma-separated inclusive PC ranges "low-high", e.g.
+ *    "0x4400-0x44ff". Open while the CPU executes within one of them.
+ *  - TraceWindowFirmware: True to open and close the window with
+ *    SIMPLE_MONITOR_START_EVENT_LOG and SIMPLE_MONITOR_STOP_EVENT_LOG writes
+ *    to the SimpleMonitor.
+ * If none is configured, the window is always open.
+ *
+ * Gated are the power model event log (<channel>_eventlog.csv),
+ * FUSED_LOG sites, the CPU & bus traces, and the boards' vcd & tab traces.
+ * While the window is closed, the event log thread sleeps and the other sites
+ * reduce to a flag check.
+ */
+namespace TraceWindow {
+
+typedef std::function<void(bool)> Listener;
+
+extern bool g_open;
+extern bool g_pcGated;  //! TraceWindowPc is set
+
+/**
+ * @brief isOpen check if detailed logging & tracing is active
+ */
+inline bool isOpen() { return g_open; }
+
+/**
+ * @brief onChange register a callback, called with the new state whenever the
+ * window opens or closes, and at the start of simulation if it starts closed.
+ * Register during elaboration.
+ */
+void onChange(Listener listener);
+
+/**
+ * @brief changedEvent event notified whenever the window opens or closes.
+ * Requires a Controller.
+ */
+const sc_core::sc_event &changedEvent();
+
+/**
+ * @brief updatePc see pc()
+ */
+void updatePc(const uint32_t pc);
+
+/**
+ * @brief pc report the address of the instruction being executed, for
+ * TraceWindowPc. Called by the CPUs for every instruction.
+ */
+inline void pc(const uint32_t pc) {
+  if (g_pcGated) {
+    updatePc(pc);
+  }
+}
+
+/**
+ * @brief firmware open or close the window on behalf of the firmware, ignored
+ * unless TraceWindowFirmware is set.
+ */
+void firmware(const bool open);
+
+/**
+ * @brief The Controller class Reads the trace window config, and opens & closes
+ * the time windows.
+ */
+class Controller : public sc_core::sc_module {
+ public:
+  SC_HAS_PROCESS(Controller);
+  explicit Controller(const sc_core::sc_module_name name);
+  ~Controller();
+
+  virtual void start_of_simulation() override;
+
+ private:
+  //! Time windows, sorted & merged
+  std::vector<std::pair<sc_core::sc_time, sc_core::sc_time>> m_times;
+  sc_core::sc_event m_changedEvent;
+
+  void process();
+};
+
+}  // namespace TraceWindow
@@ -10,6 +10,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <fstream>
+#include "utilities/Config.hpp"
 #include "utilities/Utilities.hpp"
 
 uint64_t Utility::packBytes(uint8_t *const data, const size_t width) {
@@ -123,3 +124,35 @@ bool Utility::assertFileExists(const std::string &filename) {
   }
   return (bool)ifile;
 }
+
+namespace {
+
+//! Key of a setting of the node (top-level module) containing a module
+std::string nodeKey(const std::string &module, const std::string &key) {
+  return module.substr(0, module.find('.')) + "." + key;
+}
+
+}  // namespace
+
+std::string Utility::elfPath(const std::string &key,
+                             const std::string &module) {
+  const auto &config = Config::get();
+  if (config.contains(key) && config.getString(key) != "none") {
+    return config.getString(key);
+  }
+  auto program = nodeKey(module, "ProgramHexFile");
+  if (module.empty() || !config.contains(program)) {
+    program = "ProgramHexFile";
+  }
+  if (config.contains(program)) {
+    auto path = config.getString(program);
+    return path.substr(0, path.rfind('.')) + ".elf";
+  }
+  return "";
+}
+
+std::string Utility::outputDirectory(const std::string &module) {
+  const auto &config = Config::get();
+  const auto key = nodeKey(module, "OutputDirectory");
+  return config.getString(config.contains(key) ? key : "OutputDirectory");
+}
@@ -72,4 +72,22 @@ uint32_t setBit(size_t bitIdx, uint32_t word, bool value);
  */
 bool assertFileExists(const std::string &filename);
 
+/**
+ * @brief elfPath get the path of the firmware ELF file, for debug info.
+ * @param key config key overriding the path, unless set to none
+ * @param module hierarchical name of the module asking, for the program of
+ * its node in network simulations
+ * @return the override, the program (<node>.ProgramHexFile, or
+ * ProgramHexFile) with .elf extension, or empty.
+ */
+std::string elfPath(const std::string &key, const std::string &module = "");
+
+/**
+ * @brief outputDirectory get the directory for the output files of a module:
+ * <node>.OutputDirectory for the nodes of a network simulation, otherwise
+ * OutputDirectory.
+ * @param module hierarchical name of the module
+ */
+std::string outputDirectory(const std::string &module);
+
 }  // namespace Utility